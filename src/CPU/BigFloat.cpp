@@ -0,0 +1,300 @@
+#include "BigFloat.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+namespace Diligent
+{
+
+    BigFloat BigFloat::FromDouble(double Value, unsigned NumLimbs)
+    {
+        BigFloat Res{NumLimbs};
+        Res.m_Negative = Value < 0.0;
+
+        double Mag = std::fabs(Value);
+        for (auto& Limb : Res.m_Limbs)
+        {
+            const double Whole = std::floor(Mag);
+            Limb               = static_cast<std::uint32_t>(Whole);
+            Mag                = (Mag - Whole) * 4294967296.0;
+            if (Mag == 0.0)
+                break;
+        }
+        if (Res.IsZero())
+            Res.m_Negative = false;
+        return Res;
+    }
+
+    bool BigFloat::FromString(const char* Str, unsigned NumLimbs, BigFloat& Out)
+    {
+        if (Str == nullptr)
+            return false;
+
+        while (std::isspace(static_cast<unsigned char>(*Str)))
+            ++Str;
+
+        bool Negative = false;
+        if (*Str == '+' || *Str == '-')
+            Negative = *Str++ == '-';
+
+        // Dígitos y posición del punto decimal
+        std::string Digits;
+        int         PointPos = -1;
+        for (; *Str != '\0'; ++Str)
+        {
+            if (std::isdigit(static_cast<unsigned char>(*Str)))
+                Digits.push_back(*Str);
+            else if (*Str == '.' && PointPos < 0)
+                PointPos = static_cast<int>(Digits.size());
+            else
+                break;
+        }
+        if (Digits.empty())
+            return false;
+        if (PointPos < 0)
+            PointPos = static_cast<int>(Digits.size());
+
+        if (*Str == 'e' || *Str == 'E')
+        {
+            char* End      = nullptr;
+            long  Exponent = std::strtol(Str + 1, &End, 10);
+            if (End == Str + 1)
+                return false;
+            PointPos += static_cast<int>(Exponent);
+            Str = End;
+        }
+        while (std::isspace(static_cast<unsigned char>(*Str)))
+            ++Str;
+        if (*Str != '\0')
+            return false;
+
+        // Normaliza para que el punto quede dentro de la cadena de dígitos
+        if (PointPos < 0)
+        {
+            Digits.insert(0, static_cast<size_t>(-PointPos), '0');
+            PointPos = 0;
+        }
+        if (PointPos > static_cast<int>(Digits.size()))
+            Digits.append(static_cast<size_t>(PointPos) - Digits.size(), '0');
+
+        BigFloat Res{NumLimbs};
+
+        // Parte entera
+        std::uint64_t IntPart = 0;
+        for (int i = 0; i < PointPos; ++i)
+        {
+            IntPart = IntPart * 10 + static_cast<std::uint64_t>(Digits[i] - '0');
+            if (IntPart > 0xFFFFFFFFull)
+                return false;
+        }
+
+        // Parte fraccionaria: de derecha a izquierda, f = (d + f) / 10
+        for (int i = static_cast<int>(Digits.size()) - 1; i >= PointPos; --i)
+        {
+            Res.m_Limbs[0] += static_cast<std::uint32_t>(Digits[i] - '0');
+            std::uint64_t Rem = 0;
+            for (auto& Limb : Res.m_Limbs)
+            {
+                const std::uint64_t Cur = (Rem << 32) | Limb;
+                Limb                    = static_cast<std::uint32_t>(Cur / 10);
+                Rem                     = Cur % 10;
+            }
+        }
+        Res.m_Limbs[0] = static_cast<std::uint32_t>(IntPart);
+
+        Res.m_Negative = Negative && !Res.IsZero();
+        Out            = std::move(Res);
+        return true;
+    }
+
+    unsigned BigFloat::LimbsForZoom(double Zoom)
+    {
+        const double Bits = std::log2(std::max(Zoom, 1.0)) + 64.0;
+        return 1 + static_cast<unsigned>(std::ceil(Bits / 32.0));
+    }
+
+    double BigFloat::ToDouble() const
+    {
+        double Res   = 0.0;
+        double Scale = 1.0;
+        // Con 4 limbs ya hay más bits que la mantisa de un double
+        const size_t Count = std::min<size_t>(m_Limbs.size(), 4);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            Res += m_Limbs[i] * Scale;
+            Scale *= 1.0 / 4294967296.0;
+        }
+        return m_Negative ? -Res : Res;
+    }
+
+    std::string BigFloat::ToString(unsigned FracDigits) const
+    {
+        std::string Res = m_Negative ? "-" : "";
+        Res += std::to_string(m_Limbs[0]);
+        Res += '.';
+
+        std::vector<std::uint32_t> Frac(m_Limbs.begin() + 1, m_Limbs.end());
+        for (unsigned d = 0; d < std::max(FracDigits, 1u); ++d)
+        {
+            std::uint64_t Carry = 0;
+            for (size_t i = Frac.size(); i-- > 0;)
+            {
+                const std::uint64_t Cur = static_cast<std::uint64_t>(Frac[i]) * 10 + Carry;
+                Frac[i]                 = static_cast<std::uint32_t>(Cur);
+                Carry                   = Cur >> 32;
+            }
+            Res += static_cast<char>('0' + Carry);
+        }
+        return Res;
+    }
+
+    bool BigFloat::IsZero() const
+    {
+        return std::all_of(m_Limbs.begin(), m_Limbs.end(), [](std::uint32_t l) { return l == 0; });
+    }
+
+    void BigFloat::SetPrecision(unsigned NumLimbs)
+    {
+        m_Limbs.resize(NumLimbs < 2 ? 2 : NumLimbs, 0u);
+        if (IsZero())
+            m_Negative = false;
+    }
+
+    BigFloat BigFloat::operator-() const
+    {
+        BigFloat Res   = *this;
+        Res.m_Negative = !m_Negative && !IsZero();
+        return Res;
+    }
+
+    BigFloat BigFloat::Abs() const
+    {
+        BigFloat Res   = *this;
+        Res.m_Negative = false;
+        return Res;
+    }
+
+    BigFloat BigFloat::Twice() const
+    {
+        BigFloat      Res   = *this;
+        std::uint32_t Carry = 0;
+        for (size_t i = Res.m_Limbs.size(); i-- > 0;)
+        {
+            const std::uint32_t Cur = Res.m_Limbs[i];
+            Res.m_Limbs[i]          = (Cur << 1) | Carry;
+            Carry                   = Cur >> 31;
+        }
+        return Res;
+    }
+
+    int BigFloat::CompareMagnitude(const BigFloat& a, const BigFloat& b)
+    {
+        const size_t N = std::max(a.m_Limbs.size(), b.m_Limbs.size());
+        for (size_t i = 0; i < N; ++i)
+        {
+            const std::uint32_t la = i < a.m_Limbs.size() ? a.m_Limbs[i] : 0u;
+            const std::uint32_t lb = i < b.m_Limbs.size() ? b.m_Limbs[i] : 0u;
+            if (la != lb)
+                return la < lb ? -1 : 1;
+        }
+        return 0;
+    }
+
+    void BigFloat::AddMagnitude(const BigFloat& a, const BigFloat& b, BigFloat& Out)
+    {
+        const size_t N = std::max(a.m_Limbs.size(), b.m_Limbs.size());
+        Out.m_Limbs.assign(N, 0u);
+
+        std::uint64_t Carry = 0;
+        for (size_t i = N; i-- > 0;)
+        {
+            const std::uint64_t Sum = static_cast<std::uint64_t>(i < a.m_Limbs.size() ? a.m_Limbs[i] : 0u) +
+                (i < b.m_Limbs.size() ? b.m_Limbs[i] : 0u) + Carry;
+            Out.m_Limbs[i] = static_cast<std::uint32_t>(Sum);
+            Carry          = Sum >> 32;
+        }
+    }
+
+    void BigFloat::SubMagnitude(const BigFloat& a, const BigFloat& b, BigFloat& Out)
+    {
+        const size_t N = std::max(a.m_Limbs.size(), b.m_Limbs.size());
+        Out.m_Limbs.assign(N, 0u);
+
+        std::int64_t Borrow = 0;
+        for (size_t i = N; i-- > 0;)
+        {
+            std::int64_t Diff = static_cast<std::int64_t>(i < a.m_Limbs.size() ? a.m_Limbs[i] : 0u) -
+                static_cast<std::int64_t>(i < b.m_Limbs.size() ? b.m_Limbs[i] : 0u) - Borrow;
+            Borrow = Diff < 0 ? 1 : 0;
+            if (Diff < 0)
+                Diff += 4294967296ll;
+            Out.m_Limbs[i] = static_cast<std::uint32_t>(Diff);
+        }
+    }
+
+    BigFloat operator+(const BigFloat& a, const BigFloat& b)
+    {
+        BigFloat Res;
+        if (a.m_Negative == b.m_Negative)
+        {
+            BigFloat::AddMagnitude(a, b, Res);
+            Res.m_Negative = a.m_Negative;
+        }
+        else if (BigFloat::CompareMagnitude(a, b) >= 0)
+        {
+            BigFloat::SubMagnitude(a, b, Res);
+            Res.m_Negative = a.m_Negative;
+        }
+        else
+        {
+            BigFloat::SubMagnitude(b, a, Res);
+            Res.m_Negative = b.m_Negative;
+        }
+        if (Res.IsZero())
+            Res.m_Negative = false;
+        return Res;
+    }
+
+    BigFloat operator-(const BigFloat& a, const BigFloat& b)
+    {
+        return a + (-b);
+    }
+
+    BigFloat operator*(const BigFloat& a, const BigFloat& b)
+    {
+        const size_t N  = std::max(a.m_Limbs.size(), b.m_Limbs.size());
+        const size_t Na = a.m_Limbs.size();
+        const size_t Nb = b.m_Limbs.size();
+
+        // r[k + 1] tiene el peso del limb k; r[0] es el desbordamiento de la parte entera
+        std::vector<std::uint32_t> r(Na + Nb + 1, 0u);
+        for (size_t i = Na; i-- > 0;)
+        {
+            const std::uint64_t ai = a.m_Limbs[i];
+            if (ai == 0)
+                continue;
+            std::uint64_t Carry = 0;
+            for (size_t j = Nb; j-- > 0;)
+            {
+                const std::uint64_t t = ai * b.m_Limbs[j] + r[i + j + 1] + Carry;
+                r[i + j + 1]          = static_cast<std::uint32_t>(t);
+                Carry                 = t >> 32;
+            }
+            r[i] += static_cast<std::uint32_t>(Carry);
+        }
+
+        BigFloat Res{static_cast<unsigned>(N)};
+        for (size_t k = 0; k < N; ++k)
+            Res.m_Limbs[k] = r[k + 1];
+        Res.m_Negative = (a.m_Negative != b.m_Negative) && !Res.IsZero();
+        return Res;
+    }
+
+    bool operator==(const BigFloat& a, const BigFloat& b)
+    {
+        return BigFloat::CompareMagnitude(a, b) == 0 && (a.m_Negative == b.m_Negative || a.IsZero());
+    }
+
+} // namespace Diligent
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Diligent
+{
+
+    // Número de precisión arbitraria en coma fija (signo + magnitud) para la órbita de
+    // referencia del deep zoom. m_Limbs[0] es la parte entera (32 bits) y el resto son
+    // dígitos fraccionarios en base 2^32, así que el rango es |x| < 2^32, de sobra para
+    // iterar fractales de escape con bailout <= 10.
+    class BigFloat
+    {
+    public:
+        BigFloat() :
+            m_Limbs(2, 0u)
+        {}
+
+        explicit BigFloat(unsigned NumLimbs) :
+            m_Limbs(NumLimbs < 2 ? 2 : NumLimbs, 0u)
+        {}
+
+        static BigFloat FromDouble(double Value, unsigned NumLimbs);
+
+        // Acepta notación decimal con exponente opcional: "-0.7436438870371587", "1.5e-40".
+        // Devuelve false si la cadena no es un número válido.
+        static bool FromString(const char* Str, unsigned NumLimbs, BigFloat& Out);
+
+        // Limbs necesarios para resolver un píxel con un zoom dado (más 64 bits de guarda)
+        static unsigned LimbsForZoom(double Zoom);
+
+        double      ToDouble() const;
+        std::string ToString(unsigned FracDigits) const;
+
+        unsigned GetNumLimbs() const { return static_cast<unsigned>(m_Limbs.size()); }
+        bool     IsNegative() const { return m_Negative; }
+        bool     IsZero() const;
+
+        // Cambia la precisión truncando o extendiendo con ceros
+        void SetPrecision(unsigned NumLimbs);
+
+        BigFloat operator-() const;
+        BigFloat Abs() const;
+        BigFloat Twice() const;
+
+        friend BigFloat operator+(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator-(const BigFloat& a, const BigFloat& b);
+        friend BigFloat operator*(const BigFloat& a, const BigFloat& b);
+
+        friend bool operator==(const BigFloat& a, const BigFloat& b);
+        friend bool operator!=(const BigFloat& a, const BigFloat& b) { return !(a == b); }
+
+    private:
+        static int  CompareMagnitude(const BigFloat& a, const BigFloat& b);
+        static void AddMagnitude(const BigFloat& a, const BigFloat& b, BigFloat& Out);
+        static void SubMagnitude(const BigFloat& a, const BigFloat& b, BigFloat& Out); // |a| >= |b|
+
+        bool                       m_Negative = false;
+        std::vector<std::uint32_t> m_Limbs;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,225 @@
+#include "CPUDistanceBricks.hpp"
+
+#include <chrono>
+
+#include "CPUFractalKernels3D.hpp"
+
+namespace Diligent
+{
+
+    namespace
+    {
+        // Semilado del dominio horneado, centrado en el origen. El Mandelbulb cabe en la bola
+        // de radio 1.5; el Menger se repite sin fin, así que se hornea la zona alrededor del
+        // cubo central (MengerDomainScale veces su tamaño) y fuera se marcha con el DE analítico.
+        constexpr float MandelbulbDomainHalfExtent = 1.5f;
+        constexpr float MengerDomainScale          = 3.0f;
+
+        double SecondsSince(const std::chrono::steady_clock::time_point& Start)
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+        }
+    } // namespace
+
+    bool CPUDistanceBrickCache::IsSupported(const CPUShaderConstants& Constants)
+    {
+        // Solo se hornean el Mandelbulb y el Menger; Mandelbox y Quaternion Julia marchan con su DE
+        const int Type = static_cast<int>(Constants.TimeAndResolution.w);
+        return Constants.CameraPos.w > 0.5f && (Type == CPU_FRACTAL_3D_MANDELBULB || Type == CPU_FRACTAL_3D_MENGER_SPONGE);
+    }
+
+    CPUDistanceBrickCache::SceneKey CPUDistanceBrickCache::MakeSceneKey(const CPUShaderConstants& Constants)
+    {
+        const CPUFractal3DSetup Setup = MakeFractal3DSetup(Constants);
+
+        SceneKey Key;
+        Key.IsMenger = Setup.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE;
+        if (Key.IsMenger)
+        {
+            Key.MengerSize = Setup.MengerSize;
+            Key.Iterations = Setup.Iterations;
+            Key.Thresh     = Setup.Thresh;
+        }
+        else
+        {
+            Key.Power = Setup.Power;
+        }
+        return Key;
+    }
+
+    bool CPUDistanceBrickCache::IsCompatible(const CPUShaderConstants& Constants) const
+    {
+        const SceneKey Key = MakeSceneKey(Constants);
+        return m_Valid && IsSupported(Constants) && Key.IsMenger == m_Key.IsMenger && Key.Power == m_Key.Power && Key.MengerSize == m_Key.MengerSize &&
+            Key.Iterations == m_Key.Iterations && Key.Thresh == m_Key.Thresh;
+    }
+
+    float CPUDistanceBrickCache::EvaluateDistance(const CPUFloat3& p, int Channel) const
+    {
+        if (!m_Key.IsMenger)
+            return DistanceMandelbulbFast(p, m_Key.Power);
+        if (Channel == CPU_DISTANCE_BRICK_CHANNEL_SCENE)
+            return DistanceMengerMap(p, m_Key.MengerSize, m_Key.Iterations, m_Key.Thresh);
+        // calculateShadow: el cubo de lado 2 * size centrado en el origen
+        const CPUFloat3 q{p.x / m_Key.MengerSize, p.y / m_Key.MengerSize, p.z / m_Key.MengerSize};
+        return DistanceMengerSponge(q, m_Key.Iterations) * m_Key.MengerSize;
+    }
+
+    bool CPUDistanceBrickCache::Prepare(CPUThreadPool& Pool, const CPUShaderConstants& Constants, const CPUDistanceBrickSettings& Settings)
+    {
+        const bool SameSettings = Settings.CellsPerAxis == m_Settings.CellsPerAxis && Settings.BrickResolution == m_Settings.BrickResolution &&
+            Settings.BandCells == m_Settings.BandCells;
+        if (SameSettings && IsCompatible(Constants))
+            return false;
+
+        const auto Start = std::chrono::steady_clock::now();
+
+        m_Valid       = true;
+        m_Key         = MakeSceneKey(Constants);
+        m_Settings    = Settings;
+        m_NumChannels = m_Key.IsMenger ? 2 : 1;
+
+        const float HalfExtent = m_Key.IsMenger ? MengerDomainScale * m_Key.MengerSize : MandelbulbDomainHalfExtent;
+        const std::uint32_t N  = m_Settings.CellsPerAxis;
+        m_DomainMin            = CPUFloat3{-HalfExtent, -HalfExtent, -HalfExtent};
+        m_CellSize             = 2.0f * HalfExtent / static_cast<float>(N);
+
+        m_Cells.assign(static_cast<size_t>(N) * N * N, CPUFloat4{});
+        m_BrickData.clear();
+        m_Pending.clear();
+        m_LastBaked.clear();
+        m_Stats = {};
+
+        // Clasificación: la celda está en la banda si, en algún canal, el DE de su centro no
+        // garantiza al menos BandCells celdas vacías más allá de su semidiagonal
+        const float HalfDiagonal = 0.8660254f * m_CellSize;
+        const float Band         = HalfDiagonal + m_Settings.BandCells * m_CellSize;
+        Pool.ParallelFor(N * N, [&](std::uint32_t Row, std::uint32_t) {
+            const std::uint32_t y = Row % N;
+            const std::uint32_t z = Row / N;
+            for (std::uint32_t x = 0; x < N; ++x)
+            {
+                const CPUFloat3 Center{m_DomainMin.x + (x + 0.5f) * m_CellSize, m_DomainMin.y + (y + 0.5f) * m_CellSize,
+                                       m_DomainMin.z + (z + 0.5f) * m_CellSize};
+
+                CPUFloat4& Cell = m_Cells[static_cast<size_t>(Row) * N + x];
+                Cell.x          = EvaluateDistance(Center, CPU_DISTANCE_BRICK_CHANNEL_SCENE);
+                Cell.y          = m_NumChannels > 1 ? EvaluateDistance(Center, CPU_DISTANCE_BRICK_CHANNEL_SHADOW) : Cell.x;
+                Cell.z          = std::abs(Cell.x) < Band || std::abs(Cell.y) < Band ? PendingBrick : NoBrick;
+            }
+        });
+
+        for (std::uint32_t i = 0, Count = static_cast<std::uint32_t>(m_Cells.size()); i < Count; ++i)
+        {
+            if (m_Cells[i].z == PendingBrick)
+                m_Pending.push_back(i);
+        }
+
+        m_Stats.Cells         = static_cast<std::uint32_t>(m_Cells.size());
+        m_Stats.BandBricks    = static_cast<std::uint32_t>(m_Pending.size());
+        m_Stats.MemoryBytes   = m_Cells.size() * sizeof(CPUFloat4);
+        m_Stats.CoarseSeconds = SecondsSince(Start);
+        return true;
+    }
+
+    std::uint32_t CPUDistanceBrickCache::BakeNearCamera(CPUThreadPool& Pool, const CPUFloat3& Eye, std::uint32_t MaxBricks)
+    {
+        m_LastBaked.clear();
+        if (!m_Valid || m_Pending.empty() || MaxBricks == 0)
+            return 0;
+
+        const auto Start = std::chrono::steady_clock::now();
+
+        // Las celdas pendientes más cercanas a la cámara pasan al final de m_Pending (a igual
+        // distancia, la de menor índice), para que el resultado no dependa del orden previo
+        const std::uint32_t N = m_Settings.CellsPerAxis;
+        auto CellDist2 = [&](std::uint32_t Index) {
+            const float dx = m_DomainMin.x + (Index % N + 0.5f) * m_CellSize - Eye.x;
+            const float dy = m_DomainMin.y + (Index / N % N + 0.5f) * m_CellSize - Eye.y;
+            const float dz = m_DomainMin.z + (Index / (N * N) + 0.5f) * m_CellSize - Eye.z;
+            return dx * dx + dy * dy + dz * dz;
+        };
+        auto Farther = [&](std::uint32_t a, std::uint32_t b) {
+            const float da = CellDist2(a);
+            const float db = CellDist2(b);
+            return da != db ? da > db : a > b;
+        };
+
+        const std::uint32_t Count = std::min(MaxBricks, static_cast<std::uint32_t>(m_Pending.size()));
+        const auto          First = m_Pending.end() - Count;
+        if (Count < m_Pending.size())
+            std::nth_element(m_Pending.begin(), First, m_Pending.end(), Farther);
+        std::sort(First, m_Pending.end(), Farther);
+
+        // Slots consecutivos, del más cercano al más lejano
+        const std::uint32_t FirstSlot = m_Stats.BakedBricks;
+        std::vector<std::uint32_t> Cells(m_Pending.rbegin(), m_Pending.rbegin() + Count);
+        m_Pending.resize(m_Pending.size() - Count);
+        m_BrickData.resize(static_cast<size_t>(FirstSlot + Count) * GetBrickFloats());
+
+        const std::uint32_t S         = GetBrickSamples();
+        const float         Voxel     = GetVoxelSize();
+        const float         MaxMargin = 0.8660254f * Voxel; // cota para un DE 1-Lipschitz
+        std::vector<float>  Margins(Count);
+        Pool.ParallelFor(Count, [&](std::uint32_t i, std::uint32_t) {
+            const std::uint32_t Index = Cells[i];
+            const CPUFloat3     Corner{m_DomainMin.x + (Index % N) * m_CellSize, m_DomainMin.y + (Index / N % N) * m_CellSize,
+                                   m_DomainMin.z + (Index / (N * N)) * m_CellSize};
+
+            float* pBrick = m_BrickData.data() + static_cast<size_t>(FirstSlot + i) * GetBrickFloats();
+            float* pOut   = pBrick;
+            for (std::uint32_t z = 0; z < S; ++z)
+            {
+                for (std::uint32_t y = 0; y < S; ++y)
+                {
+                    for (std::uint32_t x = 0; x < S; ++x)
+                    {
+                        const CPUFloat3 p{Corner.x + x * Voxel, Corner.y + y * Voxel, Corner.z + z * Voxel};
+                        for (std::uint32_t c = 0; c < m_NumChannels; ++c)
+                            *pOut++ = EvaluateDistance(p, static_cast<int>(c));
+                    }
+                }
+            }
+
+            // Error de la interpolación en el centro de cada vóxel, donde es mayor; el margen
+            // del brick lo dobla para cubrir lo que no se ve en los centros
+            const size_t C     = m_NumChannels;
+            const size_t StepY = S * C;
+            const size_t StepZ = S * S * C;
+            float        Error = 0.0f;
+            for (std::uint32_t z = 0; z + 1 < S; ++z)
+            {
+                for (std::uint32_t y = 0; y + 1 < S; ++y)
+                {
+                    for (std::uint32_t x = 0; x + 1 < S; ++x)
+                    {
+                        const CPUFloat3 p{Corner.x + (x + 0.5f) * Voxel, Corner.y + (y + 0.5f) * Voxel, Corner.z + (z + 0.5f) * Voxel};
+                        for (std::uint32_t c = 0; c < C; ++c)
+                        {
+                            const float* s      = pBrick + ((z * S + y) * S + x) * C + c;
+                            const float  Interp = (s[0] + s[C] + s[StepY] + s[StepY + C] + s[StepZ] + s[StepZ + C] + s[StepZ + StepY] +
+                                                  s[StepZ + StepY + C]) *
+                                0.125f;
+                            Error = std::max(Error, std::abs(Interp - EvaluateDistance(p, static_cast<int>(c))));
+                        }
+                    }
+                }
+            }
+            Margins[i] = std::min(2.0f * Error, MaxMargin);
+        });
+
+        // Las celdas solo apuntan a su brick cuando ya está completo
+        for (std::uint32_t i = 0; i < Count; ++i)
+        {
+            m_Cells[Cells[i]].z = static_cast<float>(FirstSlot + i);
+            m_Cells[Cells[i]].w = Margins[i];
+            m_LastBaked.push_back(FirstSlot + i);
+        }
+
+        m_Stats.BakedBricks += Count;
+        m_Stats.MemoryBytes = m_Cells.size() * sizeof(CPUFloat4) + m_BrickData.size() * sizeof(float);
+        m_Stats.BrickSeconds += SecondsSince(Start);
+        return Count;
+    }
+
+} // namespace Diligent
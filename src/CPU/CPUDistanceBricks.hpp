@@ -0,0 +1,184 @@
+#pragma once
+
+// Cache de distancias horneado para los fractales 3D estáticos (Menger, y el Mandelbulb con
+// la potencia fija o el tiempo parado). El dominio se parte en CellsPerAxis^3 celdas; cada
+// celda guarda el DE en su centro y, si está en la banda estrecha alrededor de la superficie,
+// un brick de (BrickResolution + 1)^3 muestras. La marcha (CPUFractalKernels3D y fractalBricks.fxh)
+// avanza con la distancia conservadora del cache y evalúa el DE analítico solo cuando queda
+// cerca de la superficie, fuera del dominio o en un brick que aún no se ha horneado.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "CPUShaderConstants.hpp"
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    // Canales del cache: la distancia de la marcha (DE del Mandelbulb o map del Menger) y la
+    // de calculateShadow (DE_MengerSponge, solo en el Menger)
+    enum CPU_DISTANCE_BRICK_CHANNEL : int
+    {
+        CPU_DISTANCE_BRICK_CHANNEL_SCENE = 0,
+        CPU_DISTANCE_BRICK_CHANNEL_SHADOW,
+        CPU_DISTANCE_BRICK_CHANNEL_COUNT
+    };
+
+    struct CPUDistanceBrickSettings
+    {
+        std::uint32_t CellsPerAxis    = 32;
+        std::uint32_t BrickResolution = 4;    // vóxeles por eje de cada brick
+        float         BandCells       = 1.0f; // ancho de la banda estrecha fuera de la celda, en celdas
+    };
+
+    struct CPUDistanceBrickStats
+    {
+        std::uint32_t Cells         = 0;
+        std::uint32_t BandBricks    = 0; // celdas de la banda (bricks posibles)
+        std::uint32_t BakedBricks   = 0;
+        std::uint64_t MemoryBytes   = 0; // celdas + bricks horneados
+        double        CoarseSeconds = 0; // clasificación de las celdas
+        double        BrickSeconds  = 0; // horneado de bricks, acumulado
+    };
+
+    class CPUDistanceBrickCache
+    {
+    public:
+        // Slot de las celdas sin brick (en CPUFloat4::z de GetCells)
+        static constexpr float NoBrick      = -1.0f; // lejos de la superficie (o dentro)
+        static constexpr float PendingBrick = -2.0f; // en la banda, sin hornear todavía
+
+        // ¿Hay cache para el fractal de Constants? Menger y Mandelbulb
+        static bool IsSupported(const CPUShaderConstants& Constants);
+
+        // Prepara el cache para la escena de Constants. Si la escena (tipo, potencia, tamaño,
+        // iteraciones y umbral del Menger) o Settings cambiaron, lo vacía y vuelve a clasificar
+        // las celdas: una evaluación del DE por celda y canal. Devuelve true si lo rehízo.
+        bool Prepare(CPUThreadPool& Pool, const CPUShaderConstants& Constants, const CPUDistanceBrickSettings& Settings);
+
+        // Hornea hasta MaxBricks bricks pendientes, los más cercanos a Eye primero, repartidos
+        // entre los hilos de Pool. Devuelve cuántos horneó; sus slots quedan en GetLastBakedBricks.
+        std::uint32_t BakeNearCamera(CPUThreadPool& Pool, const CPUFloat3& Eye, std::uint32_t MaxBricks);
+
+        // ¿Se puede usar con Constants? (misma escena que el último Prepare)
+        bool IsCompatible(const CPUShaderConstants& Constants) const;
+        bool IsComplete() const { return m_Stats.BakedBricks == m_Stats.BandBricks; }
+
+        // Distancia conservadora en p para Channel. Devuelve false si hay que evaluar el DE
+        // analítico: fuera del dominio o a menos de FallbackVoxels vóxeles de la superficie.
+        bool Sample(const CPUFloat3& p, int Channel, float& Dist) const;
+
+        const CPUDistanceBrickStats& GetStats() const { return m_Stats; }
+
+        // Datos para subir a la GPU (FractalViewer): una celda por texel (x, y = distancia en
+        // el centro por canal, z = slot del brick o NoBrick/PendingBrick, w = margen de error
+        // de la interpolación en el brick) y los bricks por slot,
+        // GetBrickSamples() muestras de GetNumChannels() floats, x más rápido
+        const std::vector<CPUFloat4>&     GetCells() const { return m_Cells; }
+        const float*                      GetBrickData(std::uint32_t Slot) const { return m_BrickData.data() + static_cast<size_t>(Slot) * GetBrickFloats(); }
+        const std::vector<std::uint32_t>& GetLastBakedBricks() const { return m_LastBaked; }
+        std::uint32_t                     GetNumChannels() const { return m_NumChannels; }
+        std::uint32_t                     GetBrickSamples() const { return m_Settings.BrickResolution + 1; }
+        const CPUDistanceBrickSettings&   GetSettings() const { return m_Settings; }
+        const CPUFloat3&                  GetDomainMin() const { return m_DomainMin; }
+        float                             GetCellSize() const { return m_CellSize; }
+        float                             GetVoxelSize() const { return m_CellSize / static_cast<float>(m_Settings.BrickResolution); }
+
+        // Distancia por debajo de la que se vuelve al DE analítico
+        float GetFallbackDist() const { return FallbackVoxels * GetVoxelSize(); }
+
+        static constexpr float FallbackVoxels = 0.25f;
+
+    private:
+        size_t GetBrickFloats() const
+        {
+            const size_t n = GetBrickSamples();
+            return n * n * n * m_NumChannels;
+        }
+
+        float EvaluateDistance(const CPUFloat3& p, int Channel) const;
+
+        // Escena del último Prepare
+        struct SceneKey
+        {
+            bool  IsMenger   = false;
+            float Power      = 0; // Mandelbulb
+            float MengerSize = 0;
+            int   Iterations = 0;
+            float Thresh     = 0;
+        };
+        static SceneKey MakeSceneKey(const CPUShaderConstants& Constants);
+
+        bool                     m_Valid = false;
+        SceneKey                 m_Key;
+        CPUDistanceBrickSettings m_Settings;
+        std::uint32_t            m_NumChannels = 1;
+        CPUFloat3                m_DomainMin;
+        float                    m_CellSize = 0;
+
+        std::vector<CPUFloat4>     m_Cells;
+        std::vector<float>         m_BrickData;
+        std::vector<std::uint32_t> m_Pending; // celdas de la banda sin hornear
+        std::vector<std::uint32_t> m_LastBaked;
+        CPUDistanceBrickStats      m_Stats;
+    };
+
+    inline bool CPUDistanceBrickCache::Sample(const CPUFloat3& p, int Channel, float& Dist) const
+    {
+        const float         Inv = 1.0f / m_CellSize;
+        const float         gx  = (p.x - m_DomainMin.x) * Inv;
+        const float         gy  = (p.y - m_DomainMin.y) * Inv;
+        const float         gz  = (p.z - m_DomainMin.z) * Inv;
+        const float         n   = static_cast<float>(m_Settings.CellsPerAxis);
+        if (!(gx >= 0.0f && gy >= 0.0f && gz >= 0.0f && gx < n && gy < n && gz < n))
+            return false;
+
+        const std::uint32_t N    = m_Settings.CellsPerAxis;
+        const std::uint32_t cx   = static_cast<std::uint32_t>(gx);
+        const std::uint32_t cy   = static_cast<std::uint32_t>(gy);
+        const std::uint32_t cz   = static_cast<std::uint32_t>(gz);
+        const CPUFloat4&    Cell = m_Cells[(static_cast<size_t>(cz) * N + cy) * N + cx];
+
+        if (Cell.z < 0.0f)
+        {
+            // Sin brick: el DE del centro menos la distancia al centro (1-Lipschitz)
+            const float dx = gx - (static_cast<float>(cx) + 0.5f);
+            const float dy = gy - (static_cast<float>(cy) + 0.5f);
+            const float dz = gz - (static_cast<float>(cz) + 0.5f);
+            Dist           = (Channel == 0 ? Cell.x : Cell.y) - std::sqrt(dx * dx + dy * dy + dz * dz) * m_CellSize;
+        }
+        else
+        {
+            // Trilineal entre las muestras del brick, menos el margen de error medido al hornearlo
+            const float         Res = static_cast<float>(m_Settings.BrickResolution);
+            const float         fx  = std::min((gx - static_cast<float>(cx)) * Res, Res - 0.001f);
+            const float         fy  = std::min((gy - static_cast<float>(cy)) * Res, Res - 0.001f);
+            const float         fz  = std::min((gz - static_cast<float>(cz)) * Res, Res - 0.001f);
+            const std::uint32_t ix  = static_cast<std::uint32_t>(fx);
+            const std::uint32_t iy  = static_cast<std::uint32_t>(fy);
+            const std::uint32_t iz  = static_cast<std::uint32_t>(fz);
+            const float         tx  = fx - static_cast<float>(ix);
+            const float         ty  = fy - static_cast<float>(iy);
+            const float         tz  = fz - static_cast<float>(iz);
+
+            const size_t S      = GetBrickSamples();
+            const size_t C      = m_NumChannels;
+            const float* pBrick = GetBrickData(static_cast<std::uint32_t>(Cell.z)) + ((iz * S + iy) * S + ix) * C + Channel;
+            const size_t StepX  = C;
+            const size_t StepY  = S * C;
+            const size_t StepZ  = S * S * C;
+
+            auto Lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+            const float d00 = Lerp(pBrick[0], pBrick[StepX], tx);
+            const float d10 = Lerp(pBrick[StepY], pBrick[StepY + StepX], tx);
+            const float d01 = Lerp(pBrick[StepZ], pBrick[StepZ + StepX], tx);
+            const float d11 = Lerp(pBrick[StepZ + StepY], pBrick[StepZ + StepY + StepX], tx);
+            Dist            = Lerp(Lerp(d00, d10, ty), Lerp(d01, d11, ty), tz) - Cell.w;
+        }
+        return Dist >= GetFallbackDist();
+    }
+
+} // namespace Diligent
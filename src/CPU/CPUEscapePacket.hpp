@@ -0,0 +1,183 @@
+#pragma once
+
+// Bucles de escape 2D vectorizados de CPUFractalKernels2D.cpp. Cabecera interna de FractalCPU:
+// el ancho de SimdPack depende de FRACTAL_CPU_AVX2, que solo se aplica a los .cpp de src/CPU,
+// así que ninguna cabecera pública ni herramienta debe incluirla.
+
+#include "CPUFractalKernels2D.hpp"
+#include "SimdPack.hpp"
+
+namespace Diligent
+{
+
+    // Lanes con c dentro de la cardioide principal o del bulbo de periodo 2 del Mandelbrot
+    // (IsInMainCardioidOrBulb de fractal2D.fxh)
+    template <typename T>
+    SimdPack<T> InMainCardioidOrBulb(const SimdPack<T>& cx, const SimdPack<T>& cy)
+    {
+        using Pack = SimdPack<T>;
+
+        const Pack xq = cx - Pack::Broadcast(T(0.25));
+        const Pack q  = xq * xq + cy * cy;
+        const Pack xb = cx + Pack::Broadcast(T(1));
+        return (q * (q + xq) < Pack::Broadcast(T(0.25)) * cy * cy) | (xb * xb + cy * cy < Pack::Broadcast(T(0.0625)));
+    }
+
+    // Bucle de escape vectorizado para un paquete de SimdPack<T>::Width píxeles.
+    // Zx/Zy contienen z0 a la entrada y el z final a la salida; Iter recibe i y Executed las
+    // iteraciones hechas de verdad. Con PeriodTol2 > 0 las lanes del interior salen antes
+    // (detección de periodo de Brent, y cardioide / bulbo con InteriorShortcut) con Iter = MaxIter.
+    template <typename T, CPU_ESCAPE_FORMULA Formula>
+    void EscapePacket(const T* Cx, const T* Cy, T* Zx, T* Zy, T* Iter, T* Executed, int MaxIter, T Bailout2, T PeriodTol2, bool InteriorShortcut)
+    {
+        using Pack = SimdPack<T>;
+
+        const Pack cx  = Pack::Load(Cx);
+        const Pack cy  = Pack::Load(Cy);
+        const Pack bb  = Pack::Broadcast(Bailout2);
+        const Pack tol = Pack::Broadcast(PeriodTol2);
+        const Pack One = Pack::Broadcast(T(1));
+        const Pack Two = Pack::Broadcast(T(2));
+
+        Pack zx       = Pack::Load(Zx);
+        Pack zy       = Pack::Load(Zy);
+        Pack sx       = zx;
+        Pack sy       = zy;
+        Pack it       = Pack::Broadcast(T(0));
+        Pack exec     = Pack::Broadcast(T(0));
+        Pack interior = Pack::Broadcast(T(0)); // máscara sin lanes
+        if (Formula == CPU_ESCAPE_FORMULA_MANDELBROT && InteriorShortcut)
+            interior = InMainCardioidOrBulb(cx, cy);
+        Pack active = AndNot(interior, AllLanes<T>());
+        int  check  = 1;
+
+        for (int i = 0; i < MaxIter && AnyLane(active); ++i)
+        {
+            Pack x = zx, y = zy;
+            if (Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP)
+            {
+                x = Abs(x);
+                y = Abs(y);
+            }
+            const Pack nx = x * x - y * y + cx;
+            const Pack ny = Two * x * y + cy;
+
+            // Las lanes que ya escaparon conservan su z final
+            zx = Select(active, nx, zx);
+            zy = Select(active, ny, zy);
+
+            exec = exec + (active & One);
+
+            const Pack escaped = active & (zx * zx + zy * zy > bb);
+            active             = AndNot(escaped, active);
+            if (PeriodTol2 > T(0))
+            {
+                // Brent: z vuelve al punto guardado en el último checkpoint
+                const Pack dx       = zx - sx;
+                const Pack dy       = zy - sy;
+                const Pack periodic = active & (dx * dx + dy * dy < tol);
+                interior            = interior | periodic;
+                active              = AndNot(periodic, active);
+                if (i + 1 == check)
+                {
+                    sx = zx;
+                    sy = zy;
+                    check *= 2;
+                }
+            }
+            it = it + (active & One);
+        }
+        it = Select(interior, Pack::Broadcast(static_cast<T>(MaxIter)), it);
+
+        zx.Store(Zx);
+        zy.Store(Zy);
+        it.Store(Iter);
+        exec.Store(Executed);
+    }
+
+    // Números double-float de un paquete, con Hi y Lo en arrays separados
+    struct CPUDoubleFloatLanes
+    {
+        float Hi[SimdPack<float>::Width];
+        float Lo[SimdPack<float>::Width];
+    };
+
+    // EscapePacket con double-float: la misma iteración que EscapeDoubleFloat2D del HLSL.
+    // Solo la comparación con el bailout y |z| usan la parte alta; la detección de periodo
+    // resta por partes.
+    template <CPU_ESCAPE_FORMULA Formula>
+    void EscapePacketDF(const CPUDoubleFloatLanes& Cx, const CPUDoubleFloatLanes& Cy, CPUDoubleFloatLanes& Zx, CPUDoubleFloatLanes& Zy, float* Iter,
+                        float* Executed, int MaxIter, float Bailout2, float PeriodTol2, bool InteriorShortcut)
+    {
+        using Pack = SimdPack<float>;
+        using DF   = DoubleFloat<Pack>;
+
+        const DF   cx   = {Pack::Load(Cx.Hi), Pack::Load(Cx.Lo)};
+        const DF   cy   = {Pack::Load(Cy.Hi), Pack::Load(Cy.Lo)};
+        const Pack bb   = Pack::Broadcast(Bailout2);
+        const Pack tol  = Pack::Broadcast(PeriodTol2);
+        const Pack Zero = Pack::Broadcast(0.0f);
+        const Pack One  = Pack::Broadcast(1.0f);
+        const Pack Two  = Pack::Broadcast(2.0f);
+
+        DF   zx       = {Pack::Load(Zx.Hi), Pack::Load(Zx.Lo)};
+        DF   zy       = {Pack::Load(Zy.Hi), Pack::Load(Zy.Lo)};
+        DF   sx       = zx;
+        DF   sy       = zy;
+        Pack it       = Zero;
+        Pack exec     = Zero;
+        Pack interior = Zero;
+        if (Formula == CPU_ESCAPE_FORMULA_MANDELBROT && InteriorShortcut)
+            interior = InMainCardioidOrBulb(cx.Hi, cy.Hi);
+        Pack active = AndNot(interior, AllLanes<float>());
+        int  check  = 1;
+
+        for (int i = 0; i < MaxIter && AnyLane(active); ++i)
+        {
+            DF x = zx, y = zy;
+            if (Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP)
+            {
+                // |x| de un double-float: el signo es el de la parte alta
+                const Pack NegX = x.Hi < Zero;
+                const Pack NegY = y.Hi < Zero;
+                x               = {Select(NegX, Zero - x.Hi, x.Hi), Select(NegX, Zero - x.Lo, x.Lo)};
+                y               = {Select(NegY, Zero - y.Hi, y.Hi), Select(NegY, Zero - y.Lo, y.Lo)};
+            }
+            const DF xy = DFMul(x, y);
+            const DF nx = DFAdd(DFSub(DFSqr(x), DFSqr(y)), cx);
+            const DF ny = DFAdd(DF{Two * xy.Hi, Two * xy.Lo}, cy);
+
+            zx = {Select(active, nx.Hi, zx.Hi), Select(active, nx.Lo, zx.Lo)};
+            zy = {Select(active, ny.Hi, zy.Hi), Select(active, ny.Lo, zy.Lo)};
+
+            exec = exec + (active & One);
+
+            const Pack escaped = active & (zx.Hi * zx.Hi + zy.Hi * zy.Hi > bb);
+            active             = AndNot(escaped, active);
+            if (PeriodTol2 > 0.0f)
+            {
+                const Pack dx       = (zx.Hi - sx.Hi) + (zx.Lo - sx.Lo);
+                const Pack dy       = (zy.Hi - sy.Hi) + (zy.Lo - sy.Lo);
+                const Pack periodic = active & (dx * dx + dy * dy < tol);
+                interior            = interior | periodic;
+                active              = AndNot(periodic, active);
+                if (i + 1 == check)
+                {
+                    sx = zx;
+                    sy = zy;
+                    check *= 2;
+                }
+            }
+            it = it + (active & One);
+        }
+        it = Select(interior, Pack::Broadcast(static_cast<float>(MaxIter)), it);
+
+        zx.Hi.Store(Zx.Hi);
+        zx.Lo.Store(Zx.Lo);
+        zy.Hi.Store(Zy.Hi);
+        zy.Lo.Store(Zy.Lo);
+        it.Store(Iter);
+        exec.Store(Executed);
+    }
+
+} // namespace Diligent
@@ -0,0 +1,404 @@
+#include "CPUFractalKernels2D.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+#include "CPUEscapePacket.hpp"
+
+namespace Diligent
+{
+
+    namespace
+    {
+        // c0 de RenderJuliaTwinDragons2DColors (literal float promocionado a double)
+        constexpr double JuliaC0X = static_cast<double>(-0.123f);
+        constexpr double JuliaC0Y = static_cast<double>(0.745f);
+
+        inline float Lerp(float a, float b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        inline CPUFloat4 Lerp(const CPUFloat4& a, const CPUFloat4& b, float t)
+        {
+            return CPUFloat4{Lerp(a.x, b.x, t), Lerp(a.y, b.y, t), Lerp(a.z, b.z, t), Lerp(a.w, b.w, t)};
+        }
+
+        inline float Saturate(float x)
+        {
+            return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+        }
+
+        // Paleta cosenoidal de los kernels "Colors"
+        inline CPUFloat3 CosinePalette(float t, float PhaseG, float PhaseB)
+        {
+            const float TwoPi = 6.2831853f;
+            return CPUFloat3{
+                0.5f + 0.5f * std::cos(TwoPi * (t + 0.0f)),
+                0.5f + 0.5f * std::cos(TwoPi * (t + PhaseG)),
+                0.5f + 0.5f * std::cos(TwoPi * (t + PhaseB))};
+        }
+
+        // Smooth iteration count de los kernels Burning Ship / Julia: i + 1 - log2(log2(|z|))
+        inline float SmoothIter(float Iter, float Mag)
+        {
+            return Iter + 1.0f - std::log2(std::log2(Mag));
+        }
+
+        inline std::uint32_t ToUNorm8(float x)
+        {
+            if (!(x == x)) // NaN
+                return 0;
+            return static_cast<std::uint32_t>(Saturate(x) * 255.0f + 0.5f);
+        }
+    } // namespace
+
+    CPUFractal2DSetup MakeFractal2DSetup(const CPUShaderConstants& C)
+    {
+        CPUFractal2DSetup S;
+
+        S.FractalType = static_cast<int>(C.TimeAndResolution.w);
+        if (S.FractalType < 0 || S.FractalType >= CPU_FRACTAL_2D_COUNT)
+            S.FractalType = CPU_FRACTAL_2D_MANDELBROT; // default del switch de main()
+
+        S.Width    = static_cast<int>(C.TimeAndResolution.y);
+        S.Height   = static_cast<int>(C.TimeAndResolution.z);
+        S.MaxIter  = C.maxiter;
+        S.Bailout2 = static_cast<double>(C.FractalParams1.x) * static_cast<double>(C.FractalParams1.x);
+
+        const int  Precision       = static_cast<int>(C.FractalParams1.z + 0.5f);
+        const bool DoubleRequested = Precision == CPU_PRECISION_DOUBLE;
+        S.UseDoubleFloat           = Precision == CPU_PRECISION_DOUBLE_FLOAT;
+        switch (S.FractalType)
+        {
+            case CPU_FRACTAL_2D_BURNING_SHIP:
+                S.Formula   = CPU_ESCAPE_FORMULA_BURNING_SHIP;
+                S.UseDouble = DoubleRequested;
+                break;
+            case CPU_FRACTAL_2D_BURNING_SHIP_COLORS:
+                // El HLSL ignora FractalParams1.z en este kernel
+                S.Formula        = CPU_ESCAPE_FORMULA_BURNING_SHIP;
+                S.UseDouble      = false;
+                S.UseDoubleFloat = false;
+                break;
+            case CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS:
+                S.Formula   = CPU_ESCAPE_FORMULA_JULIA;
+                S.UseDouble = DoubleRequested;
+                break;
+            default:
+                S.Formula   = CPU_ESCAPE_FORMULA_MANDELBROT;
+                S.UseDouble = DoubleRequested;
+                break;
+        }
+
+        S.ZoomF    = C.ZoomOffset.x;
+        S.OffsetXF = C.ZoomOffset.y;
+        S.OffsetYF = C.ZoomOffset.z;
+        S.AspectF  = C.TimeAndResolution.y / C.TimeAndResolution.z;
+        // double y double-float usan también la parte baja del zoom y del offset
+        S.ZoomDF    = DFQuickTwoSum(C.ZoomOffset.x, C.ZoomOffsetLo.x);
+        S.OffsetXDF = DFQuickTwoSum(C.ZoomOffset.y, C.ZoomOffsetLo.y);
+        S.OffsetYDF = DFQuickTwoSum(C.ZoomOffset.z, C.ZoomOffsetLo.z);
+        S.ZoomD     = DFToDouble(S.ZoomDF);
+        S.OffsetXD  = DFToDouble(S.OffsetXDF);
+        S.OffsetYD  = DFToDouble(S.OffsetYDF);
+        S.AspectD   = static_cast<double>(C.TimeAndResolution.y) / static_cast<double>(C.TimeAndResolution.z);
+
+        const float  TimeF = C.TimeAndResolution.x * C.AnimationParams.x;
+        const double TimeD = static_cast<double>(C.TimeAndResolution.x) * static_cast<double>(C.AnimationParams.x);
+        S.CxF              = C.AnimationParams.z * std::sin(TimeF);
+        S.CyF              = C.AnimationParams.w * std::cos(TimeF);
+        S.CxD              = static_cast<double>(C.AnimationParams.z) * std::sin(TimeD);
+        S.CyD              = static_cast<double>(C.AnimationParams.w) * std::cos(TimeD);
+        S.CxDF             = {S.CxF, 0.0f};
+        S.CyDF             = {S.CyF, 0.0f};
+        if (S.Formula == CPU_ESCAPE_FORMULA_JULIA)
+        {
+            S.CxDF = DFTwoSum(static_cast<float>(JuliaC0X), S.CxF);
+            S.CyDF = DFTwoSum(static_cast<float>(JuliaC0Y), S.CyF);
+            S.CxF  = static_cast<float>(JuliaC0X) + S.CxF;
+            S.CyF  = static_cast<float>(JuliaC0Y) + S.CyF;
+            S.CxD  = JuliaC0X + S.CxD;
+            S.CyD  = JuliaC0Y + S.CyD;
+        }
+
+        if (C.FractalParams2.y > 0.5f)
+        {
+            // 1/1024 de píxel, como GetPeriodTolerance2 / GetPeriodTolerance2D
+            const float  EpsF  = 2.0f / (C.TimeAndResolution.z * C.ZoomOffset.x) * (1.0f / 1024.0f);
+            const double EpsD  = 2.0 / (static_cast<double>(C.TimeAndResolution.z) * S.ZoomD) * (1.0 / 1024.0);
+            S.PeriodTol2F      = EpsF * EpsF;
+            S.PeriodTol2D      = EpsD * EpsD;
+            S.InteriorShortcut = C.AnimationParams.z == 0.0f && C.AnimationParams.w == 0.0f;
+        }
+
+        return S;
+    }
+
+    void GetPixelCoordF(const CPUFractal2DSetup& S, float PixelX, float PixelY, float& X, float& Y)
+    {
+        const float U = PixelX / static_cast<float>(S.Width);
+        const float V = PixelY / static_cast<float>(S.Height);
+
+        float uvx = U * 2.0f - 1.0f;
+        float uvy = V * 2.0f - 1.0f;
+        uvx *= S.AspectF;
+        X = uvx / S.ZoomF + S.OffsetXF;
+        Y = uvy / S.ZoomF + S.OffsetYF;
+    }
+
+    void GetPixelCoordD(const CPUFractal2DSetup& S, double PixelX, double PixelY, double& X, double& Y)
+    {
+        const float U = static_cast<float>(PixelX / S.Width);
+        const float V = static_cast<float>(PixelY / S.Height);
+
+        double uvx, uvy;
+        if (S.Formula == CPU_ESCAPE_FORMULA_JULIA)
+        {
+            // RenderJuliaTwinDragons2DColors pasa el UV a double antes de escalarlo
+            uvx = static_cast<double>(U) * 2.0 - 1.0;
+            uvy = static_cast<double>(V) * 2.0 - 1.0;
+        }
+        else
+        {
+            uvx = static_cast<double>(U * 2.0f - 1.0f);
+            uvy = static_cast<double>(V * 2.0f - 1.0f);
+        }
+        uvx *= S.AspectD;
+        X = uvx / S.ZoomD + S.OffsetXD;
+        Y = uvy / S.ZoomD + S.OffsetYD;
+    }
+
+    void GetPixelCoordDF(const CPUFractal2DSetup& S, float PixelX, float PixelY, DoubleFloat<float>& X, DoubleFloat<float>& Y)
+    {
+        // UV en float como en el HLSL; el producto por el aspecto ya es exacto en double-float
+        const float U = PixelX / static_cast<float>(S.Width);
+        const float V = PixelY / static_cast<float>(S.Height);
+
+        const DoubleFloat<float> uvx = DFTwoProd(U * 2.0f - 1.0f, S.AspectF);
+        const DoubleFloat<float> uvy = {V * 2.0f - 1.0f, 0.0f};
+        X = DFAdd(DFDiv(uvx, S.ZoomDF), S.OffsetXDF);
+        Y = DFAdd(DFDiv(uvy, S.ZoomDF), S.OffsetYDF);
+    }
+
+    CPUFloat4 ShadeEscapeSample2D(const CPUFractal2DSetup& S, const CPUShaderConstants& C, const CPUEscapeSample& Sample)
+    {
+        const float MaxIter = static_cast<float>(S.MaxIter);
+        const bool  Escaped = Sample.Iter < MaxIter;
+
+        switch (S.FractalType)
+        {
+            case CPU_FRACTAL_2D_MANDELBROT_COLORS:
+            {
+                const float     t   = Sample.Iter / MaxIter;
+                const CPUFloat3 Pal = CosinePalette(t, 0.33f, 0.66f);
+                return CPUFloat4{Pal.x * C.FractalColor.x, Pal.y * C.FractalColor.y, Pal.z * C.FractalColor.z, 1.0f};
+            }
+
+            case CPU_FRACTAL_2D_BURNING_SHIP:
+            {
+                const float t = SmoothIter(Sample.Iter, Sample.Mag) / MaxIter;
+                return Lerp(C.BackgroundColor, C.FractalColor, t);
+            }
+
+            case CPU_FRACTAL_2D_BURNING_SHIP_COLORS:
+            {
+                float t = Escaped ? SmoothIter(Sample.Iter, std::fmax(Sample.Mag, 1e-6f)) / MaxIter : 1.0f;
+                t       = Saturate(t);
+
+                const CPUFloat3 Pal = CosinePalette(t, 0.3333f, 0.6667f);
+                const CPUFloat4 Fg{Pal.x * C.FractalColor.x, Pal.y * C.FractalColor.y, Pal.z * C.FractalColor.z, C.FractalColor.w};
+                return Lerp(C.BackgroundColor, Fg, t);
+            }
+
+            case CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS:
+            {
+                const float     t   = Escaped ? SmoothIter(Sample.Iter, std::fmax(Sample.Mag, 1e-6f)) / MaxIter : 1.0f;
+                const CPUFloat3 Pal = CosinePalette(t, 0.33f, 0.66f);
+                return CPUFloat4{Pal.x * C.FractalColor.x, Pal.y * C.FractalColor.y, Pal.z * C.FractalColor.z, 1.0f};
+            }
+
+            default:
+            {
+                const float t = Sample.Iter / MaxIter;
+                return Lerp(C.BackgroundColor, C.FractalColor, t);
+            }
+        }
+    }
+
+    namespace
+    {
+        // Recorre Count muestras en paquetes de SimdPack<T>::Width lanes. GetPos(k, X, Y)
+        // devuelve la posición en píxeles de la muestra k. El último paquete se rellena
+        // repitiendo la última muestra válida.
+        template <typename T, CPU_ESCAPE_FORMULA Formula, typename PosFuncType>
+        std::uint64_t EscapeSamples(const CPUFractal2DSetup& S, int Count, CPUEscapeSample* Out, PosFuncType GetPos)
+        {
+            constexpr int Width = SimdPack<T>::Width;
+
+            T Cx[Width], Cy[Width], Zx[Width], Zy[Width], Iter[Width], Executed[Width];
+
+            std::uint64_t Iterations = 0;
+            for (int Base = 0; Base < Count; Base += Width)
+            {
+                const int Valid = Count - Base < Width ? Count - Base : Width;
+                for (int Lane = 0; Lane < Width; ++Lane)
+                {
+                    double PX, PY;
+                    GetPos(Base + (Lane < Valid ? Lane : Valid - 1), PX, PY);
+
+                    T X, Y;
+                    if (std::is_same<T, float>::value)
+                    {
+                        float XF, YF;
+                        GetPixelCoordF(S, static_cast<float>(PX), static_cast<float>(PY), XF, YF);
+                        X = static_cast<T>(XF);
+                        Y = static_cast<T>(YF);
+                    }
+                    else if (Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP)
+                    {
+                        // RenderBurningShip2D calcula el UV en float también en el camino double
+                        float XF, YF;
+                        GetPixelCoordF(S, static_cast<float>(PX), static_cast<float>(PY), XF, YF);
+                        X = static_cast<T>(XF);
+                        Y = static_cast<T>(YF);
+                    }
+                    else
+                    {
+                        double XD, YD;
+                        GetPixelCoordD(S, PX, PY, XD, YD);
+                        X = static_cast<T>(XD);
+                        Y = static_cast<T>(YD);
+                    }
+
+                    const T AnimX = std::is_same<T, float>::value ? static_cast<T>(S.CxF) : static_cast<T>(S.CxD);
+                    const T AnimY = std::is_same<T, float>::value ? static_cast<T>(S.CyF) : static_cast<T>(S.CyD);
+
+                    Zx[Lane] = X;
+                    Zy[Lane] = Y;
+                    if (Formula == CPU_ESCAPE_FORMULA_JULIA)
+                    {
+                        Cx[Lane] = AnimX;
+                        Cy[Lane] = AnimY;
+                    }
+                    else
+                    {
+                        Cx[Lane] = X + AnimX;
+                        Cy[Lane] = Y + AnimY;
+                    }
+                }
+
+                const T Tol2 = std::is_same<T, float>::value ? static_cast<T>(S.PeriodTol2F) : static_cast<T>(S.PeriodTol2D);
+                EscapePacket<T, Formula>(Cx, Cy, Zx, Zy, Iter, Executed, S.MaxIter, static_cast<T>(S.Bailout2), Tol2, S.InteriorShortcut);
+
+                for (int Lane = 0; Lane < Valid; ++Lane)
+                {
+                    CPUEscapeSample& Sample = Out[Base + Lane];
+                    Sample.Iter             = static_cast<float>(Iter[Lane]);
+                    Sample.Mag              = static_cast<float>(std::sqrt(Zx[Lane] * Zx[Lane] + Zy[Lane] * Zy[Lane]));
+                    Iterations += static_cast<std::uint64_t>(Executed[Lane]);
+                }
+            }
+            return Iterations;
+        }
+
+        // EscapeSamples con double-float (EscapeDoubleFloat2D del HLSL)
+        template <CPU_ESCAPE_FORMULA Formula, typename PosFuncType>
+        std::uint64_t EscapeSamplesDF(const CPUFractal2DSetup& S, int Count, CPUEscapeSample* Out, PosFuncType GetPos)
+        {
+            constexpr int Width = SimdPack<float>::Width;
+
+            CPUDoubleFloatLanes Cx, Cy, Zx, Zy;
+            float               Iter[Width];
+            float               Executed[Width];
+
+            std::uint64_t Iterations = 0;
+            for (int Base = 0; Base < Count; Base += Width)
+            {
+                const int Valid = Count - Base < Width ? Count - Base : Width;
+                for (int Lane = 0; Lane < Width; ++Lane)
+                {
+                    double PX, PY;
+                    GetPos(Base + (Lane < Valid ? Lane : Valid - 1), PX, PY);
+
+                    DoubleFloat<float> X, Y;
+                    GetPixelCoordDF(S, static_cast<float>(PX), static_cast<float>(PY), X, Y);
+
+                    const DoubleFloat<float> CX = Formula == CPU_ESCAPE_FORMULA_JULIA ? S.CxDF : DFAdd(X, S.CxDF);
+                    const DoubleFloat<float> CY = Formula == CPU_ESCAPE_FORMULA_JULIA ? S.CyDF : DFAdd(Y, S.CyDF);
+                    Zx.Hi[Lane] = X.Hi;
+                    Zx.Lo[Lane] = X.Lo;
+                    Zy.Hi[Lane] = Y.Hi;
+                    Zy.Lo[Lane] = Y.Lo;
+                    Cx.Hi[Lane] = CX.Hi;
+                    Cx.Lo[Lane] = CX.Lo;
+                    Cy.Hi[Lane] = CY.Hi;
+                    Cy.Lo[Lane] = CY.Lo;
+                }
+
+                EscapePacketDF<Formula>(Cx, Cy, Zx, Zy, Iter, Executed, S.MaxIter, static_cast<float>(S.Bailout2), S.PeriodTol2F, S.InteriorShortcut);
+
+                for (int Lane = 0; Lane < Valid; ++Lane)
+                {
+                    CPUEscapeSample& Sample = Out[Base + Lane];
+                    Sample.Iter             = Iter[Lane];
+                    Sample.Mag              = std::sqrt(Zx.Hi[Lane] * Zx.Hi[Lane] + Zy.Hi[Lane] * Zy.Hi[Lane]);
+                    Iterations += static_cast<std::uint64_t>(Executed[Lane]);
+                }
+            }
+            return Iterations;
+        }
+
+        template <typename PosFuncType>
+        std::uint64_t DispatchEscape(const CPUFractal2DSetup& S, int Count, CPUEscapeSample* Out, PosFuncType GetPos)
+        {
+            if (S.UseDoubleFloat)
+            {
+                switch (S.Formula)
+                {
+                    case CPU_ESCAPE_FORMULA_BURNING_SHIP: return EscapeSamplesDF<CPU_ESCAPE_FORMULA_BURNING_SHIP>(S, Count, Out, GetPos);
+                    case CPU_ESCAPE_FORMULA_JULIA: return EscapeSamplesDF<CPU_ESCAPE_FORMULA_JULIA>(S, Count, Out, GetPos);
+                    default: return EscapeSamplesDF<CPU_ESCAPE_FORMULA_MANDELBROT>(S, Count, Out, GetPos);
+                }
+            }
+
+            switch (S.Formula)
+            {
+                case CPU_ESCAPE_FORMULA_BURNING_SHIP:
+                    return S.UseDouble ?
+                        EscapeSamples<double, CPU_ESCAPE_FORMULA_BURNING_SHIP>(S, Count, Out, GetPos) :
+                        EscapeSamples<float, CPU_ESCAPE_FORMULA_BURNING_SHIP>(S, Count, Out, GetPos);
+                case CPU_ESCAPE_FORMULA_JULIA:
+                    return S.UseDouble ?
+                        EscapeSamples<double, CPU_ESCAPE_FORMULA_JULIA>(S, Count, Out, GetPos) :
+                        EscapeSamples<float, CPU_ESCAPE_FORMULA_JULIA>(S, Count, Out, GetPos);
+                default:
+                    return S.UseDouble ?
+                        EscapeSamples<double, CPU_ESCAPE_FORMULA_MANDELBROT>(S, Count, Out, GetPos) :
+                        EscapeSamples<float, CPU_ESCAPE_FORMULA_MANDELBROT>(S, Count, Out, GetPos);
+            }
+        }
+    } // namespace
+
+    std::uint64_t EscapeRow2D(const CPUFractal2DSetup& S, int PixelY, int PixelX0, int Count, CPUEscapeSample* Out)
+    {
+        return DispatchEscape(S, Count, Out, [&](int k, double& PX, double& PY) {
+            PX = PixelX0 + k + 0.5;
+            PY = PixelY + 0.5;
+        });
+    }
+
+    std::uint64_t EscapePoints2D(const CPUFractal2DSetup& S, const float* PixelX, const float* PixelY, int Count, CPUEscapeSample* Out)
+    {
+        return DispatchEscape(S, Count, Out, [&](int k, double& PX, double& PY) {
+            PX = PixelX[k];
+            PY = PixelY[k];
+        });
+    }
+
+    std::uint32_t PackColorRGBA8(const CPUFloat4& Color)
+    {
+        return ToUNorm8(Color.x) | (ToUNorm8(Color.y) << 8) | (ToUNorm8(Color.z) << 16) | (ToUNorm8(Color.w) << 24);
+    }
+
+} // namespace Diligent
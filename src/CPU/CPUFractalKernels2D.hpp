@@ -0,0 +1,89 @@
+#pragma once
+
+// Versión CPU de los kernels 2D de fractal.psh (RenderMandelbrot2D, RenderMandelbrot2DColors,
+// RenderBurningShip2D, RenderBurningShip2DColors, RenderJuliaTwinDragons2DColors).
+// El bucle de escape se vectoriza con SimdPack (una lane por píxel, con máscara de
+// lanes que ya escaparon, CPUEscapePacket.hpp) y el coloreado se hace por píxel replicando el HLSL.
+
+#include <cstdint>
+
+#include "CPUShaderConstants.hpp"
+#include "DoubleFloat.hpp"
+
+namespace Diligent
+{
+
+    // Fórmula de iteración que comparten los distintos kernels 2D
+    enum CPU_ESCAPE_FORMULA : int
+    {
+        CPU_ESCAPE_FORMULA_MANDELBROT = 0, // z = z^2 + c,       z0 = c
+        CPU_ESCAPE_FORMULA_BURNING_SHIP,   // z = |z|^2 + c,     z0 = c
+        CPU_ESCAPE_FORMULA_JULIA           // z = z^2 + c_fijo, z0 = píxel
+    };
+
+    // Resultado del bucle de escape de un píxel: lo mínimo que necesita el coloreado
+    struct CPUEscapeSample
+    {
+        float Iter; // i al salir del bucle (maxiter si no escapó)
+        float Mag;  // |z| final
+    };
+
+    // Parámetros del kernel 2D derivados de las constantes, calculados una vez por frame
+    struct CPUFractal2DSetup
+    {
+        int                FractalType = CPU_FRACTAL_2D_MANDELBROT;
+        CPU_ESCAPE_FORMULA Formula     = CPU_ESCAPE_FORMULA_MANDELBROT;
+        bool               UseDouble   = false;
+        bool               UseDoubleFloat = false; // double emulado con dos float (excluye UseDouble)
+
+        int    Width   = 0;
+        int    Height  = 0;
+        int    MaxIter = 0;
+        double Bailout2 = 4.0;
+
+        // Transformación píxel -> plano complejo, en float, en double y en double-float
+        float  ZoomF = 1, OffsetXF = 0, OffsetYF = 0, AspectF = 1;
+        double ZoomD = 1, OffsetXD = 0, OffsetYD = 0, AspectD = 1;
+
+        DoubleFloat<float> ZoomDF = {1, 0}, OffsetXDF = {0, 0}, OffsetYDF = {0, 0};
+
+        // Desplazamiento animado de c (Mandelbrot / Burning Ship) o c fijo (Julia)
+        float              CxF = 0, CyF = 0;
+        double             CxD = 0, CyD = 0;
+        DoubleFloat<float> CxDF = {0, 0}, CyDF = {0, 0};
+
+        // Salida anticipada del interior (FractalParams2.y): tolerancia al cuadrado de la
+        // detección de periodo, 1/1024 de píxel (0 = desactivada). Float sirve también al
+        // camino double-float, como GetPeriodTolerance2 en fractal2D.fxh.
+        float  PeriodTol2F = 0;
+        double PeriodTol2D = 0;
+
+        // Prueba de cardioide / bulbo del Mandelbrot: solo con la salida anticipada y c sin
+        // animar. Con AnimationParams.z/w la órbita empieza en z = uv y no en c, y estar en la
+        // cardioide ya no garantiza que no escape
+        bool InteriorShortcut = false;
+    };
+
+    CPUFractal2DSetup MakeFractal2DSetup(const CPUShaderConstants& Constants);
+
+    // Coordenada del centro del píxel (PixelX, PixelY) en el plano complejo, como la
+    // calcula el HLSL (UV interpolado en el centro del píxel, fila 0 arriba).
+    void GetPixelCoordF(const CPUFractal2DSetup& Setup, float PixelX, float PixelY, float& X, float& Y);
+    void GetPixelCoordD(const CPUFractal2DSetup& Setup, double PixelX, double PixelY, double& X, double& Y);
+    void GetPixelCoordDF(const CPUFractal2DSetup& Setup, float PixelX, float PixelY, DoubleFloat<float>& X, DoubleFloat<float>& Y);
+
+    // Color final del píxel a partir del resultado del bucle de escape
+    CPUFloat4 ShadeEscapeSample2D(const CPUFractal2DSetup& Setup, const CPUShaderConstants& Constants, const CPUEscapeSample& Sample);
+
+    // Bucle de escape de Count píxeles consecutivos de la fila PixelY empezando en PixelX0,
+    // muestreados en el centro del píxel. Devuelve las iteraciones ejecutadas.
+    std::uint64_t EscapeRow2D(const CPUFractal2DSetup& Setup, int PixelY, int PixelX0, int Count, CPUEscapeSample* Out);
+
+    // Igual que EscapeRow2D pero con posiciones arbitrarias en coordenadas de píxel
+    // (PixelX + 0.5 es el centro del píxel), p.ej. para muestras con jitter.
+    std::uint64_t EscapePoints2D(const CPUFractal2DSetup& Setup, const float* PixelX, const float* PixelY, int Count, CPUEscapeSample* Out);
+
+    // Conversión a RGBA8 UNORM con las mismas reglas que la GPU (saturate, NaN -> 0)
+    std::uint32_t PackColorRGBA8(const CPUFloat4& Color);
+
+} // namespace Diligent
@@ -0,0 +1,1069 @@
+#include "CPUFractalKernels3D.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "CPUDistanceBricks.hpp"
+#include "CPURayPacket3D.hpp"
+
+namespace Diligent
+{
+
+    namespace
+    {
+        inline CPUFloat3 operator+(const CPUFloat3& a, const CPUFloat3& b) { return CPUFloat3{a.x + b.x, a.y + b.y, a.z + b.z}; }
+        inline CPUFloat3 operator-(const CPUFloat3& a, const CPUFloat3& b) { return CPUFloat3{a.x - b.x, a.y - b.y, a.z - b.z}; }
+        inline CPUFloat3 operator*(const CPUFloat3& a, float s) { return CPUFloat3{a.x * s, a.y * s, a.z * s}; }
+        inline CPUFloat3 operator/(const CPUFloat3& a, float s) { return CPUFloat3{a.x / s, a.y / s, a.z / s}; }
+
+        inline float Dot(const CPUFloat3& a, const CPUFloat3& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        inline CPUFloat3 Normalize(const CPUFloat3& v)
+        {
+            return v * (1.0f / std::sqrt(Dot(v, v)));
+        }
+
+        inline float Lerp(float a, float b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        inline CPUFloat3 Lerp(const CPUFloat3& a, const CPUFloat3& b, float t)
+        {
+            return CPUFloat3{Lerp(a.x, b.x, t), Lerp(a.y, b.y, t), Lerp(a.z, b.z, t)};
+        }
+
+        inline float Saturate(float x)
+        {
+            return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+        }
+
+        inline CPUFloat3 Saturate(const CPUFloat3& v)
+        {
+            return CPUFloat3{Saturate(v.x), Saturate(v.y), Saturate(v.z)};
+        }
+
+        inline float Clamp1(float x)
+        {
+            return x < -1.0f ? -1.0f : (x > 1.0f ? 1.0f : x);
+        }
+
+        inline CPUFloat3 XYZ(const CPUFloat4& v)
+        {
+            return CPUFloat3{v.x, v.y, v.z};
+        }
+
+        // Gradiente cielo-horizonte de ambos kernels
+        inline CPUFloat3 BackgroundGradient(const CPUShaderConstants& C, const CPUFloat3& rd)
+        {
+            return Lerp(CPUFloat3{0.9f, 0.8f, 0.7f}, XYZ(C.BackgroundColor), Saturate(rd.y * 0.5f + 0.5f));
+        }
+
+        struct Complex
+        {
+            float re, im;
+        };
+
+        inline Complex ComplexMul(const Complex& a, const Complex& b)
+        {
+            return Complex{a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+        }
+
+        // ComplexPowInt de fractal3D.fxh: cuadrados sucesivos, N conocido en compilación
+        template <int N>
+        inline Complex ComplexPowInt(Complex c)
+        {
+            Complex Result{1.0f, 0.0f};
+            for (int e = N; e > 0; e >>= 1)
+            {
+                if (e & 1)
+                    Result = ComplexMul(Result, c);
+                c = ComplexMul(c, c);
+            }
+            return Result;
+        }
+
+        // Matriz 3x3 por filas (Row[i][j] = d z_i / d pos_j)
+        struct Matrix3
+        {
+            CPUFloat3 Row[3];
+        };
+
+        inline Matrix3 Mul(const Matrix3& A, const Matrix3& B)
+        {
+            Matrix3 R;
+            for (int i = 0; i < 3; ++i)
+                R.Row[i] = B.Row[0] * A.Row[i].x + B.Row[1] * A.Row[i].y + B.Row[2] * A.Row[i].z;
+            return R;
+        }
+
+        // DE_MandelbulbKernel de fractal3D.fxh. IntPower = 0 es la potencia real Power (acos,
+        // atan2, pow, sin/cos); IntPower > 0 la forma polinómica sin trigonometría. Con
+        // WithGradient devuelve en *pGradient el gradiente del DE (la normal sin normalizar).
+        template <int IntPower, bool WithGradient>
+        float MandelbulbKernel(const CPUFloat3& Pos, float Power, CPUFloat3* pGradient)
+        {
+            CPUFloat3 z  = Pos;
+            float     dr = 1.0f;
+            float     r  = 0.0f;
+            Matrix3   J  = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+            CPUFloat3 GradDr;
+
+            const float Bailout2 = 2.0f * 2.0f;
+            for (int i = 0; i < 100; ++i)
+            {
+                const float r2 = Dot(z, z);
+                r              = std::sqrt(r2);
+                if (r2 > Bailout2)
+                    break;
+
+                Complex     NTheta, NPhi; // (cos, sin) de nθ y nφ
+                float       Rn1, Zr;
+                const float DrPrev = dr;
+                if (IntPower > 0)
+                {
+                    const float Rho    = std::sqrt(z.x * z.x + z.y * z.y);
+                    Complex     DirPhi = {1.0f, 0.0f};
+                    if (Rho > 0.0f)
+                        DirPhi = Complex{z.x / Rho, z.y / Rho};
+                    NTheta = ComplexPowInt<IntPower>(Complex{z.z / r, Rho / r});
+                    NPhi   = ComplexPowInt<IntPower>(DirPhi);
+                    Rn1    = 1.0f;
+                    for (int k = 1; k < IntPower; ++k)
+                        Rn1 *= r;
+                    Zr = Rn1 * r;
+                    dr = Rn1 * static_cast<float>(IntPower) * dr + 1.0f;
+                }
+                else
+                {
+                    const float Theta = std::acos(z.z / r);
+                    const float Phi   = std::atan2(z.y, z.x);
+                    Rn1               = std::pow(r, Power - 1.0f);
+                    dr                = Rn1 * Power * dr + 1.0f;
+
+                    Zr                 = std::pow(r, Power);
+                    const float ThetaN = Theta * Power;
+                    const float PhiN   = Phi * Power;
+                    NTheta             = Complex{std::cos(ThetaN), std::sin(ThetaN)};
+                    NPhi               = Complex{std::cos(PhiN), std::sin(PhiN)};
+                }
+
+                if (WithGradient)
+                {
+                    // d(r^n f(nθ, nφ))/dz = r^(n-1) (n f ⊗ z/r + r (df/dθ ⊗ dθ/dz + df/dφ ⊗ dφ/dz))
+                    const float     n      = IntPower > 0 ? static_cast<float>(IntPower) : Power;
+                    const float     Rho    = std::max(std::sqrt(z.x * z.x + z.y * z.y), 1e-10f);
+                    const CPUFloat3 f      = {NTheta.im * NPhi.re, NTheta.im * NPhi.im, NTheta.re};
+                    const CPUFloat3 fTheta = CPUFloat3{NTheta.re * NPhi.re, NTheta.re * NPhi.im, -NTheta.im} * n;
+                    const CPUFloat3 fPhi   = CPUFloat3{-NTheta.im * NPhi.im, NTheta.im * NPhi.re, 0.0f} * n;
+                    const CPUFloat3 gR     = z * (n / r);
+                    const CPUFloat3 gTheta = {z.x * z.z / (r * Rho), z.y * z.z / (r * Rho), -Rho / r};
+                    const CPUFloat3 gPhi   = CPUFloat3{-z.y, z.x, 0.0f} * (r / (Rho * Rho));
+
+                    const Matrix3 M = {{gR * f.x + gTheta * fTheta.x + gPhi * fPhi.x,
+                                        gR * f.y + gTheta * fTheta.y + gPhi * fPhi.y,
+                                        gR * f.z + gTheta * fTheta.z + gPhi * fPhi.z}};
+                    // dr = n r^(n-1) dr + 1
+                    const CPUFloat3 GradR = (J.Row[0] * z.x + J.Row[1] * z.y + J.Row[2] * z.z) / r;
+                    GradDr                = (GradR * ((n - 1.0f) * Rn1 / r * DrPrev) + GradDr * Rn1) * n;
+
+                    const Matrix3 MJ = Mul(M, J);
+                    for (int k = 0; k < 3; ++k)
+                        J.Row[k] = MJ.Row[k] * Rn1;
+                    J.Row[0].x += 1.0f;
+                    J.Row[1].y += 1.0f;
+                    J.Row[2].z += 1.0f;
+                }
+
+                z = CPUFloat3{NTheta.im * NPhi.re, NTheta.im * NPhi.im, NTheta.re} * Zr + Pos;
+            }
+
+            const float LogR = std::log(r);
+            if (WithGradient)
+            {
+                // d(0.5 log(r) r / dr) = 0.5 ((log(r) + 1) dr' - log(r) r / dr ddr') / dr
+                const CPUFloat3 GradR = (J.Row[0] * z.x + J.Row[1] * z.y + J.Row[2] * z.z) / r;
+                *pGradient            = (GradR * (LogR + 1.0f) - GradDr * (LogR * r / dr)) * (0.5f / dr);
+            }
+            return 0.5f * LogR * r / dr;
+        }
+
+        // getCross / getInnerMenger / map de fractalCompute.psh (solo la distancia)
+        float CrossDistance(CPUFloat3 p, float Size)
+        {
+            p = CPUFloat3{std::abs(p.x), std::abs(p.y), std::abs(p.z)} - CPUFloat3{Size / 3.0f, Size / 3.0f, Size / 3.0f};
+            const float bx = std::max(p.y, p.z);
+            const float by = std::max(p.x, p.z);
+            const float bz = std::max(p.x, p.y);
+            return std::min(std::min(bx, by), bz);
+        }
+
+        float MengerMap(const CPUFloat3& p, const CPUFractal3DSetup& S)
+        {
+            float d     = S.Thresh;
+            float Scale = 1.0f;
+            for (int i = 0; i < S.Iterations; i++)
+            {
+                const float r = S.MengerSize / Scale;
+                // fmod de HLSL conserva el signo del dividendo, como std::fmod
+                const CPUFloat3 q{std::fmod(p.x + r, 2.0f * r) - r, std::fmod(p.y + r, 2.0f * r) - r, std::fmod(p.z + r, 2.0f * r) - r};
+                d = std::min(d, CrossDistance(q, r));
+                Scale *= 3.0f;
+            }
+            return -d;
+        }
+
+        // DE_Mandelbox de fractal3D.fxh: pliegue de caja y de esfera (radio mínimo 0.5, fijo 1)
+        // con escala Scale. La caja mide 2 (|s| + 1) / (|s| - 1) de semilado; el espacio se
+        // escala por Fit = (|s| + 1) / (|s| - 1) para que quede en [-2, 2]^3 como el Mandelbulb.
+        // Lejos de la caja el DE subestima mucho: la distancia a ese cubo también es una cota
+        float MandelboxKernel(const CPUFloat3& Pos, float Scale)
+        {
+            const float     AbsScale = std::abs(Scale);
+            const float     Fit      = (AbsScale + 1.0f) / (AbsScale - 1.0f);
+            const CPUFloat3 p        = Pos * Fit;
+
+            CPUFloat3 z  = p;
+            float     dr = 1.0f;
+            for (int i = 0; i < MandelboxIterations; ++i)
+            {
+                z              = CPUFloat3{Clamp1(z.x) * 2.0f - z.x, Clamp1(z.y) * 2.0f - z.y, Clamp1(z.z) * 2.0f - z.z};
+                const float r2 = Dot(z, z);
+                if (r2 < 0.25f)
+                {
+                    z  = z * 4.0f;
+                    dr = dr * 4.0f;
+                }
+                else if (r2 < 1.0f)
+                {
+                    const float t = 1.0f / r2;
+                    z             = z * t;
+                    dr            = dr * t;
+                }
+                z  = z * Scale + p;
+                dr = dr * AbsScale + 1.0f;
+            }
+            const CPUFloat3 Out{std::max(std::abs(Pos.x) - 2.0f, 0.0f), std::max(std::abs(Pos.y) - 2.0f, 0.0f),
+                                std::max(std::abs(Pos.z) - 2.0f, 0.0f)};
+            return std::max(std::sqrt(Dot(z, z)) / std::abs(dr) / Fit, std::sqrt(Dot(Out, Out)));
+        }
+
+        // DE_QuaternionJulia de fractal3D.fxh: q = (x, y, z, 0) con la parte real en x,
+        // q = q^2 + c y dq = 2 q dq (los productos cruzados se anulan), hasta |q| > 4.
+        // Lejos del conjunto (escapa en un paso) la estimación se pasa: fuera de la esfera de
+        // radio 2, que lo contiene si |c| <= 2, se limita a |p| - 2 sin bajar de la mitad
+        inline float LimitJuliaDistance(float Dist, float PosLength)
+        {
+            return PosLength > 2.0f ? std::min(Dist, std::max(PosLength - 2.0f, 0.5f * Dist)) : Dist;
+        }
+
+        float QuaternionJuliaKernel(const CPUFloat3& Pos, const CPUFloat4& C)
+        {
+            float qx = Pos.x, qy = Pos.y, qz = Pos.z, qw = 0.0f;
+            float dx = 1.0f, dy = 0.0f, dz = 0.0f, dw = 0.0f;
+            float q2 = qx * qx + qy * qy + qz * qz + qw * qw;
+            for (int i = 0; i < QuaternionJuliaIterations; ++i)
+            {
+                const float ndx = 2.0f * (qx * dx - (qy * dy + qz * dz + qw * dw));
+                const float ndy = 2.0f * (qx * dy + dx * qy);
+                const float ndz = 2.0f * (qx * dz + dx * qz);
+                const float ndw = 2.0f * (qx * dw + dx * qw);
+                dx = ndx, dy = ndy, dz = ndz, dw = ndw;
+
+                const float nqx = qx * qx - (qy * qy + qz * qz + qw * qw) + C.x;
+                const float nqy = 2.0f * qx * qy + C.y;
+                const float nqz = 2.0f * qx * qz + C.z;
+                const float nqw = 2.0f * qx * qw + C.w;
+                qx = nqx, qy = nqy, qz = nqz, qw = nqw;
+
+                q2 = qx * qx + qy * qy + qz * qz + qw * qw;
+                if (q2 > 16.0f)
+                    break;
+            }
+            const float r    = std::sqrt(q2);
+            const float Dist = 0.5f * r * std::log(r) / std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+            return LimitJuliaDistance(Dist, std::sqrt(Dot(Pos, Pos)));
+        }
+
+        // DE de la marcha sin el cache (SceneDistance3D de fractal3D.fxh)
+        float AnalyticDistance(const CPUFractal3DSetup& S, const CPUFloat3& p)
+        {
+            switch (S.FractalType)
+            {
+                case CPU_FRACTAL_3D_MENGER_SPONGE: return MengerMap(p, S);
+                case CPU_FRACTAL_3D_QUATERNION_JULIA: return QuaternionJuliaKernel(p, S.JuliaC);
+                case CPU_FRACTAL_3D_MANDELBOX: return MandelboxKernel(p, S.MandelboxScale);
+                default: return DistanceMandelbulbFast(p, S.Power);
+            }
+        }
+
+        // Distancia de la marcha: la del cache si la tiene (lejos de la superficie), si no el DE
+        float SceneDistance(const CPUFractal3DSetup& S, const CPUFloat3& p, CPURay3DStats& Stats)
+        {
+            float Dist;
+            if (S.pBricks != nullptr && S.pBricks->Sample(p, CPU_DISTANCE_BRICK_CHANNEL_SCENE, Dist))
+            {
+                ++Stats.BrickSamples;
+                return Dist;
+            }
+            ++Stats.DEEvaluations;
+            return AnalyticDistance(S, p);
+        }
+
+        float ShadowDistance(const CPUFractal3DSetup& S, const CPUFloat3& p, CPURay3DStats& Stats)
+        {
+            float Dist;
+            if (S.pBricks != nullptr && S.pBricks->Sample(p, CPU_DISTANCE_BRICK_CHANNEL_SHADOW, Dist))
+            {
+                ++Stats.BrickSamples;
+                return Dist;
+            }
+            ++Stats.DEEvaluations;
+            return DistanceMengerSponge(p / S.MengerSize, S.Iterations) * S.MengerSize;
+        }
+
+        // Sombreado común: difusa + ambiente, especular Blinn-Phong y Fresnel
+        CPUFloat3 ShadeHit(const CPUShaderConstants& C, const CPUFloat3& Normal, const CPUFloat3& ViewDir, float Shadow, float FresnelPower,
+                           const CPUFloat3& FresnelColor, float FresnelWeight)
+        {
+            const CPUFloat3 LightDir = Normalize(CPUFloat3{0.5f, 0.8f, -0.3f});
+            const float     Diffuse  = Saturate(Dot(Normal, LightDir));
+            const float     Ambient  = 0.2f;
+
+            const CPUFloat3 HalfwayDir = Normalize(LightDir + ViewDir);
+            const float     Specular   = std::pow(Saturate(Dot(Normal, HalfwayDir)), 32.0f);
+            const float     Fresnel    = std::pow(1.0f - Saturate(Dot(Normal, ViewDir)), FresnelPower);
+
+            const CPUFloat3 Lit = XYZ(C.FractalColor) * (Diffuse * Shadow + Ambient) + CPUFloat3{1, 1, 1} * (Specular * Shadow);
+            return Saturate(Lerp(Lit, FresnelColor, Fresnel * FresnelWeight));
+        }
+
+        // Rayo de la cámara en el espacio uv de CSMain; todos menos el Menger adelantan el origen con el zoom
+        CPUFloat3 GetRayOrigin(const CPUFractal3DSetup& S, const CPUShaderConstants& C)
+        {
+            if (S.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE)
+                return XYZ(C.CameraPos);
+            return XYZ(C.CameraPos) + XYZ(C.CameraDirZ) * C.ZoomOffset.x;
+        }
+
+        CPUFloat3 GetRayDirection(const CPUFractal3DSetup& S, const CPUShaderConstants& C, float PixelX, float PixelY)
+        {
+            const float u = (PixelX / static_cast<float>(S.Width) * 2.0f - 1.0f) * S.Aspect;
+            const float v = PixelY / static_cast<float>(S.Height) * 2.0f - 1.0f;
+            return Normalize(XYZ(C.CameraDirX) * u + XYZ(C.CameraDirY) * v + XYZ(C.CameraDirZ));
+        }
+
+        const CPUFloat3 LightDirection = Normalize(CPUFloat3{0.5f, 0.8f, -0.3f});
+
+        // calculateShadow del Menger desde el impacto p
+        float MengerShadow(const CPUFractal3DSetup& S, const CPUFloat3& p, CPURay3DStats& Stats)
+        {
+            float t      = S.Thresh * 2.0f;
+            float Shadow = 1.0f;
+            for (int i = 0; i < S.MaxSteps; i++)
+            {
+                const float sd = ShadowDistance(S, p + LightDirection * t, Stats);
+                if (sd < S.Thresh)
+                {
+                    Shadow = 0.0f;
+                    break;
+                }
+                Shadow = std::min(Shadow, 10.0f * sd / t);
+                t += sd;
+                if (t > S.MaxDist)
+                    break;
+            }
+            return Shadow;
+        }
+
+        // Marcha principal de cada kernel. Deja Stats.Hit y Stats.HitDist (MaxDist si no hay impacto).
+        // La distancia reproyectada no es conservadora: si ya se empieza en la superficie se
+        // vuelve a la segura. El Menger (rayMarch) comprueba el umbral antes de avanzar; el
+        // resto (RenderMandelbulb3D, RenderDistanceEstimated3D) después.
+        void MarchRay(const CPUFractal3DSetup& S, const CPUFloat3& ro, const CPUFloat3& rd, float StartDist, float SafeStartDist, CPURay3DStats& Stats)
+        {
+            float TotalDist = StartDist;
+            if (StartDist > SafeStartDist)
+            {
+                ++Stats.DEEvaluations;
+                if (AnalyticDistance(S, ro + rd * StartDist) < S.Thresh)
+                    TotalDist = SafeStartDist;
+            }
+
+            if (S.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE)
+            {
+                for (int i = 0; i < S.MaxSteps; i++)
+                {
+                    const float d = SceneDistance(S, ro + rd * TotalDist, Stats);
+                    ++Stats.Steps;
+                    if (d < S.Thresh)
+                        break;
+                    TotalDist += d;
+                    if (TotalDist > S.MaxDist)
+                        break;
+                }
+                Stats.Hit = TotalDist < S.MaxDist;
+            }
+            else
+            {
+                float Dist = 0.0f;
+                for (int i = 0; i < S.MaxSteps; ++i)
+                {
+                    Dist = SceneDistance(S, ro + rd * TotalDist, Stats);
+                    ++Stats.Steps;
+                    TotalDist += Dist;
+                    if (Dist < S.Thresh || TotalDist > S.MaxDist)
+                        break;
+                }
+                Stats.Hit = Dist < S.Thresh;
+            }
+            Stats.HitDist = Stats.Hit ? TotalDist : S.MaxDist;
+        }
+
+        // Color del rayo ya marchado: fondo, o normal y sombreado del impacto. Shadow < 0 marcha
+        // aquí la sombra del Menger (RenderPacket3D la trae ya marchada)
+        CPUFloat4 ShadeRay(const CPUFractal3DSetup& S, const CPUShaderConstants& C, const CPUFloat3& ro, const CPUFloat3& rd, float Shadow,
+                           CPURay3DStats& Stats)
+        {
+            const CPUFloat3 Bg = BackgroundGradient(C, rd);
+            if (!Stats.Hit)
+                return CPUFloat4{Bg.x, Bg.y, Bg.z, 1.0f};
+
+            const CPUFloat3 HitPos = ro + rd * Stats.HitDist;
+            CPUFloat3       Color;
+            if (S.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE)
+            {
+                // getNormal: diferencias hacia atrás con epsilon = umbral
+                const float     d      = MengerMap(HitPos, S);
+                const CPUFloat3 Normal = Normalize(CPUFloat3{
+                    d - MengerMap(HitPos - CPUFloat3{S.Thresh, 0, 0}, S),
+                    d - MengerMap(HitPos - CPUFloat3{0, S.Thresh, 0}, S),
+                    d - MengerMap(HitPos - CPUFloat3{0, 0, S.Thresh}, S)});
+                Stats.DEEvaluations += 4;
+
+                if (Shadow < 0.0f)
+                    Shadow = MengerShadow(S, HitPos, Stats);
+                Color = ShadeHit(C, Normal, Normalize(ro - HitPos), Shadow, 5.0f, CPUFloat3{1.0f, 0.9f, 0.8f}, 0.6f);
+            }
+            else if (S.FractalType == CPU_FRACTAL_3D_QUATERNION_JULIA || S.FractalType == CPU_FRACTAL_3D_MANDELBOX)
+            {
+                // GetDistanceNormal3D: las mismas diferencias que el Menger
+                const float     d      = AnalyticDistance(S, HitPos);
+                const CPUFloat3 Normal = Normalize(CPUFloat3{
+                    d - AnalyticDistance(S, HitPos - CPUFloat3{S.Thresh, 0, 0}),
+                    d - AnalyticDistance(S, HitPos - CPUFloat3{0, S.Thresh, 0}),
+                    d - AnalyticDistance(S, HitPos - CPUFloat3{0, 0, S.Thresh})});
+                Stats.DEEvaluations += 4;
+                Color = ShadeHit(C, Normal, Normalize(ro - HitPos), 1.0f, 4.0f, CPUFloat3{0.8f, 0.8f, 1.0f}, 0.5f);
+            }
+            else
+            {
+                // calculateNormal: normal analítica, una sola evaluación con jacobiano
+                CPUFloat3 Gradient;
+                DistanceMandelbulbGradient(HitPos, S.Power, Gradient);
+                Stats.DEEvaluations += 1;
+                Color = ShadeHit(C, Normalize(Gradient), Normalize(ro - HitPos), 1.0f, 4.0f, CPUFloat3{0.8f, 0.8f, 1.0f}, 0.5f);
+            }
+            return CPUFloat4{Color.x, Color.y, Color.z, 1.0f};
+        }
+    } // namespace
+
+    CPUFractal3DSetup MakeFractal3DSetup(const CPUShaderConstants& C)
+    {
+        CPUFractal3DSetup S;
+        S.FractalType = static_cast<int>(C.TimeAndResolution.w);
+        S.Width       = static_cast<int>(C.TimeAndResolution.y);
+        S.Height      = static_cast<int>(C.TimeAndResolution.z);
+        S.Aspect      = S.Height > 0 ? static_cast<float>(S.Width) / static_cast<float>(S.Height) : 1.0f;
+        S.MaxSteps    = static_cast<int>(C.Options3D.x);
+        S.MaxDist     = C.Options3D.y;
+        S.Thresh      = C.Options3D.z;
+
+        const float Time = C.TimeAndResolution.x;
+        S.Power          = C.Options3D.w > 0.0f ? C.Options3D.w : Lerp(C.FractalParams1.y, 11.0f, std::sin(Time * 0.5f) * 0.5f + 0.5f);
+        S.MengerSize     = C.ZoomOffset.x;
+        S.Iterations     = C.maxiter;
+
+        const float Scale = C.FractalParams1.y;
+        S.MandelboxScale  = std::abs(Scale) < MinMandelboxScale ? (Scale < 0.0f ? -MinMandelboxScale : MinMandelboxScale) : Scale;
+        const bool ZeroC  = C.FractalC.x == 0.0f && C.FractalC.y == 0.0f && C.FractalC.z == 0.0f && C.FractalC.w == 0.0f;
+        S.JuliaC          = ZeroC ? DefaultQuaternionJuliaC : C.FractalC;
+        return S;
+    }
+
+    float DistanceMandelbulb(const CPUFloat3& Pos, float Power)
+    {
+        return MandelbulbKernel<0, false>(Pos, Power, nullptr);
+    }
+
+    float DistanceMandelbulbFast(const CPUFloat3& Pos, float Power)
+    {
+        if (Power == 8.0f)
+            return MandelbulbKernel<8, false>(Pos, Power, nullptr);
+        return MandelbulbKernel<0, false>(Pos, Power, nullptr);
+    }
+
+    float DistanceMandelbulbGradient(const CPUFloat3& Pos, float Power, CPUFloat3& Gradient)
+    {
+        if (Power == 8.0f)
+            return MandelbulbKernel<8, true>(Pos, Power, &Gradient);
+        return MandelbulbKernel<0, true>(Pos, Power, &Gradient);
+    }
+
+    float DistanceMengerSponge(const CPUFloat3& Pos, int Iterations)
+    {
+        const CPUFloat3 a0{std::abs(Pos.x), std::abs(Pos.y), std::abs(Pos.z)};
+        const CPUFloat3 Out{std::max(a0.x - 1.0f, 0.0f), std::max(a0.y - 1.0f, 0.0f), std::max(a0.z - 1.0f, 0.0f)};
+
+        float d = std::sqrt(Dot(Out, Out));
+        float s = 1.0f;
+        for (int i = 0; i < Iterations; ++i)
+        {
+            s /= 3.0f;
+            const CPUFloat3 a{std::fmod(a0.x, 2.0f * s) - s, std::fmod(a0.y, 2.0f * s) - s, std::fmod(a0.z, 2.0f * s) - s};
+            const float     da = std::max(std::abs(a.x), std::abs(a.y));
+            const float     db = std::max(std::abs(a.y), std::abs(a.z));
+            const float     dc = std::max(std::abs(a.z), std::abs(a.x));
+            d                  = std::max(d, -std::min(da, std::min(db, dc)));
+        }
+        return d;
+    }
+
+    float DistanceMandelbox(const CPUFloat3& Pos, float Scale)
+    {
+        return MandelboxKernel(Pos, Scale);
+    }
+
+    float DistanceQuaternionJulia(const CPUFloat3& Pos, const CPUFloat4& C)
+    {
+        return QuaternionJuliaKernel(Pos, C);
+    }
+
+    float DistanceMengerMap(const CPUFloat3& Pos, float Size, int Iterations, float Thresh)
+    {
+        CPUFractal3DSetup S;
+        S.MengerSize = Size;
+        S.Iterations = Iterations;
+        S.Thresh     = Thresh;
+        return MengerMap(Pos, S);
+    }
+
+    CPUFloat4 RenderPixel3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, float PixelX, float PixelY, float StartDist,
+                            float SafeStartDist, CPURay3DStats& Stats)
+    {
+        const CPUFloat3 ro = GetRayOrigin(Setup, Constants);
+        const CPUFloat3 rd = GetRayDirection(Setup, Constants, PixelX, PixelY);
+        MarchRay(Setup, ro, rd, StartDist, SafeStartDist, Stats);
+        return ShadeRay(Setup, Constants, ro, rd, -1.0f, Stats);
+    }
+
+    CPUFloat3 GetPixelRayPoint3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, float PixelX, float PixelY, float Dist)
+    {
+        return GetRayOrigin(Setup, Constants) + GetRayDirection(Setup, Constants, PixelX, PixelY) * Dist;
+    }
+
+    bool ProjectToPixel3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, const CPUFloat3& Point, float& PixelX, float& PixelY,
+                          float& Dist)
+    {
+        // Inversa de GetRayDirection: uv = (x, y) / z en la base de la cámara
+        const CPUFloat3 d = Point - GetRayOrigin(Setup, Constants);
+        const float     z = Dot(d, XYZ(Constants.CameraDirZ));
+        if (z <= 0.0f)
+            return false;
+
+        const float u = Dot(d, XYZ(Constants.CameraDirX)) / z;
+        const float v = Dot(d, XYZ(Constants.CameraDirY)) / z;
+        PixelX        = (u / Setup.Aspect + 1.0f) * 0.5f * static_cast<float>(Setup.Width);
+        PixelY        = (v + 1.0f) * 0.5f * static_cast<float>(Setup.Height);
+        Dist          = std::sqrt(Dot(d, d));
+        return true;
+    }
+
+    bool IsTemporalHistoryCompatible3D(const CPUShaderConstants& Prev, const CPUShaderConstants& Cur)
+    {
+        auto GetKey = [](const CPUShaderConstants& C) {
+            CPUShaderConstants Key = C;
+            Key.CameraPos          = CPUFloat4{0, 0, 0, C.CameraPos.w};
+            Key.CameraDirX         = CPUFloat4{};
+            Key.CameraDirY         = CPUFloat4{};
+            Key.CameraDirZ         = CPUFloat4{};
+            // Solo el Mandelbulb usa el tiempo, a través de la potencia. Fuera del Menger el zoom
+            // es parte de la cámara
+            const CPUFractal3DSetup S = MakeFractal3DSetup(C);
+            Key.TimeAndResolution.x   = 0.0f;
+            if (S.FractalType != CPU_FRACTAL_3D_MENGER_SPONGE)
+            {
+                if (S.FractalType != CPU_FRACTAL_3D_QUATERNION_JULIA && S.FractalType != CPU_FRACTAL_3D_MANDELBOX)
+                    Key.TimeAndResolution.x = S.Power;
+                Key.ZoomOffset.x = 0.0f;
+            }
+            return Key;
+        };
+
+        const CPUShaderConstants PrevKey = GetKey(Prev);
+        const CPUShaderConstants CurKey  = GetKey(Cur);
+        return std::memcmp(&PrevKey, &CurKey, sizeof(PrevKey)) == 0;
+    }
+
+    namespace
+    {
+        using FloatPack = SimdPack<float>;
+
+        struct Float3Pack
+        {
+            FloatPack x, y, z;
+        };
+
+        inline Float3Pack Broadcast3(const CPUFloat3& v)
+        {
+            return Float3Pack{FloatPack::Broadcast(v.x), FloatPack::Broadcast(v.y), FloatPack::Broadcast(v.z)};
+        }
+
+        // a + b * t, en el mismo orden que ro + rd * t con CPUFloat3
+        inline Float3Pack MulAdd(const Float3Pack& a, const Float3Pack& b, FloatPack t)
+        {
+            return Float3Pack{a.x + b.x * t, a.y + b.y * t, a.z + b.z * t};
+        }
+
+        inline FloatPack Dot(const Float3Pack& a, const Float3Pack& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        // Máscara de las lanes con su bit a 1 en Bits
+        FloatPack MaskFromBits(int Bits)
+        {
+            float Lanes[CPURayPacketWidth];
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                Lanes[Lane] = (Bits >> Lane) & 1 ? 1.0f : 0.0f;
+            return FloatPack::Broadcast(0.0f) < FloatPack::Load(Lanes);
+        }
+
+        // std::min(a, b) y std::max(a, b) devuelven a si alguno es NaN; Min/Max de SimdPack, el
+        // segundo argumento. Con los argumentos al revés el resultado es el mismo bit a bit
+        inline FloatPack StdMin(FloatPack a, FloatPack b)
+        {
+            return Min(b, a);
+        }
+
+        inline FloatPack StdMax(FloatPack a, FloatPack b)
+        {
+            return Max(b, a);
+        }
+
+        // fmod con el signo del dividendo; difiere del exacto de std::fmod en el redondeo
+        inline FloatPack Fmod(FloatPack x, FloatPack y)
+        {
+            return x - Trunc(x / y) * y;
+        }
+
+        struct ComplexPack
+        {
+            FloatPack re, im;
+        };
+
+        inline ComplexPack ComplexMul(const ComplexPack& a, const ComplexPack& b)
+        {
+            return ComplexPack{a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+        }
+
+        template <int N>
+        inline ComplexPack ComplexPowInt(ComplexPack c)
+        {
+            ComplexPack Result{FloatPack::Broadcast(1.0f), FloatPack::Broadcast(0.0f)};
+            for (int e = N; e > 0; e >>= 1)
+            {
+                if (e & 1)
+                    Result = ComplexMul(Result, c);
+                c = ComplexMul(c, c);
+            }
+            return Result;
+        }
+
+        // MandelbulbKernel<8, false> en las lanes de Mask; las que escapan se congelan
+        FloatPack MandelbulbPacket8(const Float3Pack& Pos, int Mask)
+        {
+            const FloatPack One      = FloatPack::Broadcast(1.0f);
+            const FloatPack Zero     = FloatPack::Broadcast(0.0f);
+            const FloatPack Bailout2 = FloatPack::Broadcast(2.0f * 2.0f);
+
+            Float3Pack z      = Pos;
+            FloatPack  dr     = One;
+            FloatPack  r      = Zero;
+            FloatPack  Active = MaskFromBits(Mask);
+            for (int i = 0; i < 100; ++i)
+            {
+                const FloatPack r2 = Dot(z, z);
+                r                  = Select(Active, Sqrt(r2), r);
+                Active             = AndNot(r2 > Bailout2, Active);
+                if (!AnyLane(Active))
+                    break;
+
+                const FloatPack   Rho     = Sqrt(z.x * z.x + z.y * z.y);
+                const FloatPack   HasRho  = Rho > Zero;
+                const ComplexPack DirPhi  = {Select(HasRho, z.x / Rho, One), Select(HasRho, z.y / Rho, Zero)};
+                const ComplexPack NTheta  = ComplexPowInt<8>(ComplexPack{z.z / r, Rho / r});
+                const ComplexPack NPhi    = ComplexPowInt<8>(DirPhi);
+                FloatPack         Rn1     = One;
+                for (int k = 1; k < 8; ++k)
+                    Rn1 = Rn1 * r;
+                const FloatPack Zr = Rn1 * r;
+
+                dr = Select(Active, Rn1 * FloatPack::Broadcast(8.0f) * dr + One, dr);
+                z  = Float3Pack{Select(Active, NTheta.im * NPhi.re * Zr + Pos.x, z.x), Select(Active, NTheta.im * NPhi.im * Zr + Pos.y, z.y),
+                               Select(Active, NTheta.re * Zr + Pos.z, z.z)};
+            }
+
+            // El logaritmo, lane a lane
+            float R[CPURayPacketWidth], Dr[CPURayPacketWidth], Dist[CPURayPacketWidth] = {};
+            r.Store(R);
+            dr.Store(Dr);
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+            {
+                if ((Mask >> Lane) & 1)
+                    Dist[Lane] = 0.5f * std::log(R[Lane]) * R[Lane] / Dr[Lane];
+            }
+            return FloatPack::Load(Dist);
+        }
+
+        FloatPack CrossDistancePacket(const Float3Pack& p, float Size)
+        {
+            const FloatPack Third = FloatPack::Broadcast(Size / 3.0f);
+            const FloatPack px    = Abs(p.x) - Third;
+            const FloatPack py    = Abs(p.y) - Third;
+            const FloatPack pz    = Abs(p.z) - Third;
+            return StdMin(StdMin(StdMax(py, pz), StdMax(px, pz)), StdMax(px, py));
+        }
+
+        FloatPack MengerMapPacket(const Float3Pack& p, const CPUFractal3DSetup& S)
+        {
+            FloatPack d     = FloatPack::Broadcast(S.Thresh);
+            float     Scale = 1.0f;
+            for (int i = 0; i < S.Iterations; i++)
+            {
+                const float     r  = S.MengerSize / Scale;
+                const FloatPack R  = FloatPack::Broadcast(r);
+                const FloatPack R2 = FloatPack::Broadcast(2.0f * r);
+                d = StdMin(d, CrossDistancePacket(Float3Pack{Fmod(p.x + R, R2) - R, Fmod(p.y + R, R2) - R, Fmod(p.z + R, R2) - R}, r));
+                Scale *= 3.0f;
+            }
+            return FloatPack::Broadcast(0.0f) - d;
+        }
+
+        // DistanceMengerSponge(p / Size) * Size, la distancia de la sombra
+        FloatPack MengerShadowPacket(const Float3Pack& p, const CPUFractal3DSetup& S)
+        {
+            const FloatPack Size = FloatPack::Broadcast(S.MengerSize);
+            const FloatPack One  = FloatPack::Broadcast(1.0f);
+            const FloatPack Zero = FloatPack::Broadcast(0.0f);
+            const Float3Pack a0  = {Abs(p.x / Size), Abs(p.y / Size), Abs(p.z / Size)};
+            const Float3Pack Out = {StdMax(a0.x - One, Zero), StdMax(a0.y - One, Zero), StdMax(a0.z - One, Zero)};
+
+            FloatPack d = Sqrt(Dot(Out, Out));
+            float     s = 1.0f;
+            for (int i = 0; i < S.Iterations; ++i)
+            {
+                s /= 3.0f;
+                const FloatPack sp = FloatPack::Broadcast(s);
+                const FloatPack s2 = FloatPack::Broadcast(2.0f * s);
+                const FloatPack ax = Abs(Fmod(a0.x, s2) - sp);
+                const FloatPack ay = Abs(Fmod(a0.y, s2) - sp);
+                const FloatPack az = Abs(Fmod(a0.z, s2) - sp);
+                const FloatPack da = StdMax(ax, ay);
+                const FloatPack db = StdMax(ay, az);
+                const FloatPack dc = StdMax(az, ax);
+                d                  = StdMax(d, Zero - StdMin(da, StdMin(db, dc)));
+            }
+            return d * Size;
+        }
+
+        FloatPack MandelboxPacket(const Float3Pack& Pos, float Scale)
+        {
+            const float     AbsScale = std::abs(Scale);
+            const float     Fit      = (AbsScale + 1.0f) / (AbsScale - 1.0f);
+            const FloatPack FitPack  = FloatPack::Broadcast(Fit);
+            const FloatPack One      = FloatPack::Broadcast(1.0f);
+            const FloatPack MinusOne = FloatPack::Broadcast(-1.0f);
+            const FloatPack Two      = FloatPack::Broadcast(2.0f);
+            const FloatPack Four     = FloatPack::Broadcast(4.0f);
+            const FloatPack MinR2    = FloatPack::Broadcast(0.25f);
+            const FloatPack ScalePk  = FloatPack::Broadcast(Scale);
+            const FloatPack AbsPk    = FloatPack::Broadcast(AbsScale);
+            const Float3Pack p       = {Pos.x * FitPack, Pos.y * FitPack, Pos.z * FitPack};
+
+            auto BoxFold = [&](FloatPack x) { return Select(x < MinusOne, MinusOne, Select(x > One, One, x)) * Two - x; };
+
+            Float3Pack z  = p;
+            FloatPack  dr = One;
+            for (int i = 0; i < MandelboxIterations; ++i)
+            {
+                z                    = Float3Pack{BoxFold(z.x), BoxFold(z.y), BoxFold(z.z)};
+                const FloatPack r2   = Dot(z, z);
+                const FloatPack t    = One / r2;
+                const FloatPack Inner = r2 < MinR2;
+                const FloatPack Fold  = r2 < One;
+                const FloatPack k    = Select(Inner, Four, Select(Fold, t, One));
+                const FloatPack Folded = Inner | Fold;
+                z                    = Float3Pack{Select(Folded, z.x * k, z.x), Select(Folded, z.y * k, z.y), Select(Folded, z.z * k, z.z)};
+                dr                   = Select(Folded, dr * k, dr);
+                z                    = Float3Pack{z.x * ScalePk + p.x, z.y * ScalePk + p.y, z.z * ScalePk + p.z};
+                dr                   = dr * AbsPk + One;
+            }
+            const FloatPack  Zero = FloatPack::Broadcast(0.0f);
+            const Float3Pack Out  = {StdMax(Abs(Pos.x) - Two, Zero), StdMax(Abs(Pos.y) - Two, Zero), StdMax(Abs(Pos.z) - Two, Zero)};
+            return StdMax(Sqrt(Dot(z, z)) / Abs(dr) / FitPack, Sqrt(Dot(Out, Out)));
+        }
+
+        // QuaternionJuliaKernel en las lanes de Mask; las que escapan se congelan
+        FloatPack QuaternionJuliaPacket(const Float3Pack& Pos, const CPUFloat4& C, int Mask)
+        {
+            const FloatPack Two  = FloatPack::Broadcast(2.0f);
+            const FloatPack Cx   = FloatPack::Broadcast(C.x);
+            const FloatPack Cy   = FloatPack::Broadcast(C.y);
+            const FloatPack Cz   = FloatPack::Broadcast(C.z);
+            const FloatPack Cw   = FloatPack::Broadcast(C.w);
+            const FloatPack Zero = FloatPack::Broadcast(0.0f);
+
+            FloatPack qx = Pos.x, qy = Pos.y, qz = Pos.z, qw = Zero;
+            FloatPack dx = FloatPack::Broadcast(1.0f), dy = Zero, dz = Zero, dw = Zero;
+            FloatPack q2     = qx * qx + qy * qy + qz * qz + qw * qw;
+            FloatPack Active = MaskFromBits(Mask);
+            for (int i = 0; i < QuaternionJuliaIterations; ++i)
+            {
+                const FloatPack ndx = Two * (qx * dx - (qy * dy + qz * dz + qw * dw));
+                const FloatPack ndy = Two * (qx * dy + dx * qy);
+                const FloatPack ndz = Two * (qx * dz + dx * qz);
+                const FloatPack ndw = Two * (qx * dw + dx * qw);
+                dx = Select(Active, ndx, dx), dy = Select(Active, ndy, dy), dz = Select(Active, ndz, dz), dw = Select(Active, ndw, dw);
+
+                const FloatPack nqx = qx * qx - (qy * qy + qz * qz + qw * qw) + Cx;
+                const FloatPack nqy = Two * qx * qy + Cy;
+                const FloatPack nqz = Two * qx * qz + Cz;
+                const FloatPack nqw = Two * qx * qw + Cw;
+                qx = Select(Active, nqx, qx), qy = Select(Active, nqy, qy), qz = Select(Active, nqz, qz), qw = Select(Active, nqw, qw);
+
+                q2     = Select(Active, qx * qx + qy * qy + qz * qz + qw * qw, q2);
+                Active = AndNot(q2 > FloatPack::Broadcast(16.0f), Active);
+                if (!AnyLane(Active))
+                    break;
+            }
+
+            float R[CPURayPacketWidth], D[CPURayPacketWidth], L[CPURayPacketWidth], Dist[CPURayPacketWidth] = {};
+            Sqrt(q2).Store(R);
+            Sqrt(dx * dx + dy * dy + dz * dz + dw * dw).Store(D);
+            Sqrt(Dot(Pos, Pos)).Store(L);
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+            {
+                if ((Mask >> Lane) & 1)
+                    Dist[Lane] = LimitJuliaDistance(0.5f * R[Lane] * std::log(R[Lane]) / D[Lane], L[Lane]);
+            }
+            return FloatPack::Load(Dist);
+        }
+
+        // AnalyticDistance de las lanes de Mask (las demás quedan indefinidas)
+        FloatPack AnalyticDistancePacket(const CPUFractal3DSetup& S, const Float3Pack& p, int Mask)
+        {
+            switch (S.FractalType)
+            {
+                case CPU_FRACTAL_3D_MENGER_SPONGE: return MengerMapPacket(p, S);
+                case CPU_FRACTAL_3D_QUATERNION_JULIA: return QuaternionJuliaPacket(p, S.JuliaC, Mask);
+                case CPU_FRACTAL_3D_MANDELBOX: return MandelboxPacket(p, S.MandelboxScale);
+                default:
+                    if (S.Power == 8.0f)
+                        return MandelbulbPacket8(p, Mask);
+            }
+
+            // Potencia no entera: sin acos/atan2/pow vectoriales, lane a lane
+            float X[CPURayPacketWidth], Y[CPURayPacketWidth], Z[CPURayPacketWidth], Dist[CPURayPacketWidth] = {};
+            p.x.Store(X);
+            p.y.Store(Y);
+            p.z.Store(Z);
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+            {
+                if ((Mask >> Lane) & 1)
+                    Dist[Lane] = DistanceMandelbulbFast(CPUFloat3{X[Lane], Y[Lane], Z[Lane]}, S.Power);
+            }
+            return FloatPack::Load(Dist);
+        }
+
+        // SceneDistance / ShadowDistance de las lanes de Mask: el cache de distancias lane a lane
+        // y, para las que no lo tienen, DistanceFunc(p, Mask) en todas a la vez
+        template <typename DistanceFuncType>
+        FloatPack SamplePacket(const CPUFractal3DSetup& S, const Float3Pack& p, int Mask, CPU_DISTANCE_BRICK_CHANNEL Channel, CPURay3DStats* pStats,
+                               DistanceFuncType DistanceFunc)
+        {
+            int   DEMask = Mask;
+            float Brick[CPURayPacketWidth] = {};
+            if (S.pBricks != nullptr)
+            {
+                float X[CPURayPacketWidth], Y[CPURayPacketWidth], Z[CPURayPacketWidth];
+                p.x.Store(X);
+                p.y.Store(Y);
+                p.z.Store(Z);
+                for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                {
+                    if (((Mask >> Lane) & 1) && S.pBricks->Sample(CPUFloat3{X[Lane], Y[Lane], Z[Lane]}, Channel, Brick[Lane]))
+                    {
+                        ++pStats[Lane].BrickSamples;
+                        DEMask &= ~(1 << Lane);
+                    }
+                }
+            }
+            if (DEMask == 0)
+                return FloatPack::Load(Brick);
+
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                pStats[Lane].DEEvaluations += (DEMask >> Lane) & 1;
+            const FloatPack Dist = DistanceFunc(p, DEMask);
+            return DEMask == Mask ? Dist : Select(MaskFromBits(DEMask), Dist, FloatPack::Load(Brick));
+        }
+    } // namespace
+
+    void RenderPacket3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, int PixelX, int PixelY, int Count, const float* pStartDist,
+                        const float* pSafeStartDist, CPUFloat4* pColors, CPURay3DStats* pStats)
+    {
+        const CPUFractal3DSetup& S = Setup;
+
+        // Las lanes de relleno repiten el último píxel y no se marchan
+        CPUFloat3     Dirs[CPURayPacketWidth];
+        float         Dx[CPURayPacketWidth], Dy[CPURayPacketWidth], Dz[CPURayPacketWidth], Start[CPURayPacketWidth], Safe[CPURayPacketWidth];
+        CPURay3DStats Stats[CPURayPacketWidth];
+        for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+        {
+            const int k = Lane < Count ? Lane : Count - 1;
+            Dirs[Lane]  = GetRayDirection(S, Constants, static_cast<float>(PixelX + k), static_cast<float>(PixelY));
+            Dx[Lane]    = Dirs[Lane].x;
+            Dy[Lane]    = Dirs[Lane].y;
+            Dz[Lane]    = Dirs[Lane].z;
+            Start[Lane] = pStartDist[k];
+            Safe[Lane]  = pSafeStartDist[k];
+        }
+        const int ValidMask = (1 << Count) - 1;
+
+        const CPUFloat3  ro    = GetRayOrigin(S, Constants);
+        const Float3Pack Ro    = Broadcast3(ro);
+        const Float3Pack Rd    = {FloatPack::Load(Dx), FloatPack::Load(Dy), FloatPack::Load(Dz)};
+        const FloatPack  Thresh  = FloatPack::Broadcast(S.Thresh);
+        const FloatPack  MaxDist = FloatPack::Broadcast(S.MaxDist);
+
+        auto SceneDE = [&](const Float3Pack& p, int Mask) { return AnalyticDistancePacket(S, p, Mask); };
+
+        // Distancia reproyectada no conservadora: las lanes que ya empiezan en la superficie
+        // vuelven a la segura
+        FloatPack TotalDist = FloatPack::Load(Start);
+        const int Reproj    = LaneMask(FloatPack::Load(Start) > FloatPack::Load(Safe)) & ValidMask;
+        if (Reproj != 0)
+        {
+            for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                Stats[Lane].DEEvaluations += (Reproj >> Lane) & 1;
+            const FloatPack d = AnalyticDistancePacket(S, MulAdd(Ro, Rd, TotalDist), Reproj);
+            TotalDist         = Select(MaskFromBits(Reproj) & (d < Thresh), FloatPack::Load(Safe), TotalDist);
+        }
+
+        int       Active = ValidMask;
+        FloatPack Hit;
+        if (S.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE)
+        {
+            for (int i = 0; i < S.MaxSteps && Active != 0; i++)
+            {
+                const FloatPack d = SamplePacket(S, MulAdd(Ro, Rd, TotalDist), Active, CPU_DISTANCE_BRICK_CHANNEL_SCENE, Stats, SceneDE);
+                for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                    Stats[Lane].Steps += (Active >> Lane) & 1;
+                Active &= ~LaneMask(d < Thresh);
+                TotalDist = Select(MaskFromBits(Active), TotalDist + d, TotalDist);
+                Active &= ~LaneMask(TotalDist > MaxDist);
+            }
+            Hit = TotalDist < MaxDist;
+        }
+        else
+        {
+            FloatPack Dist = FloatPack::Broadcast(0.0f);
+            for (int i = 0; i < S.MaxSteps && Active != 0; ++i)
+            {
+                const FloatPack d = SamplePacket(S, MulAdd(Ro, Rd, TotalDist), Active, CPU_DISTANCE_BRICK_CHANNEL_SCENE, Stats, SceneDE);
+                for (int Lane = 0; Lane < CPURayPacketWidth; ++Lane)
+                    Stats[Lane].Steps += (Active >> Lane) & 1;
+                const FloatPack ActivePack = MaskFromBits(Active);
+                Dist                       = Select(ActivePack, d, Dist);
+                TotalDist                  = Select(ActivePack, TotalDist + d, TotalDist);
+                Active &= ~LaneMask((d < Thresh) | (TotalDist > MaxDist));
+            }
+            Hit = Dist < Thresh;
+        }
+
+        const int HitMask = LaneMask(Hit) & ValidMask;
+        float     HitDist[CPURayPacketWidth];
+        Select(Hit, TotalDist, MaxDist).Store(HitDist);
+
+        // Sombra del Menger (calculateShadow) desde los impactos, también por paquetes
+        float Shadow[CPURayPacketWidth];
+        FloatPack::Broadcast(1.0f).Store(Shadow);
+        if (S.FractalType == CPU_FRACTAL_3D_MENGER_SPONGE && HitMask != 0)
+        {
+            const Float3Pack HitPos = MulAdd(Ro, Rd, FloatPack::Load(HitDist));
+            const Float3Pack Light  = Broadcast3(LightDirection);
+            const FloatPack  Ten    = FloatPack::Broadcast(10.0f);
+            auto ShadowDE = [&](const Float3Pack& p, int) { return MengerShadowPacket(p, S); };
+
+            FloatPack t      = FloatPack::Broadcast(S.Thresh * 2.0f);
+            FloatPack Shade  = FloatPack::Broadcast(1.0f);
+            int       Lanes  = HitMask;
+            for (int i = 0; i < S.MaxSteps && Lanes != 0; i++)
+            {
+                const FloatPack sd       = SamplePacket(S, MulAdd(HitPos, Light, t), Lanes, CPU_DISTANCE_BRICK_CHANNEL_SHADOW, Stats, ShadowDE);
+                const FloatPack Occluded = MaskFromBits(Lanes) & (sd < Thresh);
+                Shade                    = Select(Occluded, FloatPack::Broadcast(0.0f), Shade);
+                Lanes &= ~LaneMask(Occluded);
+
+                const FloatPack LanePack = MaskFromBits(Lanes);
+                Shade                    = Select(LanePack, StdMin(Shade, Ten * sd / t), Shade);
+                t                        = Select(LanePack, t + sd, t);
+                Lanes &= ~LaneMask(t > MaxDist);
+            }
+            Shade.Store(Shadow);
+        }
+
+        // Normal y color lane a lane
+        for (int Lane = 0; Lane < Count; ++Lane)
+        {
+            Stats[Lane].Hit     = (HitMask >> Lane) & 1;
+            Stats[Lane].HitDist = HitDist[Lane];
+            pColors[Lane]       = ShadeRay(S, Constants, ro, Dirs[Lane], Shadow[Lane], Stats[Lane]);
+            pStats[Lane]        = Stats[Lane];
+        }
+    }
+
+    float ConeMarchTile3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, int TileX, int TileY, int TileSize, float StartDist,
+                          CPURay3DStats& Stats)
+    {
+        // Eje: centro de los píxeles de la tile. Con la base de la cámara ortonormal |dir| >= 1,
+        // así que la semidiagonal de la tile en uv acota la tangente del ángulo con cualquier rayo
+        const float     Size   = static_cast<float>(TileSize);
+        const CPUFloat3 ro     = GetRayOrigin(Setup, Constants);
+        const CPUFloat3 rd     = GetRayDirection(Setup, Constants, TileX * Size + (Size - 1.0f) * 0.5f, TileY * Size + (Size - 1.0f) * 0.5f);
+        const float     PixelU = 2.0f * Setup.Aspect / static_cast<float>(Setup.Width);
+        const float     PixelV = 2.0f / static_cast<float>(Setup.Height);
+        const float     Ratio  = 0.5f * Size * std::sqrt(PixelU * PixelU + PixelV * PixelV);
+
+        // Un punto del cono a distancia axial t + dt está a menos de dt * (1 + Ratio) + t * Ratio
+        // del punto del eje en t: mientras la distancia d supere el radio r = t * Ratio se puede
+        // avanzar (d - r) / (1 + Ratio) sin salir de la esfera vacía
+        float t = StartDist;
+        for (int i = 0; i < Setup.MaxSteps; ++i)
+        {
+            const CPUFloat3 p = ro + rd * t;
+            const float     d = SceneDistance(Setup, p, Stats);
+            const float     r = t * Ratio;
+            ++Stats.Steps;
+            if (d < r + Setup.Thresh || t > Setup.MaxDist)
+                break;
+            t += (d - r) / (1.0f + Ratio);
+        }
+        return t;
+    }
+
+} // namespace Diligent
@@ -0,0 +1,98 @@
+#pragma once
+
+// Versión CPU de los ray marchers 3D de fractalCompute.psh (RenderMandelbulb3D,
+// RenderMengerSponge3D y RenderDistanceEstimated3D para Mandelbox y Quaternion Julia).
+// Replica el HLSL paso a paso para poder medir y comprobar los kernels 3D sin GPU; además
+// cuenta las evaluaciones de la función de distancia. RenderPixel3D marcha un rayo;
+// RenderPacket3D (CPURayPacket3D.hpp) marcha varios a la vez en las lanes de SimdPack.
+
+#include <cstdint>
+
+#include "CPUShaderConstants.hpp"
+
+namespace Diligent
+{
+
+    class CPUDistanceBrickCache;
+
+    // Parámetros del ray marching derivados de las constantes, calculados una vez por frame
+    struct CPUFractal3DSetup
+    {
+        int FractalType = CPU_FRACTAL_3D_MANDELBULB;
+
+        int   Width    = 0;
+        int   Height   = 0;
+        float Aspect   = 1;
+        int   MaxSteps = 0;
+        float MaxDist  = 0;
+        float Thresh   = 0;
+
+        float Power      = 8; // potencia del Mandelbulb (Options3D.w, o la animada)
+        float MengerSize = 1; // ZoomOffset.x
+        int   Iterations = 0; // iteraciones del Menger (maxiter)
+
+        float     MandelboxScale = 2; // FractalParams1.y, con |escala| >= MinMandelboxScale
+        CPUFloat4 JuliaC;             // c del Quaternion Julia (FractalC; a cero, DefaultQuaternionJuliaC)
+
+        // Cache de distancias horneado (CPUDistanceBricks.hpp) para la marcha, el cono y la
+        // sombra; nullptr evalúa siempre el DE analítico
+        const CPUDistanceBrickCache* pBricks = nullptr;
+    };
+
+    CPUFractal3DSetup MakeFractal3DSetup(const CPUShaderConstants& Constants);
+
+    // Constantes de DE_Mandelbox y DE_QuaternionJulia de fractal3D.fxh
+    static constexpr int       MandelboxIterations       = 15;
+    static constexpr float     MinMandelboxScale         = 1.5f;
+    static constexpr int       QuaternionJuliaIterations = 16;
+    static constexpr CPUFloat4 DefaultQuaternionJuliaC   = {-0.2f, 0.6f, 0.2f, 0.2f};
+
+    struct CPURay3DStats
+    {
+        std::uint64_t DEEvaluations = 0; // llamadas a la función de distancia (marcha, normal y sombra)
+        std::uint64_t BrickSamples  = 0; // pasos resueltos con el cache de distancias, sin DE analítico
+        std::uint32_t Steps         = 0; // pasos de la marcha principal
+        bool          Hit           = false;
+        float         HitDist       = 0; // distancia del impacto (MaxDist si no hay), para la historia temporal
+    };
+
+    // Color del píxel (PixelX, PixelY) como lo calcula CSMain: uv sin el medio píxel,
+    // fila 0 arriba (admite coordenadas fraccionarias, p.ej. para muestras con jitter).
+    // Cada tipo de CPU_FRACTAL_3D con su kernel, como RenderFractal3D de fractalCompute.psh.
+    // La marcha empieza en StartDist. SafeStartDist es la distancia conservadora (0, o lo que
+    // dejó ConeMarchTile3D para su tile); si StartDist la supera (profundidad reproyectada del
+    // frame anterior) y ese punto ya está en la superficie, se empieza desde SafeStartDist.
+    CPUFloat4 RenderPixel3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, float PixelX, float PixelY, float StartDist,
+                            float SafeStartDist, CPURay3DStats& Stats);
+
+    // Prepasada de cono de fractalConeMarch.psh: marcha desde StartDist un cono que cubre la
+    // tile (TileX, TileY) de TileSize píxeles y devuelve hasta qué distancia está vacío
+    float ConeMarchTile3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, int TileX, int TileY, int TileSize, float StartDist,
+                          CPURay3DStats& Stats);
+
+    // Reproyección (fractalTemporal.fxh): punto a distancia Dist del rayo del píxel (admite
+    // coordenadas fraccionarias) y, al revés, píxel y distancia de un punto visto por la cámara
+    // de Constants. ProjectToPixel3D devuelve false si el punto queda detrás de la cámara.
+    CPUFloat3 GetPixelRayPoint3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, float PixelX, float PixelY, float Dist);
+    bool      ProjectToPixel3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, const CPUFloat3& Point, float& PixelX, float& PixelY,
+                               float& Dist);
+
+    // ¿Sigue valiendo la historia del frame Prev para el frame Cur? Solo pueden cambiar la
+    // cámara (posición, base y, fuera del Menger, el zoom que adelanta el origen) y el tiempo
+    // mientras no cambie la potencia; cualquier otro parámetro, o la potencia animada, la invalida.
+    bool IsTemporalHistoryCompatible3D(const CPUShaderConstants& Prev, const CPUShaderConstants& Cur);
+
+    // Funciones de distancia del shader, expuestas para pruebas (fractal_de_test).
+    // DistanceMandelbulb es siempre el camino general (trigonométrico); DistanceMandelbulbFast
+    // usa el kernel polinómico para la potencia 8, como DE_MandelbulbFast; y
+    // DistanceMandelbulbGradient devuelve además la dirección de la normal analítica (sin normalizar).
+    float DistanceMandelbulb(const CPUFloat3& Pos, float Power);
+    float DistanceMandelbulbFast(const CPUFloat3& Pos, float Power);
+    float DistanceMandelbulbGradient(const CPUFloat3& Pos, float Power, CPUFloat3& Gradient);
+    float DistanceMengerSponge(const CPUFloat3& Pos, int Iterations);
+    // map de fractal3D.fxh (getInnerMenger cambiado de signo), la distancia de la marcha del Menger
+    float DistanceMengerMap(const CPUFloat3& Pos, float Size, int Iterations, float Thresh);
+    float DistanceMandelbox(const CPUFloat3& Pos, float Scale);
+    float DistanceQuaternionJulia(const CPUFloat3& Pos, const CPUFloat4& C);
+
+} // namespace Diligent
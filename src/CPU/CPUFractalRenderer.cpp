@@ -0,0 +1,768 @@
+#include "CPUFractalRenderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "CPURayPacket3D.hpp"
+
+namespace Diligent
+{
+
+    namespace
+    {
+        // Mezcla canal a canal Cur + (Prev - Cur) * Weight de dos colores RGBA8
+        std::uint32_t BlendRGBA8(std::uint32_t Cur, std::uint32_t Prev, float Weight)
+        {
+            std::uint32_t Result = 0;
+            for (int Shift = 0; Shift < 32; Shift += 8)
+            {
+                const float c = static_cast<float>((Cur >> Shift) & 0xFF);
+                const float p = static_cast<float>((Prev >> Shift) & 0xFF);
+                Result |= static_cast<std::uint32_t>(c + (p - c) * Weight + 0.5f) << Shift;
+            }
+            return Result;
+        }
+
+        // Bits de un float no negativo: conservan el orden, así que el mínimo se puede hacer con
+        // compare-exchange sobre enteros (como InterlockedMin en fractalReproject.psh)
+        void AtomicMinDepth(std::atomic<std::uint32_t>& Target, float Depth)
+        {
+            std::uint32_t Bits;
+            std::memcpy(&Bits, &Depth, sizeof(Bits));
+            std::uint32_t Current = Target.load(std::memory_order_relaxed);
+            while (Bits < Current && !Target.compare_exchange_weak(Current, Bits, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        CPUFloat4 UnpackColorRGBA8(std::uint32_t Color)
+        {
+            return CPUFloat4{static_cast<float>(Color & 0xFF) / 255.0f, static_cast<float>((Color >> 8) & 0xFF) / 255.0f,
+                             static_cast<float>((Color >> 16) & 0xFF) / 255.0f, static_cast<float>(Color >> 24) / 255.0f};
+        }
+
+        void AddColor(CPUFloat4& Sum, const CPUFloat4& Color)
+        {
+            Sum.x += Color.x;
+            Sum.y += Color.y;
+            Sum.z += Color.z;
+            Sum.w += Color.w;
+        }
+
+        // Desplazamiento de la muestra extra Sample respecto al píxel, en [-0.5, 0.5): la
+        // secuencia R2, bien repartida para cualquier número de muestras (igual en fractalAdaptiveAA.psh)
+        void GetAAJitter(std::uint32_t Sample, float& dx, float& dy)
+        {
+            const float k  = static_cast<float>(Sample + 1);
+            const float jx = 0.5f + k * 0.7548776662f;
+            const float jy = 0.5f + k * 0.5698402910f;
+            dx             = jx - std::floor(jx) - 0.5f;
+            dy             = jy - std::floor(jy) - 0.5f;
+        }
+
+        // Desviación típica de Metric en la vecindad 3x3 de (x, y), recortada en los bordes
+        float GetNeighbourhoodStdDev(const std::vector<float>& Metric, std::uint32_t Width, std::uint32_t Height, std::uint32_t x, std::uint32_t y)
+        {
+            float Sum = 0.0f, Sum2 = 0.0f, Count = 0.0f;
+            for (std::uint32_t ny = y > 0 ? y - 1 : 0; ny <= std::min(y + 1, Height - 1); ++ny)
+            {
+                for (std::uint32_t nx = x > 0 ? x - 1 : 0; nx <= std::min(x + 1, Width - 1); ++nx)
+                {
+                    const float v = Metric[static_cast<size_t>(ny) * Width + nx];
+                    Sum += v;
+                    Sum2 += v * v;
+                    Count += 1.0f;
+                }
+            }
+            const float Mean = Sum / Count;
+            return std::sqrt(std::max(Sum2 / Count - Mean * Mean, 0.0f));
+        }
+
+        // Muestras extra de un píxel: una por cada vez que la desviación supera el umbral
+        std::uint32_t GetAASampleCount(float StdDev, float Threshold, std::uint32_t MaxSamples)
+        {
+            if (!(StdDev > Threshold))
+                return 0;
+            return std::max(1u, static_cast<std::uint32_t>(std::min(StdDev / Threshold, static_cast<float>(MaxSamples))));
+        }
+
+        // Una tile de RenderEscapeSubdivided2D. Los rectángulos son inclusivos ([X0, X1] x [Y0, Y1])
+        // para que las cuatro subtiles compartan las líneas de corte y no se calculen dos veces.
+        class SubdivisionTile
+        {
+        public:
+            SubdivisionTile(const CPUFractal2DSetup& Setup, CPUEscapeSample* pSamples, std::uint32_t Stride,
+                            std::uint32_t X0, std::uint32_t Y0, std::uint32_t X1, std::uint32_t Y1) :
+                m_Setup{Setup},
+                m_pSamples{pSamples},
+                m_Stride{Stride},
+                m_X0{X0},
+                m_Y0{Y0},
+                m_Width{X1 - X0 + 1}
+            {
+                m_Known.assign(static_cast<size_t>(m_Width) * (Y1 - Y0 + 1), 0);
+                Subdivide(X0, Y0, X1, Y1);
+            }
+
+            std::uint64_t Iterations = 0;
+            std::uint64_t Skipped    = 0;
+
+        private:
+            CPUEscapeSample& At(std::uint32_t x, std::uint32_t y) { return m_pSamples[static_cast<size_t>(y) * m_Stride + x]; }
+
+            void AddBorderPixel(std::uint32_t x, std::uint32_t y)
+            {
+                std::uint8_t& Known = m_Known[static_cast<size_t>(y - m_Y0) * m_Width + (x - m_X0)];
+                if (Known)
+                    return;
+                Known = 1;
+                m_PixelX.push_back(x + 0.5f);
+                m_PixelY.push_back(y + 0.5f);
+            }
+
+            void Subdivide(std::uint32_t x0, std::uint32_t y0, std::uint32_t x1, std::uint32_t y1)
+            {
+                // 1) Borde, saltando lo que ya calcularon la tile madre o las hermanas
+                m_PixelX.clear();
+                m_PixelY.clear();
+                for (std::uint32_t x = x0; x <= x1; ++x)
+                {
+                    AddBorderPixel(x, y0);
+                    AddBorderPixel(x, y1);
+                }
+                for (std::uint32_t y = y0 + 1; y < y1; ++y)
+                {
+                    AddBorderPixel(x0, y);
+                    AddBorderPixel(x1, y);
+                }
+                if (!m_PixelX.empty())
+                {
+                    m_Escape.resize(m_PixelX.size());
+                    Iterations += EscapePoints2D(m_Setup, m_PixelX.data(), m_PixelY.data(), static_cast<int>(m_PixelX.size()), m_Escape.data());
+                    for (size_t i = 0; i < m_Escape.size(); ++i)
+                        At(static_cast<std::uint32_t>(m_PixelX[i]), static_cast<std::uint32_t>(m_PixelY[i])) = m_Escape[i];
+                }
+                if (x1 - x0 < 2 || y1 - y0 < 2)
+                    return;
+
+                // 2) Si todo el borde tiene la misma iteración se rellena el interior
+                const CPUEscapeSample Fill    = At(x0, y0);
+                bool                  Uniform = true;
+                for (std::uint32_t x = x0; x <= x1 && Uniform; ++x)
+                    Uniform = At(x, y0).Iter == Fill.Iter && At(x, y1).Iter == Fill.Iter;
+                for (std::uint32_t y = y0 + 1; y < y1 && Uniform; ++y)
+                    Uniform = At(x0, y).Iter == Fill.Iter && At(x1, y).Iter == Fill.Iter;
+
+                if (Uniform)
+                {
+                    for (std::uint32_t y = y0 + 1; y < y1; ++y)
+                        std::fill(&At(x0 + 1, y), &At(x1, y), Fill);
+                    Skipped += static_cast<std::uint64_t>(x1 - x0 - 1) * (y1 - y0 - 1);
+                    return;
+                }
+
+                // 3) Tile mínima: el interior se calcula entero; si no, cuatro subtiles
+                if (x1 - x0 + 1 <= CPUFractalRenderer::SubdivMinTileSize || y1 - y0 + 1 <= CPUFractalRenderer::SubdivMinTileSize)
+                {
+                    for (std::uint32_t y = y0 + 1; y < y1; ++y)
+                        Iterations += EscapeRow2D(m_Setup, static_cast<int>(y), static_cast<int>(x0 + 1), static_cast<int>(x1 - x0 - 1), &At(x0 + 1, y));
+                    return;
+                }
+
+                const std::uint32_t xm = (x0 + x1) / 2;
+                const std::uint32_t ym = (y0 + y1) / 2;
+                Subdivide(x0, y0, xm, ym);
+                Subdivide(xm, y0, x1, ym);
+                Subdivide(x0, ym, xm, y1);
+                Subdivide(xm, ym, x1, y1);
+            }
+
+            const CPUFractal2DSetup& m_Setup;
+            CPUEscapeSample*         m_pSamples;
+            std::uint32_t            m_Stride;
+            std::uint32_t            m_X0;
+            std::uint32_t            m_Y0;
+            std::uint32_t            m_Width;
+
+            std::vector<std::uint8_t>    m_Known; // borde ya calculado
+            std::vector<float>           m_PixelX, m_PixelY;
+            std::vector<CPUEscapeSample> m_Escape;
+        };
+    } // namespace
+
+    const char* GetSimdInstructionSetName()
+    {
+#if defined(FRACTAL_CPU_SIMD_AVX2)
+        return "AVX2";
+#elif defined(FRACTAL_CPU_SIMD_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    CPUFractalRenderer::CPUFractalRenderer(std::uint32_t NumThreads) :
+        m_ThreadPool{NumThreads}
+    {
+    }
+
+    void CPUFractalRenderer::SetTileSize(std::uint32_t TileWidth, std::uint32_t TileHeight)
+    {
+        m_TileWidth  = std::max(1u, TileWidth);
+        m_TileHeight = std::max(1u, TileHeight);
+    }
+
+    void CPUFractalRenderer::SetAdaptiveSupersampling(std::uint32_t MaxSamples, float Threshold)
+    {
+        m_AAMaxSamples = std::min(MaxSamples, AAMaxSamplesLimit);
+        m_AAThreshold  = std::max(Threshold, 1e-6f);
+    }
+
+    void CPUFractalRenderer::SetTemporalReprojection(bool Enable, float Blend)
+    {
+        m_Temporal      = Enable;
+        m_TemporalBlend = std::min(std::max(Blend, 0.0f), 1.0f);
+        if (!Enable)
+            m_HistoryValid = false;
+    }
+
+    template <typename ProcessRowType>
+    void CPUFractalRenderer::RenderTiles(const CPUShaderConstants& Constants, std::uint32_t RegionX0, std::uint32_t RegionY0,
+                                         std::uint32_t RegionX1, std::uint32_t RegionY1, ProcessRowType ProcessRow)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(Constants);
+        RegionX1 = std::min(RegionX1, static_cast<std::uint32_t>(std::max(Setup.Width, 0)));
+        RegionY1 = std::min(RegionY1, static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+        const std::uint32_t Width  = RegionX1 > RegionX0 ? RegionX1 - RegionX0 : 0;
+        const std::uint32_t Height = RegionY1 > RegionY0 ? RegionY1 - RegionY0 : 0;
+
+        const std::uint32_t TilesX = (Width + m_TileWidth - 1) / m_TileWidth;
+        const std::uint32_t TilesY = (Height + m_TileHeight - 1) / m_TileHeight;
+
+        std::atomic<std::uint64_t> TotalIterations{0};
+        m_ThreadPool.ParallelFor(TilesX * TilesY, [&](std::uint32_t TileIndex, std::uint32_t) {
+            const std::uint32_t X0 = RegionX0 + (TileIndex % TilesX) * m_TileWidth;
+            const std::uint32_t Y0 = RegionY0 + (TileIndex / TilesX) * m_TileHeight;
+            const std::uint32_t X1 = std::min(X0 + m_TileWidth, RegionX1);
+            const std::uint32_t Y1 = std::min(Y0 + m_TileHeight, RegionY1);
+
+            std::vector<CPUEscapeSample> Row(X1 - X0);
+            std::uint64_t                Iterations = 0;
+            for (std::uint32_t y = Y0; y < Y1; ++y)
+            {
+                Iterations += EscapeRow2D(Setup, static_cast<int>(y), static_cast<int>(X0), static_cast<int>(X1 - X0), Row.data());
+                ProcessRow(Setup, y, X0, X1, Row.data());
+            }
+            TotalIterations.fetch_add(Iterations, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Pixels        = static_cast<std::uint64_t>(Width) * Height;
+        m_LastStats.Iterations    = TotalIterations.load();
+        m_LastStats.Skipped       = 0;
+        m_LastStats.DEEvaluations = 0;
+        m_LastStats.BrickSamples  = 0;
+        m_LastStats.RefinedPixels = 0;
+        m_LastStats.ExtraSamples  = 0;
+        m_LastStats.Seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUFractalRenderer::Render2D(const CPUShaderConstants& Constants, CPUImage& Image)
+    {
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(Constants);
+        Image.Resize(static_cast<std::uint32_t>(std::max(Setup.Width, 0)), static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+
+        // El supersampling adaptativo mira las iteraciones de los vecinos: se guardan todas
+        std::vector<CPUEscapeSample> Escape(m_AAMaxSamples > 0 ? Image.Pixels.size() : 0);
+        RenderTiles(Constants, 0, 0, Image.Width, Image.Height, [&](const CPUFractal2DSetup& S, std::uint32_t y, std::uint32_t X0, std::uint32_t X1, const CPUEscapeSample* Row) {
+            const size_t   Offset = static_cast<size_t>(y) * Image.Width + X0;
+            std::uint32_t* pDst   = &Image.Pixels[Offset];
+            for (std::uint32_t x = 0; x < X1 - X0; ++x)
+                pDst[x] = PackColorRGBA8(ShadeEscapeSample2D(S, Constants, Row[x]));
+            if (!Escape.empty())
+                std::copy(Row, Row + (X1 - X0), &Escape[Offset]);
+        });
+
+        if (!Escape.empty())
+            RefineEdges2D(Constants, Escape, Image);
+    }
+
+    void CPUFractalRenderer::RefineEdges2D(const CPUShaderConstants& Constants, const std::vector<CPUEscapeSample>& Escape, CPUImage& Image)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(Constants);
+        std::vector<float>      Metric(Escape.size());
+        for (size_t i = 0; i < Escape.size(); ++i)
+            Metric[i] = std::log2(1.0f + Escape[i].Iter);
+
+        std::atomic<std::uint64_t> TotalIterations{0};
+        std::atomic<std::uint64_t> TotalRefined{0};
+        std::atomic<std::uint64_t> TotalSamples{0};
+        m_ThreadPool.ParallelFor(Image.Height, [&](std::uint32_t y, std::uint32_t) {
+            float           PixelX[AAMaxSamplesLimit], PixelY[AAMaxSamplesLimit];
+            CPUEscapeSample Samples[AAMaxSamplesLimit];
+            std::uint64_t   Iterations = 0, Refined = 0, NumSamples = 0;
+            for (std::uint32_t x = 0; x < Image.Width; ++x)
+            {
+                const std::uint32_t Count = GetAASampleCount(GetNeighbourhoodStdDev(Metric, Image.Width, Image.Height, x, y), m_AAThreshold, m_AAMaxSamples);
+                if (Count == 0)
+                    continue;
+
+                for (std::uint32_t k = 0; k < Count; ++k)
+                {
+                    float dx, dy;
+                    GetAAJitter(k, dx, dy);
+                    PixelX[k] = static_cast<float>(x) + 0.5f + dx;
+                    PixelY[k] = static_cast<float>(y) + 0.5f + dy;
+                }
+                Iterations += EscapePoints2D(Setup, PixelX, PixelY, static_cast<int>(Count), Samples);
+
+                // Media de los colores, no de las iteraciones
+                const size_t Index = static_cast<size_t>(y) * Image.Width + x;
+                CPUFloat4    Sum   = ShadeEscapeSample2D(Setup, Constants, Escape[Index]);
+                for (std::uint32_t k = 0; k < Count; ++k)
+                    AddColor(Sum, ShadeEscapeSample2D(Setup, Constants, Samples[k]));
+                const float Scale   = 1.0f / static_cast<float>(Count + 1);
+                Image.Pixels[Index] = PackColorRGBA8(CPUFloat4{Sum.x * Scale, Sum.y * Scale, Sum.z * Scale, Sum.w * Scale});
+                ++Refined;
+                NumSamples += Count;
+            }
+            TotalIterations.fetch_add(Iterations, std::memory_order_relaxed);
+            TotalRefined.fetch_add(Refined, std::memory_order_relaxed);
+            TotalSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Iterations += TotalIterations.load();
+        m_LastStats.RefinedPixels = TotalRefined.load();
+        m_LastStats.ExtraSamples  = TotalSamples.load();
+        m_LastStats.Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUFractalRenderer::RenderEscape2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples)
+    {
+        const CPUFractal2DSetup Setup  = MakeFractal2DSetup(Constants);
+        const std::uint32_t     Width  = static_cast<std::uint32_t>(std::max(Setup.Width, 0));
+        const std::uint32_t     Height = static_cast<std::uint32_t>(std::max(Setup.Height, 0));
+        Samples.resize(static_cast<size_t>(Width) * Height);
+
+        RenderEscapeRegion2D(Constants, Samples, 0, 0, Width, Height);
+    }
+
+    void CPUFractalRenderer::RenderEscapeRegion2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples,
+                                                  std::uint32_t X0, std::uint32_t Y0, std::uint32_t X1, std::uint32_t Y1)
+    {
+        const size_t Width = static_cast<size_t>(std::max(MakeFractal2DSetup(Constants).Width, 0));
+
+        RenderTiles(Constants, X0, Y0, X1, Y1, [&](const CPUFractal2DSetup&, std::uint32_t y, std::uint32_t RowX0, std::uint32_t RowX1, const CPUEscapeSample* Row) {
+            std::copy(Row, Row + (RowX1 - RowX0), &Samples[y * Width + RowX0]);
+        });
+    }
+
+    void CPUFractalRenderer::RenderEscapeSubdivided2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        const CPUFractal2DSetup Setup  = MakeFractal2DSetup(Constants);
+        const std::uint32_t     Width  = static_cast<std::uint32_t>(std::max(Setup.Width, 0));
+        const std::uint32_t     Height = static_cast<std::uint32_t>(std::max(Setup.Height, 0));
+        Samples.resize(static_cast<size_t>(Width) * Height);
+
+        const std::uint32_t TilesX = (Width + SubdivMaxTileSize - 1) / SubdivMaxTileSize;
+        const std::uint32_t TilesY = (Height + SubdivMaxTileSize - 1) / SubdivMaxTileSize;
+
+        std::atomic<std::uint64_t> TotalIterations{0};
+        std::atomic<std::uint64_t> TotalSkipped{0};
+        m_ThreadPool.ParallelFor(TilesX * TilesY, [&](std::uint32_t TileIndex, std::uint32_t) {
+            const std::uint32_t X0 = (TileIndex % TilesX) * SubdivMaxTileSize;
+            const std::uint32_t Y0 = (TileIndex / TilesX) * SubdivMaxTileSize;
+            const std::uint32_t X1 = std::min(X0 + SubdivMaxTileSize, Width) - 1;
+            const std::uint32_t Y1 = std::min(Y0 + SubdivMaxTileSize, Height) - 1;
+
+            const SubdivisionTile Tile{Setup, Samples.data(), Width, X0, Y0, X1, Y1};
+            TotalIterations.fetch_add(Tile.Iterations, std::memory_order_relaxed);
+            TotalSkipped.fetch_add(Tile.Skipped, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Pixels        = static_cast<std::uint64_t>(Width) * Height;
+        m_LastStats.Iterations    = TotalIterations.load();
+        m_LastStats.Skipped       = TotalSkipped.load();
+        m_LastStats.DEEvaluations = 0;
+        m_LastStats.BrickSamples  = 0;
+        m_LastStats.RefinedPixels = 0;
+        m_LastStats.ExtraSamples  = 0;
+        m_LastStats.Seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUFractalRenderer::Render3D(const CPUShaderConstants& Constants, CPUImage& Image)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        CPUFractal3DSetup Setup = MakeFractal3DSetup(Constants);
+        if (m_pDistanceBricks != nullptr && m_pDistanceBricks->IsCompatible(Constants))
+            Setup.pBricks = m_pDistanceBricks;
+        Image.Resize(static_cast<std::uint32_t>(std::max(Setup.Width, 0)), static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+
+        std::atomic<std::uint64_t> TotalEvaluations{0};
+        std::atomic<std::uint64_t> TotalBrickSamples{0};
+
+        // Prepasada de cono: una distancia por tile de cada nivel, partiendo de la tile madre
+        std::vector<float> ConeDepth, ParentDepth;
+        std::uint32_t      ConeTileSize = 0, ConeTilesX = 0;
+        if (m_ConePrepass)
+        {
+            std::uint32_t ParentTilesX = 0;
+            for (std::uint32_t TileSize = ConeMaxTileSize; TileSize >= ConeMinTileSize; TileSize /= 2)
+            {
+                const std::uint32_t TilesX = (Image.Width + TileSize - 1) / TileSize;
+                const std::uint32_t TilesY = (Image.Height + TileSize - 1) / TileSize;
+                ParentDepth.swap(ConeDepth);
+                ConeDepth.assign(static_cast<size_t>(TilesX) * TilesY, 0.0f);
+
+                m_ThreadPool.ParallelFor(TilesX * TilesY, [&](std::uint32_t TileIndex, std::uint32_t) {
+                    const std::uint32_t tx = TileIndex % TilesX;
+                    const std::uint32_t ty = TileIndex / TilesX;
+
+                    float StartDist = 0.0f;
+                    if (ConeTileSize > 0)
+                        StartDist = ParentDepth[(ty * TileSize / ConeTileSize) * ParentTilesX + tx * TileSize / ConeTileSize];
+
+                    CPURay3DStats Cone;
+                    ConeDepth[TileIndex] = ConeMarchTile3D(Setup, Constants, static_cast<int>(tx), static_cast<int>(ty), static_cast<int>(TileSize), StartDist, Cone);
+                    TotalEvaluations.fetch_add(Cone.DEEvaluations, std::memory_order_relaxed);
+                    TotalBrickSamples.fetch_add(Cone.BrickSamples, std::memory_order_relaxed);
+                });
+
+                ConeTileSize = TileSize;
+                ConeTilesX   = TilesX;
+                ParentTilesX = TilesX;
+            }
+        }
+
+        // Reproyección: cada impacto del frame anterior se lleva a la cámara nueva y deja su
+        // profundidad (la menor) en los 2x2 píxeles que rodean su proyección
+        const size_t NumPixels  = static_cast<size_t>(Image.Width) * Image.Height;
+        const bool   UseHistory = m_Temporal && m_HistoryValid && m_HistoryDepth.size() == NumPixels &&
+            IsTemporalHistoryCompatible3D(m_HistoryConstants, Constants);
+
+        CPUFractal3DSetup                       PrevSetup;
+        std::vector<std::atomic<std::uint32_t>> ReprojDepth;
+        if (UseHistory)
+        {
+            PrevSetup   = MakeFractal3DSetup(m_HistoryConstants);
+            ReprojDepth = std::vector<std::atomic<std::uint32_t>>(NumPixels);
+            for (auto& Depth : ReprojDepth)
+                Depth.store(0x7F800000u, std::memory_order_relaxed); // +inf
+
+            m_ThreadPool.ParallelFor(Image.Height, [&](std::uint32_t y, std::uint32_t) {
+                for (std::uint32_t x = 0; x < Image.Width; ++x)
+                {
+                    const float PrevDepth = m_HistoryDepth[static_cast<size_t>(y) * Image.Width + x];
+                    if (PrevDepth >= PrevSetup.MaxDist)
+                        continue;
+
+                    const CPUFloat3 Point = GetPixelRayPoint3D(PrevSetup, m_HistoryConstants, static_cast<float>(x), static_cast<float>(y), PrevDepth);
+                    float           px, py, Dist;
+                    if (!ProjectToPixel3D(Setup, Constants, Point, px, py, Dist))
+                        continue;
+
+                    const float fx = std::floor(px), fy = std::floor(py);
+                    if (fx < -1.0f || fy < -1.0f || fx >= static_cast<float>(Image.Width) || fy >= static_cast<float>(Image.Height))
+                        continue;
+                    for (int dy = 0; dy < 2; ++dy)
+                    {
+                        for (int dx = 0; dx < 2; ++dx)
+                        {
+                            const int tx = static_cast<int>(fx) + dx;
+                            const int ty = static_cast<int>(fy) + dy;
+                            if (tx >= 0 && ty >= 0 && tx < static_cast<int>(Image.Width) && ty < static_cast<int>(Image.Height))
+                                AtomicMinDepth(ReprojDepth[static_cast<size_t>(ty) * Image.Width + tx], Dist);
+                        }
+                    }
+                }
+            });
+        }
+
+        // Profundidad de impacto de este frame: la historia siguiente y la métrica del supersampling
+        std::vector<float> NewDepth(m_Temporal || m_AAMaxSamples > 0 ? NumPixels : 0);
+
+        const std::uint32_t TilesX = (Image.Width + m_TileWidth - 1) / m_TileWidth;
+        const std::uint32_t TilesY = (Image.Height + m_TileHeight - 1) / m_TileHeight;
+
+        // Con la marcha por paquetes, CPURayPacketWidth píxeles de la fila de la tile a la vez
+        const std::uint32_t PixelsPerStep = m_PacketMarching ? static_cast<std::uint32_t>(CPURayPacketWidth) : 1;
+
+        std::atomic<std::uint64_t> TotalReused{0};
+        m_ThreadPool.ParallelFor(TilesX * TilesY, [&](std::uint32_t TileIndex, std::uint32_t) {
+            const std::uint32_t X0 = (TileIndex % TilesX) * m_TileWidth;
+            const std::uint32_t Y0 = (TileIndex / TilesX) * m_TileHeight;
+            const std::uint32_t X1 = std::min(X0 + m_TileWidth, Image.Width);
+            const std::uint32_t Y1 = std::min(Y0 + m_TileHeight, Image.Height);
+
+            std::uint64_t Evaluations  = 0;
+            std::uint64_t BrickSamples = 0;
+            std::uint64_t Reused       = 0;
+            for (std::uint32_t y = Y0; y < Y1; ++y)
+            {
+                for (std::uint32_t x = X0; x < X1; x += PixelsPerStep)
+                {
+                    const int Count = static_cast<int>(std::min(PixelsPerStep, X1 - x));
+
+                    float StartDist[CPURayPacketWidth], SafeStartDist[CPURayPacketWidth];
+                    for (int k = 0; k < Count; ++k)
+                    {
+                        const std::uint32_t px = x + static_cast<std::uint32_t>(k);
+                        SafeStartDist[k]       = ConeTileSize > 0 ? ConeDepth[(y / ConeTileSize) * ConeTilesX + px / ConeTileSize] : 0.0f;
+                        StartDist[k]           = SafeStartDist[k];
+                        if (UseHistory)
+                        {
+                            const std::uint32_t Bits = ReprojDepth[static_cast<size_t>(y) * Image.Width + px].load(std::memory_order_relaxed);
+                            float               Depth;
+                            std::memcpy(&Depth, &Bits, sizeof(Depth));
+                            Depth *= 1.0f - TemporalDepthMargin;
+                            if (Depth < Setup.MaxDist && Depth > StartDist[k])
+                            {
+                                StartDist[k] = Depth;
+                                ++Reused;
+                            }
+                        }
+                    }
+
+                    CPUFloat4     Colors[CPURayPacketWidth];
+                    CPURay3DStats Rays[CPURayPacketWidth];
+                    if (m_PacketMarching)
+                        RenderPacket3D(Setup, Constants, static_cast<int>(x), static_cast<int>(y), Count, StartDist, SafeStartDist, Colors, Rays);
+                    else
+                        Colors[0] = RenderPixel3D(Setup, Constants, static_cast<float>(x), static_cast<float>(y), StartDist[0], SafeStartDist[0], Rays[0]);
+
+                    for (int k = 0; k < Count; ++k)
+                    {
+                        const std::uint32_t  px    = x + static_cast<std::uint32_t>(k);
+                        const size_t         Index = static_cast<size_t>(y) * Image.Width + px;
+                        const CPURay3DStats& Ray   = Rays[k];
+                        std::uint32_t        Color = PackColorRGBA8(Colors[k]);
+                        Evaluations += Ray.DEEvaluations;
+                        BrickSamples += Ray.BrickSamples;
+
+                        // Color: el impacto visto desde la cámara anterior, si allí había la misma superficie
+                        if (UseHistory && Ray.Hit && m_TemporalBlend > 0.0f)
+                        {
+                            const CPUFloat3 Point = GetPixelRayPoint3D(Setup, Constants, static_cast<float>(px), static_cast<float>(y), Ray.HitDist);
+                            float           ppx, ppy, Dist;
+                            if (ProjectToPixel3D(PrevSetup, m_HistoryConstants, Point, ppx, ppy, Dist))
+                            {
+                                const long PrevX = std::lround(ppx);
+                                const long PrevY = std::lround(ppy);
+                                if (PrevX >= 0 && PrevY >= 0 && PrevX < static_cast<long>(Image.Width) && PrevY < static_cast<long>(Image.Height))
+                                {
+                                    const size_t PrevIndex = static_cast<size_t>(PrevY) * Image.Width + static_cast<size_t>(PrevX);
+                                    if (std::abs(m_HistoryDepth[PrevIndex] - Dist) < Dist * TemporalDepthTolerance)
+                                        Color = BlendRGBA8(Color, m_HistoryColor[PrevIndex], m_TemporalBlend);
+                                }
+                            }
+                        }
+
+                        Image.Pixels[Index] = Color;
+                        if (!NewDepth.empty())
+                            NewDepth[Index] = Ray.HitDist;
+                    }
+                }
+            }
+            TotalEvaluations.fetch_add(Evaluations, std::memory_order_relaxed);
+            TotalBrickSamples.fetch_add(BrickSamples, std::memory_order_relaxed);
+            TotalReused.fetch_add(Reused, std::memory_order_relaxed);
+        });
+
+        // La historia guarda la primera muestra, como la GPU (el supersampling va después)
+        if (m_Temporal)
+        {
+            m_HistoryDepth.swap(NewDepth);
+            m_HistoryColor     = Image.Pixels;
+            m_HistoryConstants = Constants;
+            m_HistoryValid     = true;
+        }
+        m_LastTemporalReuse = NumPixels > 0 ? static_cast<float>(TotalReused.load()) / static_cast<float>(NumPixels) : 0.0f;
+
+        m_LastStats.Pixels        = static_cast<std::uint64_t>(Image.Width) * Image.Height;
+        m_LastStats.Iterations    = 0;
+        m_LastStats.Skipped       = 0;
+        m_LastStats.DEEvaluations = TotalEvaluations.load();
+        m_LastStats.BrickSamples  = TotalBrickSamples.load();
+        m_LastStats.RefinedPixels = 0;
+        m_LastStats.ExtraSamples  = 0;
+        m_LastStats.Seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+
+        if (m_AAMaxSamples > 0)
+            RefineEdges3D(Setup, Constants, m_Temporal ? m_HistoryDepth : NewDepth, Image);
+    }
+
+    void CPUFractalRenderer::RenderRegion(const CPUShaderConstants& Constants, std::uint32_t X0, std::uint32_t Y0, std::uint32_t Width,
+                                          std::uint32_t Height, CPUImage& Image)
+    {
+        Image.Resize(Width, Height);
+        std::fill(Image.Pixels.begin(), Image.Pixels.end(), 0u);
+
+        if (Constants.CameraPos.w <= 0.5f)
+        {
+            RenderTiles(Constants, X0, Y0, X0 + Width, Y0 + Height, [&](const CPUFractal2DSetup& S, std::uint32_t y, std::uint32_t RowX0, std::uint32_t RowX1, const CPUEscapeSample* Row) {
+                std::uint32_t* pDst = &Image.Pixels[static_cast<size_t>(y - Y0) * Width + (RowX0 - X0)];
+                for (std::uint32_t x = 0; x < RowX1 - RowX0; ++x)
+                    pDst[x] = PackColorRGBA8(ShadeEscapeSample2D(S, Constants, Row[x]));
+            });
+            return;
+        }
+
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        CPUFractal3DSetup Setup = MakeFractal3DSetup(Constants);
+        if (m_pDistanceBricks != nullptr && m_pDistanceBricks->IsCompatible(Constants))
+            Setup.pBricks = m_pDistanceBricks;
+        const std::uint32_t X1 = std::min(X0 + Width, static_cast<std::uint32_t>(std::max(Setup.Width, 0)));
+        const std::uint32_t Y1 = std::min(Y0 + Height, static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+
+        std::atomic<std::uint64_t> TotalEvaluations{0};
+        std::atomic<std::uint64_t> TotalBrickSamples{0};
+        m_ThreadPool.ParallelFor(Y1 > Y0 ? Y1 - Y0 : 0, [&](std::uint32_t Row, std::uint32_t) {
+            std::uint64_t Evaluations = 0, BrickSamples = 0;
+            for (std::uint32_t x = X0; x < X1; ++x)
+            {
+                CPURay3DStats Ray;
+                Image.Pixels[static_cast<size_t>(Row) * Width + (x - X0)] =
+                    PackColorRGBA8(RenderPixel3D(Setup, Constants, static_cast<float>(x), static_cast<float>(Y0 + Row), 0.0f, 0.0f, Ray));
+                Evaluations += Ray.DEEvaluations;
+                BrickSamples += Ray.BrickSamples;
+            }
+            TotalEvaluations.fetch_add(Evaluations, std::memory_order_relaxed);
+            TotalBrickSamples.fetch_add(BrickSamples, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Pixels        = static_cast<std::uint64_t>(X1 > X0 ? X1 - X0 : 0) * (Y1 > Y0 ? Y1 - Y0 : 0);
+        m_LastStats.Iterations    = 0;
+        m_LastStats.Skipped       = 0;
+        m_LastStats.DEEvaluations = TotalEvaluations.load();
+        m_LastStats.BrickSamples  = TotalBrickSamples.load();
+        m_LastStats.RefinedPixels = 0;
+        m_LastStats.ExtraSamples  = 0;
+        m_LastStats.Seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUFractalRenderer::RenderSweep(const std::vector<CPUShaderConstants>& Slices, std::uint32_t Columns, CPUImage& Atlas)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        const std::uint32_t Count  = static_cast<std::uint32_t>(Slices.size());
+        const std::uint32_t ThumbW = Count > 0 ? static_cast<std::uint32_t>(std::max(Slices[0].TimeAndResolution.y, 0.0f)) : 0;
+        const std::uint32_t ThumbH = Count > 0 ? static_cast<std::uint32_t>(std::max(Slices[0].TimeAndResolution.z, 0.0f)) : 0;
+        Columns                    = std::max(std::min(Columns, Count), 1u);
+        Atlas.Resize(Columns * ThumbW, (Count + Columns - 1) / Columns * ThumbH);
+        std::fill(Atlas.Pixels.begin(), Atlas.Pixels.end(), 0u);
+
+        // Preparación de cada miniatura, una vez por barrido; el cache de distancias es de la
+        // escena de la vista, no de las miniaturas
+        std::vector<CPUFractal2DSetup> Setups2D(Count);
+        std::vector<CPUFractal3DSetup> Setups3D(Count);
+        for (std::uint32_t i = 0; i < Count; ++i)
+        {
+            if (Slices[i].CameraPos.w > 0.5f)
+                Setups3D[i] = MakeFractal3DSetup(Slices[i]);
+            else
+                Setups2D[i] = MakeFractal2DSetup(Slices[i]);
+        }
+
+        std::vector<std::vector<CPUEscapeSample>> Rows(GetNumThreads(), std::vector<CPUEscapeSample>(ThumbW));
+        std::atomic<std::uint64_t>                TotalIterations{0};
+        std::atomic<std::uint64_t>                TotalEvaluations{0};
+        m_ThreadPool.ParallelFor(Count * ThumbH, [&](std::uint32_t Job, std::uint32_t ThreadIndex) {
+            const std::uint32_t       Slice = Job / ThumbH;
+            const std::uint32_t       y     = Job % ThumbH;
+            const CPUShaderConstants& C     = Slices[Slice];
+            std::uint32_t*            pDst  = &Atlas.Pixels[static_cast<size_t>(Slice / Columns * ThumbH + y) * Atlas.Width + Slice % Columns * ThumbW];
+
+            if (C.CameraPos.w <= 0.5f)
+            {
+                CPUEscapeSample* Row = Rows[ThreadIndex].data();
+                TotalIterations.fetch_add(EscapeRow2D(Setups2D[Slice], static_cast<int>(y), 0, static_cast<int>(ThumbW), Row), std::memory_order_relaxed);
+                for (std::uint32_t x = 0; x < ThumbW; ++x)
+                    pDst[x] = PackColorRGBA8(ShadeEscapeSample2D(Setups2D[Slice], C, Row[x]));
+                return;
+            }
+
+            std::uint64_t Evaluations = 0;
+            for (std::uint32_t x = 0; x < ThumbW; ++x)
+            {
+                CPURay3DStats Ray;
+                pDst[x] = PackColorRGBA8(RenderPixel3D(Setups3D[Slice], C, static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, Ray));
+                Evaluations += Ray.DEEvaluations;
+            }
+            TotalEvaluations.fetch_add(Evaluations, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Pixels        = static_cast<std::uint64_t>(Count) * ThumbW * ThumbH;
+        m_LastStats.Iterations    = TotalIterations.load();
+        m_LastStats.Skipped       = 0;
+        m_LastStats.DEEvaluations = TotalEvaluations.load();
+        m_LastStats.BrickSamples  = 0;
+        m_LastStats.RefinedPixels = 0;
+        m_LastStats.ExtraSamples  = 0;
+        m_LastStats.Seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUFractalRenderer::RefineEdges3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, const std::vector<float>& Depth, CPUImage& Image)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        std::vector<float> Metric(Depth.size());
+        for (size_t i = 0; i < Depth.size(); ++i)
+            Metric[i] = std::log2(std::max(Depth[i], 1e-6f));
+
+        // Se leen los colores de la primera muestra mientras se escriben los refinados
+        const std::vector<std::uint32_t> FirstColor = Image.Pixels;
+
+        std::atomic<std::uint64_t> TotalEvaluations{0};
+        std::atomic<std::uint64_t> TotalBrickSamples{0};
+        std::atomic<std::uint64_t> TotalRefined{0};
+        std::atomic<std::uint64_t> TotalSamples{0};
+        m_ThreadPool.ParallelFor(Image.Height, [&](std::uint32_t y, std::uint32_t) {
+            std::uint64_t Evaluations = 0, BrickSamples = 0, Refined = 0, NumSamples = 0;
+            for (std::uint32_t x = 0; x < Image.Width; ++x)
+            {
+                const std::uint32_t Count = GetAASampleCount(GetNeighbourhoodStdDev(Metric, Image.Width, Image.Height, x, y), m_AAThreshold, m_AAMaxSamples);
+                if (Count == 0)
+                    continue;
+
+                // Rayos con jitter desde la cámara: ni la tile del cono ni la reproyección son
+                // conservadoras fuera del rayo del píxel
+                const size_t Index = static_cast<size_t>(y) * Image.Width + x;
+                CPUFloat4    Sum   = UnpackColorRGBA8(FirstColor[Index]);
+                for (std::uint32_t k = 0; k < Count; ++k)
+                {
+                    float dx, dy;
+                    GetAAJitter(k, dx, dy);
+                    CPURay3DStats Ray;
+                    AddColor(Sum, RenderPixel3D(Setup, Constants, static_cast<float>(x) + dx, static_cast<float>(y) + dy, 0.0f, 0.0f, Ray));
+                    Evaluations += Ray.DEEvaluations;
+                    BrickSamples += Ray.BrickSamples;
+                }
+                const float Scale   = 1.0f / static_cast<float>(Count + 1);
+                Image.Pixels[Index] = PackColorRGBA8(CPUFloat4{Sum.x * Scale, Sum.y * Scale, Sum.z * Scale, Sum.w * Scale});
+                ++Refined;
+                NumSamples += Count;
+            }
+            TotalEvaluations.fetch_add(Evaluations, std::memory_order_relaxed);
+            TotalBrickSamples.fetch_add(BrickSamples, std::memory_order_relaxed);
+            TotalRefined.fetch_add(Refined, std::memory_order_relaxed);
+            TotalSamples.fetch_add(NumSamples, std::memory_order_relaxed);
+        });
+
+        m_LastStats.DEEvaluations += TotalEvaluations.load();
+        m_LastStats.BrickSamples += TotalBrickSamples.load();
+        m_LastStats.RefinedPixels = TotalRefined.load();
+        m_LastStats.ExtraSamples  = TotalSamples.load();
+        m_LastStats.Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+} // namespace Diligent
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CPUShaderConstants.hpp"
+#include "CPUDistanceBricks.hpp"
+#include "CPUFractalKernels2D.hpp"
+#include "CPUFractalKernels3D.hpp"
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    // Imagen RGBA8 en memoria (fila 0 arriba, mismo orden que OutputTex)
+    struct CPUImage
+    {
+        std::uint32_t              Width  = 0;
+        std::uint32_t              Height = 0;
+        std::vector<std::uint32_t> Pixels; // RGBA8 empaquetado, R en el byte bajo
+
+        void Resize(std::uint32_t NewWidth, std::uint32_t NewHeight)
+        {
+            Width  = NewWidth;
+            Height = NewHeight;
+            Pixels.resize(static_cast<size_t>(Width) * Height);
+        }
+
+        std::uint32_t GetStride() const { return Width * 4; }
+    };
+
+    struct CPURenderStats
+    {
+        std::uint64_t Pixels        = 0;
+        std::uint64_t Iterations    = 0; // iteraciones de escape totales
+        std::uint64_t Skipped       = 0; // píxeles rellenados sin iterar (RenderEscapeSubdivided2D)
+        std::uint64_t DEEvaluations = 0; // evaluaciones de la función de distancia (Render3D)
+        std::uint64_t BrickSamples  = 0; // pasos de Render3D resueltos con el cache de distancias
+        std::uint64_t RefinedPixels = 0; // píxeles con muestras extra del supersampling adaptativo
+        std::uint64_t ExtraSamples  = 0; // muestras extra, en total
+        double        Seconds       = 0;
+
+        double GetMPixelsPerSecond() const { return Seconds > 0 ? Pixels / Seconds * 1e-6 : 0.0; }
+        double GetIterationsPerSecond() const { return Seconds > 0 ? Iterations / Seconds : 0.0; }
+        double GetDEEvaluationsPerRay() const { return Pixels > 0 ? static_cast<double>(DEEvaluations) / Pixels : 0.0; }
+        double GetDEEvaluationsPerSecond() const { return Seconds > 0 ? DEEvaluations / Seconds : 0.0; }
+    };
+
+    // Nombre del conjunto de instrucciones con el que se compiló FractalCPU (AVX2, SSE2 o
+    // Scalar), para los informes de rendimiento
+    const char* GetSimdInstructionSetName();
+
+    // Renderizador por software de los fractales 2D de fractal.psh y 3D de fractalCompute.psh.
+    // Recibe las mismas constantes que los shaders, reparte la imagen en tiles entre
+    // todos los núcleos y vectoriza con SimdPack (AVX2/SSE2) el bucle de escape y, con
+    // SetPacketMarching, la marcha de los rayos 3D.
+    class CPUFractalRenderer
+    {
+    public:
+        // NumThreads = 0 usa todos los núcleos
+        explicit CPUFractalRenderer(std::uint32_t NumThreads = 0);
+
+        void SetTileSize(std::uint32_t TileWidth, std::uint32_t TileHeight);
+
+        // Renderiza el fractal 2D seleccionado en TimeAndResolution.w a una imagen de
+        // TimeAndResolution.y x TimeAndResolution.z píxeles.
+        void Render2D(const CPUShaderConstants& Constants, CPUImage& Image);
+
+        // Solo el bucle de escape (Width * Height muestras, fila 0 arriba), para colorear aparte
+        void RenderEscape2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples);
+
+        // Igual que RenderEscape2D pero solo para el rectángulo [X0, X1) x [Y0, Y1); el resto
+        // de Samples (ya con Width * Height elementos) no se toca
+        void RenderEscapeRegion2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples,
+                                  std::uint32_t X0, std::uint32_t Y0, std::uint32_t X1, std::uint32_t Y1);
+
+        // Relleno por subdivisión (Mariani–Silver): calcula el borde de cada tile de
+        // SubdivMaxTileSize y, si tiene una sola iteración, rellena el interior sin iterarlo;
+        // si no, la parte en cuatro hasta SubdivMinTileSize. Mismo resultado que RenderEscape2D
+        // salvo donde el borde engaña (detalles más finos que la tile que no lo tocan).
+        void RenderEscapeSubdivided2D(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples);
+
+        // Ray marching 3D de fractalCompute.psh (el tipo CPU_FRACTAL_3D de TimeAndResolution.w),
+        // un rayo por píxel. Con la prepasada de cono, antes se marchan conos por tiles de
+        // ConeMaxTileSize a ConeMinTileSize píxeles (cada nivel parte del anterior) y cada rayo
+        // empieza desde la distancia de su tile. Las estadísticas cuentan evaluaciones de
+        // distancia (incluidas las de la prepasada), no iteraciones.
+        //
+        // Con la reproyección temporal se guardan la profundidad y el color del frame anterior.
+        // Si la historia sigue valiendo (IsTemporalHistoryCompatible3D), cada impacto del frame
+        // anterior se proyecta con la cámara nueva y los rayos empiezan desde (1 - TemporalDepthMargin)
+        // veces la menor profundidad que cae en su píxel; el color se mezcla con el anterior
+        // (peso TemporalBlend) donde la profundidad reproyectada coincide.
+        void Render3D(const CPUShaderConstants& Constants, CPUImage& Image);
+        void SetConePrepass(bool Enable) { m_ConePrepass = Enable; }
+        // Marcha por paquetes (RenderPacket3D): los rayos de CPURayPacketWidth píxeles seguidos
+        // de cada fila de tile avanzan juntos en las lanes SIMD. Solo en Render3D
+        void SetPacketMarching(bool Enable) { m_PacketMarching = Enable; }
+        void SetTemporalReprojection(bool Enable, float Blend = 0.0f);
+        void ResetTemporalHistory() { m_HistoryValid = false; }
+        // Fracción de rayos del último Render3D que empezaron desde la profundidad reproyectada
+        float GetLastTemporalReuse() const { return m_LastTemporalReuse; }
+        // Cache de distancias horneado (no se copia; nullptr lo quita). Render3D lo usa si es
+        // de la misma escena (CPUDistanceBrickCache::IsCompatible); si no, marcha con el DE.
+        void SetDistanceBricks(const CPUDistanceBrickCache* pBricks) { m_pDistanceBricks = pBricks; }
+
+        // Rectángulo [X0, X0 + Width) x [Y0, Y0 + Height) de la imagen de TimeAndResolution.y x
+        // TimeAndResolution.z píxeles (2D o 3D según CameraPos.w), en una imagen de Width x Height.
+        // Los píxeles fuera de la imagen completa quedan a 0. Para lienzos mayores que la memoria
+        // (FractalPosterCPU): una muestra por píxel, sin prepasada de cono, historia ni
+        // supersampling, que necesitan la imagen completa.
+        void RenderRegion(const CPUShaderConstants& Constants, std::uint32_t X0, std::uint32_t Y0, std::uint32_t Width, std::uint32_t Height,
+                          CPUImage& Image);
+
+        // Barrido de parámetros (CPUParameterSweep.hpp): una miniatura por elemento de Slices,
+        // todas del tamaño TimeAndResolution.y x TimeAndResolution.z de la primera y cada una
+        // 2D o 3D, en un atlas de Columns miniaturas por fila. Cada miniatura es igual que
+        // RenderRegion de su imagen completa. Las filas de todas las miniaturas se reparten
+        // juntas entre los hilos, así que 256 miniaturas cuestan como un frame de los mismos
+        // píxeles y no como 256 renders pequeños.
+        void RenderSweep(const std::vector<CPUShaderConstants>& Slices, std::uint32_t Columns, CPUImage& Atlas);
+
+        // Supersampling adaptativo de Render2D y Render3D (como fractalAdaptiveAA.psh): tras la
+        // primera muestra, los píxeles cuya vecindad 3x3 tiene una desviación típica mayor que
+        // Threshold (en log2 de 1 + la iteración de escape, o de la profundidad de impacto en 3D)
+        // reciben floor(desviación / Threshold) muestras extra con jitter, hasta MaxSamples, y se
+        // quedan con la media de los colores. MaxSamples = 0 lo desactiva.
+        void SetAdaptiveSupersampling(std::uint32_t MaxSamples, float Threshold = DefaultAAThreshold);
+
+        static constexpr std::uint32_t SubdivMaxTileSize = 64;
+        static constexpr std::uint32_t SubdivMinTileSize = 8;
+
+        static constexpr std::uint32_t ConeMaxTileSize = 8;
+        static constexpr std::uint32_t ConeMinTileSize = 4;
+
+        static constexpr std::uint32_t AAMaxSamplesLimit  = 16;
+        static constexpr float         DefaultAAThreshold = 0.25f;
+
+        static constexpr float TemporalDepthMargin    = 0.02f;
+        static constexpr float TemporalDepthTolerance = 0.02f; // diferencia relativa máxima para reutilizar el color
+
+        const CPURenderStats& GetLastStats() const { return m_LastStats; }
+        CPUThreadPool&        GetThreadPool() { return m_ThreadPool; }
+        std::uint32_t         GetNumThreads() const { return m_ThreadPool.GetNumThreads(); }
+
+    private:
+        // Reparte el rectángulo [X0, X1) x [Y0, Y1) en tiles y llama a ProcessRow(Setup, y, X0, X1, Row)
+        // por cada fila de tile con Row ya calculada; deja las estadísticas en m_LastStats
+        template <typename ProcessRowType>
+        void RenderTiles(const CPUShaderConstants& Constants, std::uint32_t X0, std::uint32_t Y0, std::uint32_t X1, std::uint32_t Y1,
+                         ProcessRowType ProcessRow);
+
+        // Segunda pasada del supersampling adaptativo sobre la imagen ya renderizada; suman a m_LastStats
+        void RefineEdges2D(const CPUShaderConstants& Constants, const std::vector<CPUEscapeSample>& Escape, CPUImage& Image);
+        void RefineEdges3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, const std::vector<float>& Depth, CPUImage& Image);
+
+        CPUThreadPool  m_ThreadPool;
+        std::uint32_t  m_TileWidth      = 32;
+        std::uint32_t  m_TileHeight     = 32;
+        bool           m_ConePrepass    = false;
+        bool           m_PacketMarching = false;
+        CPURenderStats m_LastStats;
+
+        const CPUDistanceBrickCache* m_pDistanceBricks = nullptr;
+
+        std::uint32_t m_AAMaxSamples = 0;
+        float         m_AAThreshold  = DefaultAAThreshold;
+
+        // Historia de Render3D: constantes, profundidad de impacto (MaxDist si no hay) y color
+        bool                       m_Temporal      = false;
+        float                      m_TemporalBlend = 0.0f;
+        bool                       m_HistoryValid  = false;
+        CPUShaderConstants         m_HistoryConstants;
+        std::vector<float>         m_HistoryDepth;
+        std::vector<std::uint32_t> m_HistoryColor;
+        float                      m_LastTemporalReuse = 0.0f;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,98 @@
+#include "CPUIterationBudget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Diligent
+{
+
+    std::uint32_t GetEscapeHistogramBin(float Iter)
+    {
+        const float Bin = 4.0f * std::log2(1.0f + std::max(Iter, 0.0f));
+        return std::min(static_cast<std::uint32_t>(Bin), CPUEscapeHistogramBins - 1);
+    }
+
+    float GetEscapeHistogramBinEnd(std::uint32_t Bin)
+    {
+        return std::exp2(static_cast<float>(Bin + 1) * 0.25f) - 1.0f;
+    }
+
+    float CPUEscapeStats::GetEscapeQuantile(std::uint64_t Tail) const
+    {
+        std::uint64_t Above = 0;
+        for (std::uint32_t Bin = CPUEscapeHistogramBins; Bin-- > 0;)
+        {
+            Above += Bins[Bin];
+            if (Above > Tail)
+                return GetEscapeHistogramBinEnd(Bin);
+        }
+        return 0.0f;
+    }
+
+    void AccumulateEscapeStats(CPUThreadPool& Pool, const CPUEscapeSample* pSamples, std::uint32_t Width, std::uint32_t Height, int MaxIter,
+                               CPUEscapeStats& Stats)
+    {
+        Stats         = CPUEscapeStats{};
+        Stats.Pixels  = static_cast<std::uint64_t>(Width) * Height;
+        Stats.MaxIter = MaxIter;
+
+        const float Cap  = static_cast<float>(MaxIter);
+        const float Late = Cap * 0.5f;
+        auto IsLate = [&](std::uint32_t x, std::uint32_t y) {
+            const float Iter = pSamples[static_cast<size_t>(y) * Width + x].Iter;
+            return Iter < Cap && Iter >= Late;
+        };
+
+        std::vector<CPUEscapeStats> PerThread(Pool.GetNumThreads());
+        Pool.ParallelFor(Height, [&](std::uint32_t y, std::uint32_t ThreadIndex) {
+            CPUEscapeStats& Local = PerThread[ThreadIndex];
+            for (std::uint32_t x = 0; x < Width; ++x)
+            {
+                const float Iter = pSamples[static_cast<size_t>(y) * Width + x].Iter;
+                if (Iter < Cap)
+                {
+                    ++Local.Escaped;
+                    ++Local.Bins[GetEscapeHistogramBin(Iter)];
+                    continue;
+                }
+                ++Local.Capped;
+                if ((x > 0 && IsLate(x - 1, y)) || (x + 1 < Width && IsLate(x + 1, y)) || (y > 0 && IsLate(x, y - 1)) ||
+                    (y + 1 < Height && IsLate(x, y + 1)))
+                    ++Local.Unresolved;
+            }
+        });
+
+        for (const CPUEscapeStats& Local : PerThread)
+        {
+            for (std::uint32_t Bin = 0; Bin < CPUEscapeHistogramBins; ++Bin)
+                Stats.Bins[Bin] += Local.Bins[Bin];
+            Stats.Escaped += Local.Escaped;
+            Stats.Capped += Local.Capped;
+            Stats.Unresolved += Local.Unresolved;
+        }
+    }
+
+    int ChooseIterationBudget(const CPUEscapeStats& Stats, const CPUIterationBudgetSettings& Settings)
+    {
+        const int Current = std::min(std::max(Stats.MaxIter, Settings.MinIter), Settings.MaxIter);
+        if (Stats.Pixels == 0)
+            return Current;
+
+        const double Allowed = static_cast<double>(Settings.UnresolvedFraction) * static_cast<double>(Stats.Pixels);
+        int          Next    = Current;
+        // Sin ningún escape no hay borde con el que medir: o es interior o el tope no llega a nada
+        if (static_cast<double>(Stats.Unresolved) > Allowed || Stats.Escaped == 0)
+        {
+            Next = Current * 2;
+        }
+        else
+        {
+            const float Target = 2.0f * Stats.GetEscapeQuantile(static_cast<std::uint64_t>(Allowed * 0.25));
+            if (Target <= 0.75f * static_cast<float>(Current))
+                Next = std::max(static_cast<int>(std::ceil(Target)), Current / 2);
+        }
+        return std::min(std::max(Next, Settings.MinIter), Settings.MaxIter);
+    }
+
+} // namespace Diligent
@@ -0,0 +1,63 @@
+#pragma once
+
+// Presupuesto automático de iteraciones para los fractales 2D. Cada frame deja un histograma
+// de las iteraciones de escape (CPUEscapeStats: AccumulateEscapeStats en CPU, reducción de
+// fractalIterStats.psh en la GPU) y ChooseIterationBudget elige con él el maxiter del siguiente:
+// el más bajo que mantiene los píxeles de borde sin resolver por debajo de un umbral.
+//
+// Un píxel que llegó al tope es "de borde sin resolver" si algún vecino (4-vecindad) escapó
+// en la mitad alta del presupuesto: el tiempo de escape aún crecía al cortarlo. Los píxeles
+// del interior junto a vecinos que escapan pronto no cuentan, así que el interior del
+// conjunto no empuja el presupuesto hacia arriba.
+
+#include <cstdint>
+
+#include "CPUFractalKernels2D.hpp"
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    // Cubetas logarítmicas: 4 por octava de (1 + iteraciones), hasta 2^16
+    static constexpr std::uint32_t CPUEscapeHistogramBins = 64;
+
+    // Misma cuenta que GetEscapeBin en fractalIterStats.psh
+    std::uint32_t GetEscapeHistogramBin(float Iter);
+    // Iteraciones en el límite superior de la cubeta Bin
+    float GetEscapeHistogramBinEnd(std::uint32_t Bin);
+
+    struct CPUEscapeStats
+    {
+        std::uint32_t Bins[CPUEscapeHistogramBins] = {}; // píxeles que escaparon, por cubeta
+        std::uint64_t Pixels     = 0;
+        std::uint64_t Escaped    = 0;
+        std::uint64_t Capped     = 0; // llegaron al tope
+        std::uint64_t Unresolved = 0; // de los que llegaron al tope, de borde sin resolver
+        int           MaxIter    = 0; // tope del frame medido
+
+        // Menor número de iteraciones por debajo del que escapa todo salvo Tail píxeles
+        // (límite superior de su cubeta)
+        float GetEscapeQuantile(std::uint64_t Tail) const;
+    };
+
+    // Estadísticas de un buffer de escape de Width x Height con tope MaxIter, repartidas por
+    // filas entre los hilos de Pool (histogramas por hilo que luego se suman)
+    void AccumulateEscapeStats(CPUThreadPool& Pool, const CPUEscapeSample* pSamples, std::uint32_t Width, std::uint32_t Height, int MaxIter,
+                               CPUEscapeStats& Stats);
+
+    struct CPUIterationBudgetSettings
+    {
+        int   MinIter            = 32;
+        int   MaxIter            = 10000;
+        float UnresolvedFraction = 0.001f; // fracción de píxeles de borde sin resolver tolerada
+    };
+
+    // maxiter para el siguiente frame a partir de las estadísticas de uno con Stats.MaxIter:
+    //  - con más píxeles sin resolver que UnresolvedFraction, o si no escapó ninguno, se dobla;
+    //  - si no, baja al doble del cuantil de escape que deja fuera una cuarta parte de ese
+    //    umbral: cada píxel que escape en la mitad alta tiene como mucho 4 vecinos en el tope,
+    //    así que el frame siguiente no vuelve a pasarse. Solo baja si eso lo reduce al menos un
+    //    25%, y como mucho a la mitad por frame.
+    int ChooseIterationBudget(const CPUEscapeStats& Stats, const CPUIterationBudgetSettings& Settings);
+
+} // namespace Diligent
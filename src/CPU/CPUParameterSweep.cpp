@@ -0,0 +1,86 @@
+#include "CPUParameterSweep.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Diligent
+{
+
+    namespace
+    {
+        // Valor i de Count repartidos en [Min, Max], extremos incluidos
+        float SweepLerp(float Min, float Max, std::uint32_t i, std::uint32_t Count)
+        {
+            return Count > 1 ? Min + (Max - Min) * static_cast<float>(i) / static_cast<float>(Count - 1) : Min;
+        }
+
+        constexpr float HalfPi = 1.57079632679f;
+    } // namespace
+
+    std::uint32_t GetSweepCount(const CPUSweepSettings& Settings)
+    {
+        return Settings.Columns * Settings.Rows;
+    }
+
+    void GetSweepValue(const CPUSweepSettings& Settings, std::uint32_t Index, float& X, float& Y)
+    {
+        if (Settings.Parameter == CPU_SWEEP_JULIA_C)
+        {
+            X = SweepLerp(Settings.MinX, Settings.MaxX, Index % std::max(Settings.Columns, 1u), Settings.Columns);
+            Y = SweepLerp(Settings.MaxY, Settings.MinY, Index / std::max(Settings.Columns, 1u), Settings.Rows); // y crece hacia arriba
+            return;
+        }
+        X = SweepLerp(Settings.MinX, Settings.MaxX, Index, GetSweepCount(Settings));
+        Y = 0.0f;
+    }
+
+    void MakeParameterSweep(const CPUShaderConstants& Base, const CPUSweepSettings& Settings, std::vector<CPUShaderConstants>& Slices)
+    {
+        const std::uint32_t Count = GetSweepCount(Settings);
+        Slices.assign(Count, Base);
+        for (std::uint32_t i = 0; i < Count; ++i)
+        {
+            CPUShaderConstants& C = Slices[i];
+            C.TimeAndResolution.y = static_cast<float>(Settings.ThumbWidth);
+            C.TimeAndResolution.z = static_cast<float>(Settings.ThumbHeight);
+
+            float X, Y;
+            GetSweepValue(Settings, i, X, Y);
+            switch (Settings.Parameter)
+            {
+                case CPU_SWEEP_JULIA_C:
+                {
+                    // c = c0 + (z sin t, w cos t) con t = pi / 4 (el seno en float, como el kernel)
+                    const float t         = HalfPi * 0.5f;
+                    C.TimeAndResolution.x = t;
+                    C.TimeAndResolution.w = static_cast<float>(CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS);
+                    C.CameraPos.w         = 0.0f;
+                    C.AnimationParams     = {1.0f, C.AnimationParams.y, X / std::sin(t), Y / std::cos(t)};
+                    break;
+                }
+
+                case CPU_SWEEP_BULB_POWER:
+                    C.TimeAndResolution.w = static_cast<float>(CPU_FRACTAL_3D_MANDELBULB);
+                    C.CameraPos.w         = 1.0f;
+                    C.Options3D.w         = X;
+                    break;
+
+                case CPU_SWEEP_BURNING_SHIP_DEFORM:
+                {
+                    // c.x = c0.x + z sin t con t = pi / 2; el desplazamiento en y se anula
+                    const int Type        = static_cast<int>(Base.TimeAndResolution.w);
+                    const bool IsShip     = Base.CameraPos.w <= 0.5f && (Type == CPU_FRACTAL_2D_BURNING_SHIP || Type == CPU_FRACTAL_2D_BURNING_SHIP_COLORS);
+                    C.TimeAndResolution.x = HalfPi;
+                    C.TimeAndResolution.w = static_cast<float>(IsShip ? Type : static_cast<int>(CPU_FRACTAL_2D_BURNING_SHIP_COLORS));
+                    C.CameraPos.w         = 0.0f;
+                    C.AnimationParams     = {1.0f, C.AnimationParams.y, X, 0.0f};
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+    }
+
+} // namespace Diligent
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CPUShaderConstants.hpp"
+
+namespace Diligent
+{
+
+    // Parámetro que recorre un barrido de miniaturas (CPUFractalRenderer::RenderSweep en CPU,
+    // fractalSweep.psh en la GPU). Cada uno fija su tipo de fractal.
+    enum CPU_SWEEP_PARAMETER : int
+    {
+        CPU_SWEEP_JULIA_C = 0,         // desplazamiento de c del Julia: x por columnas, y por filas
+        CPU_SWEEP_BULB_POWER,          // potencia fija del Mandelbulb (Options3D.w)
+        CPU_SWEEP_BURNING_SHIP_DEFORM, // deformación del Burning Ship (AnimationParams.z)
+        CPU_SWEEP_PARAMETER_COUNT
+    };
+
+    struct CPUSweepSettings
+    {
+        CPU_SWEEP_PARAMETER Parameter   = CPU_SWEEP_JULIA_C;
+        std::uint32_t       Columns     = 16;
+        std::uint32_t       Rows        = 16;
+        std::uint32_t       ThumbWidth  = 64;
+        std::uint32_t       ThumbHeight = 48;
+
+        // Rango del parámetro, extremos incluidos: en el Julia x va por columnas e y por filas;
+        // en el resto solo se usa x, en el orden de las miniaturas (por filas)
+        float MinX = -0.25f, MaxX = 0.25f;
+        float MinY = -0.25f, MaxY = 0.25f;
+    };
+
+    std::uint32_t GetSweepCount(const CPUSweepSettings& Settings);
+
+    // Valor del parámetro en la miniatura Index (Y solo en el Julia)
+    void GetSweepValue(const CPUSweepSettings& Settings, std::uint32_t Index, float& X, float& Y);
+
+    // Constantes de cada miniatura, por filas: las de Base con la resolución de la miniatura, el
+    // tipo de fractal del parámetro y su valor. En el Julia y el Burning Ship el tiempo queda
+    // fijo en el ángulo en que AnimationParams.zw es directamente el desplazamiento de c, así
+    // que las miniaturas no dependen de la animación de la vista.
+    void MakeParameterSweep(const CPUShaderConstants& Base, const CPUSweepSettings& Settings, std::vector<CPUShaderConstants>& Slices);
+
+} // namespace Diligent
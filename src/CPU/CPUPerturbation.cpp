@@ -0,0 +1,535 @@
+#include "CPUPerturbation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace Diligent
+{
+
+    namespace
+    {
+        // |c + d| - |c| sin cancelación catastrófica (perturbación del Burning Ship)
+        inline double DiffAbs(double c, double d)
+        {
+            const double cd = c + d;
+            if (c >= 0.0)
+                return cd >= 0.0 ? d : -(2.0 * c + d);
+            else
+                return cd > 0.0 ? 2.0 * c + d : -d;
+        }
+
+        inline double Mag2(double x, double y)
+        {
+            return x * x + y * y;
+        }
+
+        // DiffAbs en float, la del pixel shader
+        inline float DiffAbsF(float c, float d)
+        {
+            const float cd = c + d;
+            if (c >= 0.0f)
+                return cd >= 0.0f ? d : -(2.0f * c + d);
+            else
+                return cd > 0.0f ? 2.0f * c + d : -d;
+        }
+
+        // DiffAbs con δ = 2^e w despreciable frente a c (δ < 2^ScaledDeltaMaxExponent): el
+        // signo de c decide, salvo con c = 0
+        inline float ScaledDiffAbs(float c, float w)
+        {
+            return c > 0.0f ? w : c < 0.0f ? -w : std::fabs(w);
+        }
+
+        // w = w / 2^k y e += k, con |w| en [0.5, 1) (exacto: potencia de dos). Con w = 0 no
+        // se toca, como NormalizeScaledDelta de fractal2D.fxh
+        inline void NormalizeScaledDelta(float& wx, float& wy, int& e)
+        {
+            const float M = std::max(std::fabs(wx), std::fabs(wy));
+            if (M > 0.0f)
+            {
+                int k = 0;
+                std::frexp(M, &k);
+                wx = std::ldexp(wx, -k);
+                wy = std::ldexp(wy, -k);
+                e += k;
+            }
+        }
+
+        struct FloatDeltaContext
+        {
+            const float*         RefX;
+            const float*         RefY;
+            int                  LastIndex;
+            int                  MaxIter;
+            float                Bailout2;
+            float                InvZoom; // PerturbParams.w
+            bool                 Burning;
+            int                  SkipIter;
+            CPUScaledDeltaParams Params;
+        };
+
+        // EscapePerturbation2D de fractal2D.fxh: la misma secuencia de operaciones en float
+        CPUEscapeSample EscapeFloatDeltas(const FloatDeltaContext& C, float uvx, float uvy, std::uint64_t& Iterations, std::uint64_t& Rebases)
+        {
+            const CPUScaledDeltaParams& P = C.Params;
+
+            float wx = 0, wy = 0;
+            int   e = P.InvZoomExponent;
+            int   n = 0, m = 0;
+            if (C.SkipIter > 0)
+            {
+                // w = A'u + B'u^2 + C'u^3 con los coeficientes ya divididos por 2^SeriesExponent
+                const float ux  = uvx * P.UScale;
+                const float uy  = uvy * P.UScale;
+                const float u2x = ux * ux - uy * uy;
+                const float u2y = ux * uy + uy * ux;
+                const float u3x = u2x * ux - u2y * uy;
+                const float u3y = u2x * uy + u2y * ux;
+
+                wx = (P.SeriesAx * ux - P.SeriesAy * uy) + (P.SeriesBx * u2x - P.SeriesBy * u2y) + (P.SeriesCx * u3x - P.SeriesCy * u3y);
+                wy = (P.SeriesAx * uy + P.SeriesAy * ux) + (P.SeriesBx * u2y + P.SeriesBy * u2x) + (P.SeriesCx * u3y + P.SeriesCy * u3x);
+                e  = P.SeriesExponent;
+                n = m = C.SkipIter;
+            }
+            NormalizeScaledDelta(wx, wy, e);
+
+            const int MaxN    = C.MaxIter + 1;
+            bool      Escaped = false;
+            float     r2      = 0;
+            float     dx      = std::ldexp(wx, e);
+            float     dy      = std::ldexp(wy, e);
+
+            // Fase escalada: δ por debajo de lo que float representa con precisión
+            bool Scaled = e < CPUScaledDeltaParams::ScaledDeltaMaxExponent;
+            while (Scaled && n < MaxN)
+            {
+                // El rebase al acabarse la referencia lo hace la iteración normal
+                if (m == C.LastIndex)
+                    break;
+
+                const float S   = std::ldexp(1.0f, e);
+                const float dcx = std::ldexp(uvx * P.InvZoomMantissa, P.InvZoomExponent - e);
+                const float dcy = std::ldexp(uvy * P.InvZoomMantissa, P.InvZoomExponent - e);
+                const float Zx  = C.RefX[m];
+                const float Zy  = C.RefY[m];
+                float       nx, ny;
+                if (C.Burning)
+                {
+                    const float a  = ScaledDiffAbs(Zx, wx);
+                    const float b  = ScaledDiffAbs(Zy, wy);
+                    const float AX = std::fabs(Zx);
+                    const float BY = std::fabs(Zy);
+                    nx             = (2.0f * AX + S * a) * a - (2.0f * BY + S * b) * b + dcx;
+                    ny             = 2.0f * (AX * b + a * BY + S * a * b) + dcy;
+                }
+                else
+                {
+                    const float tx = 2.0f * Zx + S * wx;
+                    const float ty = 2.0f * Zy + S * wy;
+                    nx             = tx * wx - ty * wy + dcx;
+                    ny             = tx * wy + ty * wx + dcy;
+                }
+                wx = nx;
+                wy = ny;
+                NormalizeScaledDelta(wx, wy, e);
+                ++m;
+                ++n;
+                ++Iterations;
+
+                dx             = std::ldexp(wx, e);
+                dy             = std::ldexp(wy, e);
+                const float zx = C.RefX[m] + dx;
+                const float zy = C.RefY[m] + dy;
+                r2             = zx * zx + zy * zy;
+                if (r2 > C.Bailout2)
+                {
+                    Escaped = true;
+                    break;
+                }
+                if (r2 < dx * dx + dy * dy)
+                {
+                    dx = zx;
+                    dy = zy;
+                    m  = 0;
+                    ++Rebases;
+                    break;
+                }
+                Scaled = e < CPUScaledDeltaParams::ScaledDeltaMaxExponent;
+            }
+
+            // Iteración normal en float, con δc = uv / zoom
+            const float dcx = uvx * C.InvZoom;
+            const float dcy = uvy * C.InvZoom;
+            while (!Escaped && n < MaxN)
+            {
+                if (m == C.LastIndex)
+                {
+                    dx += C.RefX[m];
+                    dy += C.RefY[m];
+                    m = 0;
+                    ++Rebases;
+                }
+
+                const float Zx = C.RefX[m];
+                const float Zy = C.RefY[m];
+                float       nx, ny;
+                if (C.Burning)
+                {
+                    const float a  = DiffAbsF(Zx, dx);
+                    const float b  = DiffAbsF(Zy, dy);
+                    const float AX = std::fabs(Zx);
+                    const float BY = std::fabs(Zy);
+                    nx             = (2.0f * AX + a) * a - (2.0f * BY + b) * b + dcx;
+                    ny             = 2.0f * (AX * b + a * BY + a * b) + dcy;
+                }
+                else
+                {
+                    const float tx = 2.0f * Zx + dx;
+                    const float ty = 2.0f * Zy + dy;
+                    nx             = tx * dx - ty * dy + dcx;
+                    ny             = tx * dy + ty * dx + dcy;
+                }
+                dx = nx;
+                dy = ny;
+                ++m;
+                ++n;
+                ++Iterations;
+
+                const float zx = C.RefX[m] + dx;
+                const float zy = C.RefY[m] + dy;
+                r2             = zx * zx + zy * zy;
+                if (r2 > C.Bailout2)
+                {
+                    Escaped = true;
+                    break;
+                }
+                if (r2 < dx * dx + dy * dy)
+                {
+                    dx = zx;
+                    dy = zy;
+                    m  = 0;
+                    ++Rebases;
+                }
+            }
+
+            CPUEscapeSample Sample;
+            Sample.Iter = Escaped ? static_cast<float>(std::max(n - 2, 0)) : static_cast<float>(C.MaxIter);
+            Sample.Mag  = std::sqrt(r2);
+            return Sample;
+        }
+    } // namespace
+
+    void CPUReferenceOrbit::Compute(const BigFloat& Cx, const BigFloat& Cy, int MaxIter, double Bailout2, CPU_ESCAPE_FORMULA Formula)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        m_Cx       = Cx;
+        m_Cy       = Cy;
+        m_MaxIter  = MaxIter;
+        m_Bailout2 = Bailout2;
+        m_Formula  = Formula;
+
+        const unsigned NumLimbs = std::max(Cx.GetNumLimbs(), Cy.GetNumLimbs());
+
+        m_X.clear();
+        m_Y.clear();
+        m_X.reserve(static_cast<size_t>(MaxIter) + 2);
+        m_Y.reserve(static_cast<size_t>(MaxIter) + 2);
+        m_X.push_back(0.0);
+        m_Y.push_back(0.0);
+
+        BigFloat X{NumLimbs}, Y{NumLimbs};
+        for (int n = 1; n <= MaxIter + 1; ++n)
+        {
+            if (Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP)
+            {
+                X = X.Abs();
+                Y = Y.Abs();
+            }
+            const BigFloat XX = X * X;
+            const BigFloat YY = Y * Y;
+            const BigFloat XY = X * Y;
+            X                 = XX - YY + Cx;
+            Y                 = XY.Twice() + Cy;
+
+            const double Xd = X.ToDouble();
+            const double Yd = Y.ToDouble();
+            if (Mag2(Xd, Yd) > Bailout2)
+                break;
+            m_X.push_back(Xd);
+            m_Y.push_back(Yd);
+        }
+
+        m_ComputeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    bool CPUReferenceOrbit::Matches(const BigFloat& Cx, const BigFloat& Cy, int MaxIter, double Bailout2, CPU_ESCAPE_FORMULA Formula) const
+    {
+        return !m_X.empty() && m_MaxIter == MaxIter && m_Bailout2 == Bailout2 && m_Formula == Formula &&
+            Cx.GetNumLimbs() <= m_Cx.GetNumLimbs() && Cy.GetNumLimbs() <= m_Cy.GetNumLimbs() &&
+            m_Cx == Cx && m_Cy == Cy;
+    }
+
+    void CPUSeriesApproximation::Compute(const CPUReferenceOrbit& Orbit, double DeltaMax, int MaxIter)
+    {
+        const double* X = Orbit.GetX();
+        const double* Y = Orbit.GetY();
+
+        SkipIter = 0;
+        Scale    = DeltaMax;
+        Ax = Ay = Bx = By = Cx = Cy = 0;
+
+        // El término omitido (D u^4) tiene que quedar por debajo del redondeo de double
+        // respecto al término lineal (A u): cerca del borde la órbita es caótica y
+        // cualquier error mayor acaba cambiando la iteración de escape.
+        const double Tolerance = 1e-16;
+
+        // n = 1: δ_1 = δc
+        double ax = DeltaMax, ay = 0, bx = 0, by = 0, cx = 0, cy = 0, dx = 0, dy = 0;
+        const int LastN = std::min(Orbit.GetLastIndex() - 1, MaxIter);
+        for (int n = 1; n < LastN; ++n)
+        {
+            const double zx = 2.0 * X[n];
+            const double zy = 2.0 * Y[n];
+
+            const double nax = zx * ax - zy * ay + DeltaMax;
+            const double nay = zx * ay + zy * ax;
+            const double nbx = zx * bx - zy * by + (ax * ax - ay * ay);
+            const double nby = zx * by + zy * bx + 2.0 * ax * ay;
+            const double ncx = zx * cx - zy * cy + 2.0 * (ax * bx - ay * by);
+            const double ncy = zx * cy + zy * cx + 2.0 * (ax * by + ay * bx);
+            const double ndx = zx * dx - zy * dy + 2.0 * (ax * cx - ay * cy) + (bx * bx - by * by);
+            const double ndy = zx * dy + zy * dx + 2.0 * (ax * cy + ay * cx) + 2.0 * bx * by;
+
+            const double ErrorEstimate = std::sqrt(Mag2(ndx, ndy));
+            if (!std::isfinite(ErrorEstimate) || !std::isfinite(ncx + ncy) ||
+                ErrorEstimate > Tolerance * std::sqrt(Mag2(nax, nay)))
+                break;
+
+            ax = nax, ay = nay, bx = nbx, by = nby, cx = ncx, cy = ncy, dx = ndx, dy = ndy;
+            SkipIter = n + 1;
+            Ax = ax, Ay = ay, Bx = bx, By = by, Cx = cx, Cy = cy;
+        }
+    }
+
+    CPUScaledDeltaParams CPUScaledDeltaParams::Make(const CPUSeriesApproximation& Series, double Zoom)
+    {
+        CPUScaledDeltaParams P;
+        P.InvZoomMantissa = static_cast<float>(std::frexp(1.0 / Zoom, &P.InvZoomExponent));
+        P.SeriesExponent  = P.InvZoomExponent;
+        if (Series.SkipIter > 0)
+        {
+            // A' ~ δ en SkipIter: con w = δ / 2^SeriesExponent los tres coeficientes caben en
+            // float (B' y C' pueden quedarse en 0, que frente a A' no cuenta)
+            const double MaxA = std::max(std::fabs(Series.Ax), std::fabs(Series.Ay));
+            if (MaxA > 0.0)
+                std::frexp(MaxA, &P.SeriesExponent);
+
+            const int e = P.SeriesExponent;
+            P.SeriesAx  = static_cast<float>(std::ldexp(Series.Ax, -e));
+            P.SeriesAy  = static_cast<float>(std::ldexp(Series.Ay, -e));
+            P.SeriesBx  = static_cast<float>(std::ldexp(Series.Bx, -e));
+            P.SeriesBy  = static_cast<float>(std::ldexp(Series.By, -e));
+            P.SeriesCx  = static_cast<float>(std::ldexp(Series.Cx, -e));
+            P.SeriesCy  = static_cast<float>(std::ldexp(Series.Cy, -e));
+            P.UScale    = static_cast<float>(1.0 / (Zoom * Series.Scale));
+        }
+        return P;
+    }
+
+    bool CPUPerturbationRenderer::SupportsFractalType(int FractalType)
+    {
+        return FractalType == CPU_FRACTAL_2D_MANDELBROT || FractalType == CPU_FRACTAL_2D_MANDELBROT_COLORS ||
+            FractalType == CPU_FRACTAL_2D_BURNING_SHIP || FractalType == CPU_FRACTAL_2D_BURNING_SHIP_COLORS;
+    }
+
+    bool CPUPerturbationRenderer::Prepare(const CPUDeepZoomView& View, const CPUShaderConstants& Constants)
+    {
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(Constants);
+
+        const bool Recompute = !m_Orbit.Matches(View.CenterX, View.CenterY, Setup.MaxIter, Setup.Bailout2, Setup.Formula);
+        if (Recompute)
+            m_Orbit.Compute(View.CenterX, View.CenterY, Setup.MaxIter, Setup.Bailout2, Setup.Formula);
+
+        const double DeltaMax = std::sqrt(Setup.AspectD * Setup.AspectD + 1.0) / View.Zoom;
+        if (Setup.Formula == CPU_ESCAPE_FORMULA_MANDELBROT)
+            m_Series.Compute(m_Orbit, DeltaMax, Setup.MaxIter);
+        else
+            m_Series = CPUSeriesApproximation{};
+
+        return Recompute;
+    }
+
+    void CPUPerturbationRenderer::RenderEscape(const CPUDeepZoomView& View, const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples)
+    {
+        const auto StartTime = std::chrono::steady_clock::now();
+
+        Prepare(View, Constants);
+
+        const CPUFractal2DSetup Setup  = MakeFractal2DSetup(Constants);
+        const std::uint32_t     Width  = static_cast<std::uint32_t>(std::max(Setup.Width, 0));
+        const std::uint32_t     Height = static_cast<std::uint32_t>(std::max(Setup.Height, 0));
+        Samples.resize(static_cast<size_t>(Width) * Height);
+
+        const double* RefX      = m_Orbit.GetX();
+        const double* RefY      = m_Orbit.GetY();
+        const int     LastIndex = m_Orbit.GetLastIndex();
+        const int     MaxN      = Setup.MaxIter + 1;
+        const bool    Burning   = Setup.Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP;
+        const auto&   SA        = m_Series;
+
+        FloatDeltaContext FloatCtx = {};
+        if (m_FloatDeltas)
+        {
+            // La referencia y los parámetros como los recibe el pixel shader
+            m_OrbitXF.assign(RefX, RefX + LastIndex + 1);
+            m_OrbitYF.assign(RefY, RefY + LastIndex + 1);
+            FloatCtx.RefX      = m_OrbitXF.data();
+            FloatCtx.RefY      = m_OrbitYF.data();
+            FloatCtx.LastIndex = LastIndex;
+            FloatCtx.MaxIter   = Setup.MaxIter;
+            FloatCtx.Bailout2  = static_cast<float>(Setup.Bailout2);
+            FloatCtx.InvZoom   = static_cast<float>(1.0 / View.Zoom);
+            FloatCtx.Burning   = Burning;
+            FloatCtx.SkipIter  = SA.SkipIter;
+            FloatCtx.Params    = CPUScaledDeltaParams::Make(SA, View.Zoom);
+        }
+
+        std::atomic<std::uint64_t> TotalIterations{0};
+        std::atomic<std::uint64_t> TotalRebases{0};
+
+        m_ThreadPool.ParallelFor(Height, [&](std::uint32_t y, std::uint32_t) {
+            std::uint64_t Iterations = 0;
+            std::uint64_t Rebases    = 0;
+
+            // Mismo mapeo píxel -> plano que los kernels double, sin el offset
+            const double uvy = (static_cast<double>(y) + 0.5) / Setup.Height * 2.0 - 1.0;
+            const double dcy = uvy / View.Zoom;
+
+            CPUEscapeSample* pDst = &Samples[static_cast<size_t>(y) * Width];
+            for (std::uint32_t x = 0; x < Width; ++x)
+            {
+                if (m_FloatDeltas)
+                {
+                    // uv como en el pixel shader: UV interpolado en float
+                    const float AspectF = static_cast<float>(Setup.Width) / static_cast<float>(Setup.Height);
+                    const float uvxF    = ((static_cast<float>(x) + 0.5f) / static_cast<float>(Setup.Width) * 2.0f - 1.0f) * AspectF;
+                    const float uvyF    = (static_cast<float>(y) + 0.5f) / static_cast<float>(Setup.Height) * 2.0f - 1.0f;
+                    pDst[x]             = EscapeFloatDeltas(FloatCtx, uvxF, uvyF, Iterations, Rebases);
+                    continue;
+                }
+
+                const double uvx = ((static_cast<double>(x) + 0.5) / Setup.Width * 2.0 - 1.0) * Setup.AspectD;
+                const double dcx = uvx / View.Zoom;
+
+                double dx = 0, dy = 0;
+                int    n = 0, m = 0;
+                if (SA.SkipIter > 0)
+                {
+                    // δ = A'u + B'u^2 + C'u^3
+                    const double ux  = dcx / SA.Scale;
+                    const double uy  = dcy / SA.Scale;
+                    const double u2x = ux * ux - uy * uy;
+                    const double u2y = 2.0 * ux * uy;
+                    const double u3x = u2x * ux - u2y * uy;
+                    const double u3y = u2x * uy + u2y * ux;
+
+                    dx = SA.Ax * ux - SA.Ay * uy + SA.Bx * u2x - SA.By * u2y + SA.Cx * u3x - SA.Cy * u3y;
+                    dy = SA.Ax * uy + SA.Ay * ux + SA.Bx * u2y + SA.By * u2x + SA.Cx * u3y + SA.Cy * u3x;
+                    n = m = SA.SkipIter;
+                }
+
+                bool   Escaped = false;
+                double r2      = 0;
+                while (n < MaxN)
+                {
+                    if (m == LastIndex)
+                    {
+                        // La referencia se acabó (escapó): rebase a Z_0 = 0
+                        dx += RefX[m];
+                        dy += RefY[m];
+                        m = 0;
+                        ++Rebases;
+                    }
+
+                    const double Zx = RefX[m];
+                    const double Zy = RefY[m];
+                    double       nx, ny;
+                    if (Burning)
+                    {
+                        const double a  = DiffAbs(Zx, dx);
+                        const double b  = DiffAbs(Zy, dy);
+                        const double AX = std::fabs(Zx);
+                        const double BY = std::fabs(Zy);
+                        nx              = (2.0 * AX + a) * a - (2.0 * BY + b) * b + dcx;
+                        ny              = 2.0 * (AX * b + a * BY + a * b) + dcy;
+                    }
+                    else
+                    {
+                        const double tx = 2.0 * Zx + dx;
+                        const double ty = 2.0 * Zy + dy;
+                        nx              = tx * dx - ty * dy + dcx;
+                        ny              = tx * dy + ty * dx + dcy;
+                    }
+                    dx = nx;
+                    dy = ny;
+                    ++m;
+                    ++n;
+                    ++Iterations;
+
+                    const double zx = RefX[m] + dx;
+                    const double zy = RefY[m] + dy;
+                    r2              = Mag2(zx, zy);
+                    if (r2 > Setup.Bailout2)
+                    {
+                        Escaped = true;
+                        break;
+                    }
+                    if (r2 < Mag2(dx, dy))
+                    {
+                        dx = zx;
+                        dy = zy;
+                        m  = 0;
+                        ++Rebases;
+                    }
+                }
+
+                // El HLSL empieza con z = c (n = 1) y cuenta i desde z_2
+                pDst[x].Iter = Escaped ? static_cast<float>(std::max(n - 2, 0)) : static_cast<float>(Setup.MaxIter);
+                pDst[x].Mag  = static_cast<float>(std::sqrt(r2));
+            }
+
+            TotalIterations.fetch_add(Iterations, std::memory_order_relaxed);
+            TotalRebases.fetch_add(Rebases, std::memory_order_relaxed);
+        });
+
+        m_LastStats.Pixels            = static_cast<std::uint64_t>(Width) * Height;
+        m_LastStats.Iterations        = TotalIterations.load();
+        m_LastStats.SkippedIterations = m_LastStats.Pixels * static_cast<std::uint64_t>(SA.SkipIter);
+        m_LastStats.Rebases           = TotalRebases.load();
+        m_LastStats.ReferenceLength   = LastIndex + 1;
+        m_LastStats.SeriesSkip        = SA.SkipIter;
+        m_LastStats.ReferenceSeconds  = m_Orbit.GetComputeSeconds();
+        m_LastStats.Seconds           = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+    void CPUPerturbationRenderer::Render(const CPUDeepZoomView& View, const CPUShaderConstants& Constants, CPUImage& Image)
+    {
+        RenderEscape(View, Constants, m_Samples);
+
+        const auto              StartTime = std::chrono::steady_clock::now();
+        const CPUFractal2DSetup Setup     = MakeFractal2DSetup(Constants);
+        Image.Resize(static_cast<std::uint32_t>(std::max(Setup.Width, 0)), static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+
+        m_ThreadPool.ParallelFor(Image.Height, [&](std::uint32_t y, std::uint32_t) {
+            const size_t Row = static_cast<size_t>(y) * Image.Width;
+            for (std::uint32_t x = 0; x < Image.Width; ++x)
+                Image.Pixels[Row + x] = PackColorRGBA8(ShadeEscapeSample2D(Setup, Constants, m_Samples[Row + x]));
+        });
+
+        m_LastStats.Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+    }
+
+} // namespace Diligent
@@ -0,0 +1,150 @@
+#pragma once
+
+// Deep zoom por teoría de perturbaciones.
+// Se calcula una única órbita de referencia Z_n en el centro de la vista con BigFloat, y
+// cada píxel itera solo su diferencia δ_n = z_n - Z_n en double:
+//     δ_{n+1} = (2 Z_n + δ_n) δ_n + δc
+// La aproximación por series (solo Mandelbrot) evalúa δ directamente en la iteración
+// SkipIter, y el rebase de Zhuoran (volver a Z_0 = 0 cuando |z| < |δ| o cuando la
+// referencia se acaba) evita los glitches sin órbitas secundarias.
+// Con δ en double el límite práctico es zoom ~1e290. El pixel shader itera δ en float con
+// un exponente aparte (CPUScaledDeltaParams) y llega igual de lejos.
+
+#include <cstdint>
+#include <vector>
+
+#include "BigFloat.hpp"
+#include "CPUFractalKernels2D.hpp"
+#include "CPUFractalRenderer.hpp"
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    // Vista de deep zoom: centro en precisión arbitraria y zoom en double
+    struct CPUDeepZoomView
+    {
+        BigFloat CenterX;
+        BigFloat CenterY;
+        double   Zoom = 1.0;
+    };
+
+    class CPUReferenceOrbit
+    {
+    public:
+        // Z_0 = 0, Z_{n+1} = f(Z_n) + C hasta MaxIter + 1 o hasta que escapa.
+        // El centro se usa con la precisión que traiga.
+        void Compute(const BigFloat& Cx, const BigFloat& Cy, int MaxIter, double Bailout2, CPU_ESCAPE_FORMULA Formula);
+
+        // true si la órbita ya calculada corresponde a estos parámetros
+        bool Matches(const BigFloat& Cx, const BigFloat& Cy, int MaxIter, double Bailout2, CPU_ESCAPE_FORMULA Formula) const;
+
+        // Índice del último Z_n válido (la referencia no escapó hasta ahí)
+        int GetLastIndex() const { return static_cast<int>(m_X.size()) - 1; }
+
+        const double* GetX() const { return m_X.data(); }
+        const double* GetY() const { return m_Y.data(); }
+
+        double GetComputeSeconds() const { return m_ComputeSeconds; }
+
+    private:
+        BigFloat           m_Cx, m_Cy;
+        int                m_MaxIter  = -1;
+        double             m_Bailout2 = 0;
+        CPU_ESCAPE_FORMULA m_Formula  = CPU_ESCAPE_FORMULA_MANDELBROT;
+
+        std::vector<double> m_X, m_Y;
+        double              m_ComputeSeconds = 0;
+    };
+
+    // Aproximación por series de δ_n = A_n δc + B_n δc^2 + C_n δc^3 (solo fórmula Mandelbrot).
+    // Los coeficientes se guardan escalados por Scale^k (Scale = |δc| máximo de la vista)
+    // para que no haya underflow en double: δ_n = A' u + B' u^2 + C' u^3, u = δc / Scale.
+    struct CPUSeriesApproximation
+    {
+        int    SkipIter = 0;
+        double Scale    = 0;
+        double Ax = 0, Ay = 0;
+        double Bx = 0, By = 0;
+        double Cx = 0, Cy = 0;
+
+        // DeltaMax es el |δc| máximo de la vista (esquina de la imagen)
+        void Compute(const CPUReferenceOrbit& Orbit, double DeltaMax, int MaxIter);
+    };
+
+    // δ en float del pixel shader (EscapePerturbation2D de fractal2D.fxh). Un float no baja de
+    // ~1e-38, así que mientras |δ| < 2^ScaledDeltaMaxExponent se itera w = δ / 2^e, con w
+    // normalizado a [0.5, 1) en cada paso y el exponente e en un entero:
+    //     w_{n+1} = (2 Z_n + 2^e w_n) w_n + δc / 2^e
+    // Al pasar de ese tamaño δ cabe en float y se sigue con la iteración normal.
+    struct CPUScaledDeltaParams
+    {
+        float InvZoomMantissa = 1; // 1/zoom = InvZoomMantissa * 2^InvZoomExponent
+        int   InvZoomExponent = 0;
+
+        // Serie en w: A', B' y C' divididos por 2^SeriesExponent (el orden de |A'|)
+        float SeriesAx = 0, SeriesAy = 0;
+        float SeriesBx = 0, SeriesBy = 0;
+        float SeriesCx = 0, SeriesCy = 0;
+        int   SeriesExponent = 0;
+        float UScale         = 0; // u = uv * UScale
+
+        static constexpr int ScaledDeltaMaxExponent = -64;
+
+        static CPUScaledDeltaParams Make(const CPUSeriesApproximation& Series, double Zoom);
+    };
+
+    struct CPUPerturbationStats
+    {
+        std::uint64_t Pixels            = 0;
+        std::uint64_t Iterations        = 0; // iteraciones de δ realmente ejecutadas
+        std::uint64_t SkippedIterations = 0; // iteraciones evitadas por la serie
+        std::uint64_t Rebases           = 0;
+        int           ReferenceLength   = 0;
+        int           SeriesSkip        = 0;
+        double        ReferenceSeconds  = 0;
+        double        Seconds           = 0;
+    };
+
+    class CPUPerturbationRenderer
+    {
+    public:
+        explicit CPUPerturbationRenderer(CPUThreadPool& ThreadPool) :
+            m_ThreadPool{ThreadPool}
+        {}
+
+        // Fractales con perturbación implementada (familias Mandelbrot y Burning Ship)
+        static bool SupportsFractalType(int FractalType);
+
+        // Prepara la órbita de referencia (solo la recalcula si cambió el centro, maxiter,
+        // bailout o la fórmula) y la aproximación por series para el zoom actual.
+        // Devuelve true si la órbita se ha recalculado.
+        bool Prepare(const CPUDeepZoomView& View, const CPUShaderConstants& Constants);
+
+        // Resultado del bucle de escape por píxel (Width * Height, fila 0 arriba), con i
+        // contado igual que en los kernels HLSL
+        void RenderEscape(const CPUDeepZoomView& View, const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples);
+
+        // Renderiza la vista con el coloreado del kernel de TimeAndResolution.w
+        void Render(const CPUDeepZoomView& View, const CPUShaderConstants& Constants, CPUImage& Image);
+
+        // Itera δ en float con CPUScaledDeltaParams, como el pixel shader, en vez de en
+        // double: para comprobar el camino GPU sin GPU (fractal_perturbation_test)
+        void SetFloatDeltas(bool Enable) { m_FloatDeltas = Enable; }
+
+        const CPUReferenceOrbit&      GetReferenceOrbit() const { return m_Orbit; }
+        const CPUSeriesApproximation& GetSeries() const { return m_Series; }
+        const CPUPerturbationStats&   GetLastStats() const { return m_LastStats; }
+
+    private:
+        CPUThreadPool&         m_ThreadPool;
+        CPUReferenceOrbit      m_Orbit;
+        CPUSeriesApproximation m_Series;
+        CPUPerturbationStats   m_LastStats;
+        bool                   m_FloatDeltas = false;
+
+        std::vector<CPUEscapeSample> m_Samples;
+        std::vector<float>           m_OrbitXF, m_OrbitYF; // la referencia en float, como ReferenceOrbit
+    };
+
+} // namespace Diligent
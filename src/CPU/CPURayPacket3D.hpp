@@ -0,0 +1,25 @@
+#pragma once
+
+// Marcha 3D por paquetes de rayos. Cabecera interna de FractalCPU, como CPUEscapePacket.hpp:
+// CPURayPacketWidth depende de las flags de FRACTAL_CPU_AVX2, que solo ven los .cpp de src/CPU.
+
+#include "CPUFractalKernels3D.hpp"
+#include "SimdPack.hpp"
+
+namespace Diligent
+{
+
+    // Rayos por paquete: las lanes de SimdPack<float> (8 con AVX2, 4 con SSE2)
+    static constexpr int CPURayPacketWidth = SimdPack<float>::Width;
+
+    // Lo mismo que RenderPixel3D para los Count <= CPURayPacketWidth píxeles contiguos de la
+    // fila PixelY que empiezan en PixelX, con las marchas (la principal y la sombra del Menger)
+    // vectorizadas: cada paso evalúa el DE de todas las lanes y las que ya terminaron quedan
+    // enmascaradas. Normal y color se calculan por lane. pStartDist y pSafeStartDist tienen
+    // Count distancias; pColors y pStats reciben Count resultados. El mismo resultado que
+    // RenderPixel3D salvo el redondeo del fmod vectorial del Menger; la potencia no entera
+    // del Mandelbulb (sin trigonometría vectorial) evalúa el DE lane a lane.
+    void RenderPacket3D(const CPUFractal3DSetup& Setup, const CPUShaderConstants& Constants, int PixelX, int PixelY, int Count, const float* pStartDist,
+                        const float* pSafeStartDist, CPUFloat4* pColors, CPURay3DStats* pStats);
+
+} // namespace Diligent
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace Diligent
+{
+
+    // Vectores POD con el mismo layout que float4/float3 de HLSL (y de BasicMath.hpp),
+    // para poder compilar el backend CPU sin depender de Diligent.
+    struct CPUFloat3
+    {
+        float x = 0, y = 0, z = 0;
+    };
+
+    struct CPUFloat4
+    {
+        float x = 0, y = 0, z = 0, w = 0;
+    };
+
+    // Copia exacta del cbuffer "Constants" de fractal.psh / fractalCompute.psh
+    // (y de FractalViewer::ShaderConstants). Los kernels CPU leen los mismos campos
+    // que los shaders, con la misma semántica.
+    struct CPUShaderConstants
+    {
+        CPUFloat4 TimeAndResolution; // x = time, y = res.x, z = res.y, w = fractalType
+
+        CPUFloat4 CameraPos;         // xyz = pos, w = is3D
+        CPUFloat4 CameraDirX;        // xyz = right
+        CPUFloat4 CameraDirY;        // xyz = up
+        CPUFloat4 CameraDirZ;        // xyz = forward
+
+        CPUFloat4 ZoomOffset;        // x = zoom, y = off.x, z = off.y, w = off.z
+
+        CPUFloat4 FractalColor;
+        CPUFloat4 BackgroundColor;
+
+        CPUFloat4 FractalC;
+
+        int       maxiter;
+        CPUFloat3 FractalParams1;    // x = bailout, y = power, z = precisión 2D (CPU_PRECISION)
+        CPUFloat4 FractalParams2;    // x = gamma, y = salida anticipada del interior (> 0.5)
+
+        CPUFloat4 Options3D;         // x = maxSteps, y = maxDist, z = threshold, w = potencia fija del Mandelbulb (0 = animada)
+        CPUFloat4 AnimationParams;   // x = timeScale, y = speedY, z = deformation, w = phase
+
+        CPUFloat4 ZoomOffsetLo;      // parte baja de ZoomOffset.xyz (zoom = x + lo.x...), para double y double-float
+    };
+    static_assert(sizeof(CPUShaderConstants) == 14 * 16, "CPUShaderConstants must match the HLSL cbuffer layout");
+
+    // Precisión de los kernels 2D (FractalParams1.z)
+    enum CPU_PRECISION : int
+    {
+        CPU_PRECISION_FLOAT = 0,
+        CPU_PRECISION_DOUBLE,
+        CPU_PRECISION_DOUBLE_FLOAT, // double emulado con dos float (DoubleFloat.hpp)
+        CPU_PRECISION_COUNT
+    };
+
+    // Índices de TimeAndResolution.w, en el mismo orden que los combos de UpdateUI
+    enum CPU_FRACTAL_2D : int
+    {
+        CPU_FRACTAL_2D_MANDELBROT = 0,
+        CPU_FRACTAL_2D_MANDELBROT_COLORS,
+        CPU_FRACTAL_2D_BURNING_SHIP,
+        CPU_FRACTAL_2D_BURNING_SHIP_COLORS,
+        CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS,
+        CPU_FRACTAL_2D_COUNT
+    };
+
+    enum CPU_FRACTAL_3D : int
+    {
+        CPU_FRACTAL_3D_MANDELBULB = 0,
+        CPU_FRACTAL_3D_MENGER_SPONGE,
+        CPU_FRACTAL_3D_QUATERNION_JULIA,
+        CPU_FRACTAL_3D_MANDELBOX,
+        CPU_FRACTAL_3D_COUNT
+    };
+
+    // Convierte cualquier struct con el mismo layout (p.ej. FractalViewer::ShaderConstants)
+    template <typename SrcType>
+    inline CPUShaderConstants ToCPUShaderConstants(const SrcType& Src)
+    {
+        static_assert(sizeof(SrcType) == sizeof(CPUShaderConstants), "Constant buffer layouts differ");
+        CPUShaderConstants Dst;
+        std::memcpy(&Dst, &Src, sizeof(Dst));
+        return Dst;
+    }
+
+} // namespace Diligent
@@ -0,0 +1,90 @@
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    CPUThreadPool::CPUThreadPool(std::uint32_t NumThreads)
+    {
+        if (NumThreads == 0)
+            NumThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        // El hilo llamante también trabaja, así que creamos uno menos
+        for (std::uint32_t i = 1; i < NumThreads; ++i)
+            m_Workers.emplace_back(&CPUThreadPool::WorkerLoop, this, i);
+    }
+
+    CPUThreadPool::~CPUThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mutex};
+            m_Stop = true;
+        }
+        m_WakeCV.notify_all();
+        for (auto& Worker : m_Workers)
+            Worker.join();
+    }
+
+    void CPUThreadPool::RunJob(std::uint32_t ThreadIndex)
+    {
+        for (;;)
+        {
+            const std::uint32_t Index = m_NextIndex.fetch_add(1, std::memory_order_relaxed);
+            if (Index >= m_JobCount)
+                break;
+            (*m_pJob)(Index, ThreadIndex);
+        }
+    }
+
+    void CPUThreadPool::WorkerLoop(std::uint32_t ThreadIndex)
+    {
+        std::uint64_t SeenGeneration = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> Lock{m_Mutex};
+                m_WakeCV.wait(Lock, [&] { return m_Stop || m_Generation != SeenGeneration; });
+                if (m_Stop)
+                    return;
+                SeenGeneration = m_Generation;
+            }
+
+            RunJob(ThreadIndex);
+
+            {
+                std::lock_guard<std::mutex> Lock{m_Mutex};
+                if (--m_Busy == 0)
+                    m_DoneCV.notify_one();
+            }
+        }
+    }
+
+    void CPUThreadPool::ParallelFor(std::uint32_t Count, const std::function<void(std::uint32_t Index, std::uint32_t ThreadIndex)>& Func)
+    {
+        if (Count == 0)
+            return;
+
+        if (m_Workers.empty() || Count == 1)
+        {
+            for (std::uint32_t i = 0; i < Count; ++i)
+                Func(i, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mutex};
+            m_pJob     = &Func;
+            m_JobCount = Count;
+            m_NextIndex.store(0, std::memory_order_relaxed);
+            m_Busy = static_cast<std::uint32_t>(m_Workers.size());
+            ++m_Generation;
+        }
+        m_WakeCV.notify_all();
+
+        RunJob(0);
+
+        std::unique_lock<std::mutex> Lock{m_Mutex};
+        m_DoneCV.wait(Lock, [&] { return m_Busy == 0; });
+        m_pJob = nullptr;
+    }
+
+} // namespace Diligent
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Diligent
+{
+
+    // Pool de hilos persistente para repartir tiles entre todos los núcleos.
+    // ParallelFor reparte los índices dinámicamente (contador atómico), así que los
+    // tiles caros cerca del borde del conjunto no dejan hilos parados.
+    class CPUThreadPool
+    {
+    public:
+        // NumThreads = 0 usa std::thread::hardware_concurrency()
+        explicit CPUThreadPool(std::uint32_t NumThreads = 0);
+        ~CPUThreadPool();
+
+        CPUThreadPool(const CPUThreadPool&) = delete;
+        CPUThreadPool& operator=(const CPUThreadPool&) = delete;
+
+        // Número total de hilos que ejecutan trabajo (incluye el hilo llamante)
+        std::uint32_t GetNumThreads() const { return static_cast<std::uint32_t>(m_Workers.size()) + 1; }
+
+        // Ejecuta Func(Index, ThreadIndex) para Index en [0, Count). Bloquea hasta terminar.
+        // ThreadIndex está en [0, GetNumThreads()) y sirve para indexar datos por hilo.
+        // No es reentrante: Func no debe volver a llamar a ParallelFor del mismo pool.
+        void ParallelFor(std::uint32_t Count, const std::function<void(std::uint32_t Index, std::uint32_t ThreadIndex)>& Func);
+
+    private:
+        void WorkerLoop(std::uint32_t ThreadIndex);
+        void RunJob(std::uint32_t ThreadIndex);
+
+        std::vector<std::thread> m_Workers;
+
+        std::mutex              m_Mutex;
+        std::condition_variable m_WakeCV;
+        std::condition_variable m_DoneCV;
+        std::uint64_t           m_Generation = 0;
+        std::uint32_t           m_Busy       = 0;
+        bool                    m_Stop       = false;
+
+        const std::function<void(std::uint32_t, std::uint32_t)>* m_pJob = nullptr;
+        std::uint32_t                                          m_JobCount = 0;
+        std::atomic<std::uint32_t>                             m_NextIndex{0};
+    };
+
+} // namespace Diligent
@@ -0,0 +1,626 @@
+#include "CPUTileCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#    include <winioctl.h>
+#else
+#    include <fcntl.h>
+#    include <sys/file.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Diligent
+{
+
+    namespace
+    {
+        constexpr char StoreMagic[8] = {'F', 'T', 'I', 'L', 'E', 'S', '0', '1'};
+
+        constexpr std::uint64_t FNVOffset = 14695981039346656037ull;
+        constexpr std::uint64_t FNVPrime  = 1099511628211ull;
+
+        // FNV-1a por palabras de 64 bits: la tile entera se comprueba en cada carga
+        std::uint64_t HashWords(const std::uint8_t* pData, std::uint64_t Bytes)
+        {
+            std::uint64_t Hash = FNVOffset;
+            for (std::uint64_t i = 0; i + 8 <= Bytes; i += 8)
+            {
+                std::uint64_t Word;
+                std::memcpy(&Word, pData + i, 8);
+                Hash = (Hash ^ Word) * FNVPrime;
+            }
+            return Hash;
+        }
+
+        // Precisión que usa de verdad el kernel (Burning Ship colores siempre en float)
+        int GetEffectivePrecision(const CPUFractal2DSetup& Setup)
+        {
+            return Setup.UseDoubleFloat ? CPU_PRECISION_DOUBLE_FLOAT : (Setup.UseDouble ? CPU_PRECISION_DOUBLE : CPU_PRECISION_FLOAT);
+        }
+
+        double GetTileWorldSize(std::int32_t Level)
+        {
+            return 2.0 * CPUTileCache::RootHalfSize / std::ldexp(1.0, Level);
+        }
+    } // namespace
+
+    std::uint64_t CPUTileKey::GetHash() const
+    {
+        const std::uint8_t* pBytes = reinterpret_cast<const std::uint8_t*>(this);
+        std::uint64_t       Hash   = FNVOffset;
+        for (size_t i = 0; i < sizeof(*this); ++i)
+            Hash = (Hash ^ pBytes[i]) * FNVPrime;
+        return Hash;
+    }
+
+    // -------------------- CPUTileStore ---------------------
+
+    struct CPUTileStore::Header
+    {
+        char          Magic[8];
+        std::uint32_t TileSize;
+        std::uint32_t NumSlots;
+        std::uint64_t Clock; // marca de tiempo de la última carga o escritura
+        std::uint8_t  Reserved[40];
+    };
+
+    struct CPUTileStore::SlotEntry
+    {
+        CPUTileKey    Key;
+        std::uint64_t Stamp;
+        std::uint64_t Checksum; // HashWords de los datos
+        std::uint32_t Valid;    // se pone a 0 mientras se escriben los datos
+        std::uint32_t Reserved;
+    };
+
+    CPUTileStore::~CPUTileStore()
+    {
+        Close();
+    }
+
+    bool CPUTileStore::Open(const std::string& Path, std::uint32_t TileSize, std::uint32_t NumSlots)
+    {
+        static_assert(sizeof(Header) == 64 && sizeof(SlotEntry) == 64, "Layout del fichero de tiles");
+
+        Close();
+        if (TileSize == 0 || NumSlots == 0)
+            return false;
+
+        m_TileSize   = TileSize;
+        m_NumSlots   = NumSlots;
+        m_DataOffset = (sizeof(Header) + std::uint64_t{NumSlots} * sizeof(SlotEntry) + 4095) / 4096 * 4096;
+
+        bool Created = false;
+        if (!Map(Path, m_DataOffset + NumSlots * GetTileBytes(), Created))
+        {
+            Close();
+            return false;
+        }
+
+        // Otro tamaño de tile u otro número de huecos: se vacía la tabla (los datos se quedan,
+        // pero ninguna entrada los apunta)
+        Header& Head = GetHeader();
+        if (Created || std::memcmp(Head.Magic, StoreMagic, sizeof(StoreMagic)) != 0 || Head.TileSize != TileSize || Head.NumSlots != NumSlots)
+        {
+            std::memset(m_pMapping, 0, static_cast<size_t>(m_DataOffset));
+            std::memcpy(Head.Magic, StoreMagic, sizeof(StoreMagic));
+            Head.TileSize = TileSize;
+            Head.NumSlots = NumSlots;
+        }
+        return true;
+    }
+
+#ifdef _WIN32
+    bool CPUTileStore::Map(const std::string& Path, std::uint64_t Bytes, bool& Created)
+    {
+        // Sin compartir: si otro proceso tiene el fichero abierto, CreateFileA falla
+        HANDLE hFile = CreateFileA(Path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+        m_hFile = hFile;
+
+        // Disperso antes de darle tamaño: SetEndOfFile reservaría los 512 MB enteros. Si el
+        // sistema de ficheros no lo admite (FAT) se sigue con el fichero normal
+        DWORD Returned = 0;
+        DeviceIoControl(hFile, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &Returned, nullptr);
+
+        LARGE_INTEGER Size = {};
+        if (!GetFileSizeEx(hFile, &Size))
+            return false;
+        if (static_cast<std::uint64_t>(Size.QuadPart) != Bytes)
+        {
+            // Otro tamaño: se trunca y se vuelve a crear a ceros
+            LARGE_INTEGER NewSize = {};
+            if (!SetFilePointerEx(hFile, NewSize, nullptr, FILE_BEGIN) || !SetEndOfFile(hFile))
+                return false;
+            NewSize.QuadPart = static_cast<LONGLONG>(Bytes);
+            if (!SetFilePointerEx(hFile, NewSize, nullptr, FILE_BEGIN) || !SetEndOfFile(hFile))
+                return false;
+            Created = true;
+        }
+
+        HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(Bytes >> 32), static_cast<DWORD>(Bytes), nullptr);
+        if (hMapping == nullptr)
+            return false;
+        m_hMapping = hMapping;
+
+        m_pMapping = static_cast<std::uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (m_pMapping == nullptr)
+            return false;
+        m_FileBytes = Bytes;
+        return true;
+    }
+
+    void CPUTileStore::Close()
+    {
+        if (m_pMapping != nullptr)
+            UnmapViewOfFile(m_pMapping);
+        if (m_hMapping != nullptr)
+            CloseHandle(m_hMapping);
+        if (m_hFile != nullptr)
+            CloseHandle(m_hFile);
+        m_pMapping  = nullptr;
+        m_hMapping  = nullptr;
+        m_hFile     = nullptr;
+        m_FileBytes = 0;
+    }
+#else
+    bool CPUTileStore::Map(const std::string& Path, std::uint64_t Bytes, bool& Created)
+    {
+        m_File = open(Path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_File < 0)
+            return false;
+        // Un solo proceso por fichero, como el modo sin compartir de Windows
+        if (flock(m_File, LOCK_EX | LOCK_NB) != 0)
+            return false;
+
+        struct stat Info;
+        if (fstat(m_File, &Info) != 0)
+            return false;
+        if (static_cast<std::uint64_t>(Info.st_size) != Bytes)
+        {
+            // Otro tamaño: se trunca y se vuelve a crear a ceros (fichero disperso)
+            if (ftruncate(m_File, 0) != 0 || ftruncate(m_File, static_cast<off_t>(Bytes)) != 0)
+                return false;
+            Created = true;
+        }
+
+        void* pMapping = mmap(nullptr, static_cast<size_t>(Bytes), PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+        if (pMapping == MAP_FAILED)
+            return false;
+        m_pMapping  = static_cast<std::uint8_t*>(pMapping);
+        m_FileBytes = Bytes;
+        return true;
+    }
+
+    void CPUTileStore::Close()
+    {
+        if (m_pMapping != nullptr)
+            munmap(m_pMapping, static_cast<size_t>(m_FileBytes));
+        if (m_File >= 0)
+            close(m_File);
+        m_pMapping  = nullptr;
+        m_File      = -1;
+        m_FileBytes = 0;
+    }
+#endif
+
+    CPUTileStore::Header& CPUTileStore::GetHeader() const
+    {
+        return *reinterpret_cast<Header*>(m_pMapping);
+    }
+
+    CPUTileStore::SlotEntry& CPUTileStore::GetSlot(std::uint32_t Slot) const
+    {
+        return reinterpret_cast<SlotEntry*>(m_pMapping + sizeof(Header))[Slot];
+    }
+
+    std::uint8_t* CPUTileStore::GetSlotData(std::uint32_t Slot) const
+    {
+        return m_pMapping + m_DataOffset + Slot * GetTileBytes();
+    }
+
+    bool CPUTileStore::Load(const CPUTileKey& Key, CPUEscapeSample* pSamples)
+    {
+        if (!IsOpen())
+            return false;
+
+        const std::uint64_t Hash = Key.GetHash();
+        for (std::uint32_t Probe = 0; Probe < std::min(ProbeSlots, m_NumSlots); ++Probe)
+        {
+            const std::uint32_t Slot  = static_cast<std::uint32_t>((Hash + Probe) % m_NumSlots);
+            SlotEntry&          Entry = GetSlot(Slot);
+            if (Entry.Valid == 0 || !(Entry.Key == Key))
+                continue;
+
+            const std::uint8_t* pData = GetSlotData(Slot);
+            if (HashWords(pData, GetTileBytes()) != Entry.Checksum)
+            {
+                Entry.Valid = 0;
+                return false;
+            }
+            std::memcpy(pSamples, pData, static_cast<size_t>(GetTileBytes()));
+            Entry.Stamp = ++GetHeader().Clock;
+            return true;
+        }
+        return false;
+    }
+
+    void CPUTileStore::Store(const CPUTileKey& Key, const CPUEscapeSample* pSamples)
+    {
+        if (!IsOpen())
+            return;
+
+        // El hueco de la misma clave, si no uno libre y si no el usado hace más tiempo
+        const std::uint64_t Hash   = Key.GetHash();
+        std::uint32_t       Target = static_cast<std::uint32_t>(Hash % m_NumSlots);
+        int                 Rank   = 3; // 0 = misma clave, 1 = libre, 2 = el más antiguo
+        for (std::uint32_t Probe = 0; Probe < std::min(ProbeSlots, m_NumSlots) && Rank > 0; ++Probe)
+        {
+            const std::uint32_t Slot  = static_cast<std::uint32_t>((Hash + Probe) % m_NumSlots);
+            const SlotEntry&    Entry = GetSlot(Slot);
+            if (Entry.Valid != 0 && Entry.Key == Key)
+            {
+                Target = Slot;
+                Rank   = 0;
+            }
+            else if (Entry.Valid == 0 && Rank > 1)
+            {
+                Target = Slot;
+                Rank   = 1;
+            }
+            else if (Rank > 2 || (Rank == 2 && Entry.Stamp < GetSlot(Target).Stamp))
+            {
+                Target = Slot;
+                Rank   = 2;
+            }
+        }
+
+        SlotEntry& Entry = GetSlot(Target);
+        Entry.Valid      = 0;
+        std::memcpy(GetSlotData(Target), pSamples, static_cast<size_t>(GetTileBytes()));
+        Entry.Key      = Key;
+        Entry.Checksum = HashWords(GetSlotData(Target), GetTileBytes());
+        Entry.Stamp    = ++GetHeader().Clock;
+        Entry.Valid    = 1;
+    }
+
+    std::uint32_t CPUTileStore::GetNumStored() const
+    {
+        std::uint32_t Count = 0;
+        for (std::uint32_t Slot = 0; IsOpen() && Slot < m_NumSlots; ++Slot)
+            Count += GetSlot(Slot).Valid != 0 ? 1 : 0;
+        return Count;
+    }
+
+    // -------------------- CPUTileCache ---------------------
+
+    CPUTileCache::CPUTileCache(CPUThreadPool& ThreadPool, const CPUTileCacheSettings& Settings) :
+        m_ThreadPool{ThreadPool},
+        m_Settings{Settings}
+    {
+        m_Settings.TileSize    = std::max(m_Settings.TileSize, 8u);
+        m_Settings.MemoryTiles = std::max(m_Settings.MemoryTiles, 1u);
+        if (!m_Settings.DiskPath.empty())
+            m_Store.Open(m_Settings.DiskPath, m_Settings.TileSize, m_Settings.DiskSlots);
+    }
+
+    std::int32_t CPUTileCache::GetViewLevel(const CPUShaderConstants& C) const
+    {
+        // Píxel de la vista 2 / (Height * zoom); píxel de tile 2 RootHalfSize / (2^L TileSize)
+        const double Zoom  = static_cast<double>(C.ZoomOffset.x) + static_cast<double>(C.ZoomOffsetLo.x);
+        const double Ratio = RootHalfSize * static_cast<double>(C.TimeAndResolution.z) * Zoom / m_Settings.TileSize;
+        if (!(Ratio > 1.0))
+            return 0;
+        return static_cast<std::int32_t>(std::ceil(std::log2(Ratio) - 1e-9));
+    }
+
+    bool CPUTileCache::CanCache(const CPUShaderConstants& C) const
+    {
+        // Con c animada cada instante sería otra tile
+        return C.CameraPos.w <= 0.5f && C.AnimationParams.z == 0.0f && C.AnimationParams.w == 0.0f && C.TimeAndResolution.y >= 1.0f &&
+            C.TimeAndResolution.z >= 1.0f && C.ZoomOffset.x > 0.0f && GetViewLevel(C) <= MaxLevel;
+    }
+
+    CPUTileCache::TileData CPUTileCache::Find(const CPUTileKey& Key, bool& FromDisk)
+    {
+        FromDisk = false;
+        auto It  = m_Index.find(Key);
+        if (It != m_Index.end())
+        {
+            m_LRU.splice(m_LRU.begin(), m_LRU, It->second);
+            return It->second->Data;
+        }
+        if (!m_Store.IsOpen())
+            return nullptr;
+
+        auto Data = std::make_shared<std::vector<CPUEscapeSample>>(static_cast<size_t>(m_Settings.TileSize) * m_Settings.TileSize);
+        if (!m_Store.Load(Key, Data->data()))
+            return nullptr;
+        FromDisk = true;
+        Insert(Key, Data);
+        return Data;
+    }
+
+    void CPUTileCache::Insert(const CPUTileKey& Key, const TileData& Data)
+    {
+        auto It = m_Index.find(Key);
+        if (It != m_Index.end())
+        {
+            It->second->Data = Data;
+            m_LRU.splice(m_LRU.begin(), m_LRU, It->second);
+            return;
+        }
+        m_LRU.push_front(LRUEntry{Key, Data});
+        m_Index[Key] = m_LRU.begin();
+        while (m_LRU.size() > m_Settings.MemoryTiles)
+        {
+            // Ya está en disco (se guarda al calcularla): basta con soltarla
+            m_Index.erase(m_LRU.back().Key);
+            m_LRU.pop_back();
+        }
+    }
+
+    void CPUTileCache::ClearMemory()
+    {
+        m_LRU.clear();
+        m_Index.clear();
+    }
+
+    std::vector<CPUTileCache::TileData> CPUTileCache::RenderTiles(const CPUShaderConstants& Constants, const std::vector<CPUTileKey>& Keys)
+    {
+        const std::uint32_t T = m_Settings.TileSize;
+
+        // Cada tile es una vista cuadrada de T x T con su zoom y su centro (parte baja incluida,
+        // como FractalViewer, para double y double-float)
+        std::vector<CPUFractal2DSetup>                             Setups;
+        std::vector<std::shared_ptr<std::vector<CPUEscapeSample>>> Tiles;
+        for (const CPUTileKey& Key : Keys)
+        {
+            const double Size = GetTileWorldSize(Key.Level);
+            const auto   Zoom = DFFromDouble(2.0 / Size);
+            const auto   CX   = DFFromDouble(-RootHalfSize + (static_cast<double>(Key.Tx) + 0.5) * Size);
+            const auto   CY   = DFFromDouble(-RootHalfSize + (static_cast<double>(Key.Ty) + 0.5) * Size);
+
+            CPUShaderConstants C  = Constants;
+            C.TimeAndResolution.y = static_cast<float>(T);
+            C.TimeAndResolution.z = static_cast<float>(T);
+            C.ZoomOffset          = {Zoom.Hi, CX.Hi, CY.Hi, Constants.ZoomOffset.w};
+            C.ZoomOffsetLo        = {Zoom.Lo, CX.Lo, CY.Lo, Constants.ZoomOffsetLo.w};
+            Setups.push_back(MakeFractal2DSetup(C));
+            Tiles.push_back(std::make_shared<std::vector<CPUEscapeSample>>(static_cast<size_t>(T) * T));
+        }
+
+        // Las filas de todas las tiles en un solo ParallelFor
+        std::atomic<std::uint64_t> TotalIterations{0};
+        m_ThreadPool.ParallelFor(static_cast<std::uint32_t>(Keys.size()) * T, [&](std::uint32_t Index, std::uint32_t) {
+            const std::uint32_t Tile = Index / T;
+            const std::uint32_t Row  = Index % T;
+            const std::uint64_t Iterations =
+                EscapeRow2D(Setups[Tile], static_cast<int>(Row), 0, static_cast<int>(T), Tiles[Tile]->data() + static_cast<size_t>(Row) * T);
+            TotalIterations.fetch_add(Iterations, std::memory_order_relaxed);
+        });
+        m_LastStats.Iterations += TotalIterations.load();
+
+        std::vector<TileData> Result;
+        for (size_t i = 0; i < Keys.size(); ++i)
+        {
+            m_Store.Store(Keys[i], Tiles[i]->data());
+            Insert(Keys[i], Tiles[i]);
+            Result.push_back(Tiles[i]);
+        }
+        return Result;
+    }
+
+    bool CPUTileCache::RenderEscape(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples)
+    {
+        const auto              StartTime = std::chrono::steady_clock::now();
+        const CPUFractal2DSetup Setup     = MakeFractal2DSetup(Constants);
+        const std::uint32_t     Width     = static_cast<std::uint32_t>(std::max(Setup.Width, 0));
+        const std::uint32_t     Height    = static_cast<std::uint32_t>(std::max(Setup.Height, 0));
+        const std::uint32_t     T         = m_Settings.TileSize;
+        Samples.resize(static_cast<size_t>(Width) * Height);
+
+        m_LastStats        = CPUTileCacheStats{};
+        m_LastStats.Level  = std::min(GetViewLevel(Constants), MaxLevel);
+        m_LastStats.Pixels = static_cast<std::uint64_t>(Width) * Height;
+        const std::int32_t Level         = m_LastStats.Level;
+        const std::int64_t NumLevelTiles = std::int64_t{1} << Level;
+
+        // Centros de los píxeles en el plano complejo: X por columna, Y por fila
+        std::vector<double> PixelX(Width), PixelY(Height);
+        for (std::uint32_t x = 0; x < Width; ++x)
+        {
+            double Y;
+            GetPixelCoordD(Setup, x + 0.5, 0.5, PixelX[x], Y);
+        }
+        for (std::uint32_t y = 0; y < Height; ++y)
+        {
+            double X;
+            GetPixelCoordD(Setup, 0.5, y + 0.5, X, PixelY[y]);
+        }
+
+        // Tiles del nivel que cubren la vista, recortadas a la raíz
+        const double ToTile      = 1.0 / GetTileWorldSize(Level);
+        auto         ToTileIndex = [&](double v) {
+            return std::min(std::max(static_cast<std::int64_t>(std::floor((v + RootHalfSize) * ToTile)), std::int64_t{0}), NumLevelTiles - 1);
+        };
+        const std::int64_t Tx0   = Width > 0 ? ToTileIndex(PixelX.front()) : 0;
+        const std::int64_t Tx1   = Width > 0 ? ToTileIndex(PixelX.back()) : -1;
+        const std::int64_t Ty0   = Height > 0 ? ToTileIndex(std::min(PixelY.front(), PixelY.back())) : 0;
+        const std::int64_t Ty1   = Height > 0 ? ToTileIndex(std::max(PixelY.front(), PixelY.back())) : -1;
+        const std::int64_t GridW = std::max<std::int64_t>(Tx1 - Tx0 + 1, 0);
+        const std::int64_t GridH = std::max<std::int64_t>(Ty1 - Ty0 + 1, 0);
+
+        CPUTileKey BaseKey;
+        BaseKey.Type      = Setup.FractalType;
+        BaseKey.Precision = GetEffectivePrecision(Setup);
+        BaseKey.MaxIter   = Setup.MaxIter;
+        BaseKey.Bailout   = Constants.FractalParams1.x;
+        BaseKey.Flags     = Constants.FractalParams2.y > 0.5f ? CPU_TILE_FLAG_EARLY_OUT : 0u;
+        auto MakeKey      = [&](std::int32_t L, std::int64_t Tx, std::int64_t Ty) {
+            CPUTileKey Key = BaseKey;
+            Key.Level      = L;
+            Key.Tx         = Tx;
+            Key.Ty         = Ty;
+            return Key;
+        };
+
+        // Fuente de cada celda: la tile exacta, sus cuatro hijas (Span 2) o un antecesor
+        struct Cell
+        {
+            TileData     Data[4];
+            std::int32_t Level = 0;
+            std::int64_t Tx = 0, Ty = 0; // tile (o primera hija) de la fuente en su nivel
+            int          Span  = 0;      // 0 = sin fuente todavía
+        };
+        std::vector<Cell> Grid(static_cast<size_t>(GridW * GridH));
+        m_LastStats.Tiles = static_cast<std::uint32_t>(Grid.size());
+
+        struct Missing
+        {
+            size_t CellIndex;
+            double Distance; // al centro de la vista, en tiles
+        };
+        std::vector<Missing> MissingTiles;
+        const double         CenterTx = (Tx0 + Tx1 + 1) * 0.5, CenterTy = (Ty0 + Ty1 + 1) * 0.5;
+        for (std::int64_t j = 0; j < GridH; ++j)
+        {
+            for (std::int64_t i = 0; i < GridW; ++i)
+            {
+                Cell& C = Grid[static_cast<size_t>(j * GridW + i)];
+                C.Level = Level;
+                C.Tx    = Tx0 + i;
+                C.Ty    = Ty0 + j;
+
+                bool FromDisk = false;
+                C.Data[0]     = Find(MakeKey(Level, C.Tx, C.Ty), FromDisk);
+                if (C.Data[0])
+                {
+                    C.Span = 1;
+                    ++(FromDisk ? m_LastStats.DiskHits : m_LastStats.MemoryHits);
+                    continue;
+                }
+                const double dx = C.Tx + 0.5 - CenterTx, dy = C.Ty + 0.5 - CenterTy;
+                MissingTiles.push_back(Missing{static_cast<size_t>(j * GridW + i), dx * dx + dy * dy});
+            }
+        }
+
+        // Sustitutos de las que faltan: las cuatro hijas (al volver a alejarse) o un antecesor
+        // (al acercarse). Sin sustituto la tile se calcula siempre; con él, solo las
+        // MaxTilesPerFrame más cercanas al centro.
+        std::sort(MissingTiles.begin(), MissingTiles.end(), [](const Missing& a, const Missing& b) { return a.Distance < b.Distance; });
+        std::vector<CPUTileKey> RenderKeys;
+        std::vector<size_t>     RenderCells;
+        std::uint32_t           Deferrable = 0;
+        for (const Missing& M : MissingTiles)
+        {
+            Cell& C        = Grid[M.CellIndex];
+            bool  FromDisk = false;
+            Cell  Placeholder;
+            if (Level < MaxLevel)
+            {
+                Placeholder.Span  = 2;
+                Placeholder.Level = Level + 1;
+                Placeholder.Tx    = C.Tx * 2;
+                Placeholder.Ty    = C.Ty * 2;
+                for (int k = 0; k < 4 && Placeholder.Span == 2; ++k)
+                {
+                    Placeholder.Data[k] = Find(MakeKey(Level + 1, C.Tx * 2 + (k & 1), C.Ty * 2 + (k >> 1)), FromDisk);
+                    if (!Placeholder.Data[k])
+                        Placeholder.Span = 0;
+                }
+            }
+            for (std::uint32_t Up = 1; Placeholder.Span == 0 && Up <= m_Settings.PlaceholderLevels && Up <= static_cast<std::uint32_t>(Level); ++Up)
+            {
+                Placeholder.Level   = Level - static_cast<std::int32_t>(Up);
+                Placeholder.Tx      = C.Tx >> Up;
+                Placeholder.Ty      = C.Ty >> Up;
+                Placeholder.Data[0] = Find(MakeKey(Placeholder.Level, Placeholder.Tx, Placeholder.Ty), FromDisk);
+                Placeholder.Span    = Placeholder.Data[0] ? 1 : 0;
+            }
+
+            if (Placeholder.Span == 0 || Deferrable++ < m_Settings.MaxTilesPerFrame)
+            {
+                RenderKeys.push_back(MakeKey(Level, C.Tx, C.Ty));
+                RenderCells.push_back(M.CellIndex);
+            }
+            else
+            {
+                C = Placeholder;
+                ++m_LastStats.Placeholders;
+            }
+        }
+
+        const std::vector<TileData> Rendered = RenderTiles(Constants, RenderKeys);
+        for (size_t k = 0; k < Rendered.size(); ++k)
+        {
+            Cell& C   = Grid[RenderCells[k]];
+            C.Data[0] = Rendered[k];
+            C.Span    = 1;
+        }
+        m_LastStats.Rendered = static_cast<std::uint32_t>(Rendered.size());
+
+        // Montaje: cada píxel toma la muestra más cercana de la fuente de su celda. Fuera de la
+        // raíz (vistas muy alejadas) se itera directamente.
+        m_ThreadPool.ParallelFor(Height, [&](std::uint32_t y, std::uint32_t) {
+            CPUEscapeSample*   pRow  = &Samples[static_cast<size_t>(y) * Width];
+            const double       V     = (PixelY[y] + RootHalfSize) * ToTile;
+            const std::int64_t Row   = static_cast<std::int64_t>(std::floor(V));
+            const bool         RowIn = V >= 0.0 && Row < NumLevelTiles;
+            for (std::uint32_t x = 0; x < Width; ++x)
+            {
+                const double       U   = (PixelX[x] + RootHalfSize) * ToTile;
+                const std::int64_t Col = static_cast<std::int64_t>(std::floor(U));
+                if (!RowIn || U < 0.0 || Col >= NumLevelTiles)
+                {
+                    const float PX = x + 0.5f, PY = y + 0.5f;
+                    EscapePoints2D(Setup, &PX, &PY, 1, &pRow[x]);
+                    continue;
+                }
+
+                // Posición en píxeles de la fuente (Span x Span tiles de su nivel)
+                const Cell&        C     = Grid[static_cast<size_t>((Row - Ty0) * GridW + (Col - Tx0))];
+                const double       Scale = std::ldexp(1.0, C.Level - Level);
+                const std::int64_t Limit = static_cast<std::int64_t>(C.Span) * T - 1;
+                const std::int64_t px    = std::min(std::max(static_cast<std::int64_t>((U * Scale - C.Tx) * T), std::int64_t{0}), Limit);
+                const std::int64_t py    = std::min(std::max(static_cast<std::int64_t>((V * Scale - C.Ty) * T), std::int64_t{0}), Limit);
+                const size_t       Child = static_cast<size_t>((py / T) * 2 + px / T);
+                pRow[x]                  = (*C.Data[Child])[static_cast<size_t>(py % T) * T + static_cast<size_t>(px % T)];
+            }
+        });
+
+        m_LastStats.Resident = static_cast<std::uint32_t>(m_LRU.size());
+        m_LastStats.Seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+        return m_LastStats.Placeholders == 0;
+    }
+
+    bool CPUTileCache::Render(const CPUShaderConstants& Constants, CPUImage& Image)
+    {
+        const bool Complete = RenderEscape(Constants, m_Samples);
+
+        const auto              StartTime = std::chrono::steady_clock::now();
+        const CPUFractal2DSetup Setup     = MakeFractal2DSetup(Constants);
+        Image.Resize(static_cast<std::uint32_t>(std::max(Setup.Width, 0)), static_cast<std::uint32_t>(std::max(Setup.Height, 0)));
+
+        m_ThreadPool.ParallelFor(Image.Height, [&](std::uint32_t y, std::uint32_t) {
+            const size_t Row = static_cast<size_t>(y) * Image.Width;
+            for (std::uint32_t x = 0; x < Image.Width; ++x)
+                Image.Pixels[Row + x] = PackColorRGBA8(ShadeEscapeSample2D(Setup, Constants, m_Samples[Row + x]));
+        });
+
+        m_LastStats.Seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+        return Complete;
+    }
+
+} // namespace Diligent
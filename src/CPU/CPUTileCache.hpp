@@ -0,0 +1,195 @@
+#pragma once
+
+// Cache persistente de tiles para explorar en 2D, como un mapa por tiles. El plano complejo
+// [-RootHalfSize, RootHalfSize]^2 se parte en un quadtree: en el nivel L hay 2^L x 2^L tiles
+// de TileSize x TileSize píxeles. Cada tile guarda el resultado del bucle de escape
+// (CPUEscapeSample), no el color, así que paleta, colores y gamma no la invalidan.
+//
+// Cada vista usa el nivel con píxeles de tile iguales o más finos que los suyos y se monta
+// muestreando las tiles (vecino más cercano). Primero se busca en un LRU en memoria, después
+// en el almacén en disco (CPUTileStore, mapeado en memoria) y solo se calculan las que faltan.
+// Las que faltan y tienen sustituto (sus cuatro hijas o un antecesor de hasta
+// PlaceholderLevels niveles más arriba) se calculan como mucho MaxTilesPerFrame por frame:
+// mientras tanto se muestra el sustituto y RenderEscape devuelve false.
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CPUFractalKernels2D.hpp"
+#include "CPUFractalRenderer.hpp"
+#include "CPUThreadPool.hpp"
+
+namespace Diligent
+{
+
+    // Todo lo que decide el resultado de escape de una tile. Layout fijo, sin relleno: se
+    // guarda tal cual en el fichero (que solo lee el mismo build, como el protocolo de la granja)
+    struct CPUTileKey
+    {
+        std::int32_t  Type      = 0; // tipo 2D (CPU_FRACTAL_2D)
+        std::int32_t  Precision = 0; // precisión efectiva (CPU_PRECISION)
+        std::int32_t  MaxIter   = 0;
+        float         Bailout   = 0;
+        std::uint32_t Flags     = 0; // CPU_TILE_FLAG
+        std::int32_t  Level     = 0;
+        std::int64_t  Tx        = 0;
+        std::int64_t  Ty        = 0; // fila, hacia +y (fila 0 de la imagen arriba, como el HLSL)
+
+        bool operator==(const CPUTileKey& Other) const { return std::memcmp(this, &Other, sizeof(*this)) == 0; }
+
+        // FNV-1a de los bytes de la clave
+        std::uint64_t GetHash() const;
+    };
+    static_assert(sizeof(CPUTileKey) == 40, "CPUTileKey se guarda en disco: sin relleno");
+
+    enum CPU_TILE_FLAG : std::uint32_t
+    {
+        CPU_TILE_FLAG_EARLY_OUT = 1u << 0 // salida anticipada del interior (FractalParams2.y)
+    };
+
+    struct CPUTileKeyHasher
+    {
+        size_t operator()(const CPUTileKey& Key) const { return static_cast<size_t>(Key.GetHash()); }
+    };
+
+    // Almacén de tiles en un fichero mapeado en memoria: cabecera, tabla de NumSlots entradas
+    // y NumSlots huecos de datos. Cada clave tiene ProbeSlots huecos posibles a partir de su
+    // hash; al guardar se reutiliza el de la misma clave, uno libre o el usado hace más tiempo
+    // (LRU aproximado en disco). Cada hueco lleva el checksum de sus datos, así que uno a medio
+    // escribir (proceso interrumpido) se trata como ausente. El fichero es disperso (NTFS y
+    // los sistemas de ficheros POSIX habituales): solo ocupa los huecos escritos. Un solo
+    // proceso por fichero: Open lo bloquea (flock en POSIX, sin compartir en Windows) y en
+    // otro proceso devuelve false.
+    class CPUTileStore
+    {
+    public:
+        static constexpr std::uint32_t ProbeSlots = 8;
+
+        CPUTileStore() = default;
+        ~CPUTileStore();
+
+        CPUTileStore(const CPUTileStore&) = delete;
+        CPUTileStore& operator=(const CPUTileStore&) = delete;
+
+        // Abre o crea Path. Si el fichero no es de este TileSize y NumSlots se vacía; false si
+        // no se puede crear o lo tiene abierto otro proceso
+        bool Open(const std::string& Path, std::uint32_t TileSize, std::uint32_t NumSlots);
+        void Close();
+
+        // Copia la tile a pSamples (TileSize * TileSize); false si no está o está corrupta
+        bool Load(const CPUTileKey& Key, CPUEscapeSample* pSamples);
+        void Store(const CPUTileKey& Key, const CPUEscapeSample* pSamples);
+
+        bool          IsOpen() const { return m_pMapping != nullptr; }
+        std::uint32_t GetNumSlots() const { return m_NumSlots; }
+        std::uint32_t GetNumStored() const;
+        std::uint64_t GetFileBytes() const { return m_FileBytes; }
+
+    private:
+        struct Header;
+        struct SlotEntry;
+
+        bool          Map(const std::string& Path, std::uint64_t Bytes, bool& Created);
+        Header&       GetHeader() const;
+        SlotEntry&    GetSlot(std::uint32_t Slot) const;
+        std::uint8_t* GetSlotData(std::uint32_t Slot) const;
+        std::uint64_t GetTileBytes() const { return std::uint64_t{m_TileSize} * m_TileSize * sizeof(CPUEscapeSample); }
+
+        std::uint8_t* m_pMapping   = nullptr;
+        std::uint64_t m_FileBytes  = 0;
+        std::uint64_t m_DataOffset = 0;
+        std::uint32_t m_TileSize   = 0;
+        std::uint32_t m_NumSlots   = 0;
+#ifdef _WIN32
+        void* m_hFile    = nullptr;
+        void* m_hMapping = nullptr;
+#else
+        int m_File = -1;
+#endif
+    };
+
+    struct CPUTileCacheSettings
+    {
+        std::uint32_t TileSize          = 128;
+        std::uint32_t MemoryTiles       = 1024; // LRU en memoria (128 KB por tile de 128)
+        std::string   DiskPath;                 // vacío = solo memoria
+        std::uint32_t DiskSlots         = 4096; // hasta 512 MB con tiles de 128 (disperso: crece con las tiles guardadas)
+        std::uint32_t MaxTilesPerFrame  = 64;   // tiles con sustituto calculadas por frame
+        std::uint32_t PlaceholderLevels = 4;    // niveles que se sube como mucho buscando un sustituto
+    };
+
+    struct CPUTileCacheStats
+    {
+        std::int32_t  Level        = 0; // nivel del quadtree de la vista
+        std::uint32_t Tiles        = 0; // tiles que cubren la vista
+        std::uint32_t MemoryHits   = 0;
+        std::uint32_t DiskHits     = 0;
+        std::uint32_t Rendered     = 0;
+        std::uint32_t Placeholders = 0; // tiles que faltan, mostradas con un sustituto
+        std::uint32_t Resident     = 0; // tiles en el LRU en memoria
+        std::uint64_t Pixels       = 0;
+        std::uint64_t Iterations   = 0; // iteraciones de escape de las tiles calculadas
+        double        Seconds      = 0;
+    };
+
+    class CPUTileCache
+    {
+    public:
+        static constexpr double       RootHalfSize = 4.0;
+        static constexpr std::int32_t MaxLevel     = 44; // el píxel de tile ronda 8 ulp de double
+
+        CPUTileCache(CPUThreadPool& ThreadPool, const CPUTileCacheSettings& Settings);
+
+        // ¿Se puede montar esta vista con tiles? 2D, sin c animada y sin pasar de MaxLevel
+        bool CanCache(const CPUShaderConstants& Constants) const;
+
+        // Nivel del quadtree para la vista: el primero con píxeles de tile no mayores que los suyos
+        std::int32_t GetViewLevel(const CPUShaderConstants& Constants) const;
+
+        // Resultado de escape de la vista (Width * Height, fila 0 arriba) montado con tiles.
+        // Devuelve false si alguna tile se ha mostrado con un sustituto: hay que volver a
+        // llamar (en otro frame) para completarla.
+        bool RenderEscape(const CPUShaderConstants& Constants, std::vector<CPUEscapeSample>& Samples);
+
+        // Igual, con el coloreado del kernel de TimeAndResolution.w
+        bool Render(const CPUShaderConstants& Constants, CPUImage& Image);
+
+        // Vacía el LRU en memoria (el fichero se queda)
+        void ClearMemory();
+
+        const CPUTileCacheSettings& GetSettings() const { return m_Settings; }
+        const CPUTileCacheStats&    GetLastStats() const { return m_LastStats; }
+        const CPUTileStore&         GetStore() const { return m_Store; }
+
+    private:
+        using TileData = std::shared_ptr<const std::vector<CPUEscapeSample>>;
+
+        // Memoria y después disco (la de disco pasa al LRU); nullptr si no está
+        TileData Find(const CPUTileKey& Key, bool& FromDisk);
+        void     Insert(const CPUTileKey& Key, const TileData& Data);
+
+        // Calcula las tiles de Keys en un solo ParallelFor (filas de todas las tiles juntas)
+        std::vector<TileData> RenderTiles(const CPUShaderConstants& Constants, const std::vector<CPUTileKey>& Keys);
+
+        CPUThreadPool&       m_ThreadPool;
+        CPUTileCacheSettings m_Settings;
+        CPUTileStore         m_Store;
+        CPUTileCacheStats    m_LastStats;
+
+        struct LRUEntry
+        {
+            CPUTileKey Key;
+            TileData   Data;
+        };
+        std::list<LRUEntry>                                                            m_LRU; // la más reciente delante
+        std::unordered_map<CPUTileKey, std::list<LRUEntry>::iterator, CPUTileKeyHasher> m_Index;
+
+        std::vector<CPUEscapeSample> m_Samples;
+    };
+
+} // namespace Diligent
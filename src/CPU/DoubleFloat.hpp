@@ -0,0 +1,132 @@
+#pragma once
+
+// Aritmética double-float: un número es la suma sin solapar de dos float, Hi + Lo con
+// |Lo| <= ulp(Hi) / 2, y tiene ~48 bits de mantisa (~4e-15 relativo) usando solo
+// operaciones de float. Es la versión CPU de Shaders/fractalDoubleFloat.fxh (mismas
+// operaciones en el mismo orden), para comparar el camino emulado con double de verdad.
+//
+// T es float o SimdPack<float>. Las transformaciones sin error (TwoSum, TwoProd) dependen
+// del redondeo de cada operación: no se pueden compilar con FMA contraídas
+// (-ffp-contract=fast con -mfma) ni con /fp:fast.
+
+namespace Diligent
+{
+
+    template <typename T>
+    struct DoubleFloat
+    {
+        T Hi;
+        T Lo;
+    };
+
+    // Constante escalar como T (float o SimdPack<float>)
+    template <typename T>
+    inline T DFConstant(float x)
+    {
+        return T::Broadcast(x);
+    }
+
+    template <>
+    inline float DFConstant<float>(float x)
+    {
+        return x;
+    }
+
+    // Mejor aproximación double-float de un double (Hi redondeado a float, Lo el resto)
+    inline DoubleFloat<float> DFFromDouble(double x)
+    {
+        const float Hi = static_cast<float>(x);
+        return {Hi, static_cast<float>(x - static_cast<double>(Hi))};
+    }
+
+    inline double DFToDouble(const DoubleFloat<float>& a)
+    {
+        return static_cast<double>(a.Hi) + static_cast<double>(a.Lo);
+    }
+
+    // a + b exacto como s + e (Knuth)
+    template <typename T>
+    inline DoubleFloat<T> DFTwoSum(T a, T b)
+    {
+        const T s = a + b;
+        const T v = s - a;
+        const T e = (a - (s - v)) + (b - v);
+        return {s, e};
+    }
+
+    // Igual, con |a| >= |b| (Dekker)
+    template <typename T>
+    inline DoubleFloat<T> DFQuickTwoSum(T a, T b)
+    {
+        const T s = a + b;
+        const T e = b - (s - a);
+        return {s, e};
+    }
+
+    // a = Hi + Lo con 12 bits en cada mitad, para que los productos de TwoProd sean exactos
+    template <typename T>
+    inline DoubleFloat<T> DFSplit(T a)
+    {
+        const T t  = DFConstant<T>(4097.0f) * a;
+        const T Hi = t - (t - a);
+        return {Hi, a - Hi};
+    }
+
+    // a * b exacto como p + e, sin FMA (Dekker)
+    template <typename T>
+    inline DoubleFloat<T> DFTwoProd(T a, T b)
+    {
+        const T              p = a * b;
+        const DoubleFloat<T> A = DFSplit(a);
+        const DoubleFloat<T> B = DFSplit(b);
+        const T              e = ((A.Hi * B.Hi - p) + A.Hi * B.Lo + A.Lo * B.Hi) + A.Lo * B.Lo;
+        return {p, e};
+    }
+
+    template <typename T>
+    inline DoubleFloat<T> DFNeg(const DoubleFloat<T>& a)
+    {
+        const T Zero = DFConstant<T>(0.0f);
+        return {Zero - a.Hi, Zero - a.Lo};
+    }
+
+    // Suma con las dos partes (precisa también cuando hay cancelación, como en x^2 - y^2)
+    template <typename T>
+    inline DoubleFloat<T> DFAdd(const DoubleFloat<T>& a, const DoubleFloat<T>& b)
+    {
+        DoubleFloat<T>       s = DFTwoSum(a.Hi, b.Hi);
+        const DoubleFloat<T> t = DFTwoSum(a.Lo, b.Lo);
+        s                      = DFQuickTwoSum(s.Hi, s.Lo + t.Hi);
+        return DFQuickTwoSum(s.Hi, s.Lo + t.Lo);
+    }
+
+    template <typename T>
+    inline DoubleFloat<T> DFSub(const DoubleFloat<T>& a, const DoubleFloat<T>& b)
+    {
+        return DFAdd(a, DFNeg(b));
+    }
+
+    template <typename T>
+    inline DoubleFloat<T> DFMul(const DoubleFloat<T>& a, const DoubleFloat<T>& b)
+    {
+        const DoubleFloat<T> p = DFTwoProd(a.Hi, b.Hi);
+        return DFQuickTwoSum(p.Hi, p.Lo + (a.Hi * b.Lo + a.Lo * b.Hi));
+    }
+
+    template <typename T>
+    inline DoubleFloat<T> DFSqr(const DoubleFloat<T>& a)
+    {
+        const DoubleFloat<T> p = DFTwoProd(a.Hi, a.Hi);
+        return DFQuickTwoSum(p.Hi, p.Lo + DFConstant<T>(2.0f) * a.Hi * a.Lo);
+    }
+
+    // Cociente con una corrección: q1 = a / b en float y q2 con el resto a - b * q1
+    template <typename T>
+    inline DoubleFloat<T> DFDiv(const DoubleFloat<T>& a, const DoubleFloat<T>& b)
+    {
+        const T              q1 = a.Hi / b.Hi;
+        const DoubleFloat<T> r  = DFSub(a, DFMul(b, DoubleFloat<T>{q1, DFConstant<T>(0.0f)}));
+        return DFQuickTwoSum(q1, r.Hi / b.Hi);
+    }
+
+} // namespace Diligent
@@ -0,0 +1,199 @@
+#pragma once
+
+// Envoltorios mínimos sobre registros SIMD para los kernels CPU.
+// El ancho se elige en tiempo de compilación: AVX2 (8 floats / 4 doubles) si el
+// compilador genera AVX2 (/arch:AVX2, -mavx2), SSE2 (4 / 2) en cualquier x64 y
+// escalar (1 / 1) en el resto. Las máscaras son packs con todos los bits a 1 en las
+// lanes activas, igual que devuelven las comparaciones de los intrínsecos.
+// Solo la incluyen los .cpp de src/CPU y sus cabeceras internas (CPUEscapePacket.hpp,
+// CPURayPacket3D.hpp): las flags de FRACTAL_CPU_AVX2 no llegan a las herramientas.
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#    define FRACTAL_CPU_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define FRACTAL_CPU_SIMD_SSE2 1
+#endif
+
+namespace Diligent
+{
+
+    template <typename T>
+    struct SimdPack;
+
+#if defined(FRACTAL_CPU_SIMD_AVX2)
+
+    template <>
+    struct SimdPack<float>
+    {
+        static constexpr int Width = 8;
+        __m256 v;
+
+        static SimdPack Broadcast(float x) { return {_mm256_set1_ps(x)}; }
+        static SimdPack Load(const float* p) { return {_mm256_loadu_ps(p)}; }
+        void            Store(float* p) const { _mm256_storeu_ps(p, v); }
+
+        friend SimdPack operator+(SimdPack a, SimdPack b) { return {_mm256_add_ps(a.v, b.v)}; }
+        friend SimdPack operator-(SimdPack a, SimdPack b) { return {_mm256_sub_ps(a.v, b.v)}; }
+        friend SimdPack operator*(SimdPack a, SimdPack b) { return {_mm256_mul_ps(a.v, b.v)}; }
+        friend SimdPack operator/(SimdPack a, SimdPack b) { return {_mm256_div_ps(a.v, b.v)}; }
+        friend SimdPack operator>(SimdPack a, SimdPack b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+        friend SimdPack operator<(SimdPack a, SimdPack b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+        friend SimdPack operator&(SimdPack a, SimdPack b) { return {_mm256_and_ps(a.v, b.v)}; }
+        friend SimdPack operator|(SimdPack a, SimdPack b) { return {_mm256_or_ps(a.v, b.v)}; }
+
+        // ~a & b
+        friend SimdPack AndNot(SimdPack a, SimdPack b) { return {_mm256_andnot_ps(a.v, b.v)}; }
+        friend SimdPack Select(SimdPack m, SimdPack a, SimdPack b) { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+        friend SimdPack Abs(SimdPack a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+        friend SimdPack Min(SimdPack a, SimdPack b) { return {_mm256_min_ps(a.v, b.v)}; }
+        friend SimdPack Max(SimdPack a, SimdPack b) { return {_mm256_max_ps(a.v, b.v)}; }
+        friend SimdPack Sqrt(SimdPack a) { return {_mm256_sqrt_ps(a.v)}; }
+        friend SimdPack Trunc(SimdPack a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)}; }
+        friend int      LaneMask(SimdPack m) { return _mm256_movemask_ps(m.v); }
+        friend bool     AnyLane(SimdPack m) { return _mm256_movemask_ps(m.v) != 0; }
+    };
+
+    template <>
+    struct SimdPack<double>
+    {
+        static constexpr int Width = 4;
+        __m256d v;
+
+        static SimdPack Broadcast(double x) { return {_mm256_set1_pd(x)}; }
+        static SimdPack Load(const double* p) { return {_mm256_loadu_pd(p)}; }
+        void            Store(double* p) const { _mm256_storeu_pd(p, v); }
+
+        friend SimdPack operator+(SimdPack a, SimdPack b) { return {_mm256_add_pd(a.v, b.v)}; }
+        friend SimdPack operator-(SimdPack a, SimdPack b) { return {_mm256_sub_pd(a.v, b.v)}; }
+        friend SimdPack operator*(SimdPack a, SimdPack b) { return {_mm256_mul_pd(a.v, b.v)}; }
+        friend SimdPack operator/(SimdPack a, SimdPack b) { return {_mm256_div_pd(a.v, b.v)}; }
+        friend SimdPack operator>(SimdPack a, SimdPack b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+        friend SimdPack operator<(SimdPack a, SimdPack b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+        friend SimdPack operator&(SimdPack a, SimdPack b) { return {_mm256_and_pd(a.v, b.v)}; }
+        friend SimdPack operator|(SimdPack a, SimdPack b) { return {_mm256_or_pd(a.v, b.v)}; }
+
+        friend SimdPack AndNot(SimdPack a, SimdPack b) { return {_mm256_andnot_pd(a.v, b.v)}; }
+        friend SimdPack Select(SimdPack m, SimdPack a, SimdPack b) { return {_mm256_blendv_pd(b.v, a.v, m.v)}; }
+        friend SimdPack Abs(SimdPack a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+        friend SimdPack Min(SimdPack a, SimdPack b) { return {_mm256_min_pd(a.v, b.v)}; }
+        friend SimdPack Max(SimdPack a, SimdPack b) { return {_mm256_max_pd(a.v, b.v)}; }
+        friend SimdPack Sqrt(SimdPack a) { return {_mm256_sqrt_pd(a.v)}; }
+        friend SimdPack Trunc(SimdPack a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)}; }
+        friend int      LaneMask(SimdPack m) { return _mm256_movemask_pd(m.v); }
+        friend bool     AnyLane(SimdPack m) { return _mm256_movemask_pd(m.v) != 0; }
+    };
+
+#elif defined(FRACTAL_CPU_SIMD_SSE2)
+
+    template <>
+    struct SimdPack<float>
+    {
+        static constexpr int Width = 4;
+        __m128 v;
+
+        static SimdPack Broadcast(float x) { return {_mm_set1_ps(x)}; }
+        static SimdPack Load(const float* p) { return {_mm_loadu_ps(p)}; }
+        void            Store(float* p) const { _mm_storeu_ps(p, v); }
+
+        friend SimdPack operator+(SimdPack a, SimdPack b) { return {_mm_add_ps(a.v, b.v)}; }
+        friend SimdPack operator-(SimdPack a, SimdPack b) { return {_mm_sub_ps(a.v, b.v)}; }
+        friend SimdPack operator*(SimdPack a, SimdPack b) { return {_mm_mul_ps(a.v, b.v)}; }
+        friend SimdPack operator/(SimdPack a, SimdPack b) { return {_mm_div_ps(a.v, b.v)}; }
+        friend SimdPack operator>(SimdPack a, SimdPack b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+        friend SimdPack operator<(SimdPack a, SimdPack b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+        friend SimdPack operator&(SimdPack a, SimdPack b) { return {_mm_and_ps(a.v, b.v)}; }
+        friend SimdPack operator|(SimdPack a, SimdPack b) { return {_mm_or_ps(a.v, b.v)}; }
+
+        friend SimdPack AndNot(SimdPack a, SimdPack b) { return {_mm_andnot_ps(a.v, b.v)}; }
+        friend SimdPack Select(SimdPack m, SimdPack a, SimdPack b) { return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))}; }
+        friend SimdPack Abs(SimdPack a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+        friend SimdPack Min(SimdPack a, SimdPack b) { return {_mm_min_ps(a.v, b.v)}; }
+        friend SimdPack Max(SimdPack a, SimdPack b) { return {_mm_max_ps(a.v, b.v)}; }
+        friend SimdPack Sqrt(SimdPack a) { return {_mm_sqrt_ps(a.v)}; }
+        // Sin SSE4.1 se pasa por enteros: solo vale para |a| < 2^31
+        friend SimdPack Trunc(SimdPack a) { return {_mm_cvtepi32_ps(_mm_cvttps_epi32(a.v))}; }
+        friend int      LaneMask(SimdPack m) { return _mm_movemask_ps(m.v); }
+        friend bool     AnyLane(SimdPack m) { return _mm_movemask_ps(m.v) != 0; }
+    };
+
+    template <>
+    struct SimdPack<double>
+    {
+        static constexpr int Width = 2;
+        __m128d v;
+
+        static SimdPack Broadcast(double x) { return {_mm_set1_pd(x)}; }
+        static SimdPack Load(const double* p) { return {_mm_loadu_pd(p)}; }
+        void            Store(double* p) const { _mm_storeu_pd(p, v); }
+
+        friend SimdPack operator+(SimdPack a, SimdPack b) { return {_mm_add_pd(a.v, b.v)}; }
+        friend SimdPack operator-(SimdPack a, SimdPack b) { return {_mm_sub_pd(a.v, b.v)}; }
+        friend SimdPack operator*(SimdPack a, SimdPack b) { return {_mm_mul_pd(a.v, b.v)}; }
+        friend SimdPack operator/(SimdPack a, SimdPack b) { return {_mm_div_pd(a.v, b.v)}; }
+        friend SimdPack operator>(SimdPack a, SimdPack b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+        friend SimdPack operator<(SimdPack a, SimdPack b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+        friend SimdPack operator&(SimdPack a, SimdPack b) { return {_mm_and_pd(a.v, b.v)}; }
+        friend SimdPack operator|(SimdPack a, SimdPack b) { return {_mm_or_pd(a.v, b.v)}; }
+
+        friend SimdPack AndNot(SimdPack a, SimdPack b) { return {_mm_andnot_pd(a.v, b.v)}; }
+        friend SimdPack Select(SimdPack m, SimdPack a, SimdPack b) { return {_mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v))}; }
+        friend SimdPack Abs(SimdPack a) { return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+        friend SimdPack Min(SimdPack a, SimdPack b) { return {_mm_min_pd(a.v, b.v)}; }
+        friend SimdPack Max(SimdPack a, SimdPack b) { return {_mm_max_pd(a.v, b.v)}; }
+        friend SimdPack Sqrt(SimdPack a) { return {_mm_sqrt_pd(a.v)}; }
+        friend SimdPack Trunc(SimdPack a) { return {_mm_cvtepi32_pd(_mm_cvttpd_epi32(a.v))}; }
+        friend int      LaneMask(SimdPack m) { return _mm_movemask_pd(m.v); }
+        friend bool     AnyLane(SimdPack m) { return _mm_movemask_pd(m.v) != 0; }
+    };
+
+#endif
+
+#if !defined(FRACTAL_CPU_SIMD_AVX2) && !defined(FRACTAL_CPU_SIMD_SSE2)
+
+    // Fallback escalar: una sola lane, las máscaras son 0 / 1.
+    template <typename T>
+    struct SimdPack
+    {
+        static constexpr int Width = 1;
+        T v;
+
+        static SimdPack Broadcast(T x) { return {x}; }
+        static SimdPack Load(const T* p) { return {*p}; }
+        void            Store(T* p) const { *p = v; }
+
+        friend SimdPack operator+(SimdPack a, SimdPack b) { return {a.v + b.v}; }
+        friend SimdPack operator-(SimdPack a, SimdPack b) { return {a.v - b.v}; }
+        friend SimdPack operator*(SimdPack a, SimdPack b) { return {a.v * b.v}; }
+        friend SimdPack operator/(SimdPack a, SimdPack b) { return {a.v / b.v}; }
+        friend SimdPack operator>(SimdPack a, SimdPack b) { return {a.v > b.v ? T(1) : T(0)}; }
+        friend SimdPack operator<(SimdPack a, SimdPack b) { return {a.v < b.v ? T(1) : T(0)}; }
+        friend SimdPack operator&(SimdPack a, SimdPack b) { return {(a.v != 0 && b.v != 0) ? T(1) : T(0)}; }
+        friend SimdPack operator|(SimdPack a, SimdPack b) { return {(a.v != 0 || b.v != 0) ? T(1) : T(0)}; }
+
+        friend SimdPack AndNot(SimdPack a, SimdPack b) { return {(a.v == 0 && b.v != 0) ? T(1) : T(0)}; }
+        friend SimdPack Select(SimdPack m, SimdPack a, SimdPack b) { return m.v != 0 ? a : b; }
+        friend SimdPack Abs(SimdPack a) { return {std::abs(a.v)}; }
+        friend SimdPack Min(SimdPack a, SimdPack b) { return {a.v < b.v ? a.v : b.v}; }
+        friend SimdPack Max(SimdPack a, SimdPack b) { return {a.v > b.v ? a.v : b.v}; }
+        friend SimdPack Sqrt(SimdPack a) { return {std::sqrt(a.v)}; }
+        friend SimdPack Trunc(SimdPack a) { return {std::trunc(a.v)}; }
+        friend int      LaneMask(SimdPack m) { return m.v != 0 ? 1 : 0; }
+        friend bool     AnyLane(SimdPack m) { return m.v != 0; }
+    };
+
+#endif
+
+    // Máscara con todas las lanes activas
+    template <typename T>
+    inline SimdPack<T> AllLanes()
+    {
+        const SimdPack<T> Zero = SimdPack<T>::Broadcast(T(0));
+        return Zero < SimdPack<T>::Broadcast(T(1));
+    }
+
+} // namespace Diligent
@@ -0,0 +1,128 @@
+#include "ComputeGroupTuner.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Diligent
+{
+
+    const std::vector<ComputeGroupTuner::GroupSize>& ComputeGroupTuner::GetCandidates()
+    {
+        static const std::vector<GroupSize> Candidates =
+        {
+            {8, 8}, {16, 8}, {8, 16}, {16, 16}, {32, 8}, {8, 32}, {64, 4}, {32, 16}, {32, 32}
+        };
+        return Candidates;
+    }
+
+    ComputeGroupTuner::ComputeGroupTuner(const char* FilePath) :
+        m_FilePath{FilePath}
+    {
+        Load();
+    }
+
+    void ComputeGroupTuner::Load()
+    {
+        std::ifstream File{m_FilePath};
+        if (!File)
+            return;
+
+        // Una línea por entrada: X Y ancho alto is3D adaptador (el nombre puede tener espacios)
+        std::string Line;
+        while (std::getline(File, Line))
+        {
+            std::istringstream Stream{Line};
+            Entry              E;
+            int                Is3D = 0;
+            if (!(Stream >> E.Size.X >> E.Size.Y >> E.Width >> E.Height >> Is3D))
+                continue;
+            std::getline(Stream >> std::ws, E.Adapter);
+            if (E.Size.X == 0 || E.Size.Y == 0 || E.Size.X * E.Size.Y > 1024)
+                continue;
+            E.Is3D = Is3D != 0;
+            m_Entries.push_back(E);
+        }
+    }
+
+    void ComputeGroupTuner::Save() const
+    {
+        std::ofstream File{m_FilePath, std::ios::trunc};
+        for (const auto& E : m_Entries)
+            File << E.Size.X << ' ' << E.Size.Y << ' ' << E.Width << ' ' << E.Height << ' ' << (E.Is3D ? 1 : 0) << ' ' << E.Adapter << '\n';
+    }
+
+    bool ComputeGroupTuner::Find(const char* Adapter, bool Is3D, Uint32 Width, Uint32 Height, GroupSize& Size) const
+    {
+        const Entry* pBest    = nullptr;
+        long long    BestDiff = 0;
+        for (const auto& E : m_Entries)
+        {
+            if (E.Is3D != Is3D || E.Adapter != Adapter)
+                continue;
+
+            const long long Diff = std::llabs(static_cast<long long>(E.Width) * E.Height - static_cast<long long>(Width) * Height);
+            if (!pBest || Diff < BestDiff)
+            {
+                pBest    = &E;
+                BestDiff = Diff;
+            }
+        }
+        if (!pBest)
+            return false;
+
+        Size = pBest->Size;
+        return true;
+    }
+
+    void ComputeGroupTuner::Begin(const char* Adapter, bool Is3D, Uint32 Width, Uint32 Height)
+    {
+        m_Tuning.Adapter = Adapter;
+        m_Tuning.Is3D    = Is3D;
+        m_Tuning.Width   = Width;
+        m_Tuning.Height  = Height;
+
+        m_Running          = true;
+        m_CurrentCandidate = 0;
+        m_Times.assign(GetCandidates().size(), std::numeric_limits<double>::infinity());
+    }
+
+    void ComputeGroupTuner::ReportTime(double Seconds)
+    {
+        if (!m_Running)
+            return;
+
+        m_Times[m_CurrentCandidate] = Seconds;
+        if (++m_CurrentCandidate < GetCandidates().size())
+            return;
+
+        m_Running = false;
+
+        size_t Best = 0;
+        for (size_t i = 1; i < m_Times.size(); ++i)
+        {
+            if (m_Times[i] < m_Times[Best])
+                Best = i;
+        }
+        // Si no compiló ninguno no se guarda nada
+        if (m_Times[Best] == std::numeric_limits<double>::infinity())
+            return;
+
+        m_LastBest    = GetCandidates()[Best];
+        m_Tuning.Size = m_LastBest;
+
+        // Sustituye la entrada de esta misma configuración si ya existía
+        for (auto& E : m_Entries)
+        {
+            if (E.Adapter == m_Tuning.Adapter && E.Is3D == m_Tuning.Is3D && E.Width == m_Tuning.Width && E.Height == m_Tuning.Height)
+            {
+                E = m_Tuning;
+                Save();
+                return;
+            }
+        }
+        m_Entries.push_back(m_Tuning);
+        Save();
+    }
+
+} // namespace Diligent
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+    // Elige el tamaño de grupo de hilos del compute shader del fractal midiendo varios
+    // candidatos (uno por frame) y guarda el ganador en disco por adaptador, modo (2D/3D)
+    // y resolución. Solo lleva la cuenta: compilar y cronometrar lo hace FractalViewer.
+    class ComputeGroupTuner
+    {
+    public:
+        struct GroupSize
+        {
+            Uint32 X = 16;
+            Uint32 Y = 16;
+        };
+
+        // Grupos cuadrados y rectangulares (filas largas / columnas largas), todos <= 1024 hilos
+        static const std::vector<GroupSize>& GetCandidates();
+
+        explicit ComputeGroupTuner(const char* FilePath);
+
+        // Tamaño guardado para este adaptador y modo: el de la misma resolución o, si no hay,
+        // el de la resolución más parecida. Devuelve false si no hay ninguno.
+        bool Find(const char* Adapter, bool Is3D, Uint32 Width, Uint32 Height, GroupSize& Size) const;
+
+        // Empieza a medir todos los candidatos para esta configuración
+        void Begin(const char* Adapter, bool Is3D, Uint32 Width, Uint32 Height);
+
+        bool IsRunning() const { return m_Running; }
+
+        // Candidato que toca medir en este frame
+        GroupSize GetCurrentCandidate() const { return GetCandidates()[m_CurrentCandidate]; }
+
+        // Tiempo por dispatch del candidato actual (infinito si no se pudo compilar). Tras el
+        // último candidato guarda el más rápido.
+        void ReportTime(double Seconds);
+
+        // Resultado de la última medición completa
+        GroupSize                  GetLastBest() const { return m_LastBest; }
+        const std::vector<double>& GetLastTimes() const { return m_Times; }
+
+    private:
+        struct Entry
+        {
+            std::string Adapter;
+            bool        Is3D   = false;
+            Uint32      Width  = 0;
+            Uint32      Height = 0;
+            GroupSize   Size;
+        };
+
+        void Load();
+        void Save() const;
+
+        std::string        m_FilePath;
+        std::vector<Entry> m_Entries;
+
+        bool                m_Running          = false;
+        size_t              m_CurrentCandidate = 0;
+        Entry               m_Tuning;
+        std::vector<double> m_Times;
+        GroupSize           m_LastBest;
+    };
+
+} // namespace Diligent
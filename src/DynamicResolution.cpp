@@ -0,0 +1,71 @@
+#include "DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Diligent
+{
+
+    void DynamicResolution::GetLevelSize(Uint32 Level, Uint32 Width, Uint32 Height, Uint32& LevelWidth, Uint32& LevelHeight)
+    {
+        const float Scale = LevelScales[std::min(Level, NumLevels - 1)];
+        LevelWidth  = std::max(static_cast<Uint32>(std::ceil(static_cast<float>(Width) * Scale)), 1u);
+        LevelHeight = std::max(static_cast<Uint32>(std::ceil(static_cast<float>(Height) * Scale)), 1u);
+    }
+
+    bool DynamicResolution::ReportFrameTime(double Ms)
+    {
+        if (Ms <= 0.0)
+            return false;
+        if (m_Skip > 0)
+        {
+            --m_Skip;
+            return false;
+        }
+
+        m_AverageMs = m_NumSamples == 0 ? Ms : m_AverageMs + (Ms - m_AverageMs) * 0.3;
+        if (++m_NumSamples < MinSamples)
+            return false;
+
+        // El coste va con el número de píxeles: se estima el tiempo de cada nivel a partir del
+        // actual. Se baja hasta el primer nivel que cabe en el presupuesto y solo se sube si el
+        // nivel de arriba cabe con margen, para no oscilar entre dos niveles
+        const double CurrentScale = LevelScales[m_Level];
+        auto         Estimate     = [&](Uint32 Level) {
+            const double Ratio = LevelScales[Level] / CurrentScale;
+            return m_AverageMs * Ratio * Ratio;
+        };
+
+        Uint32 Level = m_Level;
+        if (m_AverageMs > m_BudgetMs)
+        {
+            while (Level + 1 < NumLevels && Estimate(Level) > m_BudgetMs)
+                ++Level;
+        }
+        else
+        {
+            while (Level > 0 && Estimate(Level - 1) < m_BudgetMs * 0.85)
+                --Level;
+        }
+        if (Level == m_Level)
+            return false;
+
+        m_Level = Level;
+        DiscardSamples();
+        return true;
+    }
+
+    void DynamicResolution::Reset()
+    {
+        m_Level = 0;
+        DiscardSamples();
+    }
+
+    void DynamicResolution::DiscardSamples()
+    {
+        m_NumSamples = 0;
+        m_AverageMs  = -1.0;
+        m_Skip       = SettleFrames;
+    }
+
+} // namespace Diligent
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+    // Escala de render del fractal según el tiempo de frame: elige uno de NumLevels tamaños
+    // (fracción de la swap chain en cada eje) para que el tiempo medido quede por debajo del
+    // presupuesto. Solo lleva la cuenta: las texturas de cada nivel y el reescalado a pantalla
+    // los hace FractalViewer.
+    class DynamicResolution
+    {
+    public:
+        static constexpr Uint32 NumLevels = 4;
+
+        // Nivel 0 = resolución completa; cada nivel tiene ~2/3 de los píxeles del anterior
+        static constexpr float LevelScales[NumLevels] = {1.0f, 0.8f, 0.65f, 0.5f};
+
+        // Tamaño de un nivel para una swap chain de Width x Height (al menos 1x1)
+        static void GetLevelSize(Uint32 Level, Uint32 Width, Uint32 Height, Uint32& LevelWidth, Uint32& LevelHeight);
+
+        void   SetBudget(double Ms) { m_BudgetMs = Ms; }
+        double GetBudget() const { return m_BudgetMs; }
+
+        // Tiempo (ms) de un frame renderizado con el nivel actual. Devuelve true si cambia el
+        // nivel; los tiempos de los frames siguientes se ignoran hasta que se renderizan con él
+        bool ReportFrameTime(double Ms);
+
+        // Vuelve a resolución completa y olvida lo medido
+        void Reset();
+
+        // Olvida lo medido sin cambiar de nivel (las texturas activas han cambiado)
+        void DiscardSamples();
+
+        Uint32 GetLevel() const { return m_Level; }
+        float  GetScale() const { return LevelScales[m_Level]; }
+        double GetAverageMs() const { return m_AverageMs; }
+
+    private:
+        // Frames que se ignoran tras un cambio (los tiempos de la GPU llegan unos frames tarde)
+        // y medidas que hacen falta para decidir
+        static constexpr Uint32 SettleFrames = 4;
+        static constexpr Uint32 MinSamples   = 3;
+
+        double m_BudgetMs   = 1000.0 / 60.0;
+        double m_AverageMs  = -1.0; // media exponencial con el nivel actual (-1 = sin medidas)
+        Uint32 m_NumSamples = 0;
+        Uint32 m_Level      = 0;
+        Uint32 m_Skip       = 0;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,506 @@
+#include "FrameWriter.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace Diligent
+{
+
+    namespace
+    {
+        std::uint32_t Crc32(const std::uint8_t* pData, size_t Size, std::uint32_t Crc = 0)
+        {
+            static const auto Table = [] {
+                std::vector<std::uint32_t> T(256);
+                for (std::uint32_t n = 0; n < 256; ++n)
+                {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    T[n] = c;
+                }
+                return T;
+            }();
+
+            Crc = ~Crc;
+            for (size_t i = 0; i < Size; ++i)
+                Crc = Table[(Crc ^ pData[i]) & 0xFF] ^ (Crc >> 8);
+            return ~Crc;
+        }
+
+        void PutU32BE(std::vector<std::uint8_t>& Out, std::uint32_t v)
+        {
+            Out.push_back(static_cast<std::uint8_t>(v >> 24));
+            Out.push_back(static_cast<std::uint8_t>(v >> 16));
+            Out.push_back(static_cast<std::uint8_t>(v >> 8));
+            Out.push_back(static_cast<std::uint8_t>(v));
+        }
+
+        void PutChunk(std::vector<std::uint8_t>& Out, const char* Type, const std::vector<std::uint8_t>& Data)
+        {
+            PutU32BE(Out, static_cast<std::uint32_t>(Data.size()));
+            const size_t TypeStart = Out.size();
+            Out.insert(Out.end(), Type, Type + 4);
+            Out.insert(Out.end(), Data.begin(), Data.end());
+            PutU32BE(Out, Crc32(&Out[TypeStart], Out.size() - TypeStart));
+        }
+
+        std::uint32_t Adler32(const std::vector<std::uint8_t>& Data)
+        {
+            std::uint32_t A = 1, B = 0;
+            for (size_t Pos = 0; Pos < Data.size();)
+            {
+                // 5552 bytes es lo máximo que se puede sumar sin desbordar antes del módulo
+                const size_t End = std::min<size_t>(Data.size(), Pos + 5552);
+                for (; Pos < End; ++Pos)
+                {
+                    A += Data[Pos];
+                    B += A;
+                }
+                A %= 65521;
+                B %= 65521;
+            }
+            return (B << 16) | A;
+        }
+
+        // Deflate con bloques sin comprimir: cota superior del tamaño y respaldo cuando el
+        // código fijo no gana (ruido, degradados muy finos)
+        void DeflateStored(std::vector<std::uint8_t>& Out, const std::vector<std::uint8_t>& Data)
+        {
+            size_t Pos = 0;
+            do
+            {
+                const size_t        Len   = std::min<size_t>(Data.size() - Pos, 65535);
+                const std::uint16_t Len16 = static_cast<std::uint16_t>(Len);
+                Out.push_back(Pos + Len == Data.size() ? 1 : 0);
+                Out.push_back(static_cast<std::uint8_t>(Len16));
+                Out.push_back(static_cast<std::uint8_t>(Len16 >> 8));
+                Out.push_back(static_cast<std::uint8_t>(~Len16));
+                Out.push_back(static_cast<std::uint8_t>(~Len16 >> 8));
+                Out.insert(Out.end(), Data.begin() + Pos, Data.begin() + Pos + Len);
+                Pos += Len;
+            } while (Pos < Data.size());
+        }
+
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<std::uint8_t>& Out) :
+                m_Out{Out}
+            {}
+
+            // Bits en orden LSB primero, como los campos extra de deflate
+            void Put(std::uint32_t Bits, int Count)
+            {
+                m_Acc |= static_cast<std::uint64_t>(Bits) << m_Count;
+                m_Count += Count;
+                while (m_Count >= 8)
+                {
+                    m_Out.push_back(static_cast<std::uint8_t>(m_Acc));
+                    m_Acc >>= 8;
+                    m_Count -= 8;
+                }
+            }
+
+            // Los códigos Huffman van con el bit más significativo primero
+            void PutCode(std::uint32_t Code, int Count)
+            {
+                std::uint32_t Rev = 0;
+                for (int i = 0; i < Count; ++i)
+                    Rev |= ((Code >> i) & 1u) << (Count - 1 - i);
+                Put(Rev, Count);
+            }
+
+            void Flush()
+            {
+                if (m_Count > 0)
+                    m_Out.push_back(static_cast<std::uint8_t>(m_Acc));
+                m_Acc   = 0;
+                m_Count = 0;
+            }
+
+        private:
+            std::vector<std::uint8_t>& m_Out;
+            std::uint64_t              m_Acc   = 0;
+            int                        m_Count = 0;
+        };
+
+        void PutFixedLiteral(BitWriter& Bits, std::uint32_t Symbol)
+        {
+            if (Symbol < 144)
+                Bits.PutCode(0x30 + Symbol, 8);
+            else if (Symbol < 256)
+                Bits.PutCode(0x190 + Symbol - 144, 9);
+            else if (Symbol < 280)
+                Bits.PutCode(Symbol - 256, 7);
+            else
+                Bits.PutCode(0xC0 + Symbol - 280, 8);
+        }
+
+        void PutFixedMatch(BitWriter& Bits, std::uint32_t Length, std::uint32_t Distance)
+        {
+            static const std::uint16_t LengthBase[29]  = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                          35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+            static const std::uint8_t  LengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                                          3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+            static const std::uint16_t DistBase[30]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                                          193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+            static const std::uint8_t  DistExtra[30]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                                          6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+            int l = 28;
+            while (LengthBase[l] > Length)
+                --l;
+            PutFixedLiteral(Bits, 257 + l);
+            Bits.Put(Length - LengthBase[l], LengthExtra[l]);
+
+            int d = 29;
+            while (DistBase[d] > Distance)
+                --d;
+            Bits.PutCode(d, 5);
+            Bits.Put(Distance - DistBase[d], DistExtra[d]);
+        }
+
+        // Un bloque deflate con el código Huffman fijo y LZ77 con cadenas hash (ventana de 32 KB).
+        // Los fractales tienen grandes zonas de color liso (interior, fondo, bandas de
+        // iteración) que, tras el filtro de fila, son casi todo repeticiones.
+        void DeflateFixed(std::vector<std::uint8_t>& Out, const std::vector<std::uint8_t>& Data)
+        {
+            constexpr size_t        WindowSize = 32768;
+            constexpr size_t        HashSize   = 1 << 15;
+            constexpr std::uint32_t MinMatch   = 3;
+            constexpr std::uint32_t MaxMatch   = 258;
+            constexpr int           MaxChain   = 32;
+            constexpr std::int32_t  None       = -1;
+
+            std::vector<std::int32_t> Head(HashSize, None);
+            std::vector<std::int32_t> Prev(WindowSize, None);
+
+            const size_t Size   = Data.size();
+            const auto   Hash   = [&](size_t i) {
+                return ((Data[i] << 10) ^ (Data[i + 1] << 5) ^ Data[i + 2]) & (HashSize - 1);
+            };
+            const auto   Insert = [&](size_t i) {
+                if (i + MinMatch > Size)
+                    return;
+                const size_t h       = Hash(i);
+                Prev[i % WindowSize] = Head[h];
+                Head[h]              = static_cast<std::int32_t>(i);
+            };
+
+            BitWriter Bits{Out};
+            Bits.Put(1, 1); // BFINAL
+            Bits.Put(1, 2); // BTYPE = 01, código fijo
+
+            size_t Pos = 0;
+            while (Pos < Size)
+            {
+                std::uint32_t BestLen  = 0;
+                std::uint32_t BestDist = 0;
+                if (Pos + MinMatch <= Size)
+                {
+                    const std::uint32_t MaxLen    = static_cast<std::uint32_t>(std::min<size_t>(MaxMatch, Size - Pos));
+                    std::int32_t        Candidate = Head[Hash(Pos)];
+                    for (int Chain = 0; Chain < MaxChain && Candidate != None; ++Chain)
+                    {
+                        const size_t Dist = Pos - static_cast<size_t>(Candidate);
+                        if (Dist > WindowSize)
+                            break;
+                        std::uint32_t Len = 0;
+                        while (Len < MaxLen && Data[Candidate + Len] == Data[Pos + Len])
+                            ++Len;
+                        if (Len > BestLen)
+                        {
+                            BestLen  = Len;
+                            BestDist = static_cast<std::uint32_t>(Dist);
+                            if (Len == MaxLen)
+                                break;
+                        }
+                        const std::int32_t Next = Prev[Candidate % WindowSize];
+                        // La entrada de Prev puede ser ya de otra vuelta de la ventana
+                        if (Next >= Candidate)
+                            break;
+                        Candidate = Next;
+                    }
+                }
+
+                if (BestLen >= MinMatch)
+                {
+                    PutFixedMatch(Bits, BestLen, BestDist);
+                    for (std::uint32_t i = 0; i < BestLen; ++i)
+                        Insert(Pos + i);
+                    Pos += BestLen;
+                }
+                else
+                {
+                    PutFixedLiteral(Bits, Data[Pos]);
+                    Insert(Pos);
+                    ++Pos;
+                }
+            }
+            PutFixedLiteral(Bits, 256);
+            Bits.Flush();
+        }
+
+        // Flujo zlib (RFC 1950) sin depender de zlib, que no está en los nodos sin GPU. Se
+        // queda con el bloque comprimido salvo que ocupe más que los bloques sin comprimir.
+        std::vector<std::uint8_t> ZlibCompress(const std::vector<std::uint8_t>& Data)
+        {
+            std::vector<std::uint8_t> Out;
+            Out.reserve(Data.size() / 2 + 64);
+            Out.push_back(0x78);
+            Out.push_back(0x01);
+            DeflateFixed(Out, Data);
+
+            const size_t StoredSize = 2 + Data.size() + (Data.size() / 65535 + 1) * 5;
+            if (Out.size() > StoredSize)
+            {
+                Out.resize(2);
+                DeflateStored(Out, Data);
+            }
+
+            PutU32BE(Out, Adler32(Data));
+            return Out;
+        }
+
+        // Filtro de fila de PNG con la heurística de la especificación: el que da la menor
+        // suma de diferencias con signo en valor absoluto
+        void FilterRow(const std::uint8_t* pRow, const std::uint8_t* pPrev, size_t RowBytes, size_t Bpp, std::vector<std::uint8_t>& Out)
+        {
+            const auto Paeth = [](int a, int b, int c) {
+                const int p  = a + b - c;
+                const int pa = std::abs(p - a);
+                const int pb = std::abs(p - b);
+                const int pc = std::abs(p - c);
+                return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+            };
+            const auto Predict = [&](int Filter, size_t i) -> int {
+                const int a = i >= Bpp ? pRow[i - Bpp] : 0;
+                const int b = pPrev != nullptr ? pPrev[i] : 0;
+                const int c = pPrev != nullptr && i >= Bpp ? pPrev[i - Bpp] : 0;
+                switch (Filter)
+                {
+                    case 1: return a;
+                    case 2: return b;
+                    case 3: return (a + b) / 2;
+                    case 4: return Paeth(a, b, c);
+                    default: return 0;
+                }
+            };
+
+            int    BestFilter = 0;
+            size_t BestCost   = ~size_t{0};
+            for (int Filter = 0; Filter < 5; ++Filter)
+            {
+                size_t Cost = 0;
+                for (size_t i = 0; i < RowBytes; ++i)
+                    Cost += std::abs(static_cast<std::int8_t>(pRow[i] - Predict(Filter, i)));
+                if (Cost < BestCost)
+                {
+                    BestCost   = Cost;
+                    BestFilter = Filter;
+                }
+            }
+
+            Out.push_back(static_cast<std::uint8_t>(BestFilter));
+            for (size_t i = 0; i < RowBytes; ++i)
+                Out.push_back(static_cast<std::uint8_t>(pRow[i] - Predict(BestFilter, i)));
+        }
+
+        std::uint8_t ClampByte(float v)
+        {
+            return static_cast<std::uint8_t>(std::min(std::max(v + 0.5f, 0.0f), 255.0f));
+        }
+    } // namespace
+
+    std::string WithExtension(const std::string& Path, const char* Extension)
+    {
+        const size_t Len = std::strlen(Extension);
+        if (Path.size() >= Len &&
+            std::equal(Path.end() - Len, Path.end(), Extension, [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            }))
+            return Path;
+        return Path + Extension;
+    }
+
+    FrameWriter::FrameWriter(const std::string& Path, FrameFormat Format, std::uint32_t Width, std::uint32_t Height, std::uint32_t FPS,
+                             std::uint32_t MaxQueuedFrames) :
+        m_Path{Path},
+        m_Format{Format},
+        m_Width{Width},
+        m_Height{Height},
+        m_FPS{std::max(FPS, 1u)},
+        m_MaxQueuedFrames{std::max(MaxQueuedFrames, 1u)}
+    {
+        if (m_Format != FrameFormat::PNG)
+        {
+            m_pFile = std::fopen(m_Path.c_str(), "wb");
+            if (m_pFile == nullptr)
+                m_Error = true;
+            else if (m_Format == FrameFormat::Y4M)
+                m_Error = std::fprintf(m_pFile, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", m_Width, m_Height, m_FPS) < 0;
+        }
+        m_Worker = std::thread{&FrameWriter::WorkerThread, this};
+    }
+
+    FrameWriter::~FrameWriter()
+    {
+        Finish();
+    }
+
+    void FrameWriter::Push(std::vector<std::uint8_t>&& RGBA)
+    {
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        m_CV.wait(Lock, [this] { return m_Queue.size() < m_MaxQueuedFrames || m_Stop; });
+        if (m_Stop)
+            return;
+        m_Queue.push_back(std::move(RGBA));
+        m_CV.notify_all();
+    }
+
+    void FrameWriter::Finish()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Stop = true;
+        }
+        m_CV.notify_all();
+        if (m_Worker.joinable())
+            m_Worker.join();
+
+        if (m_pFile != nullptr)
+        {
+            if (std::fclose(m_pFile) != 0)
+                m_Error = true;
+            m_pFile = nullptr;
+        }
+    }
+
+    bool FrameWriter::HasError() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Error;
+    }
+
+    std::uint32_t FrameWriter::GetNumWritten() const
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Written;
+    }
+
+    const char* FrameWriter::GetFormatExtension(FrameFormat Format)
+    {
+        switch (Format)
+        {
+            case FrameFormat::Y4M: return ".y4m";
+            case FrameFormat::PNG: return ".png";
+            default: return ".rgba";
+        }
+    }
+
+    std::string FrameWriter::GetOutputPath(const std::string& OutPath, FrameFormat Format)
+    {
+        const std::string Path = WithExtension(OutPath, GetFormatExtension(Format));
+        if (Format != FrameFormat::PNG)
+            return Path;
+        return Path.substr(0, Path.size() - std::strlen(GetFormatExtension(Format)));
+    }
+
+    void FrameWriter::WorkerThread()
+    {
+        for (;;)
+        {
+            std::vector<std::uint8_t> Frame;
+            std::uint32_t             Index = 0;
+            {
+                std::unique_lock<std::mutex> Lock{m_Mtx};
+                m_CV.wait(Lock, [this] { return !m_Queue.empty() || m_Stop; });
+                // Al parar se termina lo que ya estaba en cola
+                if (m_Queue.empty())
+                    return;
+                Frame = std::move(m_Queue.front());
+                m_Queue.pop_front();
+                Index = m_Written;
+            }
+            m_CV.notify_all();
+
+            const bool Ok = !m_Error && WriteFrame(Frame, Index);
+
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Error = m_Error || !Ok;
+            ++m_Written;
+        }
+    }
+
+    bool FrameWriter::WriteFrame(const std::vector<std::uint8_t>& RGBA, std::uint32_t Index)
+    {
+        if (RGBA.size() != static_cast<size_t>(m_Width) * m_Height * 4)
+            return false;
+
+        switch (m_Format)
+        {
+            case FrameFormat::Y4M: return WriteY4MFrame(RGBA);
+            case FrameFormat::PNG: return WritePNG(RGBA, Index);
+            default: return m_pFile != nullptr && std::fwrite(RGBA.data(), 1, RGBA.size(), m_pFile) == RGBA.size();
+        }
+    }
+
+    bool FrameWriter::WriteY4MFrame(const std::vector<std::uint8_t>& RGBA)
+    {
+        if (m_pFile == nullptr)
+            return false;
+
+        // BT.601, rango de estudio, planos Y, Cb y Cr completos (C444)
+        const size_t              NumPixels = static_cast<size_t>(m_Width) * m_Height;
+        std::vector<std::uint8_t> Planes(NumPixels * 3);
+        for (size_t i = 0; i < NumPixels; ++i)
+        {
+            const float R = RGBA[i * 4 + 0];
+            const float G = RGBA[i * 4 + 1];
+            const float B = RGBA[i * 4 + 2];
+
+            Planes[i]                 = ClampByte(16.0f + 0.2568f * R + 0.5041f * G + 0.0979f * B);
+            Planes[NumPixels + i]     = ClampByte(128.0f - 0.1482f * R - 0.2910f * G + 0.4392f * B);
+            Planes[2 * NumPixels + i] = ClampByte(128.0f + 0.4392f * R - 0.3678f * G - 0.0714f * B);
+        }
+
+        return std::fputs("FRAME\n", m_pFile) >= 0 && std::fwrite(Planes.data(), 1, Planes.size(), m_pFile) == Planes.size();
+    }
+
+    bool FrameWriter::WritePNG(const std::vector<std::uint8_t>& RGBA, std::uint32_t Index)
+    {
+        // Filas RGB8, cada una con su byte de filtro delante
+        const size_t              RowBytes = static_cast<size_t>(m_Width) * 3;
+        std::vector<std::uint8_t> Rows(RowBytes * m_Height);
+        for (size_t i = 0, NumPixels = static_cast<size_t>(m_Width) * m_Height; i < NumPixels; ++i)
+            std::copy(&RGBA[i * 4], &RGBA[i * 4 + 3], &Rows[i * 3]);
+
+        std::vector<std::uint8_t> Raw;
+        Raw.reserve((RowBytes + 1) * m_Height);
+        for (std::uint32_t y = 0; y < m_Height; ++y)
+            FilterRow(&Rows[y * RowBytes], y > 0 ? &Rows[(y - 1) * RowBytes] : nullptr, RowBytes, 3, Raw);
+
+        std::vector<std::uint8_t> Header;
+        PutU32BE(Header, m_Width);
+        PutU32BE(Header, m_Height);
+        Header.insert(Header.end(), {8, 2, 0, 0, 0}); // 8 bits, RGB, deflate, filtros adaptativos, sin entrelazado
+
+        static const std::uint8_t Signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<std::uint8_t> Png(Signature, Signature + sizeof(Signature));
+        PutChunk(Png, "IHDR", Header);
+        PutChunk(Png, "IDAT", ZlibCompress(Raw));
+        PutChunk(Png, "IEND", {});
+
+        char Suffix[32];
+        std::snprintf(Suffix, sizeof(Suffix), "_%05u.png", Index);
+        std::FILE* pFile = std::fopen((m_Path + Suffix).c_str(), "wb");
+        if (pFile == nullptr)
+            return false;
+        const bool Ok = std::fwrite(Png.data(), 1, Png.size(), pFile) == Png.size();
+        return std::fclose(pFile) == 0 && Ok;
+    }
+
+} // namespace Diligent
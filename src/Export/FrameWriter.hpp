@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Diligent
+{
+
+    enum class FrameFormat : int
+    {
+        Y4M = 0, // un solo .y4m, YUV 4:4:4 (BT.601, rango de estudio)
+        PNG,     // secuencia Base_00000.png, RGB8
+        RawRGBA  // un solo fichero con los frames RGBA8 seguidos
+    };
+
+    // Path con la extensión Extension (".y4m", ".tif"...), que se añade solo si no termina
+    // ya en ella, sin distinguir mayúsculas. La usan todas las herramientas con --out.
+    std::string WithExtension(const std::string& Path, const char* Extension);
+
+    // Escribe en disco los frames de una exportación desde un hilo propio, para que ni el
+    // render ni la lectura de la GPU esperen al disco. No depende de Diligent: lo usan el
+    // visor y la exportación por CPU (FractalExportCPU).
+    class FrameWriter
+    {
+    public:
+        // Path: fichero (.y4m / raw) o prefijo de la secuencia PNG. MaxQueuedFrames limita
+        // la memoria: Push espera si el disco va por detrás.
+        FrameWriter(const std::string& Path, FrameFormat Format, std::uint32_t Width, std::uint32_t Height, std::uint32_t FPS,
+                    std::uint32_t MaxQueuedFrames = 8);
+        ~FrameWriter();
+
+        FrameWriter(const FrameWriter&) = delete;
+        FrameWriter& operator=(const FrameWriter&) = delete;
+
+        // Encola un frame RGBA8 de Width * Height píxeles, fila 0 arriba, sin relleno entre filas
+        void Push(std::vector<std::uint8_t>&& RGBA);
+
+        // Espera a que se escriba todo lo encolado y cierra el fichero
+        void Finish();
+
+        bool          HasError() const;
+        std::uint32_t GetNumWritten() const;
+
+        static const char* GetFormatExtension(FrameFormat Format);
+
+        // Path del constructor a partir del --out del usuario: añade la extensión del formato
+        // si no la lleva ya; en PNG, que es un prefijo, la quita ("zoom.png" -> zoom_00000.png)
+        static std::string GetOutputPath(const std::string& OutPath, FrameFormat Format);
+
+    private:
+        void WorkerThread();
+        bool WriteFrame(const std::vector<std::uint8_t>& RGBA, std::uint32_t Index);
+        bool WriteY4MFrame(const std::vector<std::uint8_t>& RGBA);
+        bool WritePNG(const std::vector<std::uint8_t>& RGBA, std::uint32_t Index);
+
+        std::string   m_Path;
+        FrameFormat   m_Format;
+        std::uint32_t m_Width;
+        std::uint32_t m_Height;
+        std::uint32_t m_FPS;
+        std::uint32_t m_MaxQueuedFrames;
+        std::FILE*    m_pFile = nullptr;
+
+        mutable std::mutex                    m_Mtx;
+        std::condition_variable               m_CV;
+        std::deque<std::vector<std::uint8_t>> m_Queue;
+        bool                                  m_Stop    = false;
+        bool                                  m_Error   = false;
+        std::uint32_t                         m_Written = 0;
+        std::thread                           m_Worker;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,203 @@
+#include "PosterWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Diligent
+{
+
+    namespace
+    {
+        constexpr char ProgressMagic[8] = {'F', 'P', 'O', 'S', 'T', 'E', 'R', '1'};
+
+        // Etiquetas y tipos de TIFF que usa el póster
+        enum : std::uint16_t
+        {
+            TIFF_SHORT = 3,
+            TIFF_LONG  = 4,
+            TIFF_LONG8 = 16
+        };
+
+        bool SeekTo(std::FILE* pFile, std::uint64_t Offset)
+        {
+#ifdef _WIN32
+            return _fseeki64(pFile, static_cast<__int64>(Offset), SEEK_SET) == 0;
+#else
+            return fseeko(pFile, static_cast<off_t>(Offset), SEEK_SET) == 0;
+#endif
+        }
+
+        void PutLE(std::vector<std::uint8_t>& Out, std::uint64_t v, int Bytes)
+        {
+            for (int i = 0; i < Bytes; ++i)
+                Out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+
+        std::uint64_t GetLE(const std::uint8_t* pData, int Bytes)
+        {
+            std::uint64_t v = 0;
+            for (int i = 0; i < Bytes; ++i)
+                v |= std::uint64_t{pData[i]} << (8 * i);
+            return v;
+        }
+
+        // Entrada de un IFD de BigTIFF: el valor va en los 8 bytes de la entrada si cabe
+        void PutEntry(std::vector<std::uint8_t>& Out, std::uint16_t Tag, std::uint16_t Type, std::uint64_t Count, std::uint64_t Value)
+        {
+            PutLE(Out, Tag, 2);
+            PutLE(Out, Type, 2);
+            PutLE(Out, Count, 8);
+            PutLE(Out, Value, 8);
+        }
+    } // namespace
+
+    PosterWriter::PosterWriter(const std::string& Path, std::uint32_t Width, std::uint32_t Height, std::uint32_t TileSize, std::uint64_t SceneHash) :
+        m_Path{Path},
+        m_ProgressPath{Path + ".progress"},
+        m_Width{std::max(Width, 1u)},
+        m_Height{std::max(Height, 1u)},
+        m_TileSize{(std::max(TileSize, 16u) + 15) / 16 * 16},
+        m_TilesX{(m_Width + m_TileSize - 1) / m_TileSize},
+        m_TilesY{(m_Height + m_TileSize - 1) / m_TileSize},
+        m_SceneHash{SceneHash}
+    {
+        m_Done.assign(GetNumTiles(), 0);
+        if (!Resume())
+            m_Error = !Create();
+    }
+
+    PosterWriter::~PosterWriter()
+    {
+        Finish();
+    }
+
+    std::uint64_t PosterWriter::HashBytes(const void* pData, size_t Size, std::uint64_t Hash)
+    {
+        const std::uint8_t* pBytes = static_cast<const std::uint8_t*>(pData);
+        for (size_t i = 0; i < Size; ++i)
+            Hash = (Hash ^ pBytes[i]) * 1099511628211ull;
+        return Hash;
+    }
+
+    bool PosterWriter::Resume()
+    {
+        m_pProgress = std::fopen(m_ProgressPath.c_str(), "r+b");
+        if (m_pProgress == nullptr)
+            return false;
+
+        // Solo se continúa el mismo póster: tamaño, tile y escena
+        std::uint8_t Header[ProgressHeaderBytes];
+        std::vector<std::uint8_t> Done(GetNumTiles());
+        const bool Match = std::fread(Header, 1, sizeof(Header), m_pProgress) == sizeof(Header) &&
+            std::memcmp(Header, ProgressMagic, sizeof(ProgressMagic)) == 0 && GetLE(Header + 8, 4) == m_Width &&
+            GetLE(Header + 12, 4) == m_Height && GetLE(Header + 16, 4) == m_TileSize && GetLE(Header + 24, 8) == m_SceneHash &&
+            std::fread(Done.data(), 1, Done.size(), m_pProgress) == Done.size();
+        if (Match)
+            m_pFile = std::fopen(m_Path.c_str(), "r+b");
+        if (m_pFile == nullptr)
+        {
+            std::fclose(m_pProgress);
+            m_pProgress = nullptr;
+            return false;
+        }
+
+        m_Done    = std::move(Done);
+        m_NumDone = static_cast<std::uint32_t>(std::count_if(m_Done.begin(), m_Done.end(), [](std::uint8_t d) { return d != 0; }));
+        m_Resumed = true;
+        return true;
+    }
+
+    bool PosterWriter::Create()
+    {
+        m_pFile = std::fopen(m_Path.c_str(), "w+b");
+        if (m_pFile == nullptr)
+            return false;
+
+        // Cabecera (little endian, BigTIFF) y, detrás de todas las tiles, el único IFD con
+        // las tablas de offsets y tamaños. Las tiles ocupan el hueco en orden de índice.
+        const std::uint32_t NumTiles  = GetNumTiles();
+        const std::uint64_t IFDOffset = GetTileOffset(NumTiles);
+        constexpr int       NumTags   = 12;
+        const std::uint64_t ArraysOffset = IFDOffset + 8 + NumTags * 20 + 8;
+
+        std::vector<std::uint8_t> Header = {'I', 'I', 43, 0, 8, 0, 0, 0};
+        PutLE(Header, IFDOffset, 8);
+
+        std::vector<std::uint8_t> IFD;
+        PutLE(IFD, NumTags, 8);
+        PutEntry(IFD, 256, TIFF_LONG, 1, m_Width);  // ImageWidth
+        PutEntry(IFD, 257, TIFF_LONG, 1, m_Height); // ImageLength
+        PutEntry(IFD, 258, TIFF_SHORT, 4, 0x0008000800080008ull); // BitsPerSample 8, 8, 8, 8
+        PutEntry(IFD, 259, TIFF_SHORT, 1, 1);   // Compression: ninguna
+        PutEntry(IFD, 262, TIFF_SHORT, 1, 2);   // PhotometricInterpretation: RGB
+        PutEntry(IFD, 277, TIFF_SHORT, 1, 4);   // SamplesPerPixel
+        PutEntry(IFD, 284, TIFF_SHORT, 1, 1);   // PlanarConfiguration: RGBA entrelazado
+        PutEntry(IFD, 322, TIFF_LONG, 1, m_TileSize); // TileWidth
+        PutEntry(IFD, 323, TIFF_LONG, 1, m_TileSize); // TileLength
+        PutEntry(IFD, 324, TIFF_LONG8, NumTiles, NumTiles == 1 ? GetTileOffset(0) : ArraysOffset); // TileOffsets
+        PutEntry(IFD, 325, TIFF_LONG8, NumTiles, NumTiles == 1 ? GetTileBytes() : ArraysOffset + NumTiles * 8ull); // TileByteCounts
+        PutEntry(IFD, 338, TIFF_SHORT, 1, 2); // ExtraSamples: alfa sin premultiplicar
+        PutLE(IFD, 0, 8);                     // sin más IFDs
+        if (NumTiles > 1)
+        {
+            for (std::uint32_t i = 0; i < NumTiles; ++i)
+                PutLE(IFD, GetTileOffset(i), 8);
+            for (std::uint32_t i = 0; i < NumTiles; ++i)
+                PutLE(IFD, GetTileBytes(), 8);
+        }
+
+        if (std::fwrite(Header.data(), 1, Header.size(), m_pFile) != Header.size() || !SeekTo(m_pFile, IFDOffset) ||
+            std::fwrite(IFD.data(), 1, IFD.size(), m_pFile) != IFD.size() || std::fflush(m_pFile) != 0)
+            return false;
+
+        std::vector<std::uint8_t> Progress(ProgressMagic, ProgressMagic + sizeof(ProgressMagic));
+        PutLE(Progress, m_Width, 4);
+        PutLE(Progress, m_Height, 4);
+        PutLE(Progress, m_TileSize, 4);
+        PutLE(Progress, 0, 4);
+        PutLE(Progress, m_SceneHash, 8);
+        Progress.resize(ProgressHeaderBytes + NumTiles, 0);
+
+        m_pProgress = std::fopen(m_ProgressPath.c_str(), "w+b");
+        return m_pProgress != nullptr && std::fwrite(Progress.data(), 1, Progress.size(), m_pProgress) == Progress.size() &&
+            std::fflush(m_pProgress) == 0;
+    }
+
+    bool PosterWriter::WriteTile(std::uint32_t Index, const std::uint32_t* pPixels, std::uint32_t Width, std::uint32_t Height)
+    {
+        if (m_Error || m_pFile == nullptr || Index >= GetNumTiles() || Width > m_TileSize || Height > m_TileSize)
+            return false;
+
+        // La tile completa, con 0 fuera del póster
+        m_Scratch.assign(static_cast<size_t>(GetTileBytes()), 0);
+        for (std::uint32_t y = 0; y < Height; ++y)
+            std::memcpy(&m_Scratch[static_cast<size_t>(y) * m_TileSize * 4], pPixels + static_cast<size_t>(y) * Width, Width * 4);
+
+        // Primero los píxeles y después la marca de terminada: una tile marcada está en disco
+        m_Error = !SeekTo(m_pFile, GetTileOffset(Index)) || std::fwrite(m_Scratch.data(), 1, m_Scratch.size(), m_pFile) != m_Scratch.size() ||
+            std::fflush(m_pFile) != 0 || !SeekTo(m_pProgress, ProgressHeaderBytes + Index) || std::fputc(1, m_pProgress) == EOF ||
+            std::fflush(m_pProgress) != 0;
+        if (m_Error)
+            return false;
+
+        if (!m_Done[Index])
+            ++m_NumDone;
+        m_Done[Index] = 1;
+        return true;
+    }
+
+    bool PosterWriter::Finish()
+    {
+        if (m_pFile != nullptr && std::fclose(m_pFile) != 0)
+            m_Error = true;
+        if (m_pProgress != nullptr && std::fclose(m_pProgress) != 0)
+            m_Error = true;
+        m_pFile     = nullptr;
+        m_pProgress = nullptr;
+
+        if (!m_Error && m_NumDone == GetNumTiles())
+            std::remove(m_ProgressPath.c_str());
+        return !m_Error;
+    }
+
+} // namespace Diligent
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Diligent
+{
+
+    // Escribe un póster RGBA8 de tamaño arbitrario tile a tile en un BigTIFF con tiles sin
+    // comprimir. Cada tile tiene un sitio fijo en el fichero y el directorio del TIFF se escribe
+    // al crearlo, así que la memoria no depende del tamaño del póster (una tile) y el fichero se
+    // puede abrir a medias (las tiles pendientes salen a 0). Las tiles terminadas se apuntan en
+    // Path + ".progress" después de escribirlas: si el render se interrumpe, otro PosterWriter
+    // con el mismo tamaño, tile y SceneHash continúa donde se quedó. No depende de Diligent.
+    class PosterWriter
+    {
+    public:
+        // TileSize se redondea a múltiplo de 16, como pide TIFF
+        PosterWriter(const std::string& Path, std::uint32_t Width, std::uint32_t Height, std::uint32_t TileSize, std::uint64_t SceneHash);
+        ~PosterWriter();
+
+        PosterWriter(const PosterWriter&) = delete;
+        PosterWriter& operator=(const PosterWriter&) = delete;
+
+        // Escribe la tile Index (fila a fila, de izquierda a derecha): Width x Height píxeles RGBA8
+        // empaquetados (R en el byte bajo, como CPUImage), ya recortada en los bordes del póster
+        bool WriteTile(std::uint32_t Index, const std::uint32_t* pPixels, std::uint32_t Width, std::uint32_t Height);
+
+        // Cierra el póster; si están todas las tiles, borra el fichero de progreso
+        bool Finish();
+
+        bool          HasError() const { return m_Error; }
+        bool          IsResumed() const { return m_Resumed; }
+        bool          IsTileDone(std::uint32_t Index) const { return m_Done[Index] != 0; }
+        std::uint32_t GetTileSize() const { return m_TileSize; }
+        std::uint32_t GetTilesX() const { return m_TilesX; }
+        std::uint32_t GetTilesY() const { return m_TilesY; }
+        std::uint32_t GetNumTiles() const { return m_TilesX * m_TilesY; }
+        std::uint32_t GetNumDone() const { return m_NumDone; }
+
+        // FNV-1a, para el SceneHash de las constantes del render
+        static std::uint64_t HashBytes(const void* pData, size_t Size, std::uint64_t Hash = 14695981039346656037ull);
+
+    private:
+        bool Resume();
+        bool Create();
+
+        std::uint64_t GetTileBytes() const { return std::uint64_t{m_TileSize} * m_TileSize * 4; }
+        std::uint64_t GetTileOffset(std::uint32_t Index) const { return HeaderBytes + Index * GetTileBytes(); }
+
+        static constexpr std::uint64_t HeaderBytes         = 16; // cabecera de BigTIFF
+        static constexpr std::uint64_t ProgressHeaderBytes = 32;
+
+        std::string   m_Path;
+        std::string   m_ProgressPath;
+        std::uint32_t m_Width;
+        std::uint32_t m_Height;
+        std::uint32_t m_TileSize;
+        std::uint32_t m_TilesX;
+        std::uint32_t m_TilesY;
+        std::uint64_t m_SceneHash;
+
+        std::FILE*                m_pFile     = nullptr;
+        std::FILE*                m_pProgress = nullptr;
+        std::vector<std::uint8_t> m_Done; // una entrada por tile, como en el fichero de progreso
+        std::uint32_t             m_NumDone = 0;
+        std::vector<std::uint8_t> m_Scratch; // tile completa, con relleno en los bordes
+        bool                      m_Resumed = false;
+        bool                      m_Error   = false;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,656 @@
+#include "RenderFarm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#    ifdef _MSC_VER
+#        pragma comment(lib, "Ws2_32.lib")
+#    endif
+#else
+#    include <netdb.h>
+#    include <netinet/in.h>
+#    include <netinet/tcp.h>
+#    include <sys/select.h>
+#    include <sys/socket.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#endif
+
+namespace Diligent
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+#ifdef _WIN32
+        using SocketHandle                   = SOCKET;
+        constexpr SocketHandle InvalidSocket = INVALID_SOCKET;
+        constexpr int          SendFlags     = 0;
+
+        void CloseSocket(SocketHandle Socket) { closesocket(Socket); }
+
+        // WSAStartup una vez por proceso
+        bool InitSockets()
+        {
+            static const bool Ok = [] {
+                WSADATA Data;
+                return WSAStartup(MAKEWORD(2, 2), &Data) == 0;
+            }();
+            return Ok;
+        }
+#else
+        using SocketHandle                   = int;
+        constexpr SocketHandle InvalidSocket = -1;
+#    ifdef MSG_NOSIGNAL
+        constexpr int SendFlags = MSG_NOSIGNAL; // un worker caído no debe matar al coordinador con SIGPIPE
+#    else
+        constexpr int SendFlags = 0;
+#    endif
+
+        void CloseSocket(SocketHandle Socket) { close(Socket); }
+        bool InitSockets() { return true; }
+#endif
+
+        // Protocolo: mensajes con una cabecera de dos uint32 little endian (tipo y bytes de
+        // datos). Las constantes van tal cual en memoria: coordinador y workers tienen que ser
+        // del mismo build, lo que comprueba el saludo con la versión y sizeof(CPUShaderConstants).
+        enum FARM_MESSAGE : std::uint32_t
+        {
+            FARM_MESSAGE_HELLO = 1, // worker -> coordinador: versión, tamaño de las constantes
+            FARM_MESSAGE_TILE,      // coordinador -> worker: run, índice, rectángulo, constantes
+            FARM_MESSAGE_RESULT,    // worker -> coordinador: run, índice, tamaño, píxeles
+            FARM_MESSAGE_BYE        // coordinador -> worker: terminar
+        };
+
+        constexpr std::uint32_t ProtocolVersion = 1;
+        constexpr size_t        MessageHeaderBytes = 8;
+        constexpr size_t        TileHeaderBytes    = 6 * 4;
+        constexpr size_t        ResultHeaderBytes  = 4 * 4;
+        constexpr std::uint32_t MaxMessageBytes    = 1u << 28; // una tile de hasta 8192 x 8192
+        constexpr double        ShutdownSeconds    = 5.0;      // espera máxima a que los workers cierren
+
+        void PutLE32(std::vector<std::uint8_t>& Out, std::uint32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+                Out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+        }
+
+        std::uint32_t GetLE32(const std::uint8_t* pData)
+        {
+            return std::uint32_t{pData[0]} | std::uint32_t{pData[1]} << 8 | std::uint32_t{pData[2]} << 16 | std::uint32_t{pData[3]} << 24;
+        }
+
+        // Cabecera de un mensaje con Bytes de datos; los datos se añaden después
+        std::vector<std::uint8_t> BeginMessage(FARM_MESSAGE Type, size_t Bytes)
+        {
+            std::vector<std::uint8_t> Message;
+            Message.reserve(MessageHeaderBytes + Bytes);
+            PutLE32(Message, Type);
+            PutLE32(Message, static_cast<std::uint32_t>(Bytes));
+            return Message;
+        }
+
+        bool SendAll(SocketHandle Socket, const std::uint8_t* pData, size_t Size)
+        {
+            while (Size > 0)
+            {
+                const int Chunk = static_cast<int>(std::min<size_t>(Size, 1 << 20));
+                const int Sent  = send(Socket, reinterpret_cast<const char*>(pData), Chunk, SendFlags);
+                if (Sent <= 0)
+                    return false;
+                pData += Sent;
+                Size -= static_cast<size_t>(Sent);
+            }
+            return true;
+        }
+
+        bool RecvAll(SocketHandle Socket, std::uint8_t* pData, size_t Size)
+        {
+            while (Size > 0)
+            {
+                const int Received = recv(Socket, reinterpret_cast<char*>(pData), static_cast<int>(std::min<size_t>(Size, 1 << 20)), 0);
+                if (Received <= 0)
+                    return false;
+                pData += Received;
+                Size -= static_cast<size_t>(Received);
+            }
+            return true;
+        }
+
+        // Mensaje completo (bloqueante), para el worker
+        bool RecvMessage(SocketHandle Socket, std::uint32_t& Type, std::vector<std::uint8_t>& Payload)
+        {
+            std::uint8_t Header[MessageHeaderBytes];
+            if (!RecvAll(Socket, Header, sizeof(Header)))
+                return false;
+            Type                     = GetLE32(Header);
+            const std::uint32_t Size = GetLE32(Header + 4);
+            if (Size > MaxMessageBytes)
+                return false;
+            Payload.resize(Size);
+            return RecvAll(Socket, Payload.data(), Size);
+        }
+
+        void ConfigureSocket(SocketHandle Socket, bool Tcp)
+        {
+#ifdef SO_NOSIGPIPE
+            int NoSigPipe = 1;
+            setsockopt(Socket, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+            if (Tcp)
+            {
+                // Las tiles son mensajes pequeños: que no esperen a llenar un paquete
+                int NoDelay = 1;
+                setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&NoDelay), sizeof(NoDelay));
+            }
+        }
+
+        bool IsUnixAddress(const std::string& Address)
+        {
+            return Address.compare(0, 5, "unix:") == 0;
+        }
+
+        // "host:puerto", "[::1]:puerto" o ":puerto"
+        bool SplitHostPort(const std::string& Address, bool Listen, std::string& Host, std::string& Port)
+        {
+            const size_t Colon = Address.rfind(':');
+            if (Colon == std::string::npos || Colon + 1 == Address.size())
+                return false;
+            Host = Address.substr(0, Colon);
+            Port = Address.substr(Colon + 1);
+            if (Host.size() >= 2 && Host.front() == '[' && Host.back() == ']')
+                Host = Host.substr(1, Host.size() - 2);
+            // Sin host: todas las interfaces al escuchar; al conectar, esta máquina
+            if (Host.empty() || (!Listen && (Host == "0.0.0.0" || Host == "::")))
+                Host = Listen ? "0.0.0.0" : "127.0.0.1";
+            return true;
+        }
+
+        // Socket que escucha (Listen) o conectado a Address; pBound recibe la dirección real
+        SocketHandle OpenSocket(const std::string& Address, bool Listen, std::string* pBound = nullptr)
+        {
+            if (!InitSockets())
+                return InvalidSocket;
+
+            if (IsUnixAddress(Address))
+            {
+#ifdef _WIN32
+                return InvalidSocket;
+#else
+                const std::string Path = Address.substr(5);
+                sockaddr_un       Addr = {};
+                if (Path.empty() || Path.size() >= sizeof(Addr.sun_path))
+                    return InvalidSocket;
+                Addr.sun_family = AF_UNIX;
+                std::memcpy(Addr.sun_path, Path.c_str(), Path.size() + 1);
+
+                const SocketHandle Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+                if (Socket == InvalidSocket)
+                    return InvalidSocket;
+                ConfigureSocket(Socket, false);
+                if (Listen)
+                    unlink(Path.c_str()); // socket de una ejecución anterior
+                const bool Ok = Listen ? bind(Socket, reinterpret_cast<const sockaddr*>(&Addr), sizeof(Addr)) == 0 && listen(Socket, 64) == 0 :
+                                         connect(Socket, reinterpret_cast<const sockaddr*>(&Addr), sizeof(Addr)) == 0;
+                if (!Ok)
+                {
+                    CloseSocket(Socket);
+                    return InvalidSocket;
+                }
+                if (pBound != nullptr)
+                    *pBound = Address;
+                return Socket;
+#endif
+            }
+
+            std::string Host, Port;
+            if (!SplitHostPort(Address, Listen, Host, Port))
+                return InvalidSocket;
+
+            addrinfo Hints    = {};
+            Hints.ai_family   = AF_UNSPEC;
+            Hints.ai_socktype = SOCK_STREAM;
+            Hints.ai_flags    = Listen ? AI_PASSIVE : 0;
+            addrinfo* pInfo   = nullptr;
+            if (getaddrinfo(Host.c_str(), Port.c_str(), &Hints, &pInfo) != 0)
+                return InvalidSocket;
+
+            SocketHandle Socket = InvalidSocket;
+            for (addrinfo* pAddr = pInfo; pAddr != nullptr && Socket == InvalidSocket; pAddr = pAddr->ai_next)
+            {
+                Socket = socket(pAddr->ai_family, pAddr->ai_socktype, pAddr->ai_protocol);
+                if (Socket == InvalidSocket)
+                    continue;
+                ConfigureSocket(Socket, true);
+
+                bool Ok = false;
+                if (Listen)
+                {
+                    int Reuse = 1;
+                    setsockopt(Socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&Reuse), sizeof(Reuse));
+                    Ok = bind(Socket, pAddr->ai_addr, static_cast<int>(pAddr->ai_addrlen)) == 0 && listen(Socket, 64) == 0;
+                }
+                else
+                {
+                    Ok = connect(Socket, pAddr->ai_addr, static_cast<int>(pAddr->ai_addrlen)) == 0;
+                }
+                if (!Ok)
+                {
+                    CloseSocket(Socket);
+                    Socket = InvalidSocket;
+                }
+            }
+            freeaddrinfo(pInfo);
+
+            if (Socket != InvalidSocket && pBound != nullptr)
+            {
+                // Puerto real (el 0 elige uno libre)
+                sockaddr_storage Bound = {};
+                socklen_t        Size  = sizeof(Bound);
+                std::uint16_t    BoundPort = 0;
+                if (getsockname(Socket, reinterpret_cast<sockaddr*>(&Bound), &Size) == 0)
+                {
+                    if (Bound.ss_family == AF_INET)
+                        BoundPort = ntohs(reinterpret_cast<const sockaddr_in*>(&Bound)->sin_port);
+                    else if (Bound.ss_family == AF_INET6)
+                        BoundPort = ntohs(reinterpret_cast<const sockaddr_in6*>(&Bound)->sin6_port);
+                }
+                const bool IPv6 = Host.find(':') != std::string::npos;
+                *pBound         = (IPv6 ? "[" + Host + "]" : Host) + ":" + std::to_string(BoundPort);
+            }
+            return Socket;
+        }
+
+        double SecondsSince(Clock::time_point Start)
+        {
+            return std::chrono::duration<double>(Clock::now() - Start).count();
+        }
+    } // namespace
+
+    void AppendFrameTiles(const CPUShaderConstants& Constants, std::uint32_t Frame, std::uint32_t TileSize, std::vector<FarmTile>& Tiles)
+    {
+        const std::uint32_t Width  = static_cast<std::uint32_t>(Constants.TimeAndResolution.y);
+        const std::uint32_t Height = static_cast<std::uint32_t>(Constants.TimeAndResolution.z);
+        TileSize                   = std::max(TileSize, 1u);
+        for (std::uint32_t Y0 = 0; Y0 < Height; Y0 += TileSize)
+        {
+            for (std::uint32_t X0 = 0; X0 < Width; X0 += TileSize)
+            {
+                FarmTile Tile;
+                Tile.Frame     = Frame;
+                Tile.X0        = X0;
+                Tile.Y0        = Y0;
+                Tile.Width     = std::min(TileSize, Width - X0);
+                Tile.Height    = std::min(TileSize, Height - Y0);
+                Tile.Constants = Constants;
+                Tiles.push_back(Tile);
+            }
+        }
+    }
+
+    struct FarmCoordinator::Connection
+    {
+        struct Assignment
+        {
+            std::uint32_t     Tile;
+            Clock::time_point Sent;
+        };
+
+        SocketHandle              Socket = InvalidSocket;
+        std::vector<std::uint8_t> Received;
+        bool                      Ready = false; // saludo recibido y compatible
+        std::vector<Assignment>   Assigned;
+    };
+
+    FarmCoordinator::FarmCoordinator(const std::string& Address)
+    {
+        const SocketHandle Listen = OpenSocket(Address, true, &m_Address);
+        m_Listen                  = static_cast<std::intptr_t>(Listen);
+        m_Error                   = Listen == InvalidSocket;
+    }
+
+    FarmCoordinator::~FarmCoordinator()
+    {
+        Shutdown();
+    }
+
+    void FarmCoordinator::Shutdown()
+    {
+        // Despedida y fin de escritura; después se descarta lo que llegue (p.ej. una tile
+        // duplicada que el worker estaba terminando) hasta que cada worker cierre, para que la
+        // despedida no se pierda con un reset por datos sin leer
+        const std::vector<std::uint8_t> Bye = BeginMessage(FARM_MESSAGE_BYE, 0);
+        for (const std::unique_ptr<Connection>& pWorker : m_Workers)
+        {
+            SendAll(pWorker->Socket, Bye.data(), Bye.size());
+#ifdef _WIN32
+            shutdown(pWorker->Socket, SD_SEND);
+#else
+            shutdown(pWorker->Socket, SHUT_WR);
+#endif
+        }
+        const Clock::time_point Start = Clock::now();
+        while (!m_Workers.empty() && SecondsSince(Start) < ShutdownSeconds)
+        {
+            fd_set ReadSet;
+            FD_ZERO(&ReadSet);
+            SocketHandle MaxSocket = 0;
+            for (const std::unique_ptr<Connection>& pWorker : m_Workers)
+            {
+                FD_SET(pWorker->Socket, &ReadSet);
+                MaxSocket = std::max(MaxSocket, pWorker->Socket);
+            }
+            timeval Timeout = {0, 100000};
+            if (select(static_cast<int>(MaxSocket + 1), &ReadSet, nullptr, nullptr, &Timeout) < 0)
+                break;
+            for (size_t w = 0; w < m_Workers.size(); ++w)
+            {
+                std::uint8_t Buffer[1 << 16];
+                if (FD_ISSET(m_Workers[w]->Socket, &ReadSet) && recv(m_Workers[w]->Socket, reinterpret_cast<char*>(Buffer), sizeof(Buffer), 0) <= 0)
+                {
+                    CloseSocket(m_Workers[w]->Socket);
+                    m_Workers.erase(m_Workers.begin() + static_cast<std::ptrdiff_t>(w--));
+                }
+            }
+        }
+        for (const std::unique_ptr<Connection>& pWorker : m_Workers)
+            CloseSocket(pWorker->Socket);
+        m_Workers.clear();
+
+        if (!m_Error)
+        {
+            CloseSocket(static_cast<SocketHandle>(m_Listen));
+#ifndef _WIN32
+            if (IsUnixAddress(m_Address))
+                unlink(m_Address.c_str() + 5);
+#endif
+            m_Error = true; // ya no acepta workers ni hace más Run
+        }
+    }
+
+    void FarmCoordinator::AcceptWorkers()
+    {
+        const SocketHandle Socket = accept(static_cast<SocketHandle>(m_Listen), nullptr, nullptr);
+        if (Socket == InvalidSocket)
+            return;
+        ConfigureSocket(Socket, !IsUnixAddress(m_Address));
+        std::unique_ptr<Connection> pWorker{new Connection};
+        pWorker->Socket = Socket;
+        m_Workers.push_back(std::move(pWorker));
+    }
+
+    void FarmCoordinator::DropWorker(size_t WorkerIndex)
+    {
+        Connection& Worker = *m_Workers[WorkerIndex];
+        // Sus tiles vuelven al principio de la cola si nadie más las tiene
+        for (const Connection::Assignment& Assigned : Worker.Assigned)
+        {
+            --m_TileHolders[Assigned.Tile];
+            if (!m_TileDone[Assigned.Tile] && m_TileHolders[Assigned.Tile] == 0)
+            {
+                m_Pending.push_back(Assigned.Tile);
+                ++m_Stats.Reissued;
+            }
+        }
+        if (!Worker.Assigned.empty())
+            ++m_Stats.LostWorkers;
+        CloseSocket(Worker.Socket);
+        m_Workers.erase(m_Workers.begin() + static_cast<std::ptrdiff_t>(WorkerIndex));
+    }
+
+    bool FarmCoordinator::ReceiveFrom(Connection& Worker, const std::vector<FarmTile>& Tiles, const TileCallback& OnTile)
+    {
+        std::uint8_t Buffer[1 << 16];
+        const int    Received = recv(Worker.Socket, reinterpret_cast<char*>(Buffer), sizeof(Buffer), 0);
+        if (Received <= 0)
+            return false;
+        Worker.Received.insert(Worker.Received.end(), Buffer, Buffer + Received);
+
+        // Todos los mensajes completos del búfer
+        size_t Consumed = 0;
+        while (Worker.Received.size() - Consumed >= MessageHeaderBytes)
+        {
+            const std::uint8_t* pMessage = Worker.Received.data() + Consumed;
+            const std::uint32_t Type     = GetLE32(pMessage);
+            const std::uint32_t Size     = GetLE32(pMessage + 4);
+            if (Size > MaxMessageBytes)
+                return false;
+            if (Worker.Received.size() - Consumed < MessageHeaderBytes + Size)
+                break;
+            const std::uint8_t* pPayload = pMessage + MessageHeaderBytes;
+            Consumed += MessageHeaderBytes + Size;
+
+            if (Type == FARM_MESSAGE_HELLO)
+            {
+                if (Size < 8 || GetLE32(pPayload) != ProtocolVersion || GetLE32(pPayload + 4) != sizeof(CPUShaderConstants))
+                    return false;
+                Worker.Ready = true;
+                ++m_Stats.Workers;
+            }
+            else if (Type == FARM_MESSAGE_RESULT && Size >= ResultHeaderBytes)
+            {
+                const std::uint32_t RunId  = GetLE32(pPayload);
+                const std::uint32_t Index  = GetLE32(pPayload + 4);
+                const std::uint32_t Width  = GetLE32(pPayload + 8);
+                const std::uint32_t Height = GetLE32(pPayload + 12);
+                // Resultado tardío de un Run anterior (una tile duplicada)
+                if (RunId != m_RunId)
+                    continue;
+
+                auto It = std::find_if(Worker.Assigned.begin(), Worker.Assigned.end(),
+                                       [&](const Connection::Assignment& Assigned) { return Assigned.Tile == Index; });
+                if (It == Worker.Assigned.end() || Width != Tiles[Index].Width || Height != Tiles[Index].Height ||
+                    Size != ResultHeaderBytes + std::uint64_t{Width} * Height * 4)
+                    return false;
+                Worker.Assigned.erase(It);
+                --m_TileHolders[Index];
+
+                if (m_TileDone[Index])
+                {
+                    ++m_Stats.Discarded;
+                    continue;
+                }
+                m_TileDone[Index] = 1;
+                ++m_NumDone;
+                m_Scratch.resize(static_cast<size_t>(Width) * Height);
+                std::memcpy(m_Scratch.data(), pPayload + ResultHeaderBytes, m_Scratch.size() * 4);
+                OnTile(Index, Tiles[Index], m_Scratch.data());
+            }
+            else
+            {
+                return false;
+            }
+        }
+        Worker.Received.erase(Worker.Received.begin(), Worker.Received.begin() + static_cast<std::ptrdiff_t>(Consumed));
+        return true;
+    }
+
+    void FarmCoordinator::AssignTiles(const std::vector<FarmTile>& Tiles)
+    {
+        for (size_t w = 0; w < m_Workers.size(); ++w)
+        {
+            Connection& Worker = *m_Workers[w];
+            while (Worker.Ready && Worker.Assigned.size() < TilesInFlight)
+            {
+                std::uint32_t Index = 0;
+                while (!m_Pending.empty() && m_TileDone[m_Pending.back()])
+                    m_Pending.pop_back();
+                if (!m_Pending.empty())
+                {
+                    Index = m_Pending.back();
+                    m_Pending.pop_back();
+                }
+                else
+                {
+                    // Cola vacía: la tile más antigua de un solo worker que este no tenga ya
+                    const Connection::Assignment* pOldest = nullptr;
+                    for (const std::unique_ptr<Connection>& pOther : m_Workers)
+                    {
+                        for (const Connection::Assignment& Assigned : pOther->Assigned)
+                        {
+                            const bool Mine = std::any_of(Worker.Assigned.begin(), Worker.Assigned.end(),
+                                                          [&](const Connection::Assignment& A) { return A.Tile == Assigned.Tile; });
+                            if (!m_TileDone[Assigned.Tile] && m_TileHolders[Assigned.Tile] == 1 && !Mine &&
+                                (pOldest == nullptr || Assigned.Sent < pOldest->Sent))
+                                pOldest = &Assigned;
+                        }
+                    }
+                    if (pOldest == nullptr)
+                        break;
+                    Index = pOldest->Tile;
+                    ++m_Stats.Duplicated;
+                }
+
+                const FarmTile&           Tile    = Tiles[Index];
+                std::vector<std::uint8_t> Message = BeginMessage(FARM_MESSAGE_TILE, TileHeaderBytes + sizeof(CPUShaderConstants));
+                PutLE32(Message, m_RunId);
+                PutLE32(Message, Index);
+                PutLE32(Message, Tile.X0);
+                PutLE32(Message, Tile.Y0);
+                PutLE32(Message, Tile.Width);
+                PutLE32(Message, Tile.Height);
+                const std::uint8_t* pConstants = reinterpret_cast<const std::uint8_t*>(&Tile.Constants);
+                Message.insert(Message.end(), pConstants, pConstants + sizeof(CPUShaderConstants));
+
+                // Se apunta antes de mandarla: si falla, DropWorker la devuelve a la cola
+                Worker.Assigned.push_back({Index, Clock::now()});
+                ++m_TileHolders[Index];
+                if (!SendAll(Worker.Socket, Message.data(), Message.size()))
+                {
+                    DropWorker(w--);
+                    break;
+                }
+            }
+        }
+    }
+
+    bool FarmCoordinator::Run(const std::vector<FarmTile>& Tiles, const TileCallback& OnTile)
+    {
+        if (m_Error)
+            return false;
+
+        ++m_RunId;
+        for (const std::unique_ptr<Connection>& pWorker : m_Workers)
+            pWorker->Assigned.clear();
+        m_TileDone.assign(Tiles.size(), 0);
+        m_TileHolders.assign(Tiles.size(), 0);
+        m_Pending.resize(Tiles.size());
+        for (size_t i = 0; i < Tiles.size(); ++i)
+            m_Pending[i] = static_cast<std::uint32_t>(Tiles.size() - 1 - i);
+        m_NumDone = 0;
+
+        Clock::time_point LastWorker = Clock::now();
+        while (m_NumDone < Tiles.size())
+        {
+            AssignTiles(Tiles);
+
+            const SocketHandle Listen = static_cast<SocketHandle>(m_Listen);
+            fd_set             ReadSet;
+            FD_ZERO(&ReadSet);
+            FD_SET(Listen, &ReadSet);
+            SocketHandle MaxSocket = Listen;
+            for (const std::unique_ptr<Connection>& pWorker : m_Workers)
+            {
+                FD_SET(pWorker->Socket, &ReadSet);
+                MaxSocket = std::max(MaxSocket, pWorker->Socket);
+            }
+            timeval Timeout = {0, 100000};
+            if (select(static_cast<int>(MaxSocket + 1), &ReadSet, nullptr, nullptr, &Timeout) < 0)
+                return false;
+
+            if (FD_ISSET(Listen, &ReadSet))
+                AcceptWorkers();
+
+            for (size_t w = 0; w < m_Workers.size(); ++w)
+            {
+                Connection& Worker = *m_Workers[w];
+                bool        Lost   = FD_ISSET(Worker.Socket, &ReadSet) && !ReceiveFrom(Worker, Tiles, OnTile);
+                for (const Connection::Assignment& Assigned : Worker.Assigned)
+                    Lost = Lost || SecondsSince(Assigned.Sent) > m_TileTimeout;
+                if (Lost)
+                    DropWorker(w--);
+            }
+
+            if (!m_Workers.empty())
+                LastWorker = Clock::now();
+            else if (m_IdleTimeout > 0 && SecondsSince(LastWorker) > m_IdleTimeout)
+                return false;
+        }
+        return true;
+    }
+
+    bool RunFarmWorker(const std::string& Address, const FarmWorkerOptions& Options, std::uint32_t* pNumTiles)
+    {
+        if (pNumTiles != nullptr)
+            *pNumTiles = 0;
+
+        // El coordinador puede no estar escuchando todavía
+        const Clock::time_point Start  = Clock::now();
+        SocketHandle            Socket = InvalidSocket;
+        while ((Socket = OpenSocket(Address, false)) == InvalidSocket)
+        {
+            if (SecondsSince(Start) > Options.ConnectTimeout)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        std::vector<std::uint8_t> Hello = BeginMessage(FARM_MESSAGE_HELLO, 8);
+        PutLE32(Hello, ProtocolVersion);
+        PutLE32(Hello, sizeof(CPUShaderConstants));
+        bool Ok = SendAll(Socket, Hello.data(), Hello.size());
+
+        CPUFractalRenderer        Renderer{Options.NumThreads};
+        CPUImage                  Image;
+        std::vector<std::uint8_t> Payload;
+        std::uint32_t             Type     = 0;
+        std::uint32_t             Received = 0;
+        bool                      Bye      = false;
+        while (Ok && !Bye && RecvMessage(Socket, Type, Payload))
+        {
+            if (Type == FARM_MESSAGE_BYE)
+            {
+                Bye = true;
+            }
+            else if (Type == FARM_MESSAGE_TILE && Payload.size() == TileHeaderBytes + sizeof(CPUShaderConstants))
+            {
+                if (++Received == Options.DropAfter)
+                    break;
+
+                CPUShaderConstants Constants;
+                std::memcpy(&Constants, Payload.data() + TileHeaderBytes, sizeof(Constants));
+                const std::uint32_t Width  = GetLE32(&Payload[16]);
+                const std::uint32_t Height = GetLE32(&Payload[20]);
+                Renderer.RenderRegion(Constants, GetLE32(&Payload[8]), GetLE32(&Payload[12]), Width, Height, Image);
+
+                std::vector<std::uint8_t> Result = BeginMessage(FARM_MESSAGE_RESULT, ResultHeaderBytes + Image.Pixels.size() * 4);
+                PutLE32(Result, GetLE32(&Payload[0])); // run
+                PutLE32(Result, GetLE32(&Payload[4])); // índice
+                PutLE32(Result, Width);
+                PutLE32(Result, Height);
+                const std::uint8_t* pPixels = reinterpret_cast<const std::uint8_t*>(Image.Pixels.data());
+                Result.insert(Result.end(), pPixels, pPixels + Image.Pixels.size() * 4);
+                Ok = SendAll(Socket, Result.data(), Result.size());
+                if (Ok && pNumTiles != nullptr)
+                    ++*pNumTiles;
+            }
+            else
+            {
+                Ok = false;
+            }
+        }
+        CloseSocket(Socket);
+        return Bye;
+    }
+
+} // namespace Diligent
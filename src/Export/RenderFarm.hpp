@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../CPU/CPUShaderConstants.hpp"
+
+namespace Diligent
+{
+
+    // Tile de un frame para la granja de render: las constantes del frame completo (las mismas
+    // que recibe CPUFractalRenderer) y el rectángulo [X0, X0 + Width) x [Y0, Y0 + Height)
+    struct FarmTile
+    {
+        std::uint32_t      Frame     = 0; // solo para quien recibe el resultado; el worker no lo usa
+        std::uint32_t      X0        = 0;
+        std::uint32_t      Y0        = 0;
+        std::uint32_t      Width     = 0;
+        std::uint32_t      Height    = 0;
+        CPUShaderConstants Constants = {};
+    };
+
+    // Añade a Tiles las tiles de TileSize x TileSize (recortadas en los bordes) del frame de
+    // TimeAndResolution.y x TimeAndResolution.z píxeles, por filas
+    void AppendFrameTiles(const CPUShaderConstants& Constants, std::uint32_t Frame, std::uint32_t TileSize, std::vector<FarmTile>& Tiles);
+
+    struct FarmStats
+    {
+        std::uint32_t Workers     = 0; // workers que han llegado a conectarse
+        std::uint32_t LostWorkers = 0; // desconectados o sin respuesta con tiles pendientes
+        std::uint32_t Reissued    = 0; // tiles devueltas a la cola por un worker perdido
+        std::uint32_t Duplicated  = 0; // tiles mandadas también a un segundo worker al final
+        std::uint32_t Discarded   = 0; // resultados que llegaron cuando la tile ya estaba hecha
+    };
+
+    // Coordinador de la granja: escucha en Address ("host:puerto" por TCP o "unix:/ruta" en
+    // POSIX; el puerto 0 elige uno libre) y reparte tiles entre los workers que se conecten, en
+    // cualquier momento, por un protocolo binario propio. El reparto es dinámico: cada worker
+    // tiene como mucho TilesInFlight tiles pendientes y recibe otra al devolver una, así que los
+    // workers con tiles baratas (fondo) se llevan más. Cuando la cola se vacía, los workers
+    // libres reciben también las tiles más antiguas de otros (gana el primer resultado), para que
+    // una tile cara del borde del conjunto no deje la granja esperando a un solo worker. Si un
+    // worker se desconecta o tarda más de TileTimeout en una tile, sus tiles vuelven a la cola.
+    // No depende de Diligent.
+    class FarmCoordinator
+    {
+    public:
+        explicit FarmCoordinator(const std::string& Address);
+        ~FarmCoordinator();
+
+        FarmCoordinator(const FarmCoordinator&) = delete;
+        FarmCoordinator& operator=(const FarmCoordinator&) = delete;
+
+        bool HasError() const { return m_Error; }
+        // Dirección en la que escucha, con el puerto real si se pidió el 0
+        const std::string& GetAddress() const { return m_Address; }
+
+        // Segundos máximos de un worker con una tile antes de darlo por perdido
+        void SetTileTimeout(double Seconds) { m_TileTimeout = Seconds; }
+        // Segundos que Run espera sin ningún worker conectado antes de fallar (0 = sin límite)
+        void SetIdleTimeout(double Seconds) { m_IdleTimeout = Seconds; }
+
+        // Renderiza Tiles con la granja y llama a OnTile(Índice, Tile, Píxeles) en este hilo por
+        // cada tile terminada, en el orden en que llegan (Width x Height píxeles RGBA8
+        // empaquetados como CPUImage). Devuelve false si no quedan workers durante IdleTimeout.
+        // Los workers siguen conectados para el siguiente Run.
+        using TileCallback = std::function<void(std::uint32_t Index, const FarmTile& Tile, const std::uint32_t* pPixels)>;
+        bool Run(const std::vector<FarmTile>& Tiles, const TileCallback& OnTile);
+
+        // Manda la orden de terminar a los workers conectados, espera unos segundos a que
+        // cierren y deja de escuchar (también lo hace el destructor)
+        void Shutdown();
+
+        const FarmStats& GetStats() const { return m_Stats; }
+        std::uint32_t    GetNumWorkers() const { return static_cast<std::uint32_t>(m_Workers.size()); }
+
+        static constexpr std::uint32_t TilesInFlight = 2;
+
+    private:
+        struct Connection;
+
+        void AcceptWorkers();
+        bool ReceiveFrom(Connection& Worker, const std::vector<FarmTile>& Tiles, const TileCallback& OnTile);
+        void DropWorker(size_t WorkerIndex);
+        void AssignTiles(const std::vector<FarmTile>& Tiles);
+
+        std::string    m_Address;
+        std::intptr_t  m_Listen      = -1;
+        bool           m_Error       = false;
+        double         m_TileTimeout = 600.0;
+        double         m_IdleTimeout = 0.0;
+        std::uint32_t  m_RunId       = 0;
+        FarmStats      m_Stats;
+
+        std::vector<std::unique_ptr<Connection>> m_Workers;
+
+        // Estado de las tiles del Run en curso
+        std::vector<std::uint8_t>  m_TileDone;
+        std::vector<std::uint8_t>  m_TileHolders; // workers que tienen la tile ahora mismo
+        std::vector<std::uint32_t> m_Pending;     // cola, se saca por el final
+        std::uint32_t              m_NumDone = 0;
+        std::vector<std::uint32_t> m_Scratch;     // píxeles alineados de un resultado
+    };
+
+    struct FarmWorkerOptions
+    {
+        std::uint32_t NumThreads     = 0;    // hilos de CPUFractalRenderer (0 = todos los núcleos)
+        double        ConnectTimeout = 10.0; // segundos reintentando la conexión
+        std::uint32_t DropAfter      = 0;    // pruebas: al recibir la tile N se desconecta sin responder (0 = nunca)
+    };
+
+    // Worker de la granja: se conecta al coordinador de Address y renderiza tiles con
+    // CPUFractalRenderer::RenderRegion hasta que el coordinador termina. Devuelve true si el
+    // coordinador lo despidió y false si no pudo conectarse o se cortó la conexión. pNumTiles
+    // recibe las tiles renderizadas.
+    bool RunFarmWorker(const std::string& Address, const FarmWorkerOptions& Options, std::uint32_t* pNumTiles = nullptr);
+
+} // namespace Diligent
@@ -0,0 +1,159 @@
+#include "FractalPSOCache.hpp"
+
+#include <fstream>
+
+#include "DataBlobImpl.hpp"
+
+namespace Diligent
+{
+
+    FractalPSOCache::FractalPSOCache(IRenderDevice* pDevice, const char* FilePath) :
+        m_pDevice{pDevice},
+        m_FilePath{FilePath}
+    {
+        RenderStateCacheCreateInfo CacheCI;
+        CacheCI.pDevice = pDevice;
+        CreateRenderStateCache(CacheCI, &m_pCache);
+        Load();
+
+        const auto DeviceType = pDevice->GetDeviceInfo().Type;
+        m_Async = DeviceType != RENDER_DEVICE_TYPE_GL && DeviceType != RENDER_DEVICE_TYPE_GLES;
+        if (m_Async)
+            m_Worker = std::thread{&FractalPSOCache::WorkerThread, this};
+    }
+
+    FractalPSOCache::~FractalPSOCache()
+    {
+        if (m_Worker.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> Lock{m_JobsMtx};
+                m_Stop = true;
+                m_Jobs.clear();
+            }
+            m_JobsCV.notify_all();
+            m_Worker.join();
+        }
+        Save();
+    }
+
+    void FractalPSOCache::Load()
+    {
+        if (!m_pCache)
+            return;
+
+        std::ifstream File{m_FilePath, std::ios::binary | std::ios::ate};
+        if (!File)
+            return;
+
+        const std::streamsize Size = File.tellg();
+        if (Size <= 0)
+            return;
+
+        auto pData = DataBlobImpl::Create(static_cast<size_t>(Size));
+        File.seekg(0);
+        if (!File.read(static_cast<char*>(pData->GetDataPtr()), Size))
+            return;
+
+        // Una caché de otra versión o de otro dispositivo simplemente no se carga
+        m_pCache->Load(pData, ContentVersion);
+    }
+
+    void FractalPSOCache::Save()
+    {
+        std::lock_guard<std::mutex> Lock{m_SaveMtx};
+        if (!m_pCache || !m_Dirty.exchange(false))
+            return;
+
+        RefCntAutoPtr<IDataBlob> pData;
+        if (!m_pCache->WriteToBlob(ContentVersion, &pData) || !pData)
+            return;
+
+        std::ofstream File{m_FilePath, std::ios::binary | std::ios::trunc};
+        File.write(static_cast<const char*>(pData->GetConstDataPtr()), static_cast<std::streamsize>(pData->GetSize()));
+    }
+
+    void FractalPSOCache::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+    {
+        if (m_pCache)
+        {
+            if (m_pCache->CreateShader(ShaderCI, ppShader))
+            {
+                ++m_NumCacheHits;
+                return;
+            }
+            m_Dirty = true;
+        }
+        else
+        {
+            m_pDevice->CreateShader(ShaderCI, ppShader);
+        }
+        ++m_NumCompiled;
+    }
+
+    void FractalPSOCache::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPSO)
+    {
+        if (m_pCache)
+        {
+            if (!m_pCache->CreateGraphicsPipelineState(PSOCreateInfo, ppPSO))
+                m_Dirty = true;
+        }
+        else
+        {
+            m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPSO);
+        }
+    }
+
+    void FractalPSOCache::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPSO)
+    {
+        if (m_pCache)
+        {
+            if (!m_pCache->CreateComputePipelineState(PSOCreateInfo, ppPSO))
+                m_Dirty = true;
+        }
+        else
+        {
+            m_pDevice->CreateComputePipelineState(PSOCreateInfo, ppPSO);
+        }
+    }
+
+    void FractalPSOCache::RunAsync(std::function<void()> Job)
+    {
+        if (!m_Async)
+        {
+            Job();
+            Save();
+            return;
+        }
+
+        ++m_NumPendingJobs;
+        {
+            std::lock_guard<std::mutex> Lock{m_JobsMtx};
+            m_Jobs.push_back(std::move(Job));
+        }
+        m_JobsCV.notify_one();
+    }
+
+    void FractalPSOCache::WorkerThread()
+    {
+        for (;;)
+        {
+            std::function<void()> Job;
+            {
+                std::unique_lock<std::mutex> Lock{m_JobsMtx};
+                m_JobsCV.wait(Lock, [this] { return m_Stop || !m_Jobs.empty(); });
+                if (m_Stop)
+                    return;
+                Job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+
+            Job();
+
+            // Al vaciarse la cola se guarda, así un cierre brusco no pierde lo compilado
+            if (--m_NumPendingJobs == 0)
+                Save();
+        }
+    }
+
+} // namespace Diligent
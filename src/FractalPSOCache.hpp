@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "RenderDevice.h"
+#include "RenderStateCache.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+    // Caché en disco de shaders y PSOs (IRenderStateCache de DiligentTools) y un hilo de
+    // compilación en segundo plano para las permutaciones del fractal. Si la caché no se
+    // puede crear, todo se compila directamente con el dispositivo.
+    class FractalPSOCache
+    {
+    public:
+        FractalPSOCache(IRenderDevice* pDevice, const char* FilePath);
+        ~FractalPSOCache();
+
+        FractalPSOCache(const FractalPSOCache&) = delete;
+        FractalPSOCache& operator=(const FractalPSOCache&) = delete;
+
+        // Igual que los métodos de IRenderDevice, pero pasando por la caché
+        void CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+        void CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPSO);
+        void CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPSO);
+
+        // Ejecuta Job en el hilo de compilación. En OpenGL el contexto no se puede usar desde
+        // otro hilo, así que allí se ejecuta en el acto.
+        void RunAsync(std::function<void()> Job);
+
+        // Escribe la caché en disco si se ha compilado algo nuevo desde la última vez
+        void Save();
+
+        Uint32 GetNumPendingJobs() const { return m_NumPendingJobs.load(); }
+        Uint32 GetNumCacheHits() const { return m_NumCacheHits.load(); }
+        Uint32 GetNumCompiled() const { return m_NumCompiled.load(); }
+        bool   IsPersistent() const { return m_pCache != nullptr; }
+
+    private:
+        void Load();
+        void WorkerThread();
+
+        // Se incrementa al cambiar el formato de lo que se guarda; invalida las cachés viejas
+        static constexpr Uint32 ContentVersion = 1;
+
+        RefCntAutoPtr<IRenderDevice>     m_pDevice;
+        RefCntAutoPtr<IRenderStateCache> m_pCache;
+        std::string                      m_FilePath;
+        std::mutex                       m_SaveMtx;
+        std::atomic<bool>                m_Dirty{false};
+
+        std::atomic<Uint32> m_NumPendingJobs{0};
+        std::atomic<Uint32> m_NumCacheHits{0};
+        std::atomic<Uint32> m_NumCompiled{0};
+
+        bool                              m_Async = false;
+        std::thread                       m_Worker;
+        std::mutex                        m_JobsMtx;
+        std::condition_variable           m_JobsCV;
+        std::deque<std::function<void()>> m_Jobs;
+        bool                              m_Stop = false;
+    };
+
+} // namespace Diligent
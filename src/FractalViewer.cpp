@@ -4,22 +4,80 @@
 #include "ColorConversion.h"
 #include "imgui.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
 namespace Diligent
 {
     
     void FractalViewer::CreatePipelineState()
     {
+        // Los .fxh compartidos se incluyen por nombre desde la carpeta de shaders
+        m_pEngineFactory->CreateDefaultShaderSourceStreamFactory("../Shaders", &m_pShaderSourceFactory);
+
+        // Shaders y PSOs pasan por la caché en disco: en los arranques siguientes no hay que
+        // volver a compilar con DXC
+        m_pPSOCache.reset(new FractalPSOCache{m_pDevice, "FractalPSOCache.bin"});
+
+        BufferDesc CBDesc;
+        CBDesc.Name = "VS constants CB";
+        CBDesc.Size = sizeof(ShaderConstants);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_VSConstants);
+
+        CBDesc.Name = "Perturbation constants CB";
+        CBDesc.Size = sizeof(PerturbationConstants);
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_PerturbationConstants);
+
+        CBDesc.Name = "Refine constants CB";
+        CBDesc.Size = sizeof(float4);
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_RefineConstants);
+
+        CBDesc.Name = "Colorize constants CB";
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_ColorizeConstants);
+
+        CreateReferenceOrbitBuffer(1024);
+
+        // Los ubershaders se crean ya: son los que se usan mientras se compilan las permutaciones.
+        // 2D y 3D escriben en formatos distintos (buffer de escape / color), así que hay uno por modo.
+        FractalPSO UberPSO;
+        CreateFractalPSO(FractalPermutation{}, UberPSO);
+        m_pPSO = UberPSO.pPSO;
+        m_pSRB = UberPSO.pSRB;
+
+        FractalPermutation Uber3D;
+        Uber3D.Is3D = true;
+        FractalPSO UberPSO3D;
+        CreateFractalPSO(Uber3D, UberPSO3D);
+        m_pPSO3D = UberPSO3D.pPSO;
+        m_pSRB3D = UberPSO3D.pSRB;
+    }
+
+    void FractalViewer::CreateFractalPSO(const FractalPermutation& Permutation, FractalPSO& Out)
+    {
+        const std::string PSOName = "Fractal PSO " + Permutation.GetName();
+
         GraphicsPipelineStateCreateInfo PSOCreateInfo;
-        PSOCreateInfo.PSODesc.Name = "Fractal PSO";
+        PSOCreateInfo.PSODesc.Name = PSOName.c_str();
 
         PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
 
         PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = m_pSwapChain->GetDesc().ColorBufferFormat;
-        PSOCreateInfo.GraphicsPipeline.DSVFormat = m_pSwapChain->GetDesc().DepthBufferFormat;
+        // El fractal se pinta en texturas intermedias (refinamiento progresivo), sin depth: color
+        // en 3D y el buffer de escape en 2D
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = Permutation.Is3D ? m_pSwapChain->GetDesc().ColorBufferFormat : TEX_FORMAT_RG32_FLOAT;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_UNKNOWN;
         PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_BACK;
-        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = True;
+        // El paneo incremental limita el pase a las franjas nuevas con el scissor
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.ScissorEnable = True;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
         ShaderCreateInfo ShaderCI;
         ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
 		ShaderCI.HLSLVersion = { 6, 3 };
@@ -28,10 +86,18 @@ namespace Diligent
 
         ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
 
-        ShaderMacro Macros[] = { {"CONVERT_PS_OUTPUT_TO_GAMMA", m_ConvertPSOutputToGamma ? "1" : "0"} };
+        const std::string Type = std::to_string(Permutation.Type);
+        const std::string Precision = std::to_string(Permutation.Type < 0 ? -1 : Permutation.Precision);
+        ShaderMacro Macros[] =
+        {
+            {"CONVERT_PS_OUTPUT_TO_GAMMA", m_ConvertPSOutputToGamma ? "1" : "0"},
+            {"FRACTAL_TYPE", Type.c_str()},
+            {"FRACTAL_IS_3D", Permutation.Is3D ? "1" : "0"},
+            {"FRACTAL_PRECISION", Precision.c_str()},
+            {"FRACTAL_PERTURBATION", Permutation.Perturbation ? "1" : "0"}
+        };
         ShaderCI.Macros = { Macros, _countof(Macros) };
 
-        m_pEngineFactory->CreateDefaultShaderSourceStreamFactory(nullptr, &m_pShaderSourceFactory);
         ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
         // Create a vertex shader
         RefCntAutoPtr<IShader> pVS;
@@ -40,7 +106,7 @@ namespace Diligent
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Quad VS";
             ShaderCI.FilePath = "../Shaders/quad.vsh";
-            m_pDevice->CreateShader(ShaderCI, &pVS);
+            m_pPSOCache->CreateShader(ShaderCI, &pVS);
         }
 
         // Create a pixel shader
@@ -50,16 +116,10 @@ namespace Diligent
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Fractal PS";
             ShaderCI.FilePath = "../Shaders/fractal.psh";
-            m_pDevice->CreateShader(ShaderCI, &pPS);
-
-            BufferDesc CBDesc;
-            CBDesc.Name = "VS constants CB";
-            CBDesc.Size = sizeof(ShaderConstants);
-            CBDesc.Usage = USAGE_DYNAMIC;
-            CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
-            CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-            m_pDevice->CreateBuffer(CBDesc, nullptr, &m_VSConstants);
+            m_pPSOCache->CreateShader(ShaderCI, &pPS);
         }
+        if (!pVS || !pPS)
+            return;
 
         // Define vertex shader input layout
         LayoutElement LayoutElems[] =
@@ -77,19 +137,185 @@ namespace Diligent
         // Define variable type that will be used by default
         PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
-        m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &m_pPSO);
+        // La órbita de referencia se recrea al crecer y se enlaza al dibujar
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_PIXEL, "ReferenceOrbit", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
 
-        m_pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "Constants")->Set(m_VSConstants);
+        m_pPSOCache->CreateGraphicsPipelineState(PSOCreateInfo, &Out.pPSO);
+        if (!Out.pPSO)
+            return;
 
-        m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
+        // Las permutaciones que no usan un cbuffer no lo declaran
+        auto SetStatic = [&](const char* Name, IBuffer* pBuffer) {
+            if (auto* pVar = Out.pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, Name))
+                pVar->Set(pBuffer);
+        };
+        SetStatic("Constants", m_VSConstants);
+        SetStatic("PerturbationConstants", m_PerturbationConstants);
+        SetStatic("RefineConstants", m_RefineConstants);
 
+        Out.pPSO->CreateShaderResourceBinding(&Out.pSRB, true);
     }
 
     void FractalViewer::CreateComputePipelineState()
     {
+        BufferDesc CBDesc;
+        CBDesc.Name = "CS Constants";
+        CBDesc.Size = sizeof(ShaderConstants);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_VSConstantsComputeShader);
+
+        // DispatchRegion + ConeParams
+        CBDesc.Name = "CS Dispatch Constants";
+        CBDesc.Size = 2 * sizeof(uint4);
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_DispatchConstants);
+
+        CBDesc.Name = "CS Temporal Constants";
+        CBDesc.Size = sizeof(TemporalConstants);
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_TemporalConstants);
+
+        // Salida, buffer de escape, historia, cono, supersampling y subdivisión: a resolución
+        // completa para empezar
+        SetRenderScale(0);
+
+        // Cache de distancias: texturas de 1 texel hasta que se hornee la primera escena
+        CBDesc.Name = "CS Brick Constants";
+        CBDesc.Size = sizeof(BrickConstants);
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_BrickConstants);
+        CreateDistanceBrickTextures();
+
+        FractalPSO UberPSO;
+        CreateComputePSO(FractalPermutation{}, UberPSO);
+        m_pComputePSO = UberPSO.pPSO;
+        m_pComputeSRB = UberPSO.pSRB;
+    }
+
+    void FractalViewer::CreateScaledTargets(Uint32 Level)
+    {
+        const auto& SCDesc = m_pSwapChain->GetDesc();
+        ScaledTargets& Targets = m_ScaledTargets[Level];
+
+        TextureDesc TexDesc;
+        TexDesc.Name = "Compute Output Texture";
+        TexDesc.Type = RESOURCE_DIM_TEX_2D;
+        DynamicResolution::GetLevelSize(Level, SCDesc.Width, SCDesc.Height, TexDesc.Width, TexDesc.Height);
+        TexDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Usage = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+        m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pOutput);
+
+        // Imagen final del supersampling adaptativo
+        TexDesc.Name = "Adaptive AA Output Texture";
+        m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pAAOutput);
+
+        TexDesc.Name = "Escape Buffer Texture";
+        TexDesc.Format = TEX_FORMAT_RG32_FLOAT;
+        m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pEscape);
+
+        // Historia de la reproyección temporal 3D: profundidades de impacto en ping-pong, la
+        // profundidad reproyectada (bits de float para InterlockedMin) y la copia del color
+        TexDesc.Format = TEX_FORMAT_R32_FLOAT;
+        for (Uint32 i = 0; i < _countof(Targets.pHistoryDepth); ++i)
+        {
+            TexDesc.Name = i == 0 ? "History Depth Texture 0" : "History Depth Texture 1";
+            m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pHistoryDepth[i]);
+        }
+
+        TexDesc.Name = "Reprojected Depth Texture";
+        TexDesc.Format = TEX_FORMAT_R32_UINT;
+        m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pReprojDepth);
+
+        TexDesc.Name = "History Color Texture";
+        TexDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        m_pDevice->CreateTexture(TexDesc, nullptr, &Targets.pHistoryColor);
+
+        // Prepasada de cono: una distancia por tile de cada nivel; el compute 3D lee la del último
+        const Uint32 Width = TexDesc.Width;
+        const Uint32 Height = TexDesc.Height;
+        for (Uint32 ConeLevel = 0; ConeLevel < _countof(ConeTileSizes); ++ConeLevel)
+        {
+            TextureDesc DepthDesc;
+            DepthDesc.Name = ConeLevel == 0 ? "Cone Depth Texture (1/8)" : "Cone Depth Texture (1/4)";
+            DepthDesc.Type = RESOURCE_DIM_TEX_2D;
+            DepthDesc.Width = (Width + ConeTileSizes[ConeLevel] - 1) / ConeTileSizes[ConeLevel];
+            DepthDesc.Height = (Height + ConeTileSizes[ConeLevel] - 1) / ConeTileSizes[ConeLevel];
+            DepthDesc.Format = TEX_FORMAT_R32_FLOAT;
+            DepthDesc.Usage = USAGE_DEFAULT;
+            DepthDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+            m_pDevice->CreateTexture(DepthDesc, nullptr, &Targets.pConeDepth[ConeLevel]);
+        }
+
+        // Subdivisión: una celda por tile mínima
+        TextureDesc StateDesc;
+        StateDesc.Name = "Subdivide State Texture";
+        StateDesc.Type = RESOURCE_DIM_TEX_2D;
+        StateDesc.Width = (Width + CPUFractalRenderer::SubdivMinTileSize - 1) / CPUFractalRenderer::SubdivMinTileSize;
+        StateDesc.Height = (Height + CPUFractalRenderer::SubdivMinTileSize - 1) / CPUFractalRenderer::SubdivMinTileSize;
+        StateDesc.Format = TEX_FORMAT_R32_UINT;
+        StateDesc.Usage = USAGE_DEFAULT;
+        StateDesc.BindFlags = BIND_UNORDERED_ACCESS;
+        m_pDevice->CreateTexture(StateDesc, nullptr, &Targets.pSubdivState);
+    }
+
+    void FractalViewer::SetRenderScale(Uint32 Level)
+    {
+        if (Level == m_RenderScaleLevel && m_pComputeOutputTex)
+            return;
+        if (!m_ScaledTargets[Level].pOutput)
+            CreateScaledTargets(Level);
+
+        const ScaledTargets& Targets = m_ScaledTargets[Level];
+        m_pComputeOutputTex = Targets.pOutput;
+        m_pEscapeTex = Targets.pEscape;
+        m_pHistoryDepthTex[0] = Targets.pHistoryDepth[0];
+        m_pHistoryDepthTex[1] = Targets.pHistoryDepth[1];
+        m_pReprojDepthTex = Targets.pReprojDepth;
+        m_pHistoryColorTex = Targets.pHistoryColor;
+        m_pConeDepthTex[0] = Targets.pConeDepth[0];
+        m_pConeDepthTex[1] = Targets.pConeDepth[1];
+        m_pAAOutputTex = Targets.pAAOutput;
+        m_pSubdivStateTex = Targets.pSubdivState;
+        m_RenderScaleLevel = Level;
+
+        // La historia 3D y la imagen del supersampling eran de las otras texturas, y los
+        // tiempos que lleguen ahora son de la escala anterior
+        m_HistoryValid = false;
+        m_AAOutputValid = false;
+        m_DynamicRes.DiscardSamples();
+    }
+
+    Uint32 FractalViewer::SelectRenderScale(const ShaderConstants& Constants)
+    {
+        // El pixel shader tiene su propio refinamiento progresivo; al exportar, resolución completa
+        if (!m_DynamicResEnabled || m_RenderMode == RenderMode::PixelShader || m_Exporting)
+            return 0;
+        m_DynamicRes.SetBudget(m_DynamicResBudgetMs);
+
+        // Mientras la escena cambia se usa el nivel del controlador; quieta, se redibuja una vez
+        // a resolución completa. Se compara con el último frame como si tuviera su tamaño.
+        ShaderConstants Probe = Constants;
+        Probe.TimeAndResolution.y = m_LastFrameKey.TimeAndResolution.y;
+        Probe.TimeAndResolution.z = m_LastFrameKey.TimeAndResolution.z;
+        const ShaderConstants Key = GetFrameKey(Probe);
+        const bool Moving = !m_HasLastFrame || m_LastFrameMode != m_RenderMode || std::memcmp(&Key, &m_LastFrameKey, sizeof(Key)) != 0 ||
+            (IsDeepZoomActive() && (m_LastDeepZoom != m_DeepZoom || m_LastDeepCenterX != m_DeepCenterX || m_LastDeepCenterY != m_DeepCenterY));
+        return Moving ? m_DynamicRes.GetLevel() : 0;
+    }
+
+    void FractalViewer::CreateComputePSO(const FractalPermutation& Permutation, FractalPSO& Out)
+    {
+        const std::string PSOName = "Fractal Compute PSO " + Permutation.GetName();
+
         // 1. Descripción básica
         ComputePipelineStateCreateInfo PSOCreateInfo;
-        PSOCreateInfo.PSODesc.Name = "Fractal Compute PSO";
+        PSOCreateInfo.PSODesc.Name = PSOName.c_str();
         PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
 
         // 2. Compilar el compute shader
@@ -100,22 +326,31 @@ namespace Diligent
         ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
         ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory; // ya creado
 
+        const std::string Type = std::to_string(Permutation.Type);
+        const std::string Precision = std::to_string(Permutation.Type < 0 ? -1 : Permutation.Precision);
+        const std::string GroupSizeX = std::to_string(Permutation.GroupSize.X);
+        const std::string GroupSizeY = std::to_string(Permutation.GroupSize.Y);
+        ShaderMacro Macros[] =
+        {
+            {"FRACTAL_TYPE", Type.c_str()},
+            {"FRACTAL_IS_3D", Permutation.Is3D ? "1" : "0"},
+            {"FRACTAL_PRECISION", Precision.c_str()},
+            {"FRACTAL_PERTURBATION", Permutation.Perturbation ? "1" : "0"},
+            {"THREAD_GROUP_SIZE_X", GroupSizeX.c_str()},
+            {"THREAD_GROUP_SIZE_Y", GroupSizeY.c_str()}
+        };
+        ShaderCI.Macros = { Macros, _countof(Macros) };
+
         RefCntAutoPtr<IShader> pCS;
         {
             ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
             ShaderCI.EntryPoint = "CSMain";
             ShaderCI.Desc.Name = "Fractal CS";
             ShaderCI.FilePath = "../Shaders/fractalCompute.psh";
-            m_pDevice->CreateShader(ShaderCI, &pCS);
-
-            BufferDesc CBDesc;
-            CBDesc.Name = "CS Constants";
-            CBDesc.Size = sizeof(ShaderConstants);
-            CBDesc.Usage = USAGE_DYNAMIC;
-            CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
-            CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-            m_pDevice->CreateBuffer(CBDesc, nullptr, &m_VSConstantsComputeShader);
+            m_pPSOCache->CreateShader(ShaderCI, &pCS);
         }
+        if (!pCS)
+            return;
 
         // 3. Asignar el compute shader al PSO
         PSOCreateInfo.pCS = pCS;
@@ -124,36 +359,135 @@ namespace Diligent
         PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType =
             SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
-        TextureDesc TexDesc;
-        TexDesc.Name = "Compute Output Texture";
-        TexDesc.Type = RESOURCE_DIM_TEX_2D;
-        TexDesc.Width = m_pSwapChain->GetDesc().Width;
-        TexDesc.Height = m_pSwapChain->GetDesc().Height;
-        TexDesc.Format = TEX_FORMAT_RGBA8_UNORM;
-        TexDesc.Usage = USAGE_DEFAULT;
-        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
-
+        // Las texturas de salida y la órbita de referencia se enlazan al despachar
         ShaderResourceVariableDesc Vars[] =
         {
-            {SHADER_TYPE_COMPUTE, "OutputTex", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+            {SHADER_TYPE_COMPUTE, "OutputTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "EscapeTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ReferenceOrbit", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ConeDepthTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "PrevDepthTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ReprojDepthTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "HistoryColorTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "DepthOutTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickCellTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickAtlasTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
         };
 
         PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
         PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
 
         // 5. Crear el PSO
-        m_pDevice->CreateComputePipelineState(PSOCreateInfo, &m_pComputePSO);
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &Out.pPSO);
+        if (!Out.pPSO)
+            return;
+
+        Out.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(m_VSConstantsComputeShader);
+        Out.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "DispatchConstants")->Set(m_DispatchConstants);
+        if (auto* pVar = Out.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "PerturbationConstants"))
+            pVar->Set(m_PerturbationConstants);
+        if (auto* pVar = Out.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "TemporalConstants"))
+            pVar->Set(m_TemporalConstants);
+        if (auto* pVar = Out.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "BrickConstants"))
+            pVar->Set(m_BrickConstants);
+
+        Out.pPSO->CreateShaderResourceBinding(&Out.pSRB, true);
+        Out.GroupSize = Permutation.GroupSize;
+    }
+
+    FractalViewer::FractalPermutation FractalViewer::GetCurrentPermutation(bool Compute, bool Perturbation) const
+    {
+        FractalPermutation Permutation;
+        Permutation.Is3D = m_is3D;
+        if (Compute)
+            Permutation.GroupSize = GetComputeGroupSize(m_is3D);
+
+        if (Compute && m_is3D)
+        {
+            // fractalCompute.psh tiene un kernel por tipo 3D (RenderFractalType3D)
+            Permutation.Type = std::min(std::max(m_SelectedFractal3D, 0), CPU_FRACTAL_3D_COUNT - 1);
+        }
+        else if (m_is3D)
+        {
+            // El pixel shader solo tiene Mandelbulb en 3D
+            Permutation.Type = 0;
+        }
+        else
+        {
+            Permutation.Type = std::min(std::max(m_SelectedFractal2D, 0), 4);
+            Permutation.Perturbation = Perturbation;
+            // El camino de perturbación siempre itera δ en float
+            Permutation.Precision = Perturbation ? CPU_PRECISION_FLOAT : static_cast<int>(m_FractalParams1.z + 0.5f);
+        }
+        return Permutation;
+    }
+
+    FractalViewer::FractalPSO FractalViewer::GetPermutationPSO(const FractalPermutation& Permutation, bool Compute)
+    {
+        const FractalPSO UberPSO = Compute ? FractalPSO{ m_pComputePSO, m_pComputeSRB } :
+            Permutation.Is3D ? FractalPSO{ m_pPSO3D, m_pSRB3D } : FractalPSO{ m_pPSO, m_pSRB };
+        if (!m_UsePermutations)
+            return UberPSO;
 
-        // Crea la textura usando el dispositivo
-        m_pDevice->CreateTexture(TexDesc, nullptr, &m_pComputeOutputTex);
+        const Uint32 Key = Permutation.GetKey() | (Compute ? FractalPermutation::ComputeBit : 0u);
+        {
+            std::lock_guard<std::mutex> Lock{ m_PermutationsMtx };
+            auto It = m_PermutationPSOs.find(Key);
+            if (It != m_PermutationPSOs.end())
+                return It->second.pPSO ? It->second : UberPSO;
+            if (!m_PendingPermutations.insert(Key).second)
+                return UberPSO;
+        }
 
-        m_pComputePSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(m_VSConstantsComputeShader);
+        // Todavía no existe: se compila en segundo plano y mientras tanto se usa el ubershader
+        m_pPSOCache->RunAsync([this, Permutation, Compute, Key]() {
+            FractalPSO PSO;
+            if (Compute)
+                CreateComputePSO(Permutation, PSO);
+            else
+                CreateFractalPSO(Permutation, PSO);
+
+            // Si falla (p. ej. sin soporte de double) se guarda vacía y se sigue con el ubershader
+            std::lock_guard<std::mutex> Lock{ m_PermutationsMtx };
+            m_PendingPermutations.erase(Key);
+            m_PermutationPSOs.emplace(Key, PSO);
+        });
+        return UberPSO;
+    }
 
-        
+    void FractalViewer::PrewarmPermutations()
+    {
+        // Todas las combinaciones que la UI puede pedir, para que al cambiar de fractal ya
+        // estén listas (o se carguen de la caché en disco)
+        for (int Type = 0; Type <= 4; ++Type)
+        {
+            for (int Precision = 0; Precision < CPU_PRECISION_COUNT; ++Precision)
+            {
+                FractalPermutation Permutation;
+                Permutation.Type = Type;
+                Permutation.Precision = Precision;
+                GetPermutationPSO(Permutation, false);
+
+                Permutation.GroupSize = GetComputeGroupSize(false);
+                GetPermutationPSO(Permutation, true);
+            }
+            if (CPUPerturbationRenderer::SupportsFractalType(Type))
+            {
+                FractalPermutation Permutation;
+                Permutation.Type = Type;
+                Permutation.Perturbation = true;
+                GetPermutationPSO(Permutation, false);
+            }
+        }
 
-        m_pComputePSO->CreateShaderResourceBinding(&m_pComputeSRB, true);
-        m_pComputeSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputTex")
-            ->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        FractalPermutation Permutation3D;
+        Permutation3D.Is3D = true;
+        Permutation3D.Type = 0;
+        GetPermutationPSO(Permutation3D, false);
+        Permutation3D.GroupSize = GetComputeGroupSize(true);
+        GetPermutationPSO(Permutation3D, true);
+        for (Permutation3D.Type = 1; Permutation3D.Type < CPU_FRACTAL_3D_COUNT; ++Permutation3D.Type)
+            GetPermutationPSO(Permutation3D, true);
     }
 
     void FractalViewer::CreateQuadPipelineState()
@@ -201,9 +535,10 @@ namespace Diligent
         PSOCreateInfo.pVS = pVS;
         PSOCreateInfo.pPS = pPS;
 
+        // La salida cambia con la escala de render y con el supersampling: se enlaza al dibujar
         ShaderResourceVariableDesc Vars[] =
         {
-            {SHADER_TYPE_PIXEL, "InputTex", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+            {SHADER_TYPE_PIXEL, "InputTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
         };
 
         SamplerDesc SamLinearClampDesc
@@ -224,207 +559,2159 @@ namespace Diligent
 
         m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &m_pQuadPSO);
         m_pQuadPSO->CreateShaderResourceBinding(&m_pQuadSRB, true);
+
+        // Variante sin depth para copiar la vista previa a la textura progresiva
+        PSOCreateInfo.PSODesc.Name = "Upscale Quad PSO";
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_UNKNOWN;
+        m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &m_pUpscalePSO);
         m_pQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, "InputTex")->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
     }
 
-    void FractalViewer::CreateIndexBuffer() {
-        static const Uint32 QuadIndices[] = {
-            0, 1, 2, 
-            2, 1, 3   
+    void FractalViewer::CreateColorizePipelineState()
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Colorize PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+        auto SCDesc = m_pSwapChain->GetDesc();
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = SCDesc.ColorBufferFormat;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = SCDesc.DepthBufferFormat;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        LayoutElement QuadLayout[] = {
+            LayoutElement{0, 0, 3, VT_FLOAT32, False},
+            LayoutElement{1, 0, 2, VT_FLOAT32, False}
         };
 
-        BufferDesc IndBuffDesc;
-        IndBuffDesc.Name = "Cube index buffer";
-        IndBuffDesc.Usage = USAGE_IMMUTABLE;
-        IndBuffDesc.BindFlags = BIND_INDEX_BUFFER;
-        IndBuffDesc.Size = sizeof(QuadIndices);
-        BufferData IBData;
-        IBData.pData = QuadIndices;
-        IBData.DataSize = sizeof(QuadIndices);
-        m_pDevice->CreateBuffer(IndBuffDesc, &IBData, &m_IndexBuffer);
-    }
+        PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = QuadLayout;
+        PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements = _countof(QuadLayout);
 
-    void FractalViewer::CreateVertexBuffer() {
-        struct Vertex
-        {
-            float3 pos;
-            float2 uv;
-        };
+        RefCntAutoPtr<IShader> pVS, pPS, pCopyPS;
+        ShaderCreateInfo SC;
+        SC.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        SC.HLSLVersion = { 6, 3 };
+        SC.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        SC.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
 
-        static const Vertex QuadVerts[] =
-        {
-            {{-1.0f, -1.0f, 0.0f}, {0.0f, 1.0f}}, 
-            {{-1.0f,  1.0f, 0.0f}, {0.0f, 0.0f}},
-            {{ 1.0f, -1.0f, 0.0f}, {1.0f, 1.0f}}, 
-            {{ 1.0f,  1.0f, 0.0f}, {1.0f, 0.0f}}, 
-        };
+        SC.Desc.UseCombinedTextureSamplers = true;
+        SC.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        SC.EntryPoint = "main";
+        SC.Desc.Name = "Quad VS";
+        SC.FilePath = "../Shaders/quad.vsh";
+        m_pPSOCache->CreateShader(SC, &pVS);
 
+        SC.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        SC.Desc.Name = "Colorize PS";
+        SC.FilePath = "../Shaders/colorize.psh";
+        m_pPSOCache->CreateShader(SC, &pPS);
 
-        BufferDesc VertBuffDesc;
-        VertBuffDesc.Name = "Fullscreen Quad vertex buffer";
-        VertBuffDesc.Usage = USAGE_IMMUTABLE;
-        VertBuffDesc.BindFlags = BIND_VERTEX_BUFFER;
-        VertBuffDesc.Size = sizeof(QuadVerts);
+        SC.EntryPoint = "CopyEscape";
+        SC.Desc.Name = "Copy Escape PS";
+        m_pPSOCache->CreateShader(SC, &pCopyPS);
 
-        BufferData VBData;
-        VBData.pData = QuadVerts;
-        VBData.DataSize = sizeof(QuadVerts);
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
 
-        m_pDevice->CreateBuffer(VertBuffDesc, &VBData, &m_VertexBuffer);
-    }
+        // El buffer de escape se lee con Load: no hace falta sampler (ni filtrado de RG32F). Cambia
+        // con la escala de render, así que se enlaza al dibujar
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_PIXEL, "EscapeTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
+        m_pPSOCache->CreateGraphicsPipelineState(PSOCreateInfo, &m_pColorizePSO);
+        m_pColorizePSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "Constants")->Set(m_VSConstants);
+        m_pColorizePSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "ColorizeConstants")->Set(m_ColorizeConstants);
+        m_pColorizePSO->CreateShaderResourceBinding(&m_pColorizeSRB, true);
+
+        // Copia de la vista previa a la textura progresiva en 2D (RG32F, sin depth)
+        PSOCreateInfo.PSODesc.Name = "Escape Upscale PSO";
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RG32_FLOAT;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_UNKNOWN;
+        PSOCreateInfo.pPS = pCopyPS;
+        m_pPSOCache->CreateGraphicsPipelineState(PSOCreateInfo, &m_pEscapeUpscalePSO);
+    }
 
+    void FractalViewer::CreateSubdividePipelineState()
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name = "Subdivide Constants";
+        CBDesc.Size = sizeof(uint4);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_SubdivideConstants);
+
+        // [0] = píxeles rellenados, [1] = píxeles iterados
+        BufferDesc CounterDesc;
+        CounterDesc.Name = "Subdivide Counters";
+        CounterDesc.Size = 2 * sizeof(Uint32);
+        CounterDesc.Usage = USAGE_DEFAULT;
+        CounterDesc.BindFlags = BIND_UNORDERED_ACCESS;
+        CounterDesc.Mode = BUFFER_MODE_RAW;
+        CounterDesc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pSubdivCounters);
+
+        CounterDesc.Name = "Subdivide Counters Readback";
+        CounterDesc.Usage = USAGE_STAGING;
+        CounterDesc.BindFlags = BIND_NONE;
+        CounterDesc.Mode = BUFFER_MODE_UNDEFINED;
+        CounterDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pSubdivReadback);
+
+        FenceDesc FenceCI;
+        FenceCI.Name = "Subdivide Readback Fence";
+        m_pDevice->CreateFence(FenceCI, &m_pSubdivFence);
 
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Fractal Subdivide PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
 
+        // Ubershader 2D (tipo y precisión en runtime); el deep zoom no usa este camino
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint = "CSSubdivide";
+        ShaderCI.Desc.Name = "Fractal Subdivide CS";
+        ShaderCI.FilePath = "../Shaders/fractalSubdivide.psh";
 
-    void FractalViewer::Initialize(const SampleInitInfo& InitInfo)
-    {
-        SampleBase::Initialize(InitInfo);
+        RefCntAutoPtr<IShader> pCS;
+        m_pPSOCache->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return;
+        PSOCreateInfo.pCS = pCS;
 
-        CreatePipelineState();
-        CreateComputePipelineState();
-        CreateQuadPipelineState();
-        CreateVertexBuffer();
-        CreateIndexBuffer();
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "EscapeTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "SubdivState", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ReferenceOrbit", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
 
-        m_Zoom = 1.0f;
-		m_Camera.SetPos({ 0.0f, 0.0f, -4.0f });
-        m_FractalParams1 = float4(100, 2, 0, 0);
-        m_FractalParams2 = float4(1, 0, 0, 0);
-        m_FractalColor = float4(1, 1, 1, 1);
-        m_BackgroundColor = float4(0, 0, 0, 1);
-        m_Options3D = float4(100, 10.0f, 0.001, 0);
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &m_pSubdividePSO);
+        if (!m_pSubdividePSO)
+            return;
 
+        m_pSubdividePSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(m_VSConstantsComputeShader);
+        m_pSubdividePSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "SubdivideConstants")->Set(m_SubdivideConstants);
+        m_pSubdividePSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "SubdivCounters")->Set(m_pSubdivCounters->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = m_pSubdividePSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "PerturbationConstants"))
+            pVar->Set(m_PerturbationConstants);
+        m_pSubdividePSO->CreateShaderResourceBinding(&m_pSubdivideSRB, true);
     }
 
-    void FractalViewer::Render()
+    void FractalViewer::CreateAdaptiveAAPipelineState()
     {
-        auto* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
-        auto* pDSV = m_pSwapChain->GetDepthBufferDSV();
-        float4 ClearColor = { 0.350f, 0.350f, 0.350f, 1.0f };
-        if (m_ConvertPSOutputToGamma)
-        {
-            ClearColor = LinearToSRGB(ClearColor);
-        }
-        m_pImmediateContext->ClearRenderTarget(pRTV, ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-        m_pImmediateContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        BufferDesc CBDesc;
+        CBDesc.Name = "Adaptive AA Constants";
+        CBDesc.Size = sizeof(float4);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_AAConstants);
+
+        // [0] = píxeles refinados, [1] = muestras extra
+        BufferDesc CounterDesc;
+        CounterDesc.Name = "Adaptive AA Counters";
+        CounterDesc.Size = 2 * sizeof(Uint32);
+        CounterDesc.Usage = USAGE_DEFAULT;
+        CounterDesc.BindFlags = BIND_UNORDERED_ACCESS;
+        CounterDesc.Mode = BUFFER_MODE_RAW;
+        CounterDesc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pAACounters);
+
+        CounterDesc.Name = "Adaptive AA Counters Readback";
+        CounterDesc.Usage = USAGE_STAGING;
+        CounterDesc.BindFlags = BIND_NONE;
+        CounterDesc.Mode = BUFFER_MODE_UNDEFINED;
+        CounterDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pAAReadback);
+
+        FenceDesc FenceCI;
+        FenceCI.Name = "Adaptive AA Readback Fence";
+        m_pDevice->CreateFence(FenceCI, &m_pAAFence);
 
-        ShaderConstants CBufferData = {};
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Fractal Adaptive AA PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
 
-		// Definición de variables de shader
-        {
-            float fracType = m_is3D
-                ? static_cast<float>(m_SelectedFractal3D)
-                : static_cast<float>(m_SelectedFractal2D);
-            CBufferData.TimeAndResolution = float4{
-                m_Time,
-                static_cast<float>(m_pSwapChain->GetDesc().Width),
-                static_cast<float>(m_pSwapChain->GetDesc().Height),
-                fracType
-            };
+        // Ubershader 2D y 3D (tipo y precisión en runtime); el deep zoom no usa este camino
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint = "CSAdaptiveAA";
+        ShaderCI.Desc.Name = "Fractal Adaptive AA CS";
+        ShaderCI.FilePath = "../Shaders/fractalAdaptiveAA.psh";
 
-            const auto& pos = m_Camera.GetPos();
-            const auto& right = m_Camera.GetWorldRight();
-            const auto& up = m_Camera.GetWorldUp();
-            const auto& forward = m_Camera.GetWorldAhead();
-            CBufferData.CameraPos = float4{ pos,  m_is3D ? 1.0f : 0.0f };
-            CBufferData.CameraDirX = float4{ right,   0.0f };
-            CBufferData.CameraDirY = float4{ up,      0.0f };
-            CBufferData.CameraDirZ = float4{ forward, 0.0f };
+        RefCntAutoPtr<IShader> pCS;
+        m_pPSOCache->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return;
+        PSOCreateInfo.pCS = pCS;
 
-            CBufferData.ZoomOffset = float4{
-                m_Zoom,
-                m_OffsetX,
-                m_OffsetY,
-                m_is3D ? m_OffsetZ : 0.0f
-            };
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "EscapeTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "FirstColorTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "FirstDepthTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "AAOutputTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ReferenceOrbit", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickCellTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickAtlasTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
 
-            CBufferData.FractalColor = m_FractalColor;
-            CBufferData.BackgroundColor = m_BackgroundColor;
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &m_pAdaptiveAAPSO);
+        if (!m_pAdaptiveAAPSO)
+            return;
+
+        m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(m_VSConstantsComputeShader);
+        m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "AAConstants")->Set(m_AAConstants);
+        m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "AACounters")->Set(m_pAACounters->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "ColorizeConstants"))
+            pVar->Set(m_ColorizeConstants);
+        if (auto* pVar = m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "PerturbationConstants"))
+            pVar->Set(m_PerturbationConstants);
+        if (auto* pVar = m_pAdaptiveAAPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "BrickConstants"))
+            pVar->Set(m_BrickConstants);
+        m_pAdaptiveAAPSO->CreateShaderResourceBinding(&m_pAdaptiveAASRB, true);
+    }
 
-            CBufferData.FractalC = m_FractalC;
+    void FractalViewer::CreateSweepPipelineState()
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name = "Parameter Sweep Dispatch Constants";
+        CBDesc.Size = sizeof(uint4);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_SweepDispatchConstants);
+
+        FenceDesc FenceCI;
+        FenceCI.Name = "Parameter Sweep Fence";
+        m_pDevice->CreateFence(FenceCI, &m_pSweepFence);
 
-		    CBufferData.maxiter = m_maxiter;
-            CBufferData.FractalParams1 = m_FractalParams1;
-            CBufferData.FractalParams2 = m_FractalParams2;
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Fractal Parameter Sweep PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
 
-            CBufferData.Options3D = m_Options3D;
-		    CBufferData.AnimationParams = m_AnimationParams;
-		}
+        // Ubershader: cada miniatura elige tipo, precisión y 2D / 3D en runtime
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint = "CSSweep";
+        ShaderCI.Desc.Name = "Fractal Parameter Sweep CS";
+        ShaderCI.FilePath = "../Shaders/fractalSweep.psh";
 
+        RefCntAutoPtr<IShader> pCS;
+        m_pPSOCache->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return;
+        PSOCreateInfo.pCS = pCS;
+
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "SweepConstants", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "SweepAtlasTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &m_pSweepPSO);
+        if (!m_pSweepPSO)
+            return;
+
+        m_pSweepPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "SweepDispatch")->Set(m_SweepDispatchConstants);
+        if (auto* pVar = m_pSweepPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "ColorizeConstants"))
+            pVar->Set(m_ColorizeConstants);
+        m_pSweepPSO->CreateShaderResourceBinding(&m_pSweepSRB, true);
+    }
+
+    void FractalViewer::CreateIterStatsPipelineState()
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name = "Iteration Stats Constants";
+        CBDesc.Size = sizeof(uint4);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_IterStatsConstants);
+
+        // Histograma de CPUEscapeHistogramBins cubetas + escaparon, en el tope, sin resolver
+        BufferDesc CounterDesc;
+        CounterDesc.Name = "Iteration Stats Counters";
+        CounterDesc.Size = (CPUEscapeHistogramBins + 3) * sizeof(Uint32);
+        CounterDesc.Usage = USAGE_DEFAULT;
+        CounterDesc.BindFlags = BIND_UNORDERED_ACCESS;
+        CounterDesc.Mode = BUFFER_MODE_RAW;
+        CounterDesc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pIterStatsCounters);
+
+        CounterDesc.Name = "Iteration Stats Readback";
+        CounterDesc.Usage = USAGE_STAGING;
+        CounterDesc.BindFlags = BIND_NONE;
+        CounterDesc.Mode = BUFFER_MODE_UNDEFINED;
+        CounterDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        m_pDevice->CreateBuffer(CounterDesc, nullptr, &m_pIterStatsReadback);
+
+        FenceDesc FenceCI;
+        FenceCI.Name = "Iteration Stats Readback Fence";
+        m_pDevice->CreateFence(FenceCI, &m_pIterStatsFence);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Fractal Iteration Stats PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint = "CSIterStats";
+        ShaderCI.Desc.Name = "Fractal Iteration Stats CS";
+        ShaderCI.FilePath = "../Shaders/fractalIterStats.psh";
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pPSOCache->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return;
+        PSOCreateInfo.pCS = pCS;
+
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "EscapeTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &m_pIterStatsPSO);
+        if (!m_pIterStatsPSO)
+            return;
+
+        m_pIterStatsPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "IterStatsConstants")->Set(m_IterStatsConstants);
+        m_pIterStatsPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "IterStats")->Set(m_pIterStatsCounters->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        m_pIterStatsPSO->CreateShaderResourceBinding(&m_pIterStatsSRB, true);
+    }
+
+    void FractalViewer::CreateConePrepassPipelineState()
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name = "Cone Prepass Constants";
+        CBDesc.Size = sizeof(uint4);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        m_pDevice->CreateBuffer(CBDesc, nullptr, &m_ConeConstants);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Fractal Cone Prepass PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+
+        // Un solo PSO para Mandelbulb, Menger, Mandelbox y Quaternion Julia (el tipo se elige en runtime)
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint = "CSConePrepass";
+        ShaderCI.Desc.Name = "Fractal Cone Prepass CS";
+        ShaderCI.FilePath = "../Shaders/fractalConeMarch.psh";
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pPSOCache->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return;
+        PSOCreateInfo.pCS = pCS;
+
+        // Cada nivel tiene su SRB: escribe su textura y lee la del anterior. Las texturas cambian
+        // con la escala de render y el cache de distancias con la escena: se enlazan al despachar
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "ConeDepthOut", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "ConeDepthIn", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickCellTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+            {SHADER_TYPE_COMPUTE, "BrickAtlasTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, &m_pConePrepassPSO);
+        if (!m_pConePrepassPSO)
+            return;
+
+        m_pConePrepassPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(m_VSConstantsComputeShader);
+        m_pConePrepassPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "ConeConstants")->Set(m_ConeConstants);
+        if (auto* pVar = m_pConePrepassPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "BrickConstants"))
+            pVar->Set(m_BrickConstants);
+        for (Uint32 Level = 0; Level < _countof(ConeTileSizes); ++Level)
+            m_pConePrepassPSO->CreateShaderResourceBinding(&m_pConePrepassSRB[Level], true);
+    }
+
+    void FractalViewer::RenderConePrepassGPU()
+    {
+        m_pImmediateContext->SetPipelineState(m_pConePrepassPSO);
+        for (Uint32 Level = 0; Level < _countof(ConeTileSizes); ++Level)
+        {
+            {
+                MapHelper<uint4> ConeHelper{ m_pImmediateContext, m_ConeConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+                *ConeHelper = uint4{ ConeTileSizes[Level], Level > 0 ? ConeTileSizes[Level - 1] : 0u, 0u, 0u };
+            }
+            // El primer nivel no lee ConeDepthIn, pero tiene que estar enlazada
+            ITexture* pParent = m_pConeDepthTex[Level == 0 ? 1 : Level - 1];
+            m_pConePrepassSRB[Level]->GetVariableByName(SHADER_TYPE_COMPUTE, "ConeDepthOut")->Set(m_pConeDepthTex[Level]->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+            m_pConePrepassSRB[Level]->GetVariableByName(SHADER_TYPE_COMPUTE, "ConeDepthIn")->Set(pParent->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+            BindDistanceBricks(m_pConePrepassSRB[Level]);
+            m_pImmediateContext->CommitShaderResources(m_pConePrepassSRB[Level], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            // Un hilo por tile
+            const auto& DepthDesc = m_pConeDepthTex[Level]->GetDesc();
+            DispatchComputeAttribs DispatchAttrs;
+            DispatchAttrs.ThreadGroupCountX = (DepthDesc.Width + 7) / 8;
+            DispatchAttrs.ThreadGroupCountY = (DepthDesc.Height + 7) / 8;
+            DispatchAttrs.ThreadGroupCountZ = 1;
+            m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+            StateTransitionDesc Barrier{ m_pConeDepthTex[Level], RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE };
+            m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+        }
+    }
+
+    void FractalViewer::CreateReprojectPipelineState()
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.HLSLVersion = { 6, 3 };
+        ShaderCI.Desc.UseCombinedTextureSamplers = true;
+        ShaderCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.pShaderSourceStreamFactory = m_pShaderSourceFactory;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.FilePath = "../Shaders/fractalReproject.psh";
+
+        // Dos puntos de entrada del mismo fichero: vaciado y proyección de los impactos
+        auto CreatePSO = [&](const char* EntryPoint, const char* Name, IPipelineState** ppPSO) {
+            ShaderCI.EntryPoint = EntryPoint;
+            ShaderCI.Desc.Name = Name;
+            RefCntAutoPtr<IShader> pCS;
+            m_pPSOCache->CreateShader(ShaderCI, &pCS);
+            if (!pCS)
+                return;
+
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            PSOCreateInfo.PSODesc.Name = Name;
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+            PSOCreateInfo.pCS = pCS;
+
+            // Las profundidades cambian con el ping-pong y con la escala de render: se enlazan al despachar
+            ShaderResourceVariableDesc Vars[] =
+            {
+                {SHADER_TYPE_COMPUTE, "PrevDepthTex", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+                {SHADER_TYPE_COMPUTE, "ReprojDepthOut", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}
+            };
+            PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+            PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+            PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+            m_pPSOCache->CreateComputePipelineState(PSOCreateInfo, ppPSO);
+            if (*ppPSO == nullptr)
+                return;
+
+            auto SetStatic = [&](const char* VarName, IDeviceObject* pObject) {
+                if (auto* pVar = (*ppPSO)->GetStaticVariableByName(SHADER_TYPE_COMPUTE, VarName))
+                    pVar->Set(pObject);
+            };
+            SetStatic("Constants", m_VSConstantsComputeShader);
+            SetStatic("TemporalConstants", m_TemporalConstants);
+        };
+        CreatePSO("CSReprojectClear", "Fractal Reproject Clear PSO", &m_pReprojectClearPSO);
+        CreatePSO("CSReprojectScatter", "Fractal Reproject Scatter PSO", &m_pReprojectScatterPSO);
+        if (!m_pReprojectClearPSO || !m_pReprojectScatterPSO)
+        {
+            m_pReprojectClearPSO.Release();
+            m_pReprojectScatterPSO.Release();
+            return;
+        }
+
+        m_pReprojectClearPSO->CreateShaderResourceBinding(&m_pReprojectClearSRB, true);
+        m_pReprojectScatterPSO->CreateShaderResourceBinding(&m_pReprojectScatterSRB, true);
+    }
+
+    void FractalViewer::RenderReprojectGPU()
+    {
+        const auto& DepthDesc = m_pReprojDepthTex->GetDesc();
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (DepthDesc.Width + 7) / 8;
+        DispatchAttrs.ThreadGroupCountY = (DepthDesc.Height + 7) / 8;
+        DispatchAttrs.ThreadGroupCountZ = 1;
+
+        ITextureView* pReprojDepthUAV = m_pReprojDepthTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS);
+        m_pReprojectClearSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ReprojDepthOut")->Set(pReprojDepthUAV);
+        m_pImmediateContext->SetPipelineState(m_pReprojectClearPSO);
+        m_pImmediateContext->CommitShaderResources(m_pReprojectClearSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+        StateTransitionDesc Barrier{ m_pReprojDepthTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE };
+        m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+
+        // Un hilo por píxel del frame anterior; lee la profundidad que no escribe este frame
+        m_pReprojectScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ReprojDepthOut")->Set(pReprojDepthUAV);
+        m_pReprojectScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "PrevDepthTex")
+            ->Set(m_pHistoryDepthTex[m_HistoryDepthIndex ^ 1]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        m_pImmediateContext->SetPipelineState(m_pReprojectScatterPSO);
+        m_pImmediateContext->CommitShaderResources(m_pReprojectScatterSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+    }
+
+    FractalViewer::TemporalConstants FractalViewer::PrepareTemporalGPU(const ShaderConstants& Constants) const
+    {
+        TemporalConstants TemporalData = {};
+        const bool Valid = m_TemporalEnabled && m_is3D && m_RenderMode == RenderMode::ComputeShader && m_HistoryValid && m_pReprojectScatterPSO &&
+            IsTemporalHistoryCompatible3D(ToCPUShaderConstants(m_HistoryConstants), ToCPUShaderConstants(Constants));
+        if (!Valid)
+            return TemporalData;
+
+        // Origen de los rayos como en GetCameraRay3D: todos menos el Menger lo adelantan con el zoom
+        const auto& Prev = m_HistoryConstants;
+        const float OriginShift = static_cast<int>(Prev.TimeAndResolution.w) == CPU_FRACTAL_3D_MENGER_SPONGE ? 0.0f : Prev.ZoomOffset.x;
+        TemporalData.PrevRayOrigin = Prev.CameraPos + Prev.CameraDirZ * OriginShift;
+        TemporalData.PrevCameraDirX = Prev.CameraDirX;
+        TemporalData.PrevCameraDirY = Prev.CameraDirY;
+        TemporalData.PrevCameraDirZ = Prev.CameraDirZ;
+        TemporalData.TemporalParams = float4{ 1.0f, m_TemporalBlend, CPUFractalRenderer::TemporalDepthMargin, CPUFractalRenderer::TemporalDepthTolerance };
+        return TemporalData;
+    }
+
+    void FractalViewer::UpdateTemporalHistory(const ShaderConstants& Constants)
+    {
+        if (!m_TemporalEnabled)
+        {
+            m_HistoryValid = false;
+            return;
+        }
+
+        // La profundidad ya está en m_pHistoryDepthTex[m_HistoryDepthIndex]; falta el color
+        CopyTextureAttribs CopyAttribs{ m_pComputeOutputTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, m_pHistoryColorTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION };
+        m_pImmediateContext->CopyTexture(CopyAttribs);
+
+        m_HistoryConstants = Constants;
+        m_HistoryValid = true;
+        m_HistoryDepthIndex ^= 1;
+    }
+
+    void FractalViewer::CreateDistanceBrickTextures()
+    {
+        // Tabla de celdas (RGBA32F, una por texel) y atlas con sitio para todos los bricks de
+        // la banda, en un bloque casi cúbico de bricks; sin escena, un texel de cada
+        const Uint32 Cells = static_cast<Uint32>(std::cbrt(static_cast<double>(std::max<size_t>(m_DistanceBricks.GetCells().size(), 1))) + 0.5);
+        const Uint32 NumBricks = std::max(m_DistanceBricks.GetStats().BandBricks, 1u);
+        const Uint32 AtlasX = static_cast<Uint32>(std::ceil(std::cbrt(static_cast<double>(NumBricks))));
+        const Uint32 AtlasZ = (NumBricks + AtlasX * AtlasX - 1) / (AtlasX * AtlasX);
+        const Uint32 Samples = m_DistanceBricks.GetCells().empty() ? 1 : m_DistanceBricks.GetBrickSamples();
+        m_BrickAtlasBricks = uint4{ AtlasX, AtlasX, AtlasZ, 0u };
+
+        TextureDesc TexDesc;
+        TexDesc.Name = "Distance Brick Cells";
+        TexDesc.Type = RESOURCE_DIM_TEX_3D;
+        TexDesc.Width = Cells;
+        TexDesc.Height = Cells;
+        TexDesc.Depth = Cells;
+        TexDesc.Format = TEX_FORMAT_RGBA32_FLOAT;
+        TexDesc.Usage = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        m_pBrickCellTex.Release();
+        m_pDevice->CreateTexture(TexDesc, nullptr, &m_pBrickCellTex);
+
+        TexDesc.Name = "Distance Brick Atlas";
+        TexDesc.Width = AtlasX * Samples;
+        TexDesc.Height = AtlasX * Samples;
+        TexDesc.Depth = AtlasZ * Samples;
+        TexDesc.Format = m_DistanceBricks.GetNumChannels() > 1 ? TEX_FORMAT_RG32_FLOAT : TEX_FORMAT_R32_FLOAT;
+        m_pBrickAtlasTex.Release();
+        m_pDevice->CreateTexture(TexDesc, nullptr, &m_pBrickAtlasTex);
+    }
+
+    void FractalViewer::BindDistanceBricks(IShaderResourceBinding* pSRB)
+    {
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "BrickCellTex"))
+            pVar->Set(m_pBrickCellTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "BrickAtlasTex"))
+            pVar->Set(m_pBrickAtlasTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    }
+
+    void FractalViewer::UpdateDistanceBricks(const ShaderConstants& Constants)
+    {
+        // Solo escenas estáticas: con la potencia animada cada frame sería otro fractal. Mandelbox
+        // y Quaternion Julia no tienen cache (marchan siempre con su DE)
+        const bool IsMenger = m_SelectedFractal3D == CPU_FRACTAL_3D_MENGER_SPONGE;
+        m_BricksActive = m_BricksEnabled && m_is3D && m_RenderMode == RenderMode::ComputeShader &&
+            CPUDistanceBrickCache::IsSupported(ToCPUShaderConstants(Constants)) && (IsMenger || m_Options3D.w > 0.0f || paused);
+
+        BrickConstants BrickData = {};
+        if (m_BricksActive)
+        {
+            if (!m_pCPURenderer)
+                m_pCPURenderer.reset(new CPUFractalRenderer{});
+            CPUThreadPool& Pool = m_pCPURenderer->GetThreadPool();
+
+            const CPUShaderConstants CPUConstants = ToCPUShaderConstants(Constants);
+            const bool Rebuilt = m_DistanceBricks.Prepare(Pool, CPUConstants, m_BrickSettings);
+            if (Rebuilt)
+                CreateDistanceBrickTextures();
+
+            const CPUFloat3 Eye{ Constants.CameraPos.x, Constants.CameraPos.y, Constants.CameraPos.z };
+            const Uint32 NumBaked = m_DistanceBricks.BakeNearCamera(Pool, Eye, static_cast<Uint32>(std::max(m_BrickBakeBudget, 1)));
+
+            // Cada brick nuevo a su sitio del atlas; la tabla de celdas, entera
+            const Uint32 Samples = m_DistanceBricks.GetBrickSamples();
+            const Uint32 SampleBytes = m_DistanceBricks.GetNumChannels() * sizeof(float);
+            for (Uint32 Slot : m_DistanceBricks.GetLastBakedBricks())
+            {
+                const Uint32 X = (Slot % m_BrickAtlasBricks.x) * Samples;
+                const Uint32 Y = (Slot / m_BrickAtlasBricks.x % m_BrickAtlasBricks.y) * Samples;
+                const Uint32 Z = (Slot / (m_BrickAtlasBricks.x * m_BrickAtlasBricks.y)) * Samples;
+
+                TextureSubResData SubresData;
+                SubresData.pData = m_DistanceBricks.GetBrickData(Slot);
+                SubresData.Stride = Samples * SampleBytes;
+                SubresData.DepthStride = Samples * Samples * SampleBytes;
+                Box BrickBox{ X, X + Samples, Y, Y + Samples, Z, Z + Samples };
+                m_pImmediateContext->UpdateTexture(m_pBrickAtlasTex, 0, 0, BrickBox, SubresData,
+                                                   RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+            if (Rebuilt || NumBaked > 0)
+            {
+                const Uint32 Cells = m_DistanceBricks.GetSettings().CellsPerAxis;
+                TextureSubResData SubresData;
+                SubresData.pData = m_DistanceBricks.GetCells().data();
+                SubresData.Stride = Cells * sizeof(CPUFloat4);
+                SubresData.DepthStride = Cells * Cells * sizeof(CPUFloat4);
+                Box CellBox{ 0, Cells, 0, Cells, 0, Cells };
+                m_pImmediateContext->UpdateTexture(m_pBrickCellTex, 0, 0, CellBox, SubresData,
+                                                   RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+
+            const CPUFloat3& DomainMin = m_DistanceBricks.GetDomainMin();
+            BrickData.BrickDomain = float4{ DomainMin.x, DomainMin.y, DomainMin.z, m_DistanceBricks.GetCellSize() };
+            BrickData.BrickParams = float4{ 1.0f, static_cast<float>(m_DistanceBricks.GetSettings().CellsPerAxis),
+                                            static_cast<float>(m_DistanceBricks.GetSettings().BrickResolution), m_DistanceBricks.GetFallbackDist() };
+            BrickData.BrickAtlas = m_BrickAtlasBricks;
+        }
+
+        MapHelper<BrickConstants> BrickHelper{ m_pImmediateContext, m_BrickConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+        *BrickHelper = BrickData;
+    }
+
+    void FractalViewer::RenderSubdivisionGPU()
+    {
+        const Uint32 ZeroCounters[2] = {};
+        m_pImmediateContext->UpdateBuffer(m_pSubdivCounters, 0, sizeof(ZeroCounters), ZeroCounters, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        BindComputeTargets(m_pSubdivideSRB);
+        m_pSubdivideSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "SubdivState")->Set(m_pSubdivStateTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        m_pImmediateContext->SetPipelineState(m_pSubdividePSO);
+        m_pImmediateContext->CommitShaderResources(m_pSubdivideSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // De la tile más grande a la mínima; cada pasada lee el estado que dejó la anterior
+        const auto& TexDesc = m_pEscapeTex->GetDesc();
+        for (Uint32 TileSize = CPUFractalRenderer::SubdivMaxTileSize; TileSize >= CPUFractalRenderer::SubdivMinTileSize; TileSize /= 2)
+        {
+            {
+                MapHelper<uint4> SubdivHelper{ m_pImmediateContext, m_SubdivideConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+                *SubdivHelper = uint4{ TileSize, CPUFractalRenderer::SubdivMinTileSize, TileSize == CPUFractalRenderer::SubdivMaxTileSize ? 1u : 0u, 0u };
+            }
+
+            DispatchComputeAttribs DispatchAttrs;
+            DispatchAttrs.ThreadGroupCountX = (TexDesc.Width + TileSize - 1) / TileSize;
+            DispatchAttrs.ThreadGroupCountY = (TexDesc.Height + TileSize - 1) / TileSize;
+            DispatchAttrs.ThreadGroupCountZ = 1;
+            m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+            StateTransitionDesc Barriers[] =
+            {
+                {m_pEscapeTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE},
+                {m_pSubdivStateTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE}
+            };
+            m_pImmediateContext->TransitionResourceStates(_countof(Barriers), Barriers);
+        }
+
+        // Los contadores se leen cuando la GPU haya terminado, sin esperarla
+        if (!m_SubdivReadbackPending)
+        {
+            m_pImmediateContext->CopyBuffer(m_pSubdivCounters, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                            m_pSubdivReadback, 0, 2 * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            m_pImmediateContext->EnqueueSignal(m_pSubdivFence, ++m_SubdivFenceValue);
+            m_SubdivReadbackPending = true;
+        }
+    }
+
+    void FractalViewer::ReadSubdivisionStats()
+    {
+        if (!m_SubdivReadbackPending || m_pSubdivFence->GetCompletedValue() < m_SubdivFenceValue)
+            return;
+
+        MapHelper<Uint32> Counters{ m_pImmediateContext, m_pSubdivReadback, MAP_READ, MAP_FLAG_DO_NOT_WAIT };
+        if (Counters)
+        {
+            m_SubdivSkipped = Counters[0];
+            m_SubdivEvaluated = Counters[1];
+        }
+        m_SubdivReadbackPending = false;
+    }
+
+    void FractalViewer::RenderIterStatsGPU(ITexture* pEscapeTex)
+    {
+        // Sin PSO o con la copia anterior aún pendiente no se mide este frame
+        if (!m_pIterStatsPSO || m_IterStatsReadbackPending)
+            return;
+
+        const Uint32 ZeroCounters[CPUEscapeHistogramBins + 3] = {};
+        m_pImmediateContext->UpdateBuffer(m_pIterStatsCounters, 0, sizeof(ZeroCounters), ZeroCounters, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        {
+            MapHelper<uint4> StatsHelper{ m_pImmediateContext, m_IterStatsConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *StatsHelper = uint4{ static_cast<Uint32>(m_maxiter), 0u, 0u, 0u };
+        }
+
+        m_pIterStatsSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "EscapeTex")->Set(pEscapeTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        m_pImmediateContext->SetPipelineState(m_pIterStatsPSO);
+        m_pImmediateContext->CommitShaderResources(m_pIterStatsSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const auto& TexDesc = pEscapeTex->GetDesc();
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (TexDesc.Width + 15) / 16;
+        DispatchAttrs.ThreadGroupCountY = (TexDesc.Height + 15) / 16;
+        DispatchAttrs.ThreadGroupCountZ = 1;
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+        // Los contadores se leen cuando la GPU haya terminado, sin esperarla
+        m_pImmediateContext->CopyBuffer(m_pIterStatsCounters, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                        m_pIterStatsReadback, 0, sizeof(ZeroCounters), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pImmediateContext->EnqueueSignal(m_pIterStatsFence, ++m_IterStatsFenceValue);
+        m_IterStatsReadbackPending = true;
+        m_IterStatsPendingFrame.Pixels = Uint64{TexDesc.Width} * TexDesc.Height;
+        m_IterStatsPendingFrame.MaxIter = m_maxiter;
+    }
+
+    void FractalViewer::ReadIterStats()
+    {
+        if (!m_IterStatsReadbackPending || m_pIterStatsFence->GetCompletedValue() < m_IterStatsFenceValue)
+            return;
+
+        CPUEscapeStats Stats = m_IterStatsPendingFrame;
+        bool Valid = false;
+        {
+            MapHelper<Uint32> Counters{ m_pImmediateContext, m_pIterStatsReadback, MAP_READ, MAP_FLAG_DO_NOT_WAIT };
+            if (Counters)
+            {
+                for (Uint32 Bin = 0; Bin < CPUEscapeHistogramBins; ++Bin)
+                    Stats.Bins[Bin] = Counters[Bin];
+                Stats.Escaped = Counters[CPUEscapeHistogramBins];
+                Stats.Capped = Counters[CPUEscapeHistogramBins + 1];
+                Stats.Unresolved = Counters[CPUEscapeHistogramBins + 2];
+                Valid = true;
+            }
+        }
+        m_IterStatsReadbackPending = false;
+        if (Valid)
+            ApplyIterationBudget(Stats);
+    }
+
+    void FractalViewer::ApplyIterationBudget(const CPUEscapeStats& Stats)
+    {
+        m_IterStats = Stats;
+        if (m_AutoIterEnabled && !m_is3D && Stats.MaxIter == m_maxiter)
+            m_maxiter = ChooseIterationBudget(Stats, m_IterBudgetSettings);
+    }
+
+    bool FractalViewer::IsAdaptiveAAActive() const
+    {
+        return m_AAEnabled && m_pAdaptiveAAPSO && m_RenderMode == RenderMode::ComputeShader && !IsDeepZoomActive();
+    }
+
+    void FractalViewer::RenderAdaptiveAAGPU(const float4* pColorKey)
+    {
+        if (!IsAdaptiveAAActive())
+        {
+            m_AAOutputValid = false;
+            return;
+        }
+
+        const Uint32 ZeroCounters[2] = {};
+        m_pImmediateContext->UpdateBuffer(m_pAACounters, 0, sizeof(ZeroCounters), ZeroCounters, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        {
+            MapHelper<float4> AAHelper{ m_pImmediateContext, m_AAConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *AAHelper = float4{ static_cast<float>(m_AAMaxSamples), m_AAThreshold, 0.0f, 0.0f };
+        }
+
+        // Primera muestra: el buffer de escape en 2D; en 3D el color y la profundidad que acaba
+        // de escribir el compute (antes de que UpdateTemporalHistory cambie de profundidad)
+        m_pAdaptiveAASRB->GetVariableByName(SHADER_TYPE_COMPUTE, "EscapeTex")->Set(m_pEscapeTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        m_pAdaptiveAASRB->GetVariableByName(SHADER_TYPE_COMPUTE, "FirstColorTex")->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        m_pAdaptiveAASRB->GetVariableByName(SHADER_TYPE_COMPUTE, "FirstDepthTex")
+            ->Set(m_pHistoryDepthTex[m_HistoryDepthIndex]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        m_pAdaptiveAASRB->GetVariableByName(SHADER_TYPE_COMPUTE, "AAOutputTex")->Set(m_pAAOutputTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = m_pAdaptiveAASRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ReferenceOrbit"))
+            pVar->Set(m_ReferenceOrbitBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        BindDistanceBricks(m_pAdaptiveAASRB);
+
+        m_pImmediateContext->SetPipelineState(m_pAdaptiveAAPSO);
+        m_pImmediateContext->CommitShaderResources(m_pAdaptiveAASRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const auto& TexDesc = m_pAAOutputTex->GetDesc();
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (TexDesc.Width + 7) / 8;
+        DispatchAttrs.ThreadGroupCountY = (TexDesc.Height + 7) / 8;
+        DispatchAttrs.ThreadGroupCountZ = 1;
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+        StateTransitionDesc Barrier(m_pAAOutputTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+
+        // Los contadores se leen cuando la GPU haya terminado, sin esperarla
+        if (!m_AAReadbackPending)
+        {
+            m_pImmediateContext->CopyBuffer(m_pAACounters, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                            m_pAAReadback, 0, 2 * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            m_pImmediateContext->EnqueueSignal(m_pAAFence, ++m_AAFenceValue);
+            m_AAReadbackPending = true;
+        }
+
+        for (Uint32 i = 0; i < _countof(m_AAColorKey); ++i)
+            m_AAColorKey[i] = pColorKey[i];
+        m_AAOutputValid = true;
+    }
+
+    void FractalViewer::ReadAdaptiveAAStats()
+    {
+        if (!m_AAReadbackPending || m_pAAFence->GetCompletedValue() < m_AAFenceValue)
+            return;
+
+        MapHelper<Uint32> Counters{ m_pImmediateContext, m_pAAReadback, MAP_READ, MAP_FLAG_DO_NOT_WAIT };
+        if (Counters)
+        {
+            m_AARefinedPixels = Counters[0];
+            m_AAExtraSamples = Counters[1];
+        }
+        m_AAReadbackPending = false;
+    }
+
+    void FractalViewer::CreateReferenceOrbitBuffer(Uint32 NumElements)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name = "Reference orbit buffer";
+        BuffDesc.Usage = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float2);
+        BuffDesc.Size = Uint64{NumElements} * sizeof(float2);
+
+        m_ReferenceOrbitBuffer.Release();
+        m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_ReferenceOrbitBuffer);
+        m_ReferenceOrbitCapacity = NumElements;
+    }
+
+    void FractalViewer::CreateIndexBuffer() {
+        static const Uint32 QuadIndices[] = {
+            0, 1, 2, 
+            2, 1, 3   
+        };
+
+        BufferDesc IndBuffDesc;
+        IndBuffDesc.Name = "Cube index buffer";
+        IndBuffDesc.Usage = USAGE_IMMUTABLE;
+        IndBuffDesc.BindFlags = BIND_INDEX_BUFFER;
+        IndBuffDesc.Size = sizeof(QuadIndices);
+        BufferData IBData;
+        IBData.pData = QuadIndices;
+        IBData.DataSize = sizeof(QuadIndices);
+        m_pDevice->CreateBuffer(IndBuffDesc, &IBData, &m_IndexBuffer);
+    }
+
+    void FractalViewer::CreateVertexBuffer() {
+        struct Vertex
+        {
+            float3 pos;
+            float2 uv;
+        };
+
+        static const Vertex QuadVerts[] =
+        {
+            {{-1.0f, -1.0f, 0.0f}, {0.0f, 1.0f}}, 
+            {{-1.0f,  1.0f, 0.0f}, {0.0f, 0.0f}},
+            {{ 1.0f, -1.0f, 0.0f}, {1.0f, 1.0f}}, 
+            {{ 1.0f,  1.0f, 0.0f}, {1.0f, 0.0f}}, 
+        };
+
+
+        BufferDesc VertBuffDesc;
+        VertBuffDesc.Name = "Fullscreen Quad vertex buffer";
+        VertBuffDesc.Usage = USAGE_IMMUTABLE;
+        VertBuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+        VertBuffDesc.Size = sizeof(QuadVerts);
+
+        BufferData VBData;
+        VBData.pData = QuadVerts;
+        VBData.DataSize = sizeof(QuadVerts);
+
+        m_pDevice->CreateBuffer(VertBuffDesc, &VBData, &m_VertexBuffer);
+    }
+
+
+
+
+
+    FractalViewer::~FractalViewer()
+    {
+        // Una exportación a medias se cierra con los frames que ya estén copiados
+        if (m_Exporting)
+            EndExport();
+
+        // Espera al hilo de compilación (usa el dispositivo) y guarda la caché
+        m_pPSOCache.reset();
+    }
+
+    void FractalViewer::ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs)
+    {
+        SampleBase::ModifyEngineInitInfo(Attribs);
+
+        // Para los tiempos de GPU del panel de timing, si el dispositivo los tiene
+        Attribs.EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+    }
+
+    void FractalViewer::Initialize(const SampleInitInfo& InitInfo)
+    {
+        SampleBase::Initialize(InitInfo);
+
+        CreatePipelineState();
+        CreateComputePipelineState();
+        CreateQuadPipelineState();
+        CreateColorizePipelineState();
+        CreateSubdividePipelineState();
+        CreateConePrepassPipelineState();
+        CreateReprojectPipelineState();
+        CreateAdaptiveAAPipelineState();
+        CreateSweepPipelineState();
+        CreateIterStatsPipelineState();
+        CreateVertexBuffer();
+        CreateIndexBuffer();
+        PrewarmPermutations();
+
+        m_pProfiler.reset(new FrameProfiler{ m_pDevice });
+
+        m_Zoom = 1.0;
+		m_Camera.SetPos({ 0.0f, 0.0f, -4.0f });
+        m_FractalParams1 = float4(100, 2, 0, 0);
+        m_FractalParams2 = float4(1, 1, 0, 0);
+        m_FractalColor = float4(1, 1, 1, 1);
+        m_BackgroundColor = float4(0, 0, 0, 1);
+        m_Options3D = float4(100, 10.0f, 0.001, 0);
+
+    }
+
+    void FractalViewer::Render()
+    {
+        auto* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
+        auto* pDSV = m_pSwapChain->GetDepthBufferDSV();
+        float4 ClearColor = { 0.350f, 0.350f, 0.350f, 1.0f };
+        if (m_ConvertPSOutputToGamma)
+        {
+            ClearColor = LinearToSRGB(ClearColor);
+        }
+        m_pImmediateContext->ClearRenderTarget(pRTV, ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pImmediateContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        static const char* RenderModeNames[] = { "pixel", "compute", "cpu" };
+        m_pProfiler->BeginFrame(RenderModeNames[static_cast<int>(m_RenderMode)]);
+
+        ShaderConstants CBufferData = {};
+
+		// Definición de variables de shader
+        {
+            float fracType = m_is3D
+                ? static_cast<float>(m_SelectedFractal3D)
+                : static_cast<float>(m_SelectedFractal2D);
+            CBufferData.TimeAndResolution = float4{
+                m_Time,
+                static_cast<float>(m_pSwapChain->GetDesc().Width),
+                static_cast<float>(m_pSwapChain->GetDesc().Height),
+                fracType
+            };
+
+            const auto& pos = m_Camera.GetPos();
+            const auto& right = m_Camera.GetWorldRight();
+            const auto& up = m_Camera.GetWorldUp();
+            const auto& forward = m_Camera.GetWorldAhead();
+            CBufferData.CameraPos = float4{ pos,  m_is3D ? 1.0f : 0.0f };
+            CBufferData.CameraDirX = float4{ right,   0.0f };
+            CBufferData.CameraDirY = float4{ up,      0.0f };
+            CBufferData.CameraDirZ = float4{ forward, 0.0f };
+
+            // Zoom y offset en double: la parte float y el resto (para double y double-float)
+            const DoubleFloat<float> Zoom    = DFFromDouble(m_Zoom);
+            const DoubleFloat<float> OffsetX = DFFromDouble(m_OffsetX);
+            const DoubleFloat<float> OffsetY = DFFromDouble(m_OffsetY);
+            CBufferData.ZoomOffset = float4{
+                Zoom.Hi,
+                OffsetX.Hi,
+                OffsetY.Hi,
+                m_is3D ? m_OffsetZ : 0.0f
+            };
+            // Los kernels float no leen la parte baja: a 0, para que el paneo (que compara las
+            // constantes enteras) no la vea cambiar
+            const bool UsesLowPart = !m_is3D && m_FractalParams1.z > 0.5f;
+            CBufferData.ZoomOffsetLo = UsesLowPart ? float4{ Zoom.Lo, OffsetX.Lo, OffsetY.Lo, 0.0f } : float4{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+            CBufferData.FractalColor = m_FractalColor;
+            CBufferData.BackgroundColor = m_BackgroundColor;
+
+            CBufferData.FractalC = m_FractalC;
+
+		    CBufferData.maxiter = m_maxiter;
+            CBufferData.FractalParams1 = m_FractalParams1;
+            CBufferData.FractalParams2 = m_FractalParams2;
+
+            CBufferData.Options3D = m_Options3D;
+		    CBufferData.AnimationParams = m_AnimationParams;
+		}
+
+        // Escala de render de este frame: el fractal ve el tamaño de las texturas del nivel
+        SetRenderScale(SelectRenderScale(CBufferData));
+        CBufferData.TimeAndResolution.y = static_cast<float>(m_pComputeOutputTex->GetDesc().Width);
+        CBufferData.TimeAndResolution.z = static_cast<float>(m_pComputeOutputTex->GetDesc().Height);
+        SnapPanOffset(CBufferData);
+
+        m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_UPLOAD);
+        {
+            MapHelper<ShaderConstants> CBDataHelper{ m_pImmediateContext, m_VSConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *CBDataHelper = CBufferData;
+        }
+        {
+            MapHelper<ShaderConstants> CBDataHelper{ m_pImmediateContext, m_VSConstantsComputeShader, MAP_WRITE, MAP_FLAG_DISCARD };
+            *CBDataHelper = CBufferData;
+        }
+
+        const float4 PaletteParams{ static_cast<float>(m_PaletteMode), m_PaletteCycles, m_PalettePhase, 0.0f };
+        {
+            MapHelper<float4> ColorizeHelper{ m_pImmediateContext, m_ColorizeConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *ColorizeHelper = PaletteParams;
+        }
+        // Lo que decide el color en 2D, para repetir el supersampling aunque no haya que redibujar
+        const float4 AAColorKey[_countof(m_AAColorKey)] = { PaletteParams, m_FractalColor, m_BackgroundColor, m_FractalParams2 };
+
+        // Deep zoom en GPU (pixel o compute shader): órbita de referencia + serie para este frame
+        PerturbationConstants PerturbData = {};
+        if (m_RenderMode != RenderMode::CPU && IsDeepZoomActive())
+            PerturbData = PreparePerturbationGPU(ToCPUShaderConstants(CBufferData));
+        {
+            MapHelper<PerturbationConstants> PerturbHelper{ m_pImmediateContext, m_PerturbationConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *PerturbHelper = PerturbData;
+        }
+
+        // 3D en compute: cámara del frame anterior si su historia sigue valiendo
+        m_TemporalData = PrepareTemporalGPU(CBufferData);
+        {
+            MapHelper<TemporalConstants> TemporalHelper{ m_pImmediateContext, m_TemporalConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *TemporalHelper = m_TemporalData;
+        }
+        // y el cache de distancias de las escenas estáticas, horneando los bricks de este frame
+        UpdateDistanceBricks(CBufferData);
+        m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_UPLOAD);
+
+        // PSO especializado para este frame (el ubershader hasta que esté compilado)
+        m_CurrentFractalPSO = GetPermutationPSO(GetCurrentPermutation(false, PerturbData.PerturbParams.x > 0.5f), false);
+
+        if (m_SubdivisionEnabled)
+            ReadSubdivisionStats();
+        if (m_AAEnabled)
+            ReadAdaptiveAAStats();
+        if (m_AutoIterEnabled)
+            ReadIterStats();
+
+        // Si nada de lo que ve el fractal ha cambiado se reutiliza el último resultado; si solo
+        // se ha desplazado, se reutiliza la parte que sigue visible
+        int2 PanShift;
+        const bool Changed = HasFrameChanged(CBufferData, PerturbData, PanShift);
+        bool Redraw = !m_ProgressiveEnabled || Changed;
+        bool Pan = Changed && (PanShift.x != 0 || PanShift.y != 0);
+
+        if (m_RenderMode == RenderMode::ComputeShader)
+        {
+            // Sin tamaño de grupo guardado para este adaptador se mide una vez automáticamente
+            const auto& TexDesc = m_pComputeOutputTex->GetDesc();
+            ComputeGroupTuner::GroupSize Size;
+            if (m_AutoTuneGroupSize && !m_GroupTuner.IsRunning() &&
+                !m_GroupTuner.Find(m_pDevice->GetAdapterInfo().Description, m_is3D, TexDesc.Width, TexDesc.Height, Size))
+                m_GroupTuner.Begin(m_pDevice->GetAdapterInfo().Description, m_is3D, TexDesc.Width, TexDesc.Height);
+
+            if (m_GroupTuner.IsRunning())
+            {
+                TuneComputeGroupSize();
+                Redraw = true;
+                Pan = false;
+            }
+        }
+
+        IBuffer* pVBs[] = { m_VertexBuffer };
+        Uint64 Offsets[] = { 0 };
+        m_pImmediateContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+        m_pImmediateContext->SetIndexBuffer(m_IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        if (m_RenderMode == RenderMode::PixelShader)
+        {
+            m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+            const Uint32 RefinePassBefore = m_RefinePass;
+            IShaderResourceBinding* pResultSRB = RenderProgressive(Redraw, Pan ? &PanShift : nullptr);
+            m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+
+            // Presupuesto de iteraciones: solo con una imagen completa nueva a resolución completa
+            const bool FullImage = pResultSRB == m_pProgressiveQuadSRB && m_RefinePass == RefineGridSize * RefineGridSize;
+            if (!m_is3D && m_AutoIterEnabled && FullImage && (Redraw || RefinePassBefore != m_RefinePass))
+                RenderIterStatsGPU(m_pProgressiveTex);
+
+            FrameProfiler::ScopedStage PresentStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_PRESENT };
+            m_pImmediateContext->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            m_pImmediateContext->SetViewports(1, nullptr, 0, 0);
+            // En 2D el resultado es el buffer de escape y aquí se colorea
+            DrawFullscreenQuad(m_is3D ? m_pQuadPSO : m_pColorizePSO, pResultSRB);
+        }
+        else if (m_RenderMode == RenderMode::ComputeShader && !Redraw)
+        {
+            FrameProfiler::ScopedStage PresentStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_PRESENT };
+            // En 2D el supersampling guarda la imagen ya coloreada: se repite si cambió el coloreado
+            if (!m_is3D && IsAdaptiveAAActive() &&
+                (!m_AAOutputValid || std::memcmp(AAColorKey, m_AAColorKey, sizeof(AAColorKey)) != 0))
+                RenderAdaptiveAAGPU(AAColorKey);
+            DrawOutputTexture();
+        }
+        else if (m_RenderMode == RenderMode::ComputeShader && !m_is3D && !Pan && m_SubdivisionEnabled && m_pSubdividePSO &&
+                 PerturbData.PerturbParams.x < 0.5f)
+        {
+            m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+            RenderSubdivisionGPU();
+            m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+
+            m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_TRANSITION);
+            StateTransitionDesc Barrier(m_pEscapeTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+            m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+            m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_TRANSITION);
+
+            if (m_AutoIterEnabled)
+                RenderIterStatsGPU(m_pEscapeTex);
+
+            FrameProfiler::ScopedStage PresentStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_PRESENT };
+            RenderAdaptiveAAGPU(AAColorKey);
+            DrawOutputTexture();
+        }
+        else if (m_RenderMode == RenderMode::ComputeShader) // ComputeShader
+        {
+            // ——— 1) Ejecutar compute shader ———
+            m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+            const FractalPSO ComputePSO = GetPermutationPSO(GetCurrentPermutation(true, PerturbData.PerturbParams.x > 0.5f), true);
+            const auto& TexDesc = m_pComputeOutputTex->GetDesc();
+
+            // Paneo: se desplaza el buffer de escape antes de enlazarlo como UAV
+            if (Pan)
+                ShiftTexture(m_pEscapeTex, PanShift);
+
+            // 3D: la prepasada de cono deja la distancia inicial de cada tile de 4x4
+            m_ConeStartTileSize = 0;
+            if (m_is3D && m_ConePrepassEnabled && m_pConePrepassPSO)
+            {
+                RenderConePrepassGPU();
+                m_ConeStartTileSize = ConeTileSizes[_countof(ConeTileSizes) - 1];
+            }
+            // y la reproyección del frame anterior, la profundidad desde la que empieza cada píxel
+            if (m_is3D && m_TemporalData.TemporalParams.x > 0.5f)
+                RenderReprojectGPU();
+
+            BindComputeTargets(ComputePSO.pSRB);
+            m_pImmediateContext->SetPipelineState(ComputePSO.pPSO);
+            m_pImmediateContext->CommitShaderResources(ComputePSO.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            if (Pan)
+            {
+                Rect Strips[2];
+                const Uint32 NumStrips = GetPanStrips(PanShift, TexDesc.Width, TexDesc.Height, Strips);
+                for (Uint32 i = 0; i < NumStrips; ++i)
+                    DispatchComputeRegion(ComputePSO, Strips[i]);
+            }
+            else
+            {
+                DispatchComputeRegion(ComputePSO, Rect{ 0, 0, static_cast<Int32>(TexDesc.Width), static_cast<Int32>(TexDesc.Height) });
+            }
+            m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_FRACTAL);
+
+            m_pProfiler->BeginStage(m_pImmediateContext, FrameProfiler::STAGE_TRANSITION);
+            StateTransitionDesc Barrier(
+                m_is3D ? m_pComputeOutputTex : m_pEscapeTex,
+                RESOURCE_STATE_UNORDERED_ACCESS,
+                RESOURCE_STATE_SHADER_RESOURCE,
+                STATE_TRANSITION_FLAG_UPDATE_STATE
+            );
+
+
+            m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+            m_pProfiler->EndStage(m_pImmediateContext, FrameProfiler::STAGE_TRANSITION);
+
+            if (!m_is3D && m_AutoIterEnabled)
+                RenderIterStatsGPU(m_pEscapeTex);
+
+            // ——— 2) Dibujar fullscreen-quad con la textura resultante ———
+            // (el supersampling lee la profundidad de este frame antes de pasarla a la historia;
+            // la historia guarda el color de la primera muestra)
+            FrameProfiler::ScopedStage PresentStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_PRESENT };
+            RenderAdaptiveAAGPU(AAColorKey);
+            if (m_is3D)
+                UpdateTemporalHistory(CBufferData);
+            DrawOutputTexture();
+        }
+        else if (m_RenderMode == RenderMode::CPU)
+        {
+            if (Redraw || m_TileCachePending)
+            {
+                FrameProfiler::ScopedStage FractalStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_FRACTAL };
+                RenderCPU(ToCPUShaderConstants(CBufferData), Pan ? &PanShift : nullptr);
+            }
+            FrameProfiler::ScopedStage PresentStage{ *m_pProfiler, m_pImmediateContext, FrameProfiler::STAGE_PRESENT };
+            DrawOutputTexture();
+        }
+
+        // La UI se dibuja después: el frame exportado no la incluye
+        if (m_Exporting)
+            CaptureExportFrame();
+
+        // Póster: una tile por frame en CPU, aparte de lo que se ve en pantalla
+        if (m_PosterRequested)
+            BeginPoster(ToCPUShaderConstants(CBufferData));
+        if (m_pPosterWriter)
+            RenderPosterTile();
+
+        // Barrido de parámetros a partir de la vista de este frame (con la resolución de la pantalla)
+        if (m_SweepRequested)
+            RenderSweep(ToCPUShaderConstants(CBufferData));
+
+        // Tiempo para la escala de render, de los frames que calculan el fractal con el nivel del
+        // controlador: con timestamps, el de la GPU del fractal al quad (llega unos frames tarde);
+        // sin ellos, el de la CPU del backend CPU o el de pared del frame
+        if (m_DynamicResEnabled && Redraw && m_RenderMode != RenderMode::PixelShader && m_RenderScaleLevel == m_DynamicRes.GetLevel())
+        {
+            double FrameMs = -1.0;
+            if (m_RenderMode == RenderMode::CPU)
+                FrameMs = m_pProfiler->GetLastCPUMs(FrameProfiler::STAGE_FRACTAL);
+            else if (!m_pProfiler->HasGPUTimings())
+                FrameMs = m_LastFrameMs;
+            else if (m_pProfiler->GetLastGPUMs(FrameProfiler::STAGE_FRACTAL) >= 0.0)
+            {
+                FrameMs = 0.0;
+                for (auto Stage : { FrameProfiler::STAGE_FRACTAL, FrameProfiler::STAGE_TRANSITION, FrameProfiler::STAGE_PRESENT })
+                    FrameMs += std::max(m_pProfiler->GetLastGPUMs(Stage), 0.0);
+            }
+            m_DynamicRes.ReportFrameTime(FrameMs);
+        }
+
+        m_pProfiler->EndFrame();
+    }
+
+    void FractalViewer::BeginExport()
+    {
+        const auto& SCDesc = m_pSwapChain->GetDesc();
+        switch (SCDesc.ColorBufferFormat)
+        {
+            case TEX_FORMAT_RGBA8_UNORM:
+            case TEX_FORMAT_RGBA8_UNORM_SRGB:
+                m_ExportSwapRB = false;
+                break;
+            case TEX_FORMAT_BGRA8_UNORM:
+            case TEX_FORMAT_BGRA8_UNORM_SRGB:
+                m_ExportSwapRB = true;
+                break;
+            default:
+                m_ExportStatus = "unsupported swap chain format";
+                return;
+        }
+
+        TextureDesc StagingDesc;
+        StagingDesc.Name = "Export Staging Texture";
+        StagingDesc.Type = RESOURCE_DIM_TEX_2D;
+        StagingDesc.Width = SCDesc.Width;
+        StagingDesc.Height = SCDesc.Height;
+        StagingDesc.Format = SCDesc.ColorBufferFormat;
+        StagingDesc.Usage = USAGE_STAGING;
+        StagingDesc.BindFlags = BIND_NONE;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        for (auto& pStaging : m_ExportStaging)
+        {
+            pStaging.Release();
+            m_pDevice->CreateTexture(StagingDesc, nullptr, &pStaging);
+        }
+
+        if (!m_pExportFence)
+        {
+            FenceDesc FenceCI;
+            FenceCI.Name = "Export Readback Fence";
+            m_pDevice->CreateFence(FenceCI, &m_pExportFence);
+        }
+
+        const FrameFormat Format = static_cast<FrameFormat>(m_ExportFormat);
+        const std::string Path = FrameWriter::GetOutputPath(m_ExportPath, Format);
+        m_pFrameWriter.reset(new FrameWriter{Path, Format, SCDesc.Width, SCDesc.Height, static_cast<Uint32>(m_ExportFPS)});
+
+        // Cada frame exportado tiene que ser el definitivo, no una vista previa
+        m_ExportSavedProgressive = m_ProgressiveEnabled;
+        m_ProgressiveEnabled = false;
+
+        m_ExportSubmitted = 0;
+        m_ExportRead = 0;
+        m_Exporting = true;
+        m_ExportStatus = "exporting to " + Path;
+    }
+
+    void FractalViewer::CaptureExportFrame()
+    {
+        ITexture* pBackBuffer = m_pSwapChain->GetCurrentBackBufferRTV()->GetTexture();
+        if (pBackBuffer->GetDesc().Width != m_ExportStaging[0]->GetDesc().Width || pBackBuffer->GetDesc().Height != m_ExportStaging[0]->GetDesc().Height)
+        {
+            EndExport();
+            m_ExportStatus = "export stopped: window resized";
+            return;
+        }
+
+        // Con el anillo lleno se espera a que la GPU termine con la textura más antigua
+        ReadExportFrames(m_ExportSubmitted >= ExportRingSize ? m_ExportSubmitted - ExportRingSize + 1 : 0);
+
+        CopyTextureAttribs CopyAttribs{ pBackBuffer, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                        m_ExportStaging[m_ExportSubmitted % ExportRingSize], RESOURCE_STATE_TRANSITION_MODE_TRANSITION };
+        m_pImmediateContext->CopyTexture(CopyAttribs);
+        // El valor de la fence es el número de frames copiados
+        m_pImmediateContext->EnqueueSignal(m_pExportFence, ++m_ExportSubmitted);
+
+        if (m_ExportSubmitted >= static_cast<Uint32>(m_ExportFrames))
+            EndExport();
+        else
+            ReadExportFrames(0);
+    }
+
+    void FractalViewer::ReadExportFrames(Uint32 MinFramesRead)
+    {
+        while (m_ExportRead < m_ExportSubmitted)
+        {
+            const Uint64 FenceValue = Uint64{m_ExportRead} + 1;
+            if (m_pExportFence->GetCompletedValue() < FenceValue)
+            {
+                if (m_ExportRead >= MinFramesRead)
+                    break;
+                m_pImmediateContext->Flush();
+                m_pExportFence->Wait(FenceValue);
+            }
+
+            ITexture*   pStaging = m_ExportStaging[m_ExportRead % ExportRingSize];
+            const auto& Desc = pStaging->GetDesc();
+            MappedTextureSubresource Mapped;
+            m_pImmediateContext->MapTextureSubresource(pStaging, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, Mapped);
+            if (Mapped.pData == nullptr)
+                break;
+
+            // Filas sin relleno y en RGBA, que es lo que espera FrameWriter
+            std::vector<Uint8> Frame(size_t{Desc.Width} * Desc.Height * 4);
+            for (Uint32 y = 0; y < Desc.Height; ++y)
+            {
+                const Uint8* pSrc = static_cast<const Uint8*>(Mapped.pData) + y * Mapped.Stride;
+                Uint8*       pDst = &Frame[size_t{y} * Desc.Width * 4];
+                std::memcpy(pDst, pSrc, size_t{Desc.Width} * 4);
+                if (m_ExportSwapRB)
+                {
+                    for (Uint32 x = 0; x < Desc.Width; ++x)
+                        std::swap(pDst[x * 4], pDst[x * 4 + 2]);
+                }
+            }
+            m_pImmediateContext->UnmapTextureSubresource(pStaging, 0, 0);
+
+            m_pFrameWriter->Push(std::move(Frame));
+            ++m_ExportRead;
+        }
+    }
+
+    void FractalViewer::EndExport()
+    {
+        ReadExportFrames(m_ExportSubmitted);
+        m_pFrameWriter->Finish();
+        m_ExportStatus = std::to_string(m_pFrameWriter->GetNumWritten()) + " frames written" + (m_pFrameWriter->HasError() ? " (write error)" : "");
+        m_pFrameWriter.reset();
+
+        m_ProgressiveEnabled = m_ExportSavedProgressive;
+        m_Exporting = false;
+    }
+
+    void FractalViewer::BeginPoster(const CPUShaderConstants& Constants)
+    {
+        m_PosterRequested = false;
+        if (IsDeepZoomActive())
+        {
+            m_PosterStatus = "posters are not available in deep zoom";
+            return;
+        }
+
+        // La vista actual con la resolución del póster: el aspecto y el campo de visión son los del póster
+        m_PosterConstants = Constants;
+        m_PosterConstants.TimeAndResolution.y = static_cast<float>(std::max(m_PosterSize[0], 1));
+        m_PosterConstants.TimeAndResolution.z = static_cast<float>(std::max(m_PosterSize[1], 1));
+
+        m_pPosterWriter.reset(new PosterWriter{ m_PosterPath, static_cast<Uint32>(std::max(m_PosterSize[0], 1)), static_cast<Uint32>(std::max(m_PosterSize[1], 1)),
+                                                static_cast<Uint32>(m_PosterTileSize), PosterWriter::HashBytes(&m_PosterConstants, sizeof(m_PosterConstants)) });
+        if (m_pPosterWriter->HasError())
+        {
+            m_PosterStatus = std::string{ "could not create " } + m_PosterPath;
+            m_pPosterWriter.reset();
+            return;
+        }
+        m_PosterNextTile = 0;
+        m_PosterStatus = m_pPosterWriter->IsResumed() ? "resumed at tile " + std::to_string(m_pPosterWriter->GetNumDone()) : "";
+
+        if (!m_pCPURenderer)
+            m_pCPURenderer.reset(new CPUFractalRenderer{});
+    }
+
+    void FractalViewer::RenderPosterTile()
+    {
+        PosterWriter& Writer = *m_pPosterWriter;
+        while (m_PosterNextTile < Writer.GetNumTiles() && Writer.IsTileDone(m_PosterNextTile))
+            ++m_PosterNextTile;
+
+        if (m_PosterNextTile < Writer.GetNumTiles())
+        {
+            const Uint32 Width    = static_cast<Uint32>(m_PosterConstants.TimeAndResolution.y);
+            const Uint32 Height   = static_cast<Uint32>(m_PosterConstants.TimeAndResolution.z);
+            const Uint32 TileSize = Writer.GetTileSize();
+            const Uint32 X0       = (m_PosterNextTile % Writer.GetTilesX()) * TileSize;
+            const Uint32 Y0       = (m_PosterNextTile / Writer.GetTilesX()) * TileSize;
+
+            CPUImage Tile;
+            m_pCPURenderer->RenderRegion(m_PosterConstants, X0, Y0, std::min(TileSize, Width - X0), std::min(TileSize, Height - Y0), Tile);
+            if (Writer.WriteTile(m_PosterNextTile, Tile.Pixels.data(), Tile.Width, Tile.Height))
+                return;
+        }
+
+        // Terminado o con error de escritura
+        const bool Ok = Writer.Finish();
+        m_PosterStatus = std::to_string(Writer.GetNumDone()) + " / " + std::to_string(Writer.GetNumTiles()) + " tiles written" + (Ok ? "" : " (write error)");
+        m_pPosterWriter.reset();
+    }
+
+    void FractalViewer::RenderSweep(const CPUShaderConstants& Base)
+    {
+        m_SweepRequested = false;
+        MakeParameterSweep(Base, m_SweepSettings, m_SweepSlices);
+
+        const Uint32 Count   = static_cast<Uint32>(m_SweepSlices.size());
+        const Uint32 AtlasW  = m_SweepSettings.Columns * m_SweepSettings.ThumbWidth;
+        const Uint32 AtlasH  = m_SweepSettings.Rows * m_SweepSettings.ThumbHeight;
+        if (!m_pSweepAtlasTex || m_pSweepAtlasTex->GetDesc().Width != AtlasW || m_pSweepAtlasTex->GetDesc().Height != AtlasH)
+        {
+            TextureDesc AtlasDesc;
+            AtlasDesc.Name = "Parameter Sweep Atlas";
+            AtlasDesc.Type = RESOURCE_DIM_TEX_2D;
+            AtlasDesc.Width = AtlasW;
+            AtlasDesc.Height = AtlasH;
+            AtlasDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+            AtlasDesc.Usage = USAGE_DEFAULT;
+            AtlasDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+            m_pSweepAtlasTex.Release();
+            m_pDevice->CreateTexture(AtlasDesc, nullptr, &m_pSweepAtlasTex);
+        }
+
+        char Status[128];
+        if (m_RenderMode == RenderMode::CPU)
+        {
+            if (!m_pCPURenderer)
+                m_pCPURenderer.reset(new CPUFractalRenderer{});
+
+            CPUImage Atlas;
+            m_pCPURenderer->RenderSweep(m_SweepSlices, m_SweepSettings.Columns, Atlas);
+
+            TextureSubResData SubresData;
+            SubresData.pData  = Atlas.Pixels.data();
+            SubresData.Stride = Atlas.GetStride();
+            Box UpdateBox{0, AtlasW, 0, AtlasH};
+            m_pImmediateContext->UpdateTexture(m_pSweepAtlasTex, 0, 0, UpdateBox, SubresData,
+                                               RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            const auto& Stats = m_pCPURenderer->GetLastStats();
+            std::snprintf(Status, sizeof(Status), "%u thumbnails, %.1f ms on the CPU (%.1f Mpix/s)", Count, Stats.Seconds * 1e3, Stats.GetMPixelsPerSecond());
+            m_SweepStatus = Status;
+            return;
+        }
+
+        if (!m_pSweepPSO)
+        {
+            m_SweepStatus = "fractalSweep.psh did not compile";
+            return;
+        }
+
+        // Constantes de todas las miniaturas en un buffer estructurado (crece, no se encoge)
+        if (Count > m_SweepCapacity)
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name = "Parameter Sweep Constants";
+            BuffDesc.Usage = USAGE_DEFAULT;
+            BuffDesc.BindFlags = BIND_SHADER_RESOURCE;
+            BuffDesc.Mode = BUFFER_MODE_STRUCTURED;
+            BuffDesc.ElementByteStride = sizeof(CPUShaderConstants);
+            BuffDesc.Size = Uint64{Count} * sizeof(CPUShaderConstants);
+            m_SweepConstants.Release();
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_SweepConstants);
+            m_SweepCapacity = Count;
+        }
+        m_pImmediateContext->UpdateBuffer(m_SweepConstants, 0, Count * sizeof(CPUShaderConstants), m_SweepSlices.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         {
-            MapHelper<ShaderConstants> CBDataHelper{ m_pImmediateContext, m_VSConstants, MAP_WRITE, MAP_FLAG_DISCARD };
-            *CBDataHelper = CBufferData;
+            MapHelper<uint4> DispatchHelper{ m_pImmediateContext, m_SweepDispatchConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *DispatchHelper = uint4{ m_SweepSettings.Columns, Count, m_SweepSettings.ThumbWidth, m_SweepSettings.ThumbHeight };
         }
+
+        const auto StartTime = std::chrono::steady_clock::now();
+        m_pSweepSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "SweepConstants")->Set(m_SweepConstants->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        m_pSweepSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "SweepAtlasTex")->Set(m_pSweepAtlasTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        m_pImmediateContext->SetPipelineState(m_pSweepPSO);
+        m_pImmediateContext->CommitShaderResources(m_pSweepSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // Un solo dispatch: z recorre las miniaturas
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (m_SweepSettings.ThumbWidth + 7) / 8;
+        DispatchAttrs.ThreadGroupCountY = (m_SweepSettings.ThumbHeight + 7) / 8;
+        DispatchAttrs.ThreadGroupCountZ = Count;
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+
+        StateTransitionDesc Barrier(m_pSweepAtlasTex, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+
+        // Es una acción puntual: se espera a la GPU para dar el tiempo
+        m_pImmediateContext->EnqueueSignal(m_pSweepFence, ++m_SweepFenceValue);
+        m_pImmediateContext->Flush();
+        m_pSweepFence->Wait(m_SweepFenceValue);
+        const double Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+        std::snprintf(Status, sizeof(Status), "%u thumbnails in one dispatch, %.1f ms until the fence", Count, Ms);
+        m_SweepStatus = Status;
+    }
+
+    FractalViewer::ShaderConstants FractalViewer::GetFrameKey(const ShaderConstants& Constants) const
+    {
+        // El tiempo solo afecta al 2D si c está animada
+        ShaderConstants Key = Constants;
+        if (!m_is3D && m_AnimationParams.z == 0.0f && m_AnimationParams.w == 0.0f)
+            Key.TimeAndResolution.x = 0.0f;
+        // En 2D los colores y la gamma solo afectan a la pasada de coloreado (FractalParams2.y,
+        // la salida anticipada del interior, sí cambia el escape)
+        if (!m_is3D)
         {
-            MapHelper<ShaderConstants> CBDataHelper{ m_pImmediateContext, m_VSConstantsComputeShader, MAP_WRITE, MAP_FLAG_DISCARD };
-            *CBDataHelper = CBufferData;
+            Key.FractalColor = float4{};
+            Key.BackgroundColor = float4{};
+            Key.FractalParams2.x = 0.0f;
         }
+        return Key;
+    }
 
-        IBuffer* pVBs[] = { m_VertexBuffer };
-        Uint64 Offsets[] = { 0 };
-        m_pImmediateContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-        m_pImmediateContext->SetIndexBuffer(m_IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    bool FractalViewer::HasFrameChanged(const ShaderConstants& Constants, const PerturbationConstants& PerturbData, int2& PanShift)
+    {
+        const ShaderConstants Key = GetFrameKey(Constants);
+        const bool DeepZoom = IsDeepZoomActive();
+        const bool Changed = !m_HasLastFrame || m_LastFrameMode != m_RenderMode ||
+            std::memcmp(&Key, &m_LastFrameKey, sizeof(Key)) != 0 ||
+            std::memcmp(&PerturbData, &m_LastPerturbData, sizeof(PerturbData)) != 0 ||
+            m_LastFrameDeepZoom != DeepZoom ||
+            (DeepZoom && (m_LastDeepZoom != m_DeepZoom || m_LastDeepCenterX != m_DeepCenterX || m_LastDeepCenterY != m_DeepCenterY));
+
+        // ¿Solo ha cambiado el offset 2D? (SnapPanOffset lo deja en píxeles enteros)
+        PanShift = int2{ 0, 0 };
+        if (Changed && m_HasLastFrame && m_PanReuseEnabled && !m_is3D && !DeepZoom && !m_LastFrameDeepZoom && m_LastFrameMode == m_RenderMode &&
+            Key.FractalParams1.z < 0.5f)
+        {
+            ShaderConstants PanKey = Key;
+            PanKey.ZoomOffset.y = m_LastFrameKey.ZoomOffset.y;
+            PanKey.ZoomOffset.z = m_LastFrameKey.ZoomOffset.z;
+            if (std::memcmp(&PanKey, &m_LastFrameKey, sizeof(PanKey)) == 0)
+            {
+                const float PixelsPerUnit = Key.ZoomOffset.x * Key.TimeAndResolution.z * 0.5f;
+                const int2  Shift{
+                    static_cast<int>(std::lround((Key.ZoomOffset.y - m_LastFrameKey.ZoomOffset.y) * PixelsPerUnit)),
+                    static_cast<int>(std::lround((Key.ZoomOffset.z - m_LastFrameKey.ZoomOffset.z) * PixelsPerUnit))
+                };
+                if (std::abs(Shift.x) < static_cast<int>(Key.TimeAndResolution.y) && std::abs(Shift.y) < static_cast<int>(Key.TimeAndResolution.z))
+                    PanShift = Shift;
+            }
+        }
 
-        if (m_RenderMode == RenderMode::PixelShader)
+        m_HasLastFrame = true;
+        m_LastFrameMode = m_RenderMode;
+        m_LastFrameKey = Key;
+        m_LastPerturbData = PerturbData;
+        m_LastFrameDeepZoom = DeepZoom;
+        if (DeepZoom)
         {
-            m_pImmediateContext->SetPipelineState(m_pPSO);
-            m_pImmediateContext->CommitShaderResources(m_pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-            DrawIndexedAttribs attrs;
-            attrs.IndexType = VT_UINT32;
-            attrs.NumIndices = 6;
-            attrs.Flags = DRAW_FLAG_VERIFY_ALL;
-            m_pImmediateContext->DrawIndexed(attrs);
+            m_LastDeepZoom = m_DeepZoom;
+            m_LastDeepCenterX = m_DeepCenterX;
+            m_LastDeepCenterY = m_DeepCenterY;
         }
-        else if (m_RenderMode == RenderMode::ComputeShader) // ComputeShader
+        return Changed;
+    }
+
+    void FractalViewer::SnapPanOffset(ShaderConstants& Constants) const
+    {
+        // Solo en float: en double y double-float el offset lleva una parte baja
+        // (ZoomOffsetLo) que el redondeo en float de aquí perdería
+        if (!m_PanReuseEnabled || m_is3D || IsDeepZoomActive() || !m_HasLastFrame || m_LastFrameKey.ZoomOffset.x != Constants.ZoomOffset.x ||
+            m_LastFrameKey.TimeAndResolution.z != Constants.TimeAndResolution.z || Constants.FractalParams1.z > 0.5f)
+            return;
+
+        // Un píxel mide 2 / (alto * zoom) en los dos ejes (uv.x ya lleva el aspecto). El
+        // offset pedido se redondea al múltiplo de píxel más cercano respecto al último frame,
+        // así la imagen anterior se puede desplazar sin remuestrear; m_OffsetX/Y no se tocan.
+        const float PixelSize = 2.0f / (Constants.TimeAndResolution.z * Constants.ZoomOffset.x);
+        const float LastX = m_LastFrameKey.ZoomOffset.y;
+        const float LastY = m_LastFrameKey.ZoomOffset.z;
+        Constants.ZoomOffset.y = LastX + std::round((Constants.ZoomOffset.y - LastX) / PixelSize) * PixelSize;
+        Constants.ZoomOffset.z = LastY + std::round((Constants.ZoomOffset.z - LastY) / PixelSize) * PixelSize;
+    }
+
+    Uint32 FractalViewer::GetPanStrips(const int2& Shift, Uint32 Width, Uint32 Height, Rect Strips[2])
+    {
+        // El píxel p del frame nuevo es el p + Shift del anterior: quedan al descubierto
+        // |Shift.x| columnas y |Shift.y| filas (sin repetir la esquina)
+        const Int32 W = static_cast<Int32>(Width);
+        const Int32 H = static_cast<Int32>(Height);
+        Uint32 NumStrips = 0;
+        if (Shift.x != 0)
+            Strips[NumStrips++] = Shift.x > 0 ? Rect{ W - Shift.x, 0, W, H } : Rect{ 0, 0, -Shift.x, H };
+
+        const Int32 X0 = Shift.x < 0 ? -Shift.x : 0;
+        const Int32 X1 = Shift.x > 0 ? W - Shift.x : W;
+        if (Shift.y != 0)
+            Strips[NumStrips++] = Shift.y > 0 ? Rect{ X0, H - Shift.y, X1, H } : Rect{ X0, 0, X1, -Shift.y };
+        return NumStrips;
+    }
+
+    void FractalViewer::ShiftTexture(ITexture* pTexture, const int2& Shift)
+    {
+        const auto& Desc = pTexture->GetDesc();
+        if (!m_pPanScratchTex || m_pPanScratchTex->GetDesc().Width != Desc.Width || m_pPanScratchTex->GetDesc().Height != Desc.Height ||
+            m_pPanScratchTex->GetDesc().Format != Desc.Format)
         {
-            // ——— 1) Ejecutar compute shader ———
-            m_pImmediateContext->SetPipelineState(m_pComputePSO);
-            m_pImmediateContext->CommitShaderResources(m_pComputeSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            TextureDesc ScratchDesc;
+            ScratchDesc.Name = "Pan Scratch Texture";
+            ScratchDesc.Type = RESOURCE_DIM_TEX_2D;
+            ScratchDesc.Width = Desc.Width;
+            ScratchDesc.Height = Desc.Height;
+            ScratchDesc.Format = Desc.Format;
+            ScratchDesc.Usage = USAGE_DEFAULT;
+            ScratchDesc.BindFlags = BIND_SHADER_RESOURCE;
+            m_pPanScratchTex.Release();
+            m_pDevice->CreateTexture(ScratchDesc, nullptr, &m_pPanScratchTex);
+        }
 
-            // Dispatch: agrupa tus hilos (aquí 16×16)
-            const auto& SCDesc = m_pSwapChain->GetDesc();
-            Uint32 wgX = (SCDesc.Width + 15) / 16;
-            Uint32 wgY = (SCDesc.Height + 15) / 16;
+        // Una textura no se puede copiar sobre sí misma con solape: ida a la auxiliar ya
+        // desplazada y vuelta a la original
+        Box SrcBox;
+        SrcBox.MinX = static_cast<Uint32>(std::max(Shift.x, 0));
+        SrcBox.MaxX = Desc.Width - static_cast<Uint32>(std::max(-Shift.x, 0));
+        SrcBox.MinY = static_cast<Uint32>(std::max(Shift.y, 0));
+        SrcBox.MaxY = Desc.Height - static_cast<Uint32>(std::max(-Shift.y, 0));
+
+        CopyTextureAttribs CopyAttribs{ pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, m_pPanScratchTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION };
+        CopyAttribs.pSrcBox = &SrcBox;
+        CopyAttribs.DstX = SrcBox.MinX - Shift.x;
+        CopyAttribs.DstY = SrcBox.MinY - Shift.y;
+        m_pImmediateContext->CopyTexture(CopyAttribs);
+
+        Box DstBox{ CopyAttribs.DstX, CopyAttribs.DstX + (SrcBox.MaxX - SrcBox.MinX), CopyAttribs.DstY, CopyAttribs.DstY + (SrcBox.MaxY - SrcBox.MinY) };
+        CopyTextureAttribs BackAttribs{ m_pPanScratchTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION };
+        BackAttribs.pSrcBox = &DstBox;
+        BackAttribs.DstX = DstBox.MinX;
+        BackAttribs.DstY = DstBox.MinY;
+        m_pImmediateContext->CopyTexture(BackAttribs);
+
+        m_LastPanReuse = static_cast<float>((SrcBox.MaxX - SrcBox.MinX) * (SrcBox.MaxY - SrcBox.MinY)) / static_cast<float>(Desc.Width * Desc.Height);
+    }
 
-            DispatchComputeAttribs DispatchAttrs;
-            DispatchAttrs.ThreadGroupCountX = wgX;
-            DispatchAttrs.ThreadGroupCountY = wgY;
-            DispatchAttrs.ThreadGroupCountZ = 1;
+    bool FractalViewer::CreateProgressiveTargets()
+    {
+        const auto& SCDesc = m_pSwapChain->GetDesc();
+        const Uint32 PreviewWidth = std::max((SCDesc.Width + m_InteractionScale - 1) / m_InteractionScale, 1u);
+        const Uint32 PreviewHeight = std::max((SCDesc.Height + m_InteractionScale - 1) / m_InteractionScale, 1u);
+        // 3D: mismo formato que el swap chain. 2D: buffer de escape para colorear después
+        const TEXTURE_FORMAT Format = m_is3D ? SCDesc.ColorBufferFormat : TEX_FORMAT_RG32_FLOAT;
+        if (m_pProgressiveTex && m_pProgressiveTex->GetDesc().Width == SCDesc.Width && m_pProgressiveTex->GetDesc().Height == SCDesc.Height &&
+            m_pPreviewTex->GetDesc().Width == PreviewWidth && m_pPreviewTex->GetDesc().Height == PreviewHeight &&
+            m_pProgressiveTex->GetDesc().Format == Format)
+            return false;
+
+        TextureDesc TexDesc;
+        TexDesc.Name = "Progressive Output Texture";
+        TexDesc.Type = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width = SCDesc.Width;
+        TexDesc.Height = SCDesc.Height;
+        TexDesc.Format = Format;
+        TexDesc.Usage = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+        m_pProgressiveTex.Release();
+        m_pDevice->CreateTexture(TexDesc, nullptr, &m_pProgressiveTex);
+
+        TexDesc.Name = "Progressive Preview Texture";
+        TexDesc.Width = PreviewWidth;
+        TexDesc.Height = PreviewHeight;
+        m_pPreviewTex.Release();
+        m_pDevice->CreateTexture(TexDesc, nullptr, &m_pPreviewTex);
+
+        IPipelineState* pQuadPSO = m_is3D ? m_pQuadPSO : m_pColorizePSO;
+        const char*     TexName = m_is3D ? "InputTex" : "EscapeTex";
+
+        m_pProgressiveQuadSRB.Release();
+        pQuadPSO->CreateShaderResourceBinding(&m_pProgressiveQuadSRB, true);
+        m_pProgressiveQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, TexName)->Set(m_pProgressiveTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+        m_pPreviewQuadSRB.Release();
+        pQuadPSO->CreateShaderResourceBinding(&m_pPreviewQuadSRB, true);
+        m_pPreviewQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, TexName)->Set(m_pPreviewTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+        // m_pUpscalePSO comparte layout con el quad; la copia del buffer de escape no
+        m_pPreviewUpscaleSRB.Release();
+        if (m_is3D)
+        {
+            m_pPreviewUpscaleSRB = m_pPreviewQuadSRB;
+        }
+        else
+        {
+            m_pEscapeUpscalePSO->CreateShaderResourceBinding(&m_pPreviewUpscaleSRB, true);
+            m_pPreviewUpscaleSRB->GetVariableByName(SHADER_TYPE_PIXEL, "EscapeTex")->Set(m_pPreviewTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+
+        return true;
+    }
+
+    void FractalViewer::RenderFractalPass(ITexture* pTarget, const float4& RefineParams, const Rect* pScissor)
+    {
+        {
+            MapHelper<float4> RefineHelper{ m_pImmediateContext, m_RefineConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+            *RefineHelper = RefineParams;
+        }
+
+        ITextureView* pRTV = pTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        m_pImmediateContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pImmediateContext->SetViewports(1, nullptr, 0, 0);
+        const auto& TexDesc = pTarget->GetDesc();
+        const Rect FullRect{ 0, 0, static_cast<Int32>(TexDesc.Width), static_cast<Int32>(TexDesc.Height) };
+        m_pImmediateContext->SetScissorRects(1, pScissor ? pScissor : &FullRect, 0, 0);
+
+        // Solo las permutaciones con el camino de perturbación declaran la órbita
+        if (auto* pVar = m_CurrentFractalPSO.pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "ReferenceOrbit"))
+            pVar->Set(m_ReferenceOrbitBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+
+        m_pImmediateContext->SetPipelineState(m_CurrentFractalPSO.pPSO);
+        m_pImmediateContext->CommitShaderResources(m_CurrentFractalPSO.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        DrawIndexedAttribs attrs;
+        attrs.IndexType = VT_UINT32;
+        attrs.NumIndices = 6;
+        attrs.Flags = DRAW_FLAG_VERIFY_ALL;
+        m_pImmediateContext->DrawIndexed(attrs);
+    }
+
+    IShaderResourceBinding* FractalViewer::RenderProgressive(bool Redraw, const int2* pPanShift)
+    {
+        // Orden de las celdas de la rejilla entrelazada (matriz de Bayer 4x4), para que
+        // las primeras pasadas ya queden repartidas por toda la imagen
+        static const int RefineCells[RefineGridSize * RefineGridSize][2] =
+        {
+            {0, 0}, {2, 2}, {2, 0}, {0, 2}, {1, 1}, {3, 3}, {3, 1}, {1, 3},
+            {1, 0}, {3, 2}, {3, 0}, {1, 2}, {0, 1}, {2, 3}, {2, 1}, {0, 3}
+        };
+        const Uint32 NumRefinePasses = RefineGridSize * RefineGridSize;
+
+        // Con texturas nuevas no hay nada que refinar
+        if (CreateProgressiveTargets())
+        {
+            Redraw = true;
+            pPanShift = nullptr;
+        }
+
+        if (Redraw && pPanShift != nullptr && m_RefinePass == NumRefinePasses)
+        {
+            // Solo se ha desplazado la vista y la imagen anterior estaba completa: se mueve y
+            // se calculan a resolución completa solo las franjas nuevas
+            ShiftTexture(m_pProgressiveTex, *pPanShift);
+            const auto& TexDesc = m_pProgressiveTex->GetDesc();
+            Rect Strips[2];
+            const Uint32 NumStrips = GetPanStrips(*pPanShift, TexDesc.Width, TexDesc.Height, Strips);
+            for (Uint32 i = 0; i < NumStrips; ++i)
+                RenderFractalPass(m_pProgressiveTex, float4{ 0, 0, 0, 0 }, &Strips[i]);
+        }
+        else if (Redraw && (!m_ProgressiveEnabled || m_InteractionScale <= 1))
+        {
+            // Imagen completa en un solo frame
+            RenderFractalPass(m_pProgressiveTex, float4{ 0, 0, 0, 0 });
+            m_RefinePass = NumRefinePasses;
+        }
+        else if (Redraw)
+        {
+            // Mientras cambian los parámetros: resolución reducida y se reinicia el refinamiento
+            RenderFractalPass(m_pPreviewTex, float4{ 0, 0, 0, 0 });
+            m_RefinePass = 0;
+            return m_pPreviewQuadSRB;
+        }
+        else if (m_RefinePass < NumRefinePasses)
+        {
+            if (m_RefinePass == 0)
+            {
+                // La vista previa escalada rellena los píxeles que aún no se han refinado
+                ITextureView* pRTV = m_pProgressiveTex->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+                m_pImmediateContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                m_pImmediateContext->SetViewports(1, nullptr, 0, 0);
+                DrawFullscreenQuad(m_is3D ? m_pUpscalePSO : m_pEscapeUpscalePSO, m_pPreviewUpscaleSRB);
+            }
+            const auto& Cell = RefineCells[m_RefinePass];
+            RenderFractalPass(m_pProgressiveTex, float4{ static_cast<float>(RefineGridSize), static_cast<float>(Cell[0]), static_cast<float>(Cell[1]), 0 });
+            ++m_RefinePass;
+        }
+
+        return m_pProgressiveQuadSRB;
+    }
+
+    ComputeGroupTuner::GroupSize FractalViewer::GetComputeGroupSize(bool Is3D) const
+    {
+        // Sin medición guardada se usa 16x16, el valor por defecto de fractalCompute.psh
+        ComputeGroupTuner::GroupSize Size;
+        const auto& TexDesc = m_pComputeOutputTex->GetDesc();
+        m_GroupTuner.Find(m_pDevice->GetAdapterInfo().Description, Is3D, TexDesc.Width, TexDesc.Height, Size);
+        return Size;
+    }
+
+    void FractalViewer::TuneComputeGroupSize()
+    {
+        // Se compila el candidato en el acto (o sale de la caché en disco), se calienta con un
+        // dispatch y se cronometran TuningDispatches seguidos esperando a la GPU
+        FractalPermutation Permutation = GetCurrentPermutation(true, false);
+        Permutation.GroupSize = m_GroupTuner.GetCurrentCandidate();
+
+        FractalPSO PSO;
+        CreateComputePSO(Permutation, PSO);
+        if (!PSO.pPSO)
+        {
+            m_GroupTuner.ReportTime(std::numeric_limits<double>::infinity());
+            return;
+        }
+
+        BindComputeTargets(PSO.pSRB);
+        m_pImmediateContext->SetPipelineState(PSO.pPSO);
+        m_pImmediateContext->CommitShaderResources(PSO.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const auto& TexDesc = m_pComputeOutputTex->GetDesc();
+        SetDispatchRegion(Rect{ 0, 0, static_cast<Int32>(TexDesc.Width), static_cast<Int32>(TexDesc.Height) });
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (TexDesc.Width + PSO.GroupSize.X - 1) / PSO.GroupSize.X;
+        DispatchAttrs.ThreadGroupCountY = (TexDesc.Height + PSO.GroupSize.Y - 1) / PSO.GroupSize.Y;
+
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+        m_pImmediateContext->WaitForIdle();
 
+        const auto Start = std::chrono::high_resolution_clock::now();
+        for (Uint32 i = 0; i < TuningDispatches; ++i)
             m_pImmediateContext->DispatchCompute(DispatchAttrs);
+        m_pImmediateContext->WaitForIdle();
+        const std::chrono::duration<double> Elapsed = std::chrono::high_resolution_clock::now() - Start;
 
-            StateTransitionDesc Barrier(
-                m_pComputeOutputTex,
-                RESOURCE_STATE_UNORDERED_ACCESS,
-                RESOURCE_STATE_SHADER_RESOURCE,
-                STATE_TRANSITION_FLAG_UPDATE_STATE
-            );
+        m_GroupTuner.ReportTime(Elapsed.count() / TuningDispatches);
+    }
+
+    void FractalViewer::SetDispatchRegion(const Rect& Region)
+    {
+        MapHelper<uint4> RegionHelper{ m_pImmediateContext, m_DispatchConstants, MAP_WRITE, MAP_FLAG_DISCARD };
+        RegionHelper[0] = uint4{ static_cast<Uint32>(Region.left), static_cast<Uint32>(Region.top),
+                                 static_cast<Uint32>(Region.right - Region.left), static_cast<Uint32>(Region.bottom - Region.top) };
+        RegionHelper[1] = uint4{ m_ConeStartTileSize, 0u, 0u, 0u };
+    }
 
+    void FractalViewer::DispatchComputeRegion(const FractalPSO& PSO, const Rect& Region)
+    {
+        SetDispatchRegion(Region);
+
+        // Tantos grupos como pida el tamaño con el que se compiló el PSO en uso (el
+        // ubershader mientras se compila la permutación)
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (static_cast<Uint32>(Region.right - Region.left) + PSO.GroupSize.X - 1) / PSO.GroupSize.X;
+        DispatchAttrs.ThreadGroupCountY = (static_cast<Uint32>(Region.bottom - Region.top) + PSO.GroupSize.Y - 1) / PSO.GroupSize.Y;
+        DispatchAttrs.ThreadGroupCountZ = 1;
+        m_pImmediateContext->DispatchCompute(DispatchAttrs);
+    }
 
-            m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+    void FractalViewer::RenderCPU(const CPUShaderConstants& Constants, const int2* pPanShift)
+    {
+        if (!m_pCPURenderer)
+            m_pCPURenderer.reset(new CPUFractalRenderer{});
 
-            // ——— 2) Dibujar fullscreen-quad con la textura resultante ———
-            m_pImmediateContext->SetPipelineState(m_pQuadPSO);
-            // Quad SRB debería tener el SRV de la textura:
-            m_pQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, "InputTex")
-                ->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
-            m_pImmediateContext->CommitShaderResources(m_pQuadSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        // El backend CPU solo calcula el bucle de escape; se sube al mismo buffer que usa el
+        // compute shader y se colorea en la GPU
+        const auto& TexDesc = m_pEscapeTex->GetDesc();
+        CPUShaderConstants CPUConstants = Constants;
+        CPUConstants.TimeAndResolution.y = static_cast<float>(TexDesc.Width);
+        CPUConstants.TimeAndResolution.z = static_cast<float>(TexDesc.Height);
+
+        if (m_TileCacheEnabled && !m_pTileCache)
+        {
+            CPUTileCacheSettings Settings;
+            Settings.DiskPath = "FractalTiles.cache";
+            m_pTileCache.reset(new CPUTileCache{m_pCPURenderer->GetThreadPool(), Settings});
+        }
+
+        m_TileCachePending = false;
+        if (IsDeepZoomActive())
+        {
+            if (!m_pPerturbation)
+                m_pPerturbation.reset(new CPUPerturbationRenderer{m_pCPURenderer->GetThreadPool()});
+            m_pPerturbation->RenderEscape(GetDeepZoomView(), CPUConstants, m_CPUEscape);
+        }
+        else if (m_TileCacheEnabled && m_pTileCache->CanCache(CPUConstants))
+        {
+            // La vista se monta con tiles (también al panear: las que siguen visibles ya están
+            // en memoria); las que se muestran con un sustituto se completan en los frames siguientes
+            m_TileCachePending = !m_pTileCache->RenderEscape(CPUConstants, m_CPUEscape);
+        }
+        else if (pPanShift != nullptr && m_CPUEscape.size() == static_cast<size_t>(TexDesc.Width) * TexDesc.Height)
+        {
+            // Paneo: se desplazan las filas en su sitio (en el orden que no pisa lo que falta
+            // por leer) y solo se calculan las franjas nuevas
+            const int W = static_cast<int>(TexDesc.Width);
+            const int H = static_cast<int>(TexDesc.Height);
+            const int2 Shift = *pPanShift;
+            const int X0 = std::max(0, -Shift.x);
+            const int X1 = std::min(W, W - Shift.x);
+            auto ShiftRow = [&](int y) {
+                const int SrcY = y + Shift.y;
+                if (SrcY >= 0 && SrcY < H)
+                    std::memmove(&m_CPUEscape[static_cast<size_t>(y) * W + X0], &m_CPUEscape[static_cast<size_t>(SrcY) * W + X0 + Shift.x],
+                                 static_cast<size_t>(X1 - X0) * sizeof(CPUEscapeSample));
+            };
+            if (Shift.y >= 0)
+            {
+                for (int y = 0; y < H; ++y)
+                    ShiftRow(y);
+            }
+            else
+            {
+                for (int y = H - 1; y >= 0; --y)
+                    ShiftRow(y);
+            }
+            m_LastPanReuse = static_cast<float>((X1 - X0) * (H - std::abs(Shift.y))) / static_cast<float>(W * H);
+
+            Rect Strips[2];
+            const Uint32 NumStrips = GetPanStrips(Shift, TexDesc.Width, TexDesc.Height, Strips);
+            for (Uint32 i = 0; i < NumStrips; ++i)
+            {
+                m_pCPURenderer->RenderEscapeRegion2D(CPUConstants, m_CPUEscape, static_cast<Uint32>(Strips[i].left), static_cast<Uint32>(Strips[i].top),
+                                                     static_cast<Uint32>(Strips[i].right), static_cast<Uint32>(Strips[i].bottom));
+            }
+        }
+        else if (m_SubdivisionEnabled)
+        {
+            m_pCPURenderer->RenderEscapeSubdivided2D(CPUConstants, m_CPUEscape);
+            m_SubdivSkipped = m_pCPURenderer->GetLastStats().Skipped;
+            m_SubdivEvaluated = m_pCPURenderer->GetLastStats().Pixels - m_SubdivSkipped;
+        }
+        else
+        {
+            m_pCPURenderer->RenderEscape2D(CPUConstants, m_CPUEscape);
+        }
+
+        // CPUEscapeSample es {i, |z|} en float, el mismo layout que RG32F
+        TextureSubResData SubresData;
+        SubresData.pData  = m_CPUEscape.data();
+        SubresData.Stride = TexDesc.Width * sizeof(CPUEscapeSample);
+        Box UpdateBox{0, TexDesc.Width, 0, TexDesc.Height};
+        m_pImmediateContext->UpdateTexture(m_pEscapeTex, 0, 0, UpdateBox, SubresData,
+                                           RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // Presupuesto de iteraciones: aquí las estadísticas están en el frame, sin lectura de la GPU
+        if (m_AutoIterEnabled)
+        {
+            CPUEscapeStats Stats;
+            AccumulateEscapeStats(m_pCPURenderer->GetThreadPool(), m_CPUEscape.data(), TexDesc.Width, TexDesc.Height, CPUConstants.maxiter, Stats);
+            ApplyIterationBudget(Stats);
+        }
+    }
+
+    bool FractalViewer::IsDeepZoomActive() const
+    {
+        return m_DeepZoomEnabled && !m_is3D && CPUPerturbationRenderer::SupportsFractalType(m_SelectedFractal2D);
+    }
+
+    bool FractalViewer::UsesCPUDeepZoom() const
+    {
+        return IsDeepZoomActive() && m_DeepZoom > MaxGPUDeepZoom;
+    }
+
+    CPUDeepZoomView FractalViewer::GetDeepZoomView() const
+    {
+        // Bits suficientes para el tamaño de píxel del zoom actual
+        const unsigned NumLimbs = BigFloat::LimbsForZoom(m_DeepZoom * m_pSwapChain->GetDesc().Height);
+
+        CPUDeepZoomView View;
+        View.CenterX = m_DeepCenterX;
+        View.CenterY = m_DeepCenterY;
+        View.CenterX.SetPrecision(NumLimbs);
+        View.CenterY.SetPrecision(NumLimbs);
+        View.Zoom = m_DeepZoom;
+        return View;
+    }
+
+    FractalViewer::PerturbationConstants FractalViewer::PreparePerturbationGPU(const CPUShaderConstants& Constants)
+    {
+        if (!m_pCPURenderer)
+            m_pCPURenderer.reset(new CPUFractalRenderer{});
+        if (!m_pPerturbation)
+            m_pPerturbation.reset(new CPUPerturbationRenderer{m_pCPURenderer->GetThreadPool()});
+
+        const bool OrbitChanged = m_pPerturbation->Prepare(GetDeepZoomView(), Constants);
+
+        const auto& Orbit = m_pPerturbation->GetReferenceOrbit();
+        const Uint32 NumElements = static_cast<Uint32>(Orbit.GetLastIndex() + 1);
+        if (OrbitChanged || NumElements > m_ReferenceOrbitCapacity)
+        {
+            if (NumElements > m_ReferenceOrbitCapacity)
+                CreateReferenceOrbitBuffer(std::max(NumElements, m_ReferenceOrbitCapacity * 2));
+
+            m_ReferenceOrbitData.resize(NumElements);
+            for (Uint32 n = 0; n < NumElements; ++n)
+                m_ReferenceOrbitData[n] = float2{static_cast<float>(Orbit.GetX()[n]), static_cast<float>(Orbit.GetY()[n])};
+            m_pImmediateContext->UpdateBuffer(m_ReferenceOrbitBuffer, 0, NumElements * sizeof(float2), m_ReferenceOrbitData.data(),
+                                              RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
 
-            DrawIndexedAttribs attrs;
-            attrs.IndexType = VT_UINT32;
-            attrs.NumIndices = 6;
-            attrs.Flags = DRAW_FLAG_VERIFY_ALL;
-            m_pImmediateContext->DrawIndexed(attrs);
+        // δ en float con exponente aparte: 1/zoom y la serie (u = δc / Scale = uv / (Zoom * Scale))
+        // como mantisa y exponente, para que no se queden en 0 pasado zoom ~1e30
+        const auto& Series = m_pPerturbation->GetSeries();
+        const CPUScaledDeltaParams Scaled = CPUScaledDeltaParams::Make(Series, m_DeepZoom);
+
+        PerturbationConstants PerturbData;
+        PerturbData.PerturbParams = float4{
+            1.0f,
+            static_cast<float>(Orbit.GetLastIndex()),
+            static_cast<float>(Series.SkipIter),
+            static_cast<float>(1.0 / m_DeepZoom)
+        };
+        PerturbData.SeriesAB = float4{ Scaled.SeriesAx, Scaled.SeriesAy, Scaled.SeriesBx, Scaled.SeriesBy };
+        PerturbData.SeriesC = float4{ Scaled.SeriesCx, Scaled.SeriesCy, Scaled.UScale, 0.0f };
+        PerturbData.PerturbScale = float4{
+            Scaled.InvZoomMantissa,
+            static_cast<float>(Scaled.InvZoomExponent),
+            static_cast<float>(Scaled.SeriesExponent),
+            0.0f
+        };
+        return PerturbData;
+    }
+
+    void FractalViewer::BindComputeTargets(IShaderResourceBinding* pSRB)
+    {
+        // Cada permutación declara solo lo que usa (el ubershader, todo)
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "OutputTex"))
+            pVar->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "EscapeTex"))
+            pVar->Set(m_pEscapeTex->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ReferenceOrbit"))
+            pVar->Set(m_ReferenceOrbitBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ConeDepthTex"))
+            pVar->Set(m_pConeDepthTex[_countof(ConeTileSizes) - 1]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+        // Reproyección temporal: se escribe una profundidad y se lee la otra
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "DepthOutTex"))
+            pVar->Set(m_pHistoryDepthTex[m_HistoryDepthIndex]->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "PrevDepthTex"))
+            pVar->Set(m_pHistoryDepthTex[m_HistoryDepthIndex ^ 1]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "ReprojDepthTex"))
+            pVar->Set(m_pReprojDepthTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "HistoryColorTex"))
+            pVar->Set(m_pHistoryColorTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        BindDistanceBricks(pSRB);
+    }
+
+    void FractalViewer::DrawOutputTexture()
+    {
+        // Con supersampling (compute) la imagen final ya está coloreada, también en 2D
+        if (IsAdaptiveAAActive() && m_AAOutputValid)
+        {
+            m_pQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, "InputTex")->Set(m_pAAOutputTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+            DrawFullscreenQuad(m_pQuadPSO, m_pQuadSRB);
+            return;
+        }
+
+        // 2D (compute o CPU): se colorea el buffer de escape
+        if (!m_is3D)
+        {
+            m_pColorizeSRB->GetVariableByName(SHADER_TYPE_PIXEL, "EscapeTex")->Set(m_pEscapeTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+            DrawFullscreenQuad(m_pColorizePSO, m_pColorizeSRB);
+            return;
         }
 
+        // Quad SRB debería tener el SRV de la textura:
+        m_pQuadSRB->GetVariableByName(SHADER_TYPE_PIXEL, "InputTex")
+            ->Set(m_pComputeOutputTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        DrawFullscreenQuad(m_pQuadPSO, m_pQuadSRB);
+    }
+
+    void FractalViewer::DrawFullscreenQuad(IPipelineState* pPSO, IShaderResourceBinding* pSRB)
+    {
+        m_pImmediateContext->SetPipelineState(pPSO);
+        m_pImmediateContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        DrawIndexedAttribs attrs;
+        attrs.IndexType = VT_UINT32;
+        attrs.NumIndices = 6;
+        attrs.Flags = DRAW_FLAG_VERIFY_ALL;
+        m_pImmediateContext->DrawIndexed(attrs);
+    }
+
+    void FractalViewer::WindowResize(Uint32 Width, Uint32 Height)
+    {
+        if (!m_pComputeOutputTex)
+            return;
+
+        // Las texturas de todas las escalas son fracciones de la swap chain: se sueltan (el
+        // dispositivo las libera cuando la GPU termina con ellas) y se recrea el nivel activo
+        for (auto& Targets : m_ScaledTargets)
+            Targets = {};
+        const Uint32 Level = m_RenderScaleLevel;
+        m_pComputeOutputTex.Release();
+        SetRenderScale(Level);
+        m_HasLastFrame = false;
     }
 
     void FractalViewer::Update(double CurrTime, double ElapsedTime, bool DoUpdateUI)
     {
         SampleBase::Update(CurrTime, ElapsedTime, DoUpdateUI);
+        m_LastFrameMs = ElapsedTime * 1e3;
 
-        float dt = static_cast<float>(ElapsedTime);
+        // Exportando, el tiempo avanza un paso fijo por frame en vez del reloj
+        float dt = m_Exporting ? 1.0f / static_cast<float>(m_ExportFPS) : static_cast<float>(ElapsedTime);
 
         if (!paused)
             m_Time += dt;
@@ -432,9 +2719,13 @@ namespace Diligent
         if (m_is3D)
             m_Camera.Update(m_InputController, dt);
 
-        if (m_usesComputePipeline && m_is3D) {
+        // En 2D el backend CPU y el deep zoom más allá del límite de la GPU mandan sobre el compute
+        if (m_usesComputePipeline && (m_is3D || !(m_UseCPURenderer || UsesCPUDeepZoom()))) {
 			m_RenderMode = RenderMode::ComputeShader;
 		}
+        else if ((m_UseCPURenderer || UsesCPUDeepZoom()) && !m_is3D) {
+            m_RenderMode = RenderMode::CPU;
+        }
 		else {
             m_RenderMode = RenderMode::PixelShader;
 		}
@@ -442,7 +2733,10 @@ namespace Diligent
 
         if (m_AutoZoomActive)
         {
-            m_Zoom *= 1.0f + m_AutoZoomSpeed * dt;
+            if (IsDeepZoomActive())
+                m_DeepZoom *= 1.0 + m_AutoZoomSpeed * dt;
+            else
+                m_Zoom *= 1.0 + m_AutoZoomSpeed * dt;
         }
     }
 
@@ -479,6 +2773,214 @@ namespace Diligent
             ImGui::Separator();
             ImGui::Checkbox("3D MODE", &m_is3D);
             ImGui::Checkbox("Uses Compute Pipeline", &m_usesComputePipeline);
+            if (m_usesComputePipeline)
+            {
+                ImGui::Checkbox("Auto-tune On First Use", &m_AutoTuneGroupSize);
+                if (ImGui::Button("Auto-tune Group Size") && !m_GroupTuner.IsRunning())
+                {
+                    const auto& TexDesc = m_pComputeOutputTex->GetDesc();
+                    m_GroupTuner.Begin(m_pDevice->GetAdapterInfo().Description, m_is3D, TexDesc.Width, TexDesc.Height);
+                }
+                const auto GroupSize = GetComputeGroupSize(m_is3D);
+                ImGui::SameLine();
+                if (m_GroupTuner.IsRunning())
+                    ImGui::Text("tuning %ux%u...", m_GroupTuner.GetCurrentCandidate().X, m_GroupTuner.GetCurrentCandidate().Y);
+                else
+                    ImGui::Text("group %ux%u", GroupSize.X, GroupSize.Y);
+
+                const auto& Times = m_GroupTuner.GetLastTimes();
+                if (!m_GroupTuner.IsRunning() && !Times.empty() && ImGui::TreeNode("Last Tuning"))
+                {
+                    const auto& Candidates = ComputeGroupTuner::GetCandidates();
+                    for (size_t i = 0; i < Times.size(); ++i)
+                        ImGui::Text("%2ux%-2u  %.3f ms", Candidates[i].X, Candidates[i].Y, Times[i] * 1e3);
+                    ImGui::TreePop();
+                }
+            }
+            ImGui::Checkbox("Specialized Shaders", &m_UsePermutations);
+            if (m_UsePermutations)
+            {
+                std::lock_guard<std::mutex> Lock{ m_PermutationsMtx };
+                ImGui::Text("PSOs: %u ready, %u compiling; cache: %u hits, %u compiled%s",
+                            static_cast<Uint32>(m_PermutationPSOs.size()), static_cast<Uint32>(m_PendingPermutations.size()),
+                            m_pPSOCache->GetNumCacheHits(), m_pPSOCache->GetNumCompiled(), m_pPSOCache->IsPersistent() ? "" : " (no disk cache)");
+            }
+            ImGui::Checkbox("Progressive Refinement", &m_ProgressiveEnabled);
+            if (!m_is3D)
+            {
+                ImGui::Checkbox("Pan Reuse", &m_PanReuseEnabled);
+                if (m_PanReuseEnabled)
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("last pan: %.0f%% reused", m_LastPanReuse * 100.0f);
+                }
+            }
+            if (m_ProgressiveEnabled)
+            {
+                int InteractionScale = static_cast<int>(m_InteractionScale);
+                if (ImGui::SliderInt("Interaction Scale", &InteractionScale, 1, 8))
+                    m_InteractionScale = static_cast<Uint32>(InteractionScale);
+                if (m_RenderMode == RenderMode::PixelShader)
+                    ImGui::Text("Refine pass: %u / %u", m_RefinePass, RefineGridSize * RefineGridSize);
+            }
+            if (m_RenderMode != RenderMode::PixelShader)
+            {
+                // Escala de render dinámica: compute y CPU
+                if (ImGui::Checkbox("Dynamic Resolution", &m_DynamicResEnabled))
+                    m_DynamicRes.Reset();
+                if (m_DynamicResEnabled)
+                {
+                    ImGui::SliderFloat("Frame Budget (ms)", &m_DynamicResBudgetMs, 4.0f, 50.0f, "%.1f");
+                    const auto& OutputDesc = m_pComputeOutputTex->GetDesc();
+                    ImGui::Text("render scale %.2f (%ux%u), controller %.2f", DynamicResolution::LevelScales[m_RenderScaleLevel], OutputDesc.Width,
+                                OutputDesc.Height, m_DynamicRes.GetScale());
+                }
+            }
+            if (m_is3D && m_RenderMode == RenderMode::ComputeShader)
+            {
+                if (ImGui::Checkbox("Cone Prepass (1/8, 1/4)", &m_ConePrepassEnabled))
+                    m_HasLastFrame = false;
+                if (ImGui::Checkbox("Temporal Reprojection", &m_TemporalEnabled))
+                    m_HistoryValid = false;
+                if (m_TemporalEnabled)
+                {
+                    ImGui::SliderFloat("History Blend", &m_TemporalBlend, 0.0f, 0.9f);
+                    // Con la potencia animada la historia no vale nunca: Animate Power o pausa
+                    ImGui::Text("history: %s", m_TemporalData.TemporalParams.x > 0.5f ? "reprojected" : "rejected");
+                }
+                if (ImGui::Checkbox("Distance Cache (bricks)", &m_BricksEnabled))
+                    m_HasLastFrame = false;
+                if (m_BricksEnabled)
+                {
+                    ImGui::SliderInt("Bricks per Frame", &m_BrickBakeBudget, 16, 4096);
+                    int CellsPerAxis = static_cast<int>(m_BrickSettings.CellsPerAxis);
+                    if (ImGui::SliderInt("Cells per Axis", &CellsPerAxis, 8, 64))
+                        m_BrickSettings.CellsPerAxis = static_cast<Uint32>(CellsPerAxis);
+                    int BrickResolution = static_cast<int>(m_BrickSettings.BrickResolution);
+                    if (ImGui::SliderInt("Brick Resolution", &BrickResolution, 2, 8))
+                        m_BrickSettings.BrickResolution = static_cast<Uint32>(BrickResolution);
+                    // Con la potencia animada la escena cambia cada frame: potencia fija o pausa
+                    if (m_BricksActive)
+                    {
+                        const auto& BrickStats = m_DistanceBricks.GetStats();
+                        ImGui::Text("bricks %u / %u, %.1f MB, bake %.1f ms", BrickStats.BakedBricks, BrickStats.BandBricks,
+                                    BrickStats.MemoryBytes / (1024.0 * 1024.0), (BrickStats.CoarseSeconds + BrickStats.BrickSeconds) * 1e3);
+                    }
+                    else
+                        ImGui::Text("bricks: static scene only");
+                }
+            }
+            if (m_RenderMode == RenderMode::ComputeShader)
+            {
+                // Supersampling adaptativo: compute, fuera del deep zoom
+                if (ImGui::Checkbox("Adaptive Supersampling", &m_AAEnabled))
+                    m_HasLastFrame = false;
+                if (m_AAEnabled)
+                {
+                    if (ImGui::SliderInt("Max Extra Samples", &m_AAMaxSamples, 1, static_cast<int>(CPUFractalRenderer::AAMaxSamplesLimit)))
+                        m_HasLastFrame = false;
+                    if (ImGui::SliderFloat("Edge Threshold", &m_AAThreshold, 0.01f, 2.0f, "%.2f"))
+                        m_HasLastFrame = false;
+                    if (IsAdaptiveAAActive())
+                    {
+                        const auto&  OutputDesc = m_pAAOutputTex->GetDesc();
+                        const Uint64 Total = Uint64{OutputDesc.Width} * OutputDesc.Height;
+                        ImGui::Text("refined %llu px (%.1f%%), %llu extra samples", static_cast<unsigned long long>(m_AARefinedPixels),
+                                    Total > 0 ? 100.0 * m_AARefinedPixels / Total : 0.0, static_cast<unsigned long long>(m_AAExtraSamples));
+                    }
+                    else
+                        ImGui::Text("supersampling: not in deep zoom");
+                }
+            }
+            if (!m_is3D)
+            {
+                // Subdivisión: CPU o compute, fuera del deep zoom
+                if (ImGui::Checkbox("Subdivision (Mariani-Silver)", &m_SubdivisionEnabled))
+                    m_HasLastFrame = false;
+                if (m_SubdivisionEnabled && (m_RenderMode == RenderMode::CPU || m_RenderMode == RenderMode::ComputeShader) && !IsDeepZoomActive())
+                {
+                    const auto&  EscapeDesc = m_pEscapeTex->GetDesc();
+                    const Uint64 Total = Uint64{EscapeDesc.Width} * EscapeDesc.Height;
+                    ImGui::Text("skipped %llu px (%.1f%%), iterated %llu px", static_cast<unsigned long long>(m_SubdivSkipped),
+                                Total > 0 ? 100.0 * m_SubdivSkipped / Total : 0.0, static_cast<unsigned long long>(m_SubdivEvaluated));
+                }
+
+                ImGui::Checkbox("CPU Renderer (SIMD)", &m_UseCPURenderer);
+                if (m_UseCPURenderer && m_pCPURenderer)
+                {
+                    const auto& Stats = m_pCPURenderer->GetLastStats();
+                    ImGui::Text("%s x %u threads: %.1f Mpix/s, %.0f Mit/s", GetSimdInstructionSetName(),
+                                m_pCPURenderer->GetNumThreads(), Stats.GetMPixelsPerSecond(), Stats.GetIterationsPerSecond() * 1e-6);
+                }
+                if (m_UseCPURenderer)
+                {
+                    if (ImGui::Checkbox("Tile Cache (disk)", &m_TileCacheEnabled))
+                        m_HasLastFrame = false;
+                    if (m_TileCacheEnabled && m_pTileCache)
+                    {
+                        const auto& Stats = m_pTileCache->GetLastStats();
+                        ImGui::Text("level %d: %u tiles, %u mem, %u disk, %u new, %u pending", Stats.Level, Stats.Tiles, Stats.MemoryHits,
+                                    Stats.DiskHits, Stats.Rendered, Stats.Placeholders);
+                        // Sin almacén: no se pudo crear el fichero o lo tiene otra instancia del viewer
+                        if (m_pTileCache->GetStore().IsOpen())
+                            ImGui::Text("resident %u, on disk %u / %u", Stats.Resident, m_pTileCache->GetStore().GetNumStored(),
+                                        m_pTileCache->GetStore().GetNumSlots());
+                        else
+                            ImGui::Text("resident %u, cannot open %s: memory only", Stats.Resident, m_pTileCache->GetSettings().DiskPath.c_str());
+                    }
+                }
+            }
+
+            // --- Exportación de animaciones (auto zoom, potencia animada del Mandelbulb...) ---
+            if (ImGui::CollapsingHeader("Export"))
+            {
+                const char* FormatOptions[] = { "Y4M (YUV 4:4:4)", "PNG sequence", "Raw RGBA" };
+                if (!m_Exporting)
+                {
+                    ImGui::InputText("Output", m_ExportPath, sizeof(m_ExportPath));
+                    ImGui::Combo("Format", &m_ExportFormat, FormatOptions, IM_ARRAYSIZE(FormatOptions));
+                    ImGui::SliderInt("FPS", &m_ExportFPS, 1, 120);
+                    ImGui::InputInt("Frames", &m_ExportFrames);
+                    m_ExportFrames = std::max(m_ExportFrames, 1);
+                    if (ImGui::Button("Start Export"))
+                        BeginExport();
+                }
+                else
+                {
+                    ImGui::Text("frame %u / %d, written %u", m_ExportSubmitted, m_ExportFrames, m_pFrameWriter->GetNumWritten());
+                    if (ImGui::Button("Stop Export"))
+                        EndExport();
+                }
+                if (!m_ExportStatus.empty())
+                    ImGui::TextWrapped("%s", m_ExportStatus.c_str());
+            }
+
+            // --- Póster por tiles (CPU), de cualquier tamaño ---
+            if (ImGui::CollapsingHeader("Poster"))
+            {
+                if (!m_pPosterWriter)
+                {
+                    ImGui::InputText("Poster File", m_PosterPath, sizeof(m_PosterPath));
+                    ImGui::InputInt2("Poster Size", m_PosterSize);
+                    ImGui::SliderInt("Poster Tile", &m_PosterTileSize, 64, 2048);
+                    if (ImGui::Button("Start Poster"))
+                        m_PosterRequested = true;
+                }
+                else
+                {
+                    const float Done = static_cast<float>(m_pPosterWriter->GetNumDone()) / static_cast<float>(m_pPosterWriter->GetNumTiles());
+                    ImGui::ProgressBar(Done);
+                    if (ImGui::Button("Stop Poster"))
+                    {
+                        // El progreso queda en disco: Start con la misma vista lo continúa
+                        m_pPosterWriter->Finish();
+                        m_PosterStatus = "stopped at tile " + std::to_string(m_pPosterWriter->GetNumDone());
+                        m_pPosterWriter.reset();
+                    }
+                }
+                if (!m_PosterStatus.empty())
+                    ImGui::TextWrapped("%s", m_PosterStatus.c_str());
+            }
 
             // --- Cámara ---
             if (ImGui::CollapsingHeader("Camera", ImGuiTreeNodeFlags_DefaultOpen) && m_is3D)
@@ -492,14 +2994,63 @@ namespace Diligent
             if (!m_is3D) {
                 ImGui::Separator();
                 ImGui::Text("Transformations:");
-                ImGui::DragFloat("Zoom", &m_Zoom, 0.2f, 0.001f, 1000000.0f, "%.6f");
-                ImGui::DragFloat("Offset X", &m_OffsetX, 0.0005f, -2.0f, 2.0f, "%.6f");
-                ImGui::DragFloat("Offset Y", &m_OffsetY, 0.0005f, -2.0f, 2.0f, "%.6f");
+                // En double: con double-float se llega a zooms de ~1e13
+                const double MinZoom = 0.001, MaxZoom = 1e14, MinOffset = -2.0, MaxOffset = 2.0;
+                ImGui::DragScalar("Zoom", ImGuiDataType_Double, &m_Zoom, 0.2f, &MinZoom, &MaxZoom, "%.6g", ImGuiSliderFlags_Logarithmic);
+                ImGui::DragScalar("Offset X", ImGuiDataType_Double, &m_OffsetX, 0.0005f, &MinOffset, &MaxOffset, "%.15f");
+                ImGui::DragScalar("Offset Y", ImGuiDataType_Double, &m_OffsetY, 0.0005f, &MinOffset, &MaxOffset, "%.15f");
                 // — Botón de auto‑zoom — 
                 if (ImGui::Button(m_AutoZoomActive ? "Stop Auto Zoom" : "Start Auto Zoom"))
                     m_AutoZoomActive = !m_AutoZoomActive;
                 ImGui::SameLine();
                 ImGui::SliderFloat("Zoom Speed", &m_AutoZoomSpeed, 0.1f, 10.0f, "%.2f");
+
+                // --- Deep zoom ---
+                if (ImGui::Checkbox("Deep Zoom (Perturbation)", &m_DeepZoomEnabled) && m_DeepZoomEnabled)
+                {
+                    // Parte de la vista float actual
+                    m_DeepZoom = m_Zoom;
+                    m_DeepCenterX = BigFloat::FromDouble(m_OffsetX, BigFloat::LimbsForZoom(m_DeepZoom));
+                    m_DeepCenterY = BigFloat::FromDouble(m_OffsetY, BigFloat::LimbsForZoom(m_DeepZoom));
+                }
+                if (m_DeepZoomEnabled)
+                {
+                    if (!CPUPerturbationRenderer::SupportsFractalType(m_SelectedFractal2D))
+                        ImGui::TextDisabled("Deep zoom: Mandelbrot / Burning Ship only");
+
+                    ImGui::InputDouble("Deep Zoom", &m_DeepZoom, 0.0, 0.0, "%.3e");
+                    m_DeepZoom = std::max(m_DeepZoom, 1e-3);
+
+                    const unsigned Digits = static_cast<unsigned>(std::log10(std::max(m_DeepZoom, 1.0))) + 8;
+                    ImGui::TextWrapped("Re: %s", m_DeepCenterX.ToString(Digits).c_str());
+                    ImGui::TextWrapped("Im: %s", m_DeepCenterY.ToString(Digits).c_str());
+                    ImGui::InputText("Center Re", m_DeepCenterInput[0], sizeof(m_DeepCenterInput[0]));
+                    ImGui::InputText("Center Im", m_DeepCenterInput[1], sizeof(m_DeepCenterInput[1]));
+                    if (ImGui::Button("Set Center"))
+                    {
+                        const unsigned NumLimbs = std::max(BigFloat::LimbsForZoom(m_DeepZoom), 8u);
+                        BigFloat X, Y;
+                        if (BigFloat::FromString(m_DeepCenterInput[0], NumLimbs, X) && BigFloat::FromString(m_DeepCenterInput[1], NumLimbs, Y))
+                        {
+                            m_DeepCenterX = X;
+                            m_DeepCenterY = Y;
+                        }
+                    }
+
+                    if (m_pPerturbation && IsDeepZoomActive())
+                    {
+                        ImGui::Text("%s, reference: %d iter, series skip: %d", UsesCPUDeepZoom() || m_UseCPURenderer ? "CPU (double)" : "GPU (scaled float)",
+                                    m_pPerturbation->GetReferenceOrbit().GetLastIndex() + 1, m_pPerturbation->GetSeries().SkipIter);
+                        if (ImGui::IsItemHovered())
+                            ImGui::SetTooltip("Series approximation: Mandelbrot only (Burning Ship always iterates from n = 0)");
+                        if (UsesCPUDeepZoom() || m_UseCPURenderer)
+                        {
+                            const auto& Stats = m_pPerturbation->GetLastStats();
+                            ImGui::Text("%.1f ms (ref %.1f ms), rebases: %llu", Stats.Seconds * 1e3, Stats.ReferenceSeconds * 1e3,
+                                        static_cast<unsigned long long>(Stats.Rebases));
+                        }
+                    }
+                }
             }
             
             ImGuiIO& io = ImGui::GetIO();
@@ -524,12 +3075,20 @@ namespace Diligent
 
                 // 4) Calculo del world‑space point:
                 //    uvF = ndc;   world = uvF/zoom + offset
-                float worldX = ndcX / m_Zoom + m_OffsetX;
-                float worldY = ndcY / m_Zoom + m_OffsetY;
+                double worldX = ndcX / m_Zoom + m_OffsetX;
+                double worldY = ndcY / m_Zoom + m_OffsetY;
 
                 // 5) **Asignamos** el nuevo offset (no sumamos incrementalmente)
                 m_OffsetX = worldX;
                 m_OffsetY = worldY;
+
+                // En deep zoom el desplazamiento se suma al centro en precisión arbitraria
+                if (IsDeepZoomActive())
+                {
+                    const unsigned NumLimbs = BigFloat::LimbsForZoom(m_DeepZoom * size.y);
+                    m_DeepCenterX = m_DeepCenterX + BigFloat::FromDouble(ndcX / m_DeepZoom, NumLimbs);
+                    m_DeepCenterY = m_DeepCenterY + BigFloat::FromDouble(ndcY / m_DeepZoom, NumLimbs);
+                }
             }
 
             // --- Colores ---
@@ -537,6 +3096,16 @@ namespace Diligent
             ImGui::Text("Colors:");
             ImGui::ColorEdit4("Fractal Color", &m_FractalColor.x);
             ImGui::ColorEdit4("Background Color", &m_BackgroundColor.x);
+            if (!m_is3D)
+            {
+                const char* paletteOptions[] = { "Fractal Default", "Smooth Gradient", "Cosine Cycles" };
+                ImGui::Combo("Palette", &m_PaletteMode, paletteOptions, IM_ARRAYSIZE(paletteOptions));
+                if (m_PaletteMode == 2)
+                {
+                    ImGui::SliderFloat("Palette Cycles", &m_PaletteCycles, 0.1f, 64.0f, "%.2f");
+                    ImGui::SliderFloat("Palette Phase", &m_PalettePhase, 0.0f, 1.0f);
+                }
+            }
 
             
 
@@ -548,12 +3117,39 @@ namespace Diligent
 
                 ImGui::Separator();
                 ImGui::Text("Fractal Parameters:");
-                ImGui::SliderInt("Max Iter", (int*)&m_maxiter, 10, 10000);
-                ImGui::SliderFloat("Bailout", &m_FractalParams1.x, 1.0f, 10.0f);
-                bool tempBool = (m_FractalParams1.z > 0.5f);
-                if (ImGui::Checkbox("Use Double Precision", &tempBool)) {
-                    m_FractalParams1.z = tempBool ? 1.0f : 0.0f;
+                // Automático: el histograma de escape de cada frame completo elige el del siguiente
+                ImGui::Checkbox("Auto Max Iter", &m_AutoIterEnabled);
+                if (m_AutoIterEnabled)
+                {
+                    ImGui::Text("Max Iter: %d (auto)", m_maxiter);
+                    float UnresolvedPercent = m_IterBudgetSettings.UnresolvedFraction * 100.0f;
+                    if (ImGui::SliderFloat("Unresolved Limit %", &UnresolvedPercent, 0.001f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic))
+                        m_IterBudgetSettings.UnresolvedFraction = UnresolvedPercent * 0.01f;
+                    if (m_IterStats.Pixels > 0)
+                    {
+                        const double Pixels = static_cast<double>(m_IterStats.Pixels);
+                        ImGui::Text("At %d: %.2f%% capped, %.3f%% unresolved", m_IterStats.MaxIter, 100.0 * m_IterStats.Capped / Pixels,
+                                    100.0 * m_IterStats.Unresolved / Pixels);
+                        float Histogram[CPUEscapeHistogramBins];
+                        for (Uint32 Bin = 0; Bin < CPUEscapeHistogramBins; ++Bin)
+                            Histogram[Bin] = static_cast<float>(m_IterStats.Bins[Bin]);
+                        ImGui::PlotHistogram("Escape (log2)", Histogram, static_cast<int>(CPUEscapeHistogramBins), 0, nullptr, 0.0f, std::numeric_limits<float>::max(), ImVec2(0, 60));
+                    }
                 }
+                else
+                {
+                    ImGui::SliderInt("Max Iter", (int*)&m_maxiter, 10, 10000);
+                }
+                ImGui::SliderFloat("Bailout", &m_FractalParams1.x, 1.0f, 10.0f);
+                // Double necesita soporte de la GPU; double-float lo emula con pares de float
+                const char* precisionOptions[] = { "Float", "Double", "Double-Float (emulated)" };
+                int precision = std::min(std::max(static_cast<int>(m_FractalParams1.z + 0.5f), 0), CPU_PRECISION_COUNT - 1);
+                if (ImGui::Combo("Precision", &precision, precisionOptions, IM_ARRAYSIZE(precisionOptions)))
+                    m_FractalParams1.z = static_cast<float>(precision);
+                // Cardioide / bulbo y detección de periodo: el interior deja de gastar maxiter
+                bool InteriorEarlyOut = m_FractalParams2.y > 0.5f;
+                if (ImGui::Checkbox("Interior Early-Out", &InteriorEarlyOut))
+                    m_FractalParams2.y = InteriorEarlyOut ? 1.0f : 0.0f;
 
                 
             }
@@ -565,25 +3161,196 @@ namespace Diligent
                 ImGui::SliderFloat("Max Steps", &m_Options3D.x, 1.0f, 1000.0f);
                 ImGui::SliderFloat("Max Dist", &m_Options3D.y, 0.001f, 100.0f);
                 ImGui::SliderFloat("Threshold", &m_Options3D.z, 0.00001f, 0.1f, "%.5f", ImGuiSliderFlags_None);
+
+                // Options3D.w: potencia fija del Mandelbulb (0 = animada). La potencia 8 usa el
+                // kernel polinómico de fractal3D.fxh
+                bool AnimatePower = m_Options3D.w <= 0.0f;
+                if (ImGui::Checkbox("Animate Power", &AnimatePower))
+                    m_Options3D.w = AnimatePower ? 0.0f : 8.0f;
+                if (!AnimatePower)
+                {
+                    int BulbPower = static_cast<int>(m_Options3D.w);
+                    if (ImGui::SliderInt("Bulb Power", &BulbPower, 2, 16))
+                        m_Options3D.w = static_cast<float>(BulbPower);
+                }
+
+                // Quaternion Julia: c en FractalC (todo a cero = la c por defecto de fractal3D.fxh).
+                // El Mandelbox toma la escala de "Power" (FractalParams1.y, mínimo 1.5)
+                if (m_SelectedFractal3D == CPU_FRACTAL_3D_QUATERNION_JULIA)
+                    ImGui::InputFloat4("C (quaternion)", &m_FractalC.x);
             }
 
             // --- Animación ---
             ImGui::Separator();
             ImGui::Text("Animation Params:");
-            ImGui::SliderFloat("Speed X", &m_AnimationParams.x, -1.0f, 1.0f);
-            ImGui::SliderFloat("Speed Y", &m_AnimationParams.y, -1.0f, 1.0f);
-            ImGui::SliderFloat("Deformation", &m_AnimationParams.z, -2.0f, 2.0f);
-            ImGui::SliderFloat("Phase/Seed", &m_AnimationParams.w, 0.0f, 1.0f);
+            // El deep zoom itera la referencia del centro con c fijo: sin los controles, para no
+            // dar a entender que anima c
+            if (IsDeepZoomActive())
+            {
+                ImGui::TextDisabled("Disabled while deep zoom is active (c is not animated)");
+            }
+            else
+            {
+                ImGui::SliderFloat("Speed X", &m_AnimationParams.x, -1.0f, 1.0f);
+                ImGui::SliderFloat("Speed Y", &m_AnimationParams.y, -1.0f, 1.0f);
+                ImGui::SliderFloat("Deformation", &m_AnimationParams.z, -2.0f, 2.0f);
+                ImGui::SliderFloat("Phase/Seed", &m_AnimationParams.w, 0.0f, 1.0f);
+            }
 
 			ImGui::Separator();
             ImGui::Checkbox("Paused", &paused);
             ImGui::SliderFloat("Power", &m_FractalParams1.y, 1.0f, 10.0f);
             ImGui::SliderFloat("Gamma", &m_FractalParams2.x, 0.1f, 5.0f);
-            ImGui::SliderFloat("Gamma", &m_FractalParams2.y, 0.1f, 5.0f);
 
 
             ImGui::End();
         }
+
+        UpdateTimingUI();
+        UpdateSweepUI();
+    }
+
+    void FractalViewer::UpdateSweepUI()
+    {
+        ImGui::SetNextWindowPos(ImVec2(420, 340), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+        if (ImGui::Begin("Parameter Sweep"))
+        {
+            const char* ParameterOptions[] = { "Julia C (grid)", "Mandelbulb Power", "Burning Ship Deformation" };
+            int Parameter = static_cast<int>(m_SweepSettings.Parameter);
+            if (ImGui::Combo("Parameter", &Parameter, ParameterOptions, IM_ARRAYSIZE(ParameterOptions)))
+            {
+                // Un rango de partida razonable para cada parámetro
+                m_SweepSettings.Parameter = static_cast<CPU_SWEEP_PARAMETER>(Parameter);
+                if (m_SweepSettings.Parameter == CPU_SWEEP_BULB_POWER)
+                {
+                    m_SweepSettings.MinX = 2.0f;
+                    m_SweepSettings.MaxX = 12.0f;
+                }
+                else
+                {
+                    m_SweepSettings.MinX = m_SweepSettings.MinY = -0.25f;
+                    m_SweepSettings.MaxX = m_SweepSettings.MaxY = 0.25f;
+                }
+            }
+            ImGui::InputFloat2("Range X", &m_SweepSettings.MinX);
+            if (m_SweepSettings.Parameter == CPU_SWEEP_JULIA_C)
+                ImGui::InputFloat2("Range Y", &m_SweepSettings.MinY);
+
+            int Grid[2] = { static_cast<int>(m_SweepSettings.Columns), static_cast<int>(m_SweepSettings.Rows) };
+            if (ImGui::InputInt2("Grid", Grid))
+            {
+                m_SweepSettings.Columns = static_cast<Uint32>(std::min(std::max(Grid[0], 1), 64));
+                m_SweepSettings.Rows = static_cast<Uint32>(std::min(std::max(Grid[1], 1), 64));
+            }
+            int Thumb[2] = { static_cast<int>(m_SweepSettings.ThumbWidth), static_cast<int>(m_SweepSettings.ThumbHeight) };
+            if (ImGui::InputInt2("Thumbnail", Thumb))
+            {
+                m_SweepSettings.ThumbWidth = static_cast<Uint32>(std::min(std::max(Thumb[0], 8), 512));
+                m_SweepSettings.ThumbHeight = static_cast<Uint32>(std::min(std::max(Thumb[1], 8), 512));
+            }
+            if (ImGui::Button("Render Sweep"))
+                m_SweepRequested = true;
+            if (!m_SweepStatus.empty())
+                ImGui::TextWrapped("%s", m_SweepStatus.c_str());
+
+            // El atlas, con el valor de la miniatura bajo el ratón
+            if (m_pSweepAtlasTex && !m_SweepSlices.empty())
+            {
+                const auto& AtlasDesc = m_pSweepAtlasTex->GetDesc();
+                const float Scale = std::min(1.0f, ImGui::GetContentRegionAvail().x / static_cast<float>(AtlasDesc.Width));
+                const ImVec2 Size{ AtlasDesc.Width * Scale, AtlasDesc.Height * Scale };
+                ImGui::Image(m_pSweepAtlasTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), Size);
+                if (ImGui::IsItemHovered())
+                {
+                    const ImVec2 Min = ImGui::GetItemRectMin();
+                    const ImVec2 Mouse = ImGui::GetIO().MousePos;
+                    const Uint32 Column = static_cast<Uint32>((Mouse.x - Min.x) / Scale) / m_SweepSettings.ThumbWidth;
+                    const Uint32 Row = static_cast<Uint32>((Mouse.y - Min.y) / Scale) / m_SweepSettings.ThumbHeight;
+                    const Uint32 Index = Row * m_SweepSettings.Columns + Column;
+                    if (Column < m_SweepSettings.Columns && Index < m_SweepSlices.size())
+                    {
+                        float X, Y;
+                        GetSweepValue(m_SweepSettings, Index, X, Y);
+                        if (m_SweepSettings.Parameter == CPU_SWEEP_JULIA_C)
+                            ImGui::SetTooltip("#%u: c offset (%.4f, %.4f)", Index, X, Y);
+                        else
+                            ImGui::SetTooltip("#%u: %.4f", Index, X);
+                    }
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+    void FractalViewer::UpdateTimingUI()
+    {
+        // Junto a "Fractal Settings"
+        ImGui::SetNextWindowPos(ImVec2(420, 10), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(430, 0), ImGuiCond_FirstUseEver);
+        if (ImGui::Begin("Frame Timing"))
+        {
+            const auto Frame = m_pProfiler->GetFrameStats();
+            ImGui::Text("Render(): avg %.3f ms, p50 %.3f, p95 %.3f, p99 %.3f (%u frames)", Frame.AvgMs, Frame.P50Ms, Frame.P95Ms, Frame.P99Ms, Frame.NumSamples);
+            if (!m_pProfiler->HasGPUTimings())
+                ImGui::TextDisabled("GPU timestamps not supported: CPU timings only");
+
+            if (ImGui::BeginTable("Stages", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+            {
+                ImGui::TableSetupColumn("Stage");
+                ImGui::TableSetupColumn("");
+                ImGui::TableSetupColumn("avg ms");
+                ImGui::TableSetupColumn("p50 ms");
+                ImGui::TableSetupColumn("p95 / p99 ms");
+                ImGui::TableHeadersRow();
+                for (Uint32 s = 0; s < FrameProfiler::STAGE_COUNT; ++s)
+                {
+                    const auto Stage = static_cast<FrameProfiler::STAGE>(s);
+                    for (int Gpu = 0; Gpu < (m_pProfiler->HasGPUTimings() ? 2 : 1); ++Gpu)
+                    {
+                        const auto Stats = Gpu ? m_pProfiler->GetGPUStats(Stage) : m_pProfiler->GetCPUStats(Stage);
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(Gpu ? "" : FrameProfiler::GetStageName(Stage));
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(Gpu ? "GPU" : "CPU");
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", Stats.AvgMs);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", Stats.P50Ms);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f / %.3f", Stats.P95Ms, Stats.P99Ms);
+                    }
+                }
+                ImGui::EndTable();
+            }
+
+            // Registro por frame para comparar modos y seguir regresiones
+            ImGui::Separator();
+            if (!m_pProfiler->IsLogging())
+            {
+                ImGui::InputText("Log File", m_TimingLogPath, sizeof(m_TimingLogPath));
+                ImGui::Combo("Log Format", &m_TimingLogFormat, "CSV\0JSON lines\0");
+                if (ImGui::Button("Start Logging"))
+                {
+                    const auto Format = m_TimingLogFormat == 0 ? FrameProfiler::LogFormat::CSV : FrameProfiler::LogFormat::JSON;
+                    if (!m_pProfiler->StartLog(m_TimingLogPath, Format))
+                        ImGui::OpenPopup("Timing Log Error");
+                }
+            }
+            else
+            {
+                ImGui::Text("Logging to %s", m_TimingLogPath);
+                if (ImGui::Button("Stop Logging"))
+                    m_pProfiler->StopLog();
+            }
+            if (ImGui::BeginPopup("Timing Log Error"))
+            {
+                ImGui::Text("Cannot open %s", m_TimingLogPath);
+                ImGui::EndPopup();
+            }
+        }
+        ImGui::End();
     }
 
 
@@ -4,34 +4,103 @@
 #include "BasicMath.hpp"
 #include "FirstPersonCamera.hpp"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "CPU/CPUFractalRenderer.hpp"
+#include "CPU/CPUIterationBudget.hpp"
+#include "CPU/CPUParameterSweep.hpp"
+#include "CPU/CPUPerturbation.hpp"
+#include "CPU/CPUTileCache.hpp"
+#include "ComputeGroupTuner.hpp"
+#include "DynamicResolution.hpp"
+#include "Export/FrameWriter.hpp"
+#include "Export/PosterWriter.hpp"
+#include "FractalPSOCache.hpp"
+#include "FrameProfiler.hpp"
+
 namespace Diligent
 {
 
     class FractalViewer final : public SampleBase
     {
     public:
+        ~FractalViewer() override;
+
+        virtual void ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
         virtual void Initialize(const SampleInitInfo& InitInfo) override final;
 
         virtual void Render() override final;
         virtual void Update(double CurrTime, double ElapsedTime, bool DoUpdateUI) override final;
+        virtual void WindowResize(Uint32 Width, Uint32 Height) override final;
 
         virtual const Char* GetSampleName() const override final { return "Tutorial02: Cube"; }
 
     protected:
 		virtual void UpdateUI() override final;
+        void UpdateTimingUI();
 
 
     private:
         void CreatePipelineState();
         void CreateVertexBuffer();
         void CreateComputePipelineState();
+        void CreateScaledTargets(Uint32 Level);
+        void SetRenderScale(Uint32 Level);
+        void PrewarmPermutations();
         void CreateQuadPipelineState();
+        void CreateColorizePipelineState();
+        void CreateSubdividePipelineState();
+        void RenderSubdivisionGPU();
+        void CreateConePrepassPipelineState();
+        void RenderConePrepassGPU();
+        void CreateReprojectPipelineState();
+        void RenderReprojectGPU();
+        void CreateDistanceBrickTextures();
+        void BindDistanceBricks(IShaderResourceBinding* pSRB);
+        void ReadSubdivisionStats();
+        void CreateAdaptiveAAPipelineState();
+        bool IsAdaptiveAAActive() const;
+        void RenderAdaptiveAAGPU(const float4* pColorKey);
+        void ReadAdaptiveAAStats();
+        void BeginExport();
+        void CaptureExportFrame();
+        void ReadExportFrames(Uint32 MinFramesRead);
+        void EndExport();
+        void BeginPoster(const CPUShaderConstants& Constants);
+        void RenderPosterTile();
+        void CreateSweepPipelineState();
+        void RenderSweep(const CPUShaderConstants& Base);
+        void UpdateSweepUI();
+        void CreateIterStatsPipelineState();
+        void RenderIterStatsGPU(ITexture* pEscapeTex);
+        void ReadIterStats();
+        void ApplyIterationBudget(const CPUEscapeStats& Stats);
 		void CreateIndexBuffer();
+        void RenderCPU(const CPUShaderConstants& Constants, const int2* pPanShift);
+        void BindComputeTargets(IShaderResourceBinding* pSRB);
+        void SetDispatchRegion(const Rect& Region);
+        void DispatchComputeRegion(const FractalPSO& PSO, const Rect& Region);
+        void DrawOutputTexture();
+        void CreateReferenceOrbitBuffer(Uint32 NumElements);
+        bool IsDeepZoomActive() const;
+        bool UsesCPUDeepZoom() const;
+        CPUDeepZoomView GetDeepZoomView() const;
+        void DrawFullscreenQuad(IPipelineState* pPSO, IShaderResourceBinding* pSRB);
+        bool CreateProgressiveTargets();
+        void RenderFractalPass(ITexture* pTarget, const float4& RefineParams, const Rect* pScissor = nullptr);
+        IShaderResourceBinding* RenderProgressive(bool Redraw, const int2* pPanShift);
+        ComputeGroupTuner::GroupSize GetComputeGroupSize(bool Is3D) const;
+        void TuneComputeGroupSize();
 
         enum class RenderMode
         {
             PixelShader = 0,
-            ComputeShader
+            ComputeShader,
+            CPU
         };
 
         struct ShaderConstants
@@ -64,16 +133,125 @@ namespace Diligent
 
             // Para efectos de tiempo, movimiento o animaciones
             float4 AnimationParams;    // x = velocidad X, y = velocidad Y, z = deformacin, w = seed o fase
+
+            // Parte baja de ZoomOffset.xyz (el valor es ZoomOffset + ZoomOffsetLo): la precisin
+            // double y double-float de los kernels 2D la necesitan para pasar de ~1e-7
+            float4 ZoomOffsetLo;
+        };
+
+        // Segundo cbuffer del pixel shader para el deep zoom por perturbaciones
+        struct PerturbationConstants
+        {
+            float4 PerturbParams;      // x = activo, y = ltimo ndice de la referencia, z = iteracin inicial (serie), w = 1/zoom
+            float4 SeriesAB;           // xy = A', zw = B' (divididos por 2^PerturbScale.z)
+            float4 SeriesC;            // xy = C' (dividido por 2^PerturbScale.z), z = escala de u (u = uv * z)
+            float4 PerturbScale;       // x = mantisa de 1/zoom, y = su exponente, z = exponente de la serie (CPUScaledDeltaParams)
+        };
+
+        // Tercer cbuffer del compute 3D: cmara del frame anterior para la reproyeccin (fractalTemporal.fxh)
+        struct TemporalConstants
+        {
+            float4 PrevRayOrigin;      // xyz = origen de los rayos del frame anterior
+            float4 PrevCameraDirX;
+            float4 PrevCameraDirY;
+            float4 PrevCameraDirZ;
+            float4 TemporalParams;     // x = historia vlida, y = peso del color anterior, z = margen, w = tolerancia de profundidad
+        };
+
+        PerturbationConstants PreparePerturbationGPU(const CPUShaderConstants& Constants);
+        // Cuarto cbuffer del compute 3D (y de la prepasada de cono): cache de distancias (fractalBricks.fxh)
+        struct BrickConstants
+        {
+            float4 BrickDomain;        // xyz = esquina mnima del dominio, w = tamao de celda
+            float4 BrickParams;        // x = activo, y = celdas por eje, z = vxeles por brick, w = distancia de vuelta al DE
+            uint4  BrickAtlas;         // xy = bricks por eje del atlas
+        };
+
+        TemporalConstants PrepareTemporalGPU(const ShaderConstants& Constants) const;
+        void UpdateTemporalHistory(const ShaderConstants& Constants);
+        void UpdateDistanceBricks(const ShaderConstants& Constants);
+        ShaderConstants GetFrameKey(const ShaderConstants& Constants) const;
+        bool HasFrameChanged(const ShaderConstants& Constants, const PerturbationConstants& PerturbData, int2& PanShift);
+        Uint32 SelectRenderScale(const ShaderConstants& Constants);
+        void SnapPanOffset(ShaderConstants& Constants) const;
+        void ShiftTexture(ITexture* pTexture, const int2& Shift);
+        static Uint32 GetPanStrips(const int2& Shift, Uint32 Width, Uint32 Height, Rect Strips[2]);
+
+        // Permutacin de los shaders del fractal (macros de fractal.psh / fractalCompute.psh)
+        struct FractalPermutation
+        {
+            static constexpr Uint32 ComputeBit = 1u << 8;
+
+            int  Type = -1;            // -1 = ubershader con switch en runtime
+            bool Is3D = false;
+            int  Precision = 0;        // CPU_PRECISION (solo 2D)
+            bool Perturbation = false;
+
+            // Tamao del grupo de hilos (solo compute; potencias de 2)
+            ComputeGroupTuner::GroupSize GroupSize;
+
+            Uint32 GetKey() const
+            {
+                auto Log2 = [](Uint32 v) { Uint32 l = 0; while (v > 1) { v >>= 1; ++l; } return l; };
+                return static_cast<Uint32>(Type + 1) | (Is3D ? 1u << 4 : 0u) | (Precision == CPU_PRECISION_DOUBLE ? 1u << 5 : 0u) | (Perturbation ? 1u << 6 : 0u) |
+                    (Precision == CPU_PRECISION_DOUBLE_FLOAT ? 1u << 7 : 0u) | (Log2(GroupSize.X) << 9) | (Log2(GroupSize.Y) << 13);
+            }
+
+            std::string GetName() const
+            {
+                if (Type < 0)
+                    return Is3D ? "(uber 3D)" : "(uber)";
+                return std::string{Is3D ? "3D " : "2D "} + std::to_string(Type) + (Perturbation ? " perturbation" : Precision == CPU_PRECISION_DOUBLE ? " double" : Precision == CPU_PRECISION_DOUBLE_FLOAT ? " double-float" : " float");
+            }
+        };
+
+        struct FractalPSO
+        {
+            RefCntAutoPtr<IPipelineState>         pPSO;
+            RefCntAutoPtr<IShaderResourceBinding> pSRB;
+            ComputeGroupTuner::GroupSize          GroupSize; // con el que se compil (compute)
         };
 
+        void CreateFractalPSO(const FractalPermutation& Permutation, FractalPSO& Out);
+        void CreateComputePSO(const FractalPermutation& Permutation, FractalPSO& Out);
+        FractalPermutation GetCurrentPermutation(bool Compute, bool Perturbation) const;
+        FractalPSO GetPermutationPSO(const FractalPermutation& Permutation, bool Compute);
+
         RenderMode m_RenderMode = RenderMode::PixelShader;
     
         RefCntAutoPtr<ITexture> m_pComputeOutputTex;
 
+        // Escala de render dinmica (compute y CPU): el fractal se calcula a una fraccin de la
+        // swap chain elegida por m_DynamicRes segn el tiempo de frame y el quad lo reescala a
+        // pantalla. Cada nivel tiene su juego de texturas del tamao de la salida, creado la
+        // primera vez que se usa; las del nivel activo son m_pComputeOutputTex, m_pEscapeTex...
+        // y se enlazan al despachar. Al cambiar el tamao de la ventana se sueltan todas. Con
+        // la escena quieta se vuelve a resolucin completa.
+        struct ScaledTargets
+        {
+            RefCntAutoPtr<ITexture> pOutput;
+            RefCntAutoPtr<ITexture> pEscape;
+            RefCntAutoPtr<ITexture> pHistoryDepth[2];
+            RefCntAutoPtr<ITexture> pReprojDepth;
+            RefCntAutoPtr<ITexture> pHistoryColor;
+            RefCntAutoPtr<ITexture> pConeDepth[2];
+            RefCntAutoPtr<ITexture> pAAOutput;
+            RefCntAutoPtr<ITexture> pSubdivState;
+        };
+        ScaledTargets     m_ScaledTargets[DynamicResolution::NumLevels];
+        Uint32            m_RenderScaleLevel = 0; // nivel de las texturas activas
+        DynamicResolution m_DynamicRes;
+        bool              m_DynamicResEnabled = true;
+        float             m_DynamicResBudgetMs = 1000.0f / 60.0f;
+        double            m_LastFrameMs = 0.0;    // tiempo de pared del ltimo Update, sin timestamps de la GPU
+
         RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pShaderSourceFactory;
         RefCntAutoPtr<IPipelineState>         m_pComputePSO;
         RefCntAutoPtr<IPipelineState>         m_pQuadPSO;
         RefCntAutoPtr<IPipelineState>         m_pPSO;
+        RefCntAutoPtr<IPipelineState>         m_pUpscalePSO;
+        RefCntAutoPtr<IPipelineState>         m_pPSO3D;
+        RefCntAutoPtr<IShaderResourceBinding> m_pSRB3D;
         RefCntAutoPtr<IShaderResourceBinding> m_pComputeSRB;
         RefCntAutoPtr<IShaderResourceBinding> m_pQuadSRB;
         RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
@@ -81,6 +259,22 @@ namespace Diligent
 		RefCntAutoPtr<IBuffer>                m_IndexBuffer;
         RefCntAutoPtr<IBuffer>                m_VSConstants;
         RefCntAutoPtr<IBuffer>                m_VSConstantsComputeShader;
+        RefCntAutoPtr<IBuffer>                m_PerturbationConstants;
+        RefCntAutoPtr<IBuffer>                m_ReferenceOrbitBuffer;
+        RefCntAutoPtr<IBuffer>                m_RefineConstants;
+
+        // Los fractales 2D se calculan en dos pasadas: bucle de escape a un buffer RG32F
+        // (x = i, y = |z|) y coloreado en colorize.psh. Colores, paleta y gamma solo
+        // repiten la segunda.
+        RefCntAutoPtr<ITexture>               m_pEscapeTex;      // salida del compute shader y del backend CPU
+        RefCntAutoPtr<IPipelineState>         m_pColorizePSO;
+        RefCntAutoPtr<IPipelineState>         m_pEscapeUpscalePSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pColorizeSRB;    // lee m_pEscapeTex
+        RefCntAutoPtr<IBuffer>                m_ColorizeConstants;
+        std::vector<CPUEscapeSample>          m_CPUEscape;
+        int                                   m_PaletteMode = 0; // 0 = la del fractal, 1 = degradado suave, 2 = coseno cclico
+        float                                 m_PaletteCycles = 4.0f;
+        float                                 m_PalettePhase = 0.0f;
         int    m_SelectedFractal2D = 0;      
         int    m_SelectedFractal3D = 0;          
         bool   first_timeUI = true;
@@ -91,14 +285,17 @@ namespace Diligent
         FirstPersonCamera m_Camera;              
         bool              m_is3D = false;
         bool m_usesComputePipeline = false;
-        float m_Zoom = 1.0f;   
-        float m_OffsetX = 0.0f, m_OffsetY = 0.0f, m_OffsetZ = 0.0f;
+        bool m_UseCPURenderer = false;
+        // Zoom y offset 2D en double: se pasan al shader como float + parte baja (ZoomOffsetLo)
+        double m_Zoom = 1.0;
+        double m_OffsetX = 0.0, m_OffsetY = 0.0;
+        float m_OffsetZ = 0.0f;
         float4 m_FractalColor = float4{ 1,1,1,1 }; 
         float4 m_BackgroundColor = float4{ 0,0,0,1 }; 
         float4 m_FractalC = float4{ 0,0,0,0 };
         int m_maxiter = 100; 
         float3 m_FractalParams1 = float3{ 2.0f, 2.0f, 0.0f };
-        float4 m_FractalParams2 = float4{ 1.0f, 0, 0, 0 };
+        float4 m_FractalParams2 = float4{ 1.0f, 1.0f, 0, 0 }; // x = gamma, y = salida anticipada del interior
         float4 m_Options3D = float4{ 0,0,0,0 };
         float4 m_AnimationParams = float4{ 1.0f,0,0,0 };
 
@@ -111,6 +308,226 @@ namespace Diligent
         bool  m_AutoZoomActive = false;
         float m_AutoZoomSpeed = 1.0f;
 
+        // Backend CPU (SIMD + multihilo); se crea al activarlo por primera vez
+        std::unique_ptr<CPUFractalRenderer> m_pCPURenderer;
+
+        // Cache de tiles 2D (solo backend CPU): se crea al activarlo, con el fichero en el
+        // directorio de trabajo. Mientras falten tiles se redibuja cada frame hasta completar la vista
+        bool                          m_TileCacheEnabled = false;
+        bool                          m_TileCachePending = false;
+        std::unique_ptr<CPUTileCache> m_pTileCache;
+
+        // Deep zoom por perturbaciones (solo 2D). El centro va en precisin arbitraria; el
+        // pixel shader itera delta en float con un exponente aparte (CPUScaledDeltaParams) hasta
+        // MaxGPUDeepZoom, el lmite prctico de delta en double, y a partir de ah se usa la CPU
+        static constexpr double MaxGPUDeepZoom = 1e290;
+        bool                                     m_DeepZoomEnabled = false;
+        BigFloat                                 m_DeepCenterX, m_DeepCenterY;
+        double                                   m_DeepZoom = 1.0;
+        std::unique_ptr<CPUPerturbationRenderer> m_pPerturbation;
+        std::vector<float2>                      m_ReferenceOrbitData;
+        Uint32                                   m_ReferenceOrbitCapacity = 0;
+        char                                     m_DeepCenterInput[2][256] = {};
+
+        // Refinamiento progresivo: mientras cambian los parmetros se pinta a 1/m_InteractionScale,
+        // luego se refina a resolucin completa en RefineGridSize^2 pasadas entrelazadas y, si
+        // nada cambia, no se vuelve a evaluar el fractal. En 2D las texturas guardan el buffer
+        // de escape y los SRB de los quads son del PSO de coloreado.
+        static constexpr Uint32 RefineGridSize = 4;
+        bool                                  m_ProgressiveEnabled = true;
+        Uint32                                m_InteractionScale = 4;
+        Uint32                                m_RefinePass = 0;
+        RefCntAutoPtr<ITexture>               m_pProgressiveTex;
+        RefCntAutoPtr<ITexture>               m_pPreviewTex;
+        RefCntAutoPtr<IShaderResourceBinding> m_pProgressiveQuadSRB;
+        RefCntAutoPtr<IShaderResourceBinding> m_pPreviewQuadSRB;
+        RefCntAutoPtr<IShaderResourceBinding> m_pPreviewUpscaleSRB;
+
+        // Un PSO por permutacin, compilados en segundo plano; m_pPSO (2D), m_pPSO3D y
+        // m_pComputePSO son los ubershaders que se usan mientras tanto
+        std::unique_ptr<FractalPSOCache> m_pPSOCache;
+        bool                             m_UsePermutations = true;
+        std::mutex                       m_PermutationsMtx;
+        std::map<Uint32, FractalPSO>     m_PermutationPSOs;
+        std::set<Uint32>                 m_PendingPermutations;
+        FractalPSO                       m_CurrentFractalPSO;
+
+        // Autoajuste del tamao de grupo del compute shader: se mide un candidato por frame y
+        // el ganador se guarda por adaptador, modo y resolucin
+        static constexpr Uint32 TuningDispatches = 8;
+        ComputeGroupTuner       m_GroupTuner{"FractalComputeTuning.txt"};
+        bool                    m_AutoTuneGroupSize = true;
+
+        // Paneo incremental (2D): si entre dos frames solo cambia el offset, el offset que se
+        // usa se ajusta a pxeles enteros, la imagen anterior se desplaza y solo se calculan
+        // las franjas que quedan al descubierto
+        bool                    m_PanReuseEnabled = true;
+        RefCntAutoPtr<ITexture> m_pPanScratchTex;
+        RefCntAutoPtr<IBuffer>  m_DispatchConstants;
+        float                   m_LastPanReuse = 0.0f; // fraccin de pxeles reutilizados en el ltimo paneo
+
+        // Relleno por subdivisin (Mariani-Silver) en 2D: en CPU con RenderEscapeSubdivided2D y
+        // en compute con fractalSubdivide.psh, una pasada por tamao de tile. Los contadores de
+        // la GPU se leen un frame despus, cuando la fence dice que la copia ha terminado.
+        bool                                  m_SubdivisionEnabled = false;
+        RefCntAutoPtr<IPipelineState>         m_pSubdividePSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pSubdivideSRB;
+        RefCntAutoPtr<IBuffer>                m_SubdivideConstants;
+        RefCntAutoPtr<ITexture>               m_pSubdivStateTex;
+        RefCntAutoPtr<IBuffer>                m_pSubdivCounters;
+        RefCntAutoPtr<IBuffer>                m_pSubdivReadback;
+        RefCntAutoPtr<IFence>                 m_pSubdivFence;
+        Uint64                                m_SubdivFenceValue = 0;
+        bool                                  m_SubdivReadbackPending = false;
+        Uint64                                m_SubdivSkipped = 0;   // pxeles rellenados sin iterar en el ltimo frame medido
+        Uint64                                m_SubdivEvaluated = 0; // pxeles iterados (en GPU cuenta los bordes repetidos)
+
+        // Prepasada de profundidad en 3D (compute): fractalConeMarch.psh marcha un cono por tile
+        // de 8 y luego de 4 pxeles, y el compute empieza cada rayo desde la distancia de su
+        // tile de 4. m_ConeStartTileSize va a DispatchConstants (0 = sin prepasada).
+        static constexpr Uint32               ConeTileSizes[2] = { CPUFractalRenderer::ConeMaxTileSize, CPUFractalRenderer::ConeMinTileSize };
+        bool                                  m_ConePrepassEnabled = true;
+        RefCntAutoPtr<IPipelineState>         m_pConePrepassPSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pConePrepassSRB[2];
+        RefCntAutoPtr<IBuffer>                m_ConeConstants;
+        RefCntAutoPtr<ITexture>               m_pConeDepthTex[2];
+        Uint32                                m_ConeStartTileSize = 0;
+
+        // Reproyeccin temporal en 3D (compute): el compute guarda la profundidad de impacto de
+        // cada pxel y se copia su color. Mientras la historia valga (IsTemporalHistoryCompatible3D:
+        // solo se ha movido la cmara), fractalReproject.psh proyecta esos impactos con la cmara
+        // nueva, cada rayo empieza desde la profundidad que cae en su pxel y el color se mezcla
+        // con el anterior con peso m_TemporalBlend. Las profundidades van en ping-pong.
+        bool                                  m_TemporalEnabled = true;
+        float                                 m_TemporalBlend = 0.3f;
+        RefCntAutoPtr<IPipelineState>         m_pReprojectClearPSO;
+        RefCntAutoPtr<IPipelineState>         m_pReprojectScatterPSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pReprojectClearSRB;
+        RefCntAutoPtr<IShaderResourceBinding> m_pReprojectScatterSRB;
+        RefCntAutoPtr<IBuffer>                m_TemporalConstants;
+        RefCntAutoPtr<ITexture>               m_pHistoryDepthTex[2];
+        RefCntAutoPtr<ITexture>               m_pHistoryColorTex;
+        RefCntAutoPtr<ITexture>               m_pReprojDepthTex;
+        Uint32                                m_HistoryDepthIndex = 0; // la que escribe el frame actual
+        bool                                  m_HistoryValid = false;
+        ShaderConstants                       m_HistoryConstants = {};
+        TemporalConstants                     m_TemporalData = {};    // las del frame actual
+
+        // Cache de distancias horneado para el 3D esttico en compute: el Menger, o el Mandelbulb
+        // con la potencia fija o en pausa. Al cambiar la escena se clasifican las celdas y cada
+        // frame se hornean hasta m_BrickBakeBudget bricks de la banda estrecha, los ms cercanos
+        // a la cmara, con el pool del renderizador CPU; se suben al atlas 3D al terminar cada uno.
+        bool                                  m_BricksEnabled = false;
+        bool                                  m_BricksActive = false; // se usa en este frame
+        int                                   m_BrickBakeBudget = 256;
+        CPUDistanceBrickSettings              m_BrickSettings;
+        CPUDistanceBrickCache                 m_DistanceBricks;
+        RefCntAutoPtr<IBuffer>                m_BrickConstants;
+        RefCntAutoPtr<ITexture>               m_pBrickCellTex;
+        RefCntAutoPtr<ITexture>               m_pBrickAtlasTex;
+        uint4                                 m_BrickAtlasBricks = {}; // bricks por eje del atlas
+
+        // Supersampling adaptativo en compute (fractalAdaptiveAA.psh): despus del fractal,
+        // los pxeles con mucha variacin en su vecindad reciben hasta m_AAMaxSamples muestras
+        // ms y la imagen final queda en m_pAAOutputTex. En 2D ya va coloreada, as que se
+        // repite si cambia el coloreado (m_AAColorKey) aunque el fractal no se recalcule.
+        bool                                  m_AAEnabled = false;
+        int                                   m_AAMaxSamples = 4;
+        float                                 m_AAThreshold = CPUFractalRenderer::DefaultAAThreshold;
+        bool                                  m_AAOutputValid = false; // m_pAAOutputTex tiene el ltimo frame
+        float4                                m_AAColorKey[4] = {};    // paleta, colores y gamma con los que se hizo
+        RefCntAutoPtr<IPipelineState>         m_pAdaptiveAAPSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pAdaptiveAASRB;
+        RefCntAutoPtr<IBuffer>                m_AAConstants;
+        RefCntAutoPtr<ITexture>               m_pAAOutputTex;
+        RefCntAutoPtr<IBuffer>                m_pAACounters;
+        RefCntAutoPtr<IBuffer>                m_pAAReadback;
+        RefCntAutoPtr<IFence>                 m_pAAFence;
+        Uint64                                m_AAFenceValue = 0;
+        bool                                  m_AAReadbackPending = false;
+        Uint64                                m_AARefinedPixels = 0; // pxeles con muestras extra en el ltimo frame medido
+        Uint64                                m_AAExtraSamples = 0;
+
+        // Exportacin de animaciones: el tiempo y el zoom avanzan 1/m_ExportFPS por frame y cada
+        // frame (el backbuffer antes de la UI) se copia a un anillo de texturas staging que se
+        // lee ExportRingSize frames despus; FrameWriter escribe en disco en su propio hilo
+        static constexpr Uint32               ExportRingSize = 4;
+        bool                                  m_Exporting = false;
+        char                                  m_ExportPath[256] = "fractal_export";
+        int                                   m_ExportFormat = 0; // FrameFormat
+        int                                   m_ExportFPS = 30;
+        int                                   m_ExportFrames = 300;
+        Uint32                                m_ExportSubmitted = 0;
+        Uint32                                m_ExportRead = 0;
+        bool                                  m_ExportSwapRB = false;
+        bool                                  m_ExportSavedProgressive = true;
+        RefCntAutoPtr<ITexture>               m_ExportStaging[ExportRingSize];
+        RefCntAutoPtr<IFence>                 m_pExportFence;
+        std::unique_ptr<FrameWriter>          m_pFrameWriter;
+        std::string                           m_ExportStatus;
+
+        // Psters de tamao arbitrario con el backend CPU: la vista del frame en que se pulsa
+        // Start con la resolucin del pster, una tile por frame a un BigTIFF (PosterWriter).
+        // Si se interrumpe, otro Start con la misma vista y tamao contina donde se qued.
+        bool                                  m_PosterRequested = false;
+        char                                  m_PosterPath[256] = "fractal_poster.tif";
+        int                                   m_PosterSize[2] = { 16384, 16384 };
+        int                                   m_PosterTileSize = 512;
+        CPUShaderConstants                    m_PosterConstants = {};
+        std::unique_ptr<PosterWriter>         m_pPosterWriter;
+        Uint32                                m_PosterNextTile = 0;
+        std::string                           m_PosterStatus;
+
+        // Barrido de parmetros: la vista con un parmetro recorriendo un rango
+        // (CPUParameterSweep.hpp), una miniatura por valor en un atlas que se ve en la ventana
+        // "Parameter Sweep". Fuera del backend CPU sale de un solo dispatch de fractalSweep.psh,
+        // que lee las constantes de cada miniatura de m_SweepConstants (estructurado); con l,
+        // de CPUFractalRenderer::RenderSweep. El tiempo es de pared hasta la fence.
+        bool                                  m_SweepRequested = false;
+        CPUSweepSettings                      m_SweepSettings;
+        std::vector<CPUShaderConstants>       m_SweepSlices;
+        RefCntAutoPtr<IPipelineState>         m_pSweepPSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pSweepSRB;
+        RefCntAutoPtr<IBuffer>                m_SweepDispatchConstants;
+        RefCntAutoPtr<IBuffer>                m_SweepConstants;
+        Uint32                                m_SweepCapacity = 0; // miniaturas que caben en m_SweepConstants
+        RefCntAutoPtr<ITexture>               m_pSweepAtlasTex;
+        RefCntAutoPtr<IFence>                 m_pSweepFence;
+        Uint64                                m_SweepFenceValue = 0;
+        std::string                           m_SweepStatus;
+
+        // Presupuesto automtico de iteraciones en 2D (CPUIterationBudget.hpp): despus de cada
+        // frame completo fractalIterStats.psh reduce el buffer de escape a un histograma que se
+        // lee sin esperar a la GPU, o AccumulateEscapeStats lo calcula en el backend CPU, y
+        // ChooseIterationBudget cambia m_maxiter para el frame siguiente. Las estadsticas de un
+        // maxiter que ya no es el actual solo se muestran.
+        bool                                  m_AutoIterEnabled = false;
+        CPUIterationBudgetSettings            m_IterBudgetSettings;
+        CPUEscapeStats                        m_IterStats; // las del ltimo frame medido
+        RefCntAutoPtr<IPipelineState>         m_pIterStatsPSO;
+        RefCntAutoPtr<IShaderResourceBinding> m_pIterStatsSRB;
+        RefCntAutoPtr<IBuffer>                m_IterStatsConstants;
+        RefCntAutoPtr<IBuffer>                m_pIterStatsCounters;
+        RefCntAutoPtr<IBuffer>                m_pIterStatsReadback;
+        RefCntAutoPtr<IFence>                 m_pIterStatsFence;
+        Uint64                                m_IterStatsFenceValue = 0;
+        bool                                  m_IterStatsReadbackPending = false;
+        CPUEscapeStats                        m_IterStatsPendingFrame; // pxeles y maxiter de la copia pendiente
+
+        // Tiempos por etapa de Render() (ventana "Frame Timing") y registro opcional por frame
+        std::unique_ptr<FrameProfiler> m_pProfiler;
+        char                           m_TimingLogPath[256] = "frame_timings.csv";
+        int                            m_TimingLogFormat = 0; // 0 = CSV, 1 = JSON (una lnea por frame)
+
+        // Estado del ltimo frame evaluado, para detectar cambios
+        bool                  m_HasLastFrame = false;
+        RenderMode            m_LastFrameMode = RenderMode::PixelShader;
+        ShaderConstants       m_LastFrameKey = {};
+        PerturbationConstants m_LastPerturbData = {};
+        bool                  m_LastFrameDeepZoom = false;
+        double                m_LastDeepZoom = 0.0;
+        BigFloat              m_LastDeepCenterX, m_LastDeepCenterY;
+
 
     };
 
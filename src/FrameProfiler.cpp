@@ -0,0 +1,168 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+
+namespace Diligent
+{
+
+    FrameProfiler::FrameProfiler(IRenderDevice* pDevice)
+    {
+        // Los resultados de la GPU llegan unos frames tarde: se reservan consultas para 8 en vuelo
+        if (pDevice->GetDeviceInfo().Features.TimestampQueries)
+        {
+            for (auto& pQuery : m_GPUQueries)
+                pQuery.reset(new DurationQueryHelper{pDevice, 8});
+        }
+        m_FrameCPUMs.fill(-1.0);
+        m_FrameGPUMs.fill(-1.0);
+    }
+
+    FrameProfiler::~FrameProfiler()
+    {
+        StopLog();
+    }
+
+    const char* FrameProfiler::GetStageName(STAGE Stage)
+    {
+        static const char* Names[STAGE_COUNT] = {"upload", "fractal", "transition", "present"};
+        return Stage < STAGE_COUNT ? Names[Stage] : "?";
+    }
+
+    void FrameProfiler::BeginFrame(const char* ModeName)
+    {
+        m_ModeName = ModeName;
+        m_FrameCPUMs.fill(-1.0);
+        m_FrameGPUMs.fill(-1.0);
+        m_FrameStart = Clock::now();
+    }
+
+    void FrameProfiler::EndFrame()
+    {
+        m_FrameTotalMs = std::chrono::duration<double, std::milli>(Clock::now() - m_FrameStart).count();
+        PushSample(m_FrameWindow, m_FrameNext, m_FrameTotalMs);
+        if (m_pLogFile != nullptr)
+            WriteRecord();
+        ++m_FrameIndex;
+    }
+
+    void FrameProfiler::BeginStage(IDeviceContext* pContext, STAGE Stage)
+    {
+        if (m_GPUQueries[Stage])
+            m_GPUQueries[Stage]->Begin(pContext);
+        m_CPUStart[Stage] = Clock::now();
+    }
+
+    void FrameProfiler::EndStage(IDeviceContext* pContext, STAGE Stage)
+    {
+        const double CPUMs = std::chrono::duration<double, std::milli>(Clock::now() - m_CPUStart[Stage]).count();
+        m_FrameCPUMs[Stage] = CPUMs;
+        PushSample(m_CPUWindow[Stage], m_CPUNext[Stage], CPUMs);
+
+        // End devuelve la duración de una medida anterior de esta etapa, si ya está lista
+        double Seconds = 0;
+        if (m_GPUQueries[Stage] && m_GPUQueries[Stage]->End(pContext, Seconds))
+        {
+            m_FrameGPUMs[Stage] = Seconds * 1e3;
+            PushSample(m_GPUWindow[Stage], m_GPUNext[Stage], Seconds * 1e3);
+        }
+    }
+
+    void FrameProfiler::PushSample(std::vector<double>& Window, Uint32& Next, double Value)
+    {
+        if (Window.size() < WindowSize)
+            Window.push_back(Value);
+        else
+            Window[Next] = Value;
+        Next = (Next + 1) % WindowSize;
+    }
+
+    FrameProfiler::Stats FrameProfiler::ComputeStats(const std::vector<double>& Window)
+    {
+        Stats S;
+        S.NumSamples = static_cast<Uint32>(Window.size());
+        if (Window.empty())
+            return S;
+
+        std::vector<double> Sorted = Window;
+        std::sort(Sorted.begin(), Sorted.end());
+        auto Percentile = [&](double p) { return Sorted[std::min(Sorted.size() - 1, static_cast<size_t>(p * (Sorted.size() - 1) + 0.5))]; };
+
+        double Sum = 0;
+        for (double v : Sorted)
+            Sum += v;
+        S.AvgMs = Sum / Sorted.size();
+        S.P50Ms = Percentile(0.50);
+        S.P95Ms = Percentile(0.95);
+        S.P99Ms = Percentile(0.99);
+        return S;
+    }
+
+    bool FrameProfiler::StartLog(const std::string& Path, LogFormat Format)
+    {
+        StopLog();
+        m_pLogFile = std::fopen(Path.c_str(), "w");
+        if (m_pLogFile == nullptr)
+            return false;
+
+        m_LogFormat = Format;
+        if (m_LogFormat == LogFormat::CSV)
+        {
+            std::fprintf(m_pLogFile, "frame,mode,total_ms");
+            for (Uint32 s = 0; s < STAGE_COUNT; ++s)
+                std::fprintf(m_pLogFile, ",%s_cpu_ms,%s_gpu_ms", GetStageName(static_cast<STAGE>(s)), GetStageName(static_cast<STAGE>(s)));
+            std::fprintf(m_pLogFile, "\n");
+        }
+        return true;
+    }
+
+    void FrameProfiler::StopLog()
+    {
+        if (m_pLogFile != nullptr)
+        {
+            std::fclose(m_pLogFile);
+            m_pLogFile = nullptr;
+        }
+    }
+
+    void FrameProfiler::WriteRecord()
+    {
+        // Las etapas sin valor quedan vacías en CSV y como null en JSON. El tiempo de GPU es
+        // el último que ha llegado en este frame, de un frame anterior.
+        if (m_LogFormat == LogFormat::CSV)
+        {
+            std::fprintf(m_pLogFile, "%llu,%s,%.4f", static_cast<unsigned long long>(m_FrameIndex), m_ModeName, m_FrameTotalMs);
+            for (Uint32 s = 0; s < STAGE_COUNT; ++s)
+            {
+                for (double v : {m_FrameCPUMs[s], m_FrameGPUMs[s]})
+                {
+                    if (v >= 0)
+                        std::fprintf(m_pLogFile, ",%.4f", v);
+                    else
+                        std::fprintf(m_pLogFile, ",");
+                }
+            }
+            std::fprintf(m_pLogFile, "\n");
+            return;
+        }
+
+        std::fprintf(m_pLogFile, "{\"frame\":%llu,\"mode\":\"%s\",\"total_ms\":%.4f", static_cast<unsigned long long>(m_FrameIndex), m_ModeName,
+                     m_FrameTotalMs);
+        const char* Keys[] = {"cpu_ms", "gpu_ms"};
+        for (int k = 0; k < 2; ++k)
+        {
+            std::fprintf(m_pLogFile, ",\"%s\":{", Keys[k]);
+            for (Uint32 s = 0; s < STAGE_COUNT; ++s)
+            {
+                const double v = k == 0 ? m_FrameCPUMs[s] : m_FrameGPUMs[s];
+                std::fprintf(m_pLogFile, s == 0 ? "\"%s\":" : ",\"%s\":", GetStageName(static_cast<STAGE>(s)));
+                if (v >= 0)
+                    std::fprintf(m_pLogFile, "%.4f", v);
+                else
+                    std::fprintf(m_pLogFile, "null");
+            }
+            std::fprintf(m_pLogFile, "}");
+        }
+        std::fprintf(m_pLogFile, "}\n");
+    }
+
+} // namespace Diligent
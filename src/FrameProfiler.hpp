@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "DurationQueryHelper.hpp"
+
+namespace Diligent
+{
+
+    // Tiempos por etapa de FractalViewer::Render: CPU con std::chrono y GPU con
+    // DurationQueryHelper (timestamps; sin soporte del dispositivo solo se mide la CPU).
+    // Guarda una ventana de los últimos frames para medias y percentiles y, si se pide,
+    // escribe un registro por frame en CSV o JSON (una línea por frame).
+    class FrameProfiler
+    {
+    public:
+        enum STAGE : Uint32
+        {
+            STAGE_UPLOAD = 0,  // constantes, perturbación
+            STAGE_FRACTAL,     // pasada del fractal (PS, dispatch o CPU + subida)
+            STAGE_TRANSITION,  // barrera UAV -> SRV del compute
+            STAGE_PRESENT,     // quad a pantalla (coloreado en 2D, supersampling adaptativo)
+            STAGE_COUNT
+        };
+
+        enum class LogFormat
+        {
+            CSV,
+            JSON
+        };
+
+        struct Stats
+        {
+            double AvgMs = 0;
+            double P50Ms = 0;
+            double P95Ms = 0;
+            double P99Ms = 0;
+            Uint32 NumSamples = 0;
+        };
+
+        static constexpr Uint32 WindowSize = 240;
+
+        explicit FrameProfiler(IRenderDevice* pDevice);
+        ~FrameProfiler();
+
+        static const char* GetStageName(STAGE Stage);
+
+        bool HasGPUTimings() const { return m_GPUQueries[0] != nullptr; }
+
+        void BeginFrame(const char* ModeName);
+        void EndFrame();
+
+        void BeginStage(IDeviceContext* pContext, STAGE Stage);
+        void EndStage(IDeviceContext* pContext, STAGE Stage);
+
+        // Mide una etapa dentro de un ámbito
+        class ScopedStage
+        {
+        public:
+            ScopedStage(FrameProfiler& Profiler, IDeviceContext* pContext, STAGE Stage) :
+                m_Profiler{Profiler}, m_pContext{pContext}, m_Stage{Stage}
+            {
+                m_Profiler.BeginStage(m_pContext, m_Stage);
+            }
+            ~ScopedStage() { m_Profiler.EndStage(m_pContext, m_Stage); }
+
+        private:
+            FrameProfiler&  m_Profiler;
+            IDeviceContext* m_pContext;
+            STAGE           m_Stage;
+        };
+
+        // Tiempos del último frame medido (-1 = la etapa no corrió; los de la GPU llegan unos
+        // frames tarde)
+        double GetLastCPUMs(STAGE Stage) const { return m_FrameCPUMs[Stage]; }
+        double GetLastGPUMs(STAGE Stage) const { return m_FrameGPUMs[Stage]; }
+
+        Stats GetCPUStats(STAGE Stage) const { return ComputeStats(m_CPUWindow[Stage]); }
+        Stats GetGPUStats(STAGE Stage) const { return ComputeStats(m_GPUWindow[Stage]); }
+        Stats GetFrameStats() const { return ComputeStats(m_FrameWindow); }
+
+        bool StartLog(const std::string& Path, LogFormat Format);
+        void StopLog();
+        bool IsLogging() const { return m_pLogFile != nullptr; }
+
+    private:
+        static Stats ComputeStats(const std::vector<double>& Window);
+        static void  PushSample(std::vector<double>& Window, Uint32& Next, double Value);
+        void         WriteRecord();
+
+        using Clock = std::chrono::steady_clock;
+
+        std::array<std::unique_ptr<DurationQueryHelper>, STAGE_COUNT> m_GPUQueries;
+        std::array<Clock::time_point, STAGE_COUNT>                    m_CPUStart;
+        Clock::time_point                                             m_FrameStart;
+
+        // Valores de este frame (-1 = la etapa no se ejecutó o el resultado de la GPU aún no llegó)
+        std::array<double, STAGE_COUNT> m_FrameCPUMs;
+        std::array<double, STAGE_COUNT> m_FrameGPUMs;
+        double                          m_FrameTotalMs = 0;
+        const char*                     m_ModeName = "";
+        Uint64                          m_FrameIndex = 0;
+
+        std::array<std::vector<double>, STAGE_COUNT> m_CPUWindow;
+        std::array<std::vector<double>, STAGE_COUNT> m_GPUWindow;
+        std::array<Uint32, STAGE_COUNT>              m_CPUNext = {};
+        std::array<Uint32, STAGE_COUNT>              m_GPUNext = {};
+        std::vector<double>                          m_FrameWindow;
+        Uint32                                       m_FrameNext = 0;
+
+        std::FILE* m_pLogFile = nullptr;
+        LogFormat  m_LogFormat = LogFormat::CSV;
+    };
+
+} // namespace Diligent
@@ -0,0 +1,706 @@
+// Benchmark determinista del backend CPU: recorre un catálogo fijo de escenas (cada tipo 2D
+// en float, double y double-float, zoom normal y profundo, y Mandelbulb / Menger con
+// cámaras y tiempo fijos, barridos de parámetros en un atlas de miniaturas y vistas montadas
+// con el cache de tiles), mide Mpixel/s, iteraciones/s y evaluaciones de distancia por rayo, y compara un
+// checksum de cada imagen con los valores de referencia de FractalBenchGolden.txt.
+// Devuelve 1 si alguna escena no coincide, para que los fallos de corrección también paren
+// la integración continua.
+//
+//   fractal_bench [--golden path] [--update-golden] [--repeat N] [--threads N] [--filter text] [--list]
+//
+// Los checksums dependen de la libm (sin, pow, log...): la referencia se generó con GCC en
+// Linux x86-64. Tras un cambio intencionado del resultado se regenera con --update-golden.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../CPU/CPUParameterSweep.hpp"
+#include "../CPU/CPUPerturbation.hpp"
+#include "../CPU/CPUTileCache.hpp"
+
+#ifndef FRACTAL_BENCH_GOLDEN
+#    define FRACTAL_BENCH_GOLDEN "FractalBenchGolden.txt"
+#endif
+
+using namespace Diligent;
+
+namespace
+{
+    enum class SceneKind
+    {
+        Fractal2D,    // CPUFractalRenderer::Render2D
+        Perturbation, // CPUPerturbationRenderer (deep zoom)
+        Fractal3D,    // CPUFractalRenderer::Render3D
+        Sweep,        // CPUFractalRenderer::RenderSweep: Width x Height es el atlas entero
+        TileCache     // CPUTileCache::Render (solo memoria)
+    };
+
+    // Estado del cache de tiles antes de la vista medida
+    enum class TileWarmup
+    {
+        Cold,  // cache vacío en cada ejecución: se calculan todas las tiles
+        Same,  // la misma vista ya montada: todo sale del LRU
+        Panned // la vista desplazada TilePanPixels ya montada: solo se calculan las tiles nuevas
+    };
+
+    struct BenchScene
+    {
+        std::string   Name;
+        SceneKind     Kind      = SceneKind::Fractal2D;
+        int           Type      = 0;
+        std::uint32_t Width     = 320;
+        std::uint32_t Height    = 240;
+        int           MaxIter   = 256;
+        int           Precision = CPU_PRECISION_FLOAT;
+        double        Zoom      = 1.0;
+        float         OffsetX   = 0.0f;
+        float         OffsetY   = 0.0f;
+        float         Time      = 0.0f;
+        const char*   CenterX   = nullptr;
+        const char*   CenterY   = nullptr;
+        bool          ConePrepass = false;
+        bool          Temporal    = false; // Render3D con la historia de un frame anterior con la cámara desplazada
+        bool          Bricks      = false; // Render3D con el cache de distancias horneado entero (sin medir el horneado)
+        std::uint32_t AASamples   = 0;     // supersampling adaptativo: muestras extra máximas por píxel (0 = sin él)
+        bool          EarlyOut    = false; // FractalParams2.y: salida anticipada del interior 2D
+        bool          Packets     = false; // Render3D con la marcha por paquetes SIMD (RenderPacket3D)
+        TileWarmup    Warmup      = TileWarmup::Cold;
+
+        // Cámara 3D: posición, guiñada y cabeceo en grados
+        CPUFloat3 CameraPos = {0.0f, 0.0f, -4.0f};
+        float     Yaw       = 0.0f;
+        float     Pitch     = 0.0f;
+        float     BulbPower = 0.0f; // Options3D.w: potencia fija del Mandelbulb (0 = animada)
+
+        // Barrido: miniaturas de Width / SweepColumns x Height / SweepRows
+        CPUSweepSettings Sweep;
+    };
+
+    struct BenchOptions
+    {
+        std::string   GoldenPath   = FRACTAL_BENCH_GOLDEN;
+        bool          UpdateGolden = false;
+        bool          ListOnly     = false;
+        std::uint32_t Repeat       = 3;
+        std::uint32_t NumThreads   = 0;
+        std::string   Filter;
+    };
+
+    std::vector<BenchScene> MakeCatalogue()
+    {
+        static const char* TypeNames[CPU_FRACTAL_2D_COUNT] = {"mandelbrot", "mandelbrot_colors", "burning_ship", "burning_ship_colors", "julia_dragons"};
+
+        // Zona con detalle a zoom 2e4 (todavía dentro de la precisión de float) por tipo
+        struct DeepSpot
+        {
+            float X, Y;
+        };
+        static const DeepSpot DeepSpots[CPU_FRACTAL_2D_COUNT] = {
+            {-0.7436439f, 0.1318259f},
+            {-0.7436439f, 0.1318259f},
+            {-1.7619f, -0.0283f},
+            {-1.7619f, -0.0283f},
+            {0.3402865f, 0.1052630f}};
+
+        std::vector<BenchScene> Scenes;
+        for (int Type = 0; Type < CPU_FRACTAL_2D_COUNT; ++Type)
+        {
+            for (int Precision = 0; Precision < CPU_PRECISION_COUNT; ++Precision)
+            {
+                static const char* PrecisionNames[CPU_PRECISION_COUNT] = {"_float", "_double", "_df"};
+                for (int Deep = 0; Deep < 2; ++Deep)
+                {
+                    BenchScene S;
+                    S.Name      = std::string{"2d_"} + TypeNames[Type] + PrecisionNames[Precision] + (Deep ? "_deep" : "_shallow");
+                    S.Type      = Type;
+                    S.Precision = Precision;
+                    S.Time      = 1.0f;
+                    if (Deep)
+                    {
+                        S.Zoom    = 2e4;
+                        S.MaxIter = 1000;
+                        S.OffsetX = DeepSpots[Type].X;
+                        S.OffsetY = DeepSpots[Type].Y;
+                    }
+                    else
+                    {
+                        S.OffsetX = Type == CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS ? 0.0f : -0.5f;
+                    }
+                    Scenes.push_back(S);
+                }
+            }
+        }
+
+        // Zoom 1e11, donde float ya no distingue píxeles: double frente a double-float en el
+        // mismo punto (centro con todas sus cifras, repartido en float + resto)
+        for (int Precision = CPU_PRECISION_DOUBLE; Precision < CPU_PRECISION_COUNT; ++Precision)
+        {
+            BenchScene S;
+            S.Name      = Precision == CPU_PRECISION_DOUBLE ? "2d_mandelbrot_double_1e11" : "2d_mandelbrot_df_1e11";
+            S.Type      = CPU_FRACTAL_2D_MANDELBROT_COLORS;
+            S.Precision = Precision;
+            S.Zoom      = 1e11;
+            S.MaxIter   = 3000;
+            S.CenterX   = "-0.743643887037158704752191506114774";
+            S.CenterY   = "0.131825904205311970493132056385139";
+            Scenes.push_back(S);
+        }
+
+        // Deep zoom por perturbaciones, más allá de lo que alcanza double
+        {
+            BenchScene S;
+            S.Name    = "deep_mandelbrot_1e12";
+            S.Kind    = SceneKind::Perturbation;
+            S.Type    = CPU_FRACTAL_2D_MANDELBROT_COLORS;
+            S.Zoom    = 1e12;
+            S.MaxIter = 4000;
+            S.CenterX = "-0.743643887037158704752191506114774";
+            S.CenterY = "0.131825904205311970493132056385139";
+            Scenes.push_back(S);
+
+            S.Name    = "deep_burning_ship_1e9";
+            S.Type    = CPU_FRACTAL_2D_BURNING_SHIP_COLORS;
+            S.Zoom    = 1e9;
+            S.MaxIter = 3000;
+            S.CenterX = "-1.75970006491318354";
+            S.CenterY = "-0.0203";
+            Scenes.push_back(S);
+        }
+
+        // 3D: poses de cada fractal, más pequeñas porque el ray marching va rayo a rayo
+        {
+            BenchScene S;
+            S.Kind    = SceneKind::Fractal3D;
+            S.Width   = 160;
+            S.Height  = 120;
+            S.Zoom    = 1.0;
+            S.MaxIter = 4;
+
+            S.Name = "3d_mandelbulb_front";
+            S.Type = CPU_FRACTAL_3D_MANDELBULB;
+            S.Time = 0.0f;
+            Scenes.push_back(S);
+
+            S.Name      = "3d_mandelbulb_oblique";
+            S.Time      = 2.0f;
+            S.CameraPos = {-1.6f, 1.2f, -2.8f};
+            S.Yaw       = 30.0f;
+            S.Pitch     = 20.0f;
+            Scenes.push_back(S);
+
+            // Potencia fija 8: kernel polinómico sin trigonometría
+            S.Name      = "3d_mandelbulb_power8";
+            S.BulbPower = 8.0f;
+            Scenes.push_back(S);
+
+            S.Name      = "3d_menger_front";
+            S.Type      = CPU_FRACTAL_3D_MENGER_SPONGE;
+            S.CameraPos = {0.1f, 0.2f, -2.5f};
+            S.Yaw       = 0.0f;
+            S.Pitch     = 0.0f;
+            S.BulbPower = 0.0f;
+            Scenes.push_back(S);
+
+            S.Name      = "3d_menger_oblique";
+            S.CameraPos = {0.3f, 0.2f, -2.5f};
+            S.Yaw       = 25.0f;
+            S.Pitch     = -15.0f;
+            Scenes.push_back(S);
+
+            // Mandelbox de escala 2 (FractalParams1.y) y Quaternion Julia con la c por defecto
+            S.Name      = "3d_mandelbox_front";
+            S.Type      = CPU_FRACTAL_3D_MANDELBOX;
+            S.CameraPos = {-2.82f, -2.05f, -4.88f};
+            S.Yaw       = 30.0f;
+            S.Pitch     = 20.0f;
+            Scenes.push_back(S);
+
+            S.Name      = "3d_quaternion_julia_front";
+            S.Type      = CPU_FRACTAL_3D_QUATERNION_JULIA;
+            S.CameraPos = {-0.99f, -0.78f, -2.72f};
+            S.Yaw       = 20.0f;
+            S.Pitch     = 15.0f;
+            Scenes.push_back(S);
+        }
+
+        // Las mismas escenas 3D con la prepasada de cono
+        const size_t Num3D = 7;
+        for (size_t i = Scenes.size() - Num3D, Count = Scenes.size(); i < Count; ++i)
+        {
+            BenchScene S  = Scenes[i];
+            S.Name        += "_cone";
+            S.ConePrepass = true;
+            Scenes.push_back(S);
+        }
+
+        // Cámara en movimiento: el frame medido reproyecta la historia del anterior, con la
+        // cámara PrevCameraStep más atrás y PrevYawStep grados girada. Solo potencia fija y
+        // Menger (con la potencia animada la historia no vale); 3d_mandelbulb_close es la
+        // referencia sin historia, con el Mandelbulb llenando casi toda la imagen.
+        {
+            auto FindScene = [&](const char* Name) {
+                return *std::find_if(Scenes.begin(), Scenes.end(), [&](const BenchScene& S) { return S.Name == Name; });
+            };
+
+            BenchScene S = FindScene("3d_mandelbulb_power8");
+            S.Name       = "3d_mandelbulb_close";
+            S.CameraPos  = {0.2f, 0.1f, -2.3f};
+            S.Yaw        = 5.0f;
+            S.Pitch      = 2.0f;
+            Scenes.push_back(S);
+
+            S.Name     += "_temporal";
+            S.Temporal = true;
+            Scenes.push_back(S);
+
+            S          = FindScene("3d_menger_oblique");
+            S.Name     += "_temporal";
+            S.Temporal = true;
+            Scenes.push_back(S);
+
+            // Cache de distancias: la marcha solo evalúa el DE cerca de la superficie
+            for (const char* Name : {"3d_mandelbulb_close", "3d_menger_front", "3d_menger_oblique"})
+            {
+                S        = FindScene(Name);
+                S.Name   += "_bricks";
+                S.Bricks = true;
+                Scenes.push_back(S);
+            }
+
+            // Supersampling adaptativo: solo los bordes reciben muestras extra
+            for (const char* Name : {"2d_mandelbrot_float_shallow", "2d_burning_ship_colors_float_deep", "3d_mandelbulb_front", "3d_menger_oblique"})
+            {
+                S           = FindScene(Name);
+                S.Name      += "_aa";
+                S.AASamples = 4;
+                Scenes.push_back(S);
+            }
+
+            // Marcha por paquetes SIMD: mismos rayos que las escenas rayo a rayo
+            for (const char* Name : {"3d_mandelbulb_front", "3d_mandelbulb_power8", "3d_menger_front", "3d_mandelbox_front", "3d_quaternion_julia_front"})
+            {
+                S         = FindScene(Name);
+                S.Name    += "_packets";
+                S.Packets = true;
+                Scenes.push_back(S);
+            }
+        }
+
+        // Vistas generales con mucho interior a maxiter 10000, sin y con la salida anticipada
+        // (cardioide / bulbo y detección de periodo)
+        {
+            struct InteriorView
+            {
+                int Type, Precision;
+            };
+            static const InteriorView InteriorViews[] = {
+                {CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_FLOAT},
+                {CPU_FRACTAL_2D_MANDELBROT, CPU_PRECISION_DOUBLE},
+                {CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_DOUBLE_FLOAT},
+                {CPU_FRACTAL_2D_BURNING_SHIP_COLORS, CPU_PRECISION_FLOAT},
+                {CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS, CPU_PRECISION_FLOAT}};
+            static const char* PrecisionNames[CPU_PRECISION_COUNT] = {"_float", "_double", "_df"};
+            for (const InteriorView& View : InteriorViews)
+            {
+                BenchScene S;
+                S.Name      = std::string{"2d_"} + TypeNames[View.Type] + PrecisionNames[View.Precision] + "_interior";
+                S.Type      = View.Type;
+                S.Precision = View.Precision;
+                S.Time      = 1.0f;
+                S.MaxIter   = 10000;
+                S.OffsetX   = View.Type == CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS ? 0.0f : -0.5f;
+                Scenes.push_back(S);
+
+                S.Name     += "_earlyout";
+                S.EarlyOut = true;
+                Scenes.push_back(S);
+            }
+        }
+
+        // Cache de tiles: la vista general de Mandelbrot en double montada con tiles de 128
+        {
+            BenchScene S;
+            S.Kind      = SceneKind::TileCache;
+            S.Name      = "2d_mandelbrot_colors_double_tiles";
+            S.Type      = CPU_FRACTAL_2D_MANDELBROT_COLORS;
+            S.Precision = CPU_PRECISION_DOUBLE;
+            S.Time      = 1.0f;
+            S.OffsetX   = -0.5f;
+            Scenes.push_back(S);
+
+            S.Name   = "2d_mandelbrot_colors_double_tiles_warm";
+            S.Warmup = TileWarmup::Same;
+            Scenes.push_back(S);
+
+            S.Name   = "2d_mandelbrot_colors_double_tiles_pan";
+            S.Warmup = TileWarmup::Panned;
+            Scenes.push_back(S);
+        }
+
+        // Barridos de parámetros: los mismos píxeles que las escenas 320x240, repartidos en
+        // miniaturas que renderiza un único ParallelFor
+        {
+            BenchScene S;
+            S.Kind          = SceneKind::Sweep;
+            S.Name          = "sweep_julia_c_16x16";
+            S.Sweep.Columns = 16;
+            S.Sweep.Rows    = 16;
+            Scenes.push_back(S);
+
+            S.Name            = "sweep_burning_ship_deform_8x8";
+            S.Type            = CPU_FRACTAL_2D_BURNING_SHIP_COLORS;
+            S.OffsetX         = -0.5f;
+            S.Sweep.Parameter = CPU_SWEEP_BURNING_SHIP_DEFORM;
+            S.Sweep.Columns   = 8;
+            S.Sweep.Rows      = 8;
+            Scenes.push_back(S);
+
+            S.Name            = "sweep_mandelbulb_power_8x8";
+            S.Type            = CPU_FRACTAL_3D_MANDELBULB;
+            S.OffsetX         = 0.0f;
+            S.MaxIter         = 4;
+            S.Sweep.Parameter = CPU_SWEEP_BULB_POWER;
+            S.Sweep.MinX      = 2.0f;
+            S.Sweep.MaxX      = 12.0f;
+            Scenes.push_back(S);
+        }
+        return Scenes;
+    }
+
+    constexpr float PrevCameraStep = 0.02f;
+    constexpr float PrevYawStep    = 0.5f;
+    constexpr float TilePanPixels  = 160.0f;
+
+    // Mismos valores por defecto que FractalViewer::Initialize, salvo la salida anticipada del
+    // interior, que solo activan las escenas EarlyOut
+    CPUShaderConstants MakeConstants(const BenchScene& S)
+    {
+        const bool Is3D = S.Kind == SceneKind::Fractal3D;
+
+        CPUShaderConstants C = {};
+        C.TimeAndResolution  = {S.Time, static_cast<float>(S.Width), static_cast<float>(S.Height), static_cast<float>(S.Type)};
+        C.ZoomOffset         = {static_cast<float>(S.Zoom), S.OffsetX, S.OffsetY, 0.0f};
+        C.FractalColor       = {1, 1, 1, 1};
+        C.BackgroundColor    = {0, 0, 0, 1};
+        C.maxiter            = S.MaxIter;
+        C.FractalParams1     = {100.0f, 2.0f, static_cast<float>(S.Precision)};
+        C.FractalParams2     = {1, S.EarlyOut ? 1.0f : 0.0f, 0, 0};
+        C.Options3D          = {100, 10.0f, 0.001f, S.BulbPower};
+        C.AnimationParams    = {1.0f, 0, 0, 0};
+
+        // Escenas 2D con el centro en texto: zoom y centro como float + parte baja, igual que
+        // FractalViewer (las de perturbación leen el centro en precisión arbitraria)
+        if (S.Kind == SceneKind::Fractal2D && S.CenterX != nullptr)
+        {
+            const DoubleFloat<float> Zoom    = DFFromDouble(S.Zoom);
+            const DoubleFloat<float> CenterX = DFFromDouble(std::atof(S.CenterX));
+            const DoubleFloat<float> CenterY = DFFromDouble(std::atof(S.CenterY));
+            C.ZoomOffset   = {Zoom.Hi, CenterX.Hi, CenterY.Hi, 0.0f};
+            C.ZoomOffsetLo = {Zoom.Lo, CenterX.Lo, CenterY.Lo, 0.0f};
+        }
+
+        // Base de la cámara como FirstPersonCamera: guiñada sobre Y y luego cabeceo
+        const float Yaw   = S.Yaw * 3.14159265f / 180.0f;
+        const float Pitch = S.Pitch * 3.14159265f / 180.0f;
+        C.CameraPos       = {S.CameraPos.x, S.CameraPos.y, S.CameraPos.z, Is3D ? 1.0f : 0.0f};
+        C.CameraDirX      = {std::cos(Yaw), 0.0f, -std::sin(Yaw), 0.0f};
+        C.CameraDirY      = {-std::sin(Yaw) * std::sin(Pitch), std::cos(Pitch), -std::cos(Yaw) * std::sin(Pitch), 0.0f};
+        C.CameraDirZ      = {std::sin(Yaw) * std::cos(Pitch), std::sin(Pitch), std::cos(Yaw) * std::cos(Pitch), 0.0f};
+        return C;
+    }
+
+    // FNV-1a de 64 bits sobre los bytes RGBA8 (independiente del orden de bytes del host)
+    std::uint64_t ImageChecksum(const CPUImage& Image)
+    {
+        std::uint64_t Hash = 14695981039346656037ull;
+        for (std::uint32_t Pixel : Image.Pixels)
+        {
+            for (int b = 0; b < 4; ++b)
+            {
+                Hash ^= (Pixel >> (b * 8)) & 0xFF;
+                Hash *= 1099511628211ull;
+            }
+        }
+        return Hash;
+    }
+
+    bool LoadGolden(const std::string& Path, std::map<std::string, std::uint64_t>& Golden)
+    {
+        std::FILE* pFile = std::fopen(Path.c_str(), "r");
+        if (pFile == nullptr)
+            return false;
+
+        char Line[512];
+        while (std::fgets(Line, sizeof(Line), pFile) != nullptr)
+        {
+            char               Name[256];
+            unsigned long long Value = 0;
+            if (Line[0] != '#' && std::sscanf(Line, "%255s %llx", Name, &Value) == 2)
+                Golden[Name] = Value;
+        }
+        std::fclose(pFile);
+        return true;
+    }
+
+    bool SaveGolden(const std::string& Path, const std::vector<BenchScene>& Scenes, const std::map<std::string, std::uint64_t>& Golden)
+    {
+        std::FILE* pFile = std::fopen(Path.c_str(), "w");
+        if (pFile == nullptr)
+            return false;
+
+        std::fprintf(pFile, "# Checksums FNV-1a (RGBA8) de las escenas de fractal_bench. Regenerar con --update-golden.\n");
+        for (const BenchScene& S : Scenes)
+        {
+            auto It = Golden.find(S.Name);
+            if (It != Golden.end())
+                std::fprintf(pFile, "%s %016llx\n", S.Name.c_str(), static_cast<unsigned long long>(It->second));
+        }
+        return std::fclose(pFile) == 0;
+    }
+
+    void PrintUsage()
+    {
+        std::printf("Usage: fractal_bench [--golden path] [--update-golden] [--repeat N] [--threads N] [--filter text] [--list]\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, BenchOptions& Opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* Arg  = argv[i];
+            auto        Next = [&](int Count) { return i + Count < argc; };
+
+            if (!std::strcmp(Arg, "--golden") && Next(1))
+                Opt.GoldenPath = argv[++i];
+            else if (!std::strcmp(Arg, "--update-golden"))
+                Opt.UpdateGolden = true;
+            else if (!std::strcmp(Arg, "--repeat") && Next(1))
+                Opt.Repeat = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--threads") && Next(1))
+                Opt.NumThreads = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--filter") && Next(1))
+                Opt.Filter = argv[++i];
+            else if (!std::strcmp(Arg, "--list"))
+                Opt.ListOnly = true;
+            else
+                return false;
+        }
+        return Opt.Repeat > 0;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchOptions Opt;
+    if (!ParseOptions(argc, argv, Opt))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<BenchScene> Scenes = MakeCatalogue();
+    if (!Opt.Filter.empty())
+    {
+        Scenes.erase(std::remove_if(Scenes.begin(), Scenes.end(), [&](const BenchScene& S) { return S.Name.find(Opt.Filter) == std::string::npos; }),
+                     Scenes.end());
+    }
+    if (Opt.ListOnly)
+    {
+        for (const BenchScene& S : Scenes)
+            std::printf("%s\n", S.Name.c_str());
+        return 0;
+    }
+
+    std::map<std::string, std::uint64_t> Golden;
+    if (!LoadGolden(Opt.GoldenPath, Golden) && !Opt.UpdateGolden)
+    {
+        std::fprintf(stderr, "Cannot read golden file %s (run with --update-golden to create it)\n", Opt.GoldenPath.c_str());
+        return 1;
+    }
+
+    CPUFractalRenderer            Renderer{Opt.NumThreads};
+    CPUPerturbationRenderer       Perturbation{Renderer.GetThreadPool()};
+    CPUDistanceBrickCache         Bricks;
+    std::unique_ptr<CPUTileCache> Tiles;
+    std::printf("fractal_bench: %s x %u threads, best of %u\n\n", GetSimdInstructionSetName(), Renderer.GetNumThreads(), Opt.Repeat);
+    std::printf("%-40s %10s %12s %10s %16s  %s\n", "scene", "Mpix/s", "Miter/s", "DE/ray", "checksum", "result");
+
+    int      NumFailed = 0;
+    CPUImage                        Image;
+    std::vector<CPUShaderConstants> SweepSlices;
+    std::vector<CPUEscapeSample>    TileSamples;
+    for (const BenchScene& S : Scenes)
+    {
+        const CPUShaderConstants Constants = MakeConstants(S);
+
+        CPUDeepZoomView View;
+        if (S.Kind == SceneKind::Perturbation)
+        {
+            const unsigned NumLimbs = BigFloat::LimbsForZoom(S.Zoom * S.Height);
+            BigFloat::FromString(S.CenterX, NumLimbs, View.CenterX);
+            BigFloat::FromString(S.CenterY, NumLimbs, View.CenterY);
+            View.Zoom = S.Zoom;
+        }
+        if (S.Kind == SceneKind::Sweep)
+        {
+            CPUSweepSettings Settings = S.Sweep;
+            Settings.ThumbWidth       = S.Width / Settings.Columns;
+            Settings.ThumbHeight      = S.Height / Settings.Rows;
+            MakeParameterSweep(Constants, Settings, SweepSlices);
+        }
+
+        // Mejor tiempo de Repeat ejecuciones; la primera perturbación incluye la órbita de referencia
+        double        BestSeconds   = 0;
+        std::uint64_t Pixels        = 0;
+        std::uint64_t Iterations    = 0;
+        std::uint64_t DEEvaluations = 0;
+        for (std::uint32_t r = 0; r < Opt.Repeat; ++r)
+        {
+            double Seconds = 0;
+            switch (S.Kind)
+            {
+                case SceneKind::Fractal2D:
+                    Renderer.SetAdaptiveSupersampling(S.AASamples);
+                    Renderer.Render2D(Constants, Image);
+                    Seconds    = Renderer.GetLastStats().Seconds;
+                    Pixels     = Renderer.GetLastStats().Pixels;
+                    Iterations = Renderer.GetLastStats().Iterations;
+                    break;
+
+                case SceneKind::Perturbation:
+                    Perturbation.Render(View, Constants, Image);
+                    Seconds    = Perturbation.GetLastStats().Seconds;
+                    Pixels     = Perturbation.GetLastStats().Pixels;
+                    Iterations = Perturbation.GetLastStats().Iterations;
+                    break;
+
+                case SceneKind::Fractal3D:
+                    if (S.Bricks && r == 0)
+                    {
+                        Bricks.Prepare(Renderer.GetThreadPool(), Constants, CPUDistanceBrickSettings{});
+                        Bricks.BakeNearCamera(Renderer.GetThreadPool(), S.CameraPos, Bricks.GetStats().BandBricks);
+                    }
+                    Renderer.SetDistanceBricks(S.Bricks ? &Bricks : nullptr);
+                    Renderer.SetConePrepass(S.ConePrepass);
+                    Renderer.SetTemporalReprojection(S.Temporal);
+                    Renderer.SetAdaptiveSupersampling(S.AASamples);
+                    Renderer.SetPacketMarching(S.Packets);
+                    if (S.Temporal)
+                    {
+                        BenchScene Prev = S;
+                        Prev.CameraPos.x -= PrevCameraStep;
+                        Prev.CameraPos.z -= PrevCameraStep;
+                        Prev.Yaw -= PrevYawStep;
+                        Renderer.ResetTemporalHistory();
+                        Renderer.Render3D(MakeConstants(Prev), Image);
+                    }
+                    Renderer.Render3D(Constants, Image);
+                    Seconds       = Renderer.GetLastStats().Seconds;
+                    Pixels        = Renderer.GetLastStats().Pixels;
+                    DEEvaluations = Renderer.GetLastStats().DEEvaluations;
+                    break;
+
+                case SceneKind::Sweep:
+                    Renderer.RenderSweep(SweepSlices, S.Sweep.Columns, Image);
+                    Seconds       = Renderer.GetLastStats().Seconds;
+                    Pixels        = Renderer.GetLastStats().Pixels;
+                    Iterations    = Renderer.GetLastStats().Iterations;
+                    DEEvaluations = Renderer.GetLastStats().DEEvaluations;
+                    break;
+
+                case SceneKind::TileCache:
+                    // El calentamiento no se mide; en Same se hace una vez y sirve para todas las ejecuciones
+                    if (S.Warmup != TileWarmup::Same || r == 0)
+                    {
+                        Tiles.reset(new CPUTileCache{Renderer.GetThreadPool(), CPUTileCacheSettings{}});
+                        CPUShaderConstants Warmup = Constants;
+                        if (S.Warmup == TileWarmup::Panned)
+                            Warmup.ZoomOffset.y += TilePanPixels * 2.0f / (S.Height * Warmup.ZoomOffset.x);
+                        if (S.Warmup != TileWarmup::Cold)
+                            Tiles->RenderEscape(Warmup, TileSamples);
+                    }
+                    Tiles->Render(Constants, Image);
+                    Seconds    = Tiles->GetLastStats().Seconds;
+                    Pixels     = Tiles->GetLastStats().Pixels;
+                    Iterations = Tiles->GetLastStats().Iterations;
+                    break;
+            }
+            BestSeconds = r == 0 ? Seconds : std::min(BestSeconds, Seconds);
+        }
+
+        const std::uint64_t Checksum = ImageChecksum(Image);
+        const char*         Result   = "ok";
+        auto                It       = Golden.find(S.Name);
+        if (Opt.UpdateGolden)
+        {
+            Result         = It == Golden.end() ? "added" : (It->second == Checksum ? "ok" : "updated");
+            Golden[S.Name] = Checksum;
+        }
+        else if (It == Golden.end())
+        {
+            Result = "MISSING";
+            ++NumFailed;
+        }
+        else if (It->second != Checksum)
+        {
+            Result = "MISMATCH";
+            ++NumFailed;
+        }
+
+        const double Seconds = std::max(BestSeconds, 1e-9);
+        std::printf("%-40s %10.2f ", S.Name.c_str(), Pixels / Seconds * 1e-6);
+        if (S.Kind == SceneKind::Fractal3D || (S.Kind == SceneKind::Sweep && S.Sweep.Parameter == CPU_SWEEP_BULB_POWER))
+            std::printf("%12s %10.1f ", "-", Pixels > 0 ? static_cast<double>(DEEvaluations) / Pixels : 0.0);
+        else
+            std::printf("%12.1f %10s ", Iterations / Seconds * 1e-6, "-");
+        std::printf("%016llx  %s\n", static_cast<unsigned long long>(Checksum), Result);
+        if (S.Bricks)
+        {
+            const CPUDistanceBrickStats& BrickStats = Bricks.GetStats();
+            std::printf("    bricks: %u/%u cells, %.1f MB, bake %.1f ms (cells %.1f ms)\n", BrickStats.BakedBricks, BrickStats.Cells,
+                        BrickStats.MemoryBytes / (1024.0 * 1024.0), (BrickStats.CoarseSeconds + BrickStats.BrickSeconds) * 1e3,
+                        BrickStats.CoarseSeconds * 1e3);
+        }
+        if (S.Kind == SceneKind::Fractal3D)
+            std::printf("    rays: %.2f Mrays/s, %.1f MDE/s\n", Pixels / Seconds * 1e-6, DEEvaluations / Seconds * 1e-6);
+        if (S.AASamples > 0)
+        {
+            const CPURenderStats& Stats = Renderer.GetLastStats();
+            std::printf("    aa: %llu refined px (%.1f%%), %llu extra samples\n", static_cast<unsigned long long>(Stats.RefinedPixels),
+                        Stats.Pixels > 0 ? 100.0 * Stats.RefinedPixels / Stats.Pixels : 0.0, static_cast<unsigned long long>(Stats.ExtraSamples));
+        }
+        if (S.Kind == SceneKind::TileCache)
+        {
+            const CPUTileCacheStats& TileStats = Tiles->GetLastStats();
+            std::printf("    tiles: level %d, %u tiles, %u from memory, %u rendered\n", TileStats.Level, TileStats.Tiles, TileStats.MemoryHits,
+                        TileStats.Rendered);
+        }
+    }
+
+    if (Opt.UpdateGolden)
+    {
+        if (!SaveGolden(Opt.GoldenPath, MakeCatalogue(), Golden))
+        {
+            std::fprintf(stderr, "Cannot write golden file %s\n", Opt.GoldenPath.c_str());
+            return 1;
+        }
+        std::printf("\nGolden checksums written to %s\n", Opt.GoldenPath.c_str());
+        return 0;
+    }
+
+    if (NumFailed > 0)
+    {
+        std::fprintf(stderr, "\n%d scene(s) do not match the golden checksums\n", NumFailed);
+        return 1;
+    }
+    std::printf("\nAll %zu scenes match the golden checksums\n", Scenes.size());
+    return 0;
+}
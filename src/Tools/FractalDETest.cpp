@@ -0,0 +1,201 @@
+// Prueba de precisión del DE del Mandelbulb (CPU/CPUFractalKernels3D, réplica de fractal3D.fxh):
+//  - el kernel polinómico de potencia 8 frente al camino general (acos/atan2/pow) con power = 8,
+//  - la normal analítica (jacobiano) frente a diferencias centradas de un DE de referencia en
+//    double, en puntos de impacto de rayos reales, con la potencia 8 y con potencias no enteras.
+// Devuelve 1 si algún error supera su tolerancia.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../CPU/CPUFractalKernels3D.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct Double3
+    {
+        double x, y, z;
+    };
+
+    // DE general del shader en double, como referencia
+    double ReferenceDistance(const Double3& Pos, double Power)
+    {
+        Double3 z  = Pos;
+        double  dr = 1.0;
+        double  r  = 0.0;
+        for (int i = 0; i < 100; ++i)
+        {
+            r = std::sqrt(z.x * z.x + z.y * z.y + z.z * z.z);
+            if (r > 2.0)
+                break;
+
+            const double Theta = std::acos(z.z / r) * Power;
+            const double Phi   = std::atan2(z.y, z.x) * Power;
+            dr                 = std::pow(r, Power - 1.0) * Power * dr + 1.0;
+
+            const double Zr = std::pow(r, Power);
+            z               = Double3{Zr * std::sin(Theta) * std::cos(Phi) + Pos.x, Zr * std::sin(Theta) * std::sin(Phi) + Pos.y, Zr * std::cos(Theta) + Pos.z};
+        }
+        return 0.5 * std::log(r) * r / dr;
+    }
+
+    Double3 ReferenceNormal(const CPUFloat3& P, double Power)
+    {
+        const double e = 1e-6;
+        const double x = P.x, y = P.y, z = P.z;
+
+        Double3 n = {ReferenceDistance({x + e, y, z}, Power) - ReferenceDistance({x - e, y, z}, Power),
+                     ReferenceDistance({x, y + e, z}, Power) - ReferenceDistance({x, y - e, z}, Power),
+                     ReferenceDistance({x, y, z + e}, Power) - ReferenceDistance({x, y, z - e}, Power)};
+        const double Len = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        return Double3{n.x / Len, n.y / Len, n.z / Len};
+    }
+
+    // Ángulo en grados entre una normal float (sin normalizar) y la de referencia
+    double AngleDegrees(const CPUFloat3& a, const Double3& b)
+    {
+        const double Len = std::sqrt(double(a.x) * a.x + double(a.y) * a.y + double(a.z) * a.z);
+        const double c   = (a.x * b.x + a.y * b.y + a.z * b.z) / Len;
+        return std::acos(std::max(-1.0, std::min(1.0, c))) * 180.0 / 3.14159265358979;
+    }
+
+    // Normal por diferencias centradas en float, como el calculateNormal anterior del shader
+    CPUFloat3 FiniteDifferenceNormal(const CPUFloat3& p, float Power)
+    {
+        const float e = 0.001f;
+        return CPUFloat3{DistanceMandelbulb({p.x + e, p.y, p.z}, Power) - DistanceMandelbulb({p.x - e, p.y, p.z}, Power),
+                         DistanceMandelbulb({p.x, p.y + e, p.z}, Power) - DistanceMandelbulb({p.x, p.y - e, p.z}, Power),
+                         DistanceMandelbulb({p.x, p.y, p.z + e}, Power) - DistanceMandelbulb({p.x, p.y, p.z - e}, Power)};
+    }
+
+    // Puntos de impacto de una rejilla de rayos desde varias posiciones alrededor del fractal
+    std::vector<CPUFloat3> MarchHitPoints(float Power)
+    {
+        std::vector<CPUFloat3> Hits;
+        const CPUFloat3        Eyes[] = {{0.0f, 0.0f, -3.0f}, {-1.6f, 1.2f, -2.2f}, {2.1f, -0.7f, 1.5f}, {0.3f, 2.8f, 0.4f}};
+        for (const CPUFloat3& Eye : Eyes)
+        {
+            for (int j = 0; j < 24; ++j)
+            {
+                for (int i = 0; i < 24; ++i)
+                {
+                    // Rayos hacia una rejilla de puntos alrededor del origen
+                    const CPUFloat3 Target = {(i - 11.5f) / 10.0f, (j - 11.5f) / 10.0f, 0.0f};
+                    CPUFloat3       rd     = {Target.x - Eye.x, Target.y - Eye.y, Target.z - Eye.z};
+                    const float     RdLen  = std::sqrt(rd.x * rd.x + rd.y * rd.y + rd.z * rd.z);
+                    rd                     = {rd.x / RdLen, rd.y / RdLen, rd.z / RdLen};
+
+                    float t = 0.0f;
+                    for (int Step = 0; Step < 200 && t < 10.0f; ++Step)
+                    {
+                        const CPUFloat3 p = {Eye.x + rd.x * t, Eye.y + rd.y * t, Eye.z + rd.z * t};
+                        const float     d = DistanceMandelbulbFast(p, Power);
+                        if (d < 0.001f)
+                        {
+                            Hits.push_back(p);
+                            break;
+                        }
+                        t += d;
+                    }
+                }
+            }
+        }
+        return Hits;
+    }
+
+    struct ErrorStats
+    {
+        double Mean = 0, P95 = 0, Max = 0;
+    };
+
+    ErrorStats Summarize(std::vector<double> Errors)
+    {
+        ErrorStats S;
+        if (Errors.empty())
+            return S;
+        std::sort(Errors.begin(), Errors.end());
+        for (double e : Errors)
+            S.Mean += e;
+        S.Mean /= Errors.size();
+        S.P95 = Errors[static_cast<size_t>(0.95 * (Errors.size() - 1))];
+        S.Max = Errors.back();
+        return S;
+    }
+
+    int NumFailed = 0;
+
+    void Check(const char* Name, double Value, double Limit)
+    {
+        const bool Ok = Value <= Limit;
+        std::printf("  %-40s %12.3g  (limit %g)  %s\n", Name, Value, Limit, Ok ? "ok" : "FAILED");
+        if (!Ok)
+            ++NumFailed;
+    }
+} // namespace
+
+int main()
+{
+    // 1. Kernel de potencia 8 frente al general, en una rejilla que cruza la superficie
+    {
+        std::vector<double> RelErrors;
+        for (int k = 0; k < 40; ++k)
+        {
+            for (int j = 0; j < 40; ++j)
+            {
+                for (int i = 0; i < 40; ++i)
+                {
+                    const CPUFloat3 p       = {(i - 19.5f) / 14.0f, (j - 19.5f) / 14.0f, (k - 19.5f) / 14.0f};
+                    const float     General = DistanceMandelbulb(p, 8.0f);
+                    const float     Fast    = DistanceMandelbulbFast(p, 8.0f);
+                    // Dentro del conjunto el DE no es una distancia y el caos amplifica cualquier redondeo
+                    if (General > 1e-3f)
+                        RelErrors.push_back(std::abs(Fast - General) / General);
+                }
+            }
+        }
+        const ErrorStats S = Summarize(RelErrors);
+        std::printf("power 8 polynomial DE vs general DE (%zu points outside the set)\n", RelErrors.size());
+        Check("mean relative error", S.Mean, 1e-4);
+        Check("p95 relative error", S.P95, 1e-4);
+        Check("max relative error", S.Max, 1e-2);
+    }
+
+    // 2. Normal analítica frente a diferencias centradas en double
+    for (float Power : {8.0f, 6.5f, 3.0f, 9.73f})
+    {
+        const std::vector<CPUFloat3> Hits = MarchHitPoints(Power);
+
+        std::vector<double> Analytic, Finite;
+        for (const CPUFloat3& p : Hits)
+        {
+            CPUFloat3 Gradient;
+            DistanceMandelbulbGradient(p, Power, Gradient);
+            const Double3 Reference = ReferenceNormal(p, Power);
+            Analytic.push_back(AngleDegrees(Gradient, Reference));
+            Finite.push_back(AngleDegrees(FiniteDifferenceNormal(p, Power), Reference));
+        }
+
+        // Los pocos puntos que agotan las 100 iteraciones dominan la media
+        const ErrorStats A = Summarize(Analytic);
+        const ErrorStats F = Summarize(Finite);
+        std::printf("power %g normals (%zu hit points; float finite differences: mean %.2f, p95 %.2f degrees)\n", Power, Hits.size(), F.Mean, F.P95);
+        Check("analytic normal mean error (degrees)", A.Mean, 1.0);
+        Check("analytic normal p95 error (degrees)", A.P95, 0.1);
+        if (Hits.size() < 1000)
+        {
+            std::printf("  too few hit points\n");
+            ++NumFailed;
+        }
+    }
+
+    if (NumFailed > 0)
+    {
+        std::fprintf(stderr, "\n%d check(s) failed\n", NumFailed);
+        return 1;
+    }
+    std::printf("\nAll checks passed\n");
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Exportación de animaciones 2D solo con el backend CPU, para máquinas sin GPU.
+// Avanza el tiempo y el zoom igual que FractalViewer::Update con el auto zoom activo, pero
+// con un paso fijo de 1/fps por frame, y escribe los frames con FrameWriter.
+//
+//   FractalExportCPU --out zoom --format y4m --frames 600 --fps 60 --size 1920 1080
+//                    --type 0 --maxiter 2000 --zoom 1 --zoom-speed 0.5
+//                    [--center -0.743643887037151 0.131825904205330] [--offset x y]
+//                    [--double | --double-float]
+//
+// Con --center se usa el deep zoom por perturbaciones (centro en precisión arbitraria);
+// sin él, offset + zoom en float, double o double-float como el visor. --out zoom y
+// --out zoom.y4m escriben los dos zoom.y4m; en PNG es el prefijo de zoom_00000.png...
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../CPU/CPUPerturbation.hpp"
+#include "../Export/FrameWriter.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct ExportOptions
+    {
+        std::string   OutPath   = "fractal_export";
+        FrameFormat   Format    = FrameFormat::Y4M;
+        std::uint32_t Frames    = 300;
+        std::uint32_t FPS       = 30;
+        std::uint32_t Width     = 1280;
+        std::uint32_t Height    = 720;
+        int           Type      = CPU_FRACTAL_2D_MANDELBROT;
+        int           MaxIter   = 100;
+        double        Zoom      = 1.0;
+        double        ZoomSpeed = 1.0;
+        double        OffsetX   = 0.0;
+        double        OffsetY   = 0.0;
+        int           Precision = CPU_PRECISION_FLOAT;
+        bool          DeepZoom  = false;
+        std::string   CenterX, CenterY;
+    };
+
+    void PrintUsage()
+    {
+        std::printf("Usage: FractalExportCPU [--out path] [--format y4m|png|raw] [--frames N] [--fps N] [--size W H]\n"
+                    "                        [--type N] [--maxiter N] [--zoom Z] [--zoom-speed S] [--offset X Y]\n"
+                    "                        [--center RE IM] [--double | --double-float]\n"
+                    "The format extension is added to --out if missing; PNG frames go to path_00000.png...\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, ExportOptions& Opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* Arg  = argv[i];
+            auto        Next = [&](int Count) { return i + Count < argc; };
+
+            if (!std::strcmp(Arg, "--out") && Next(1))
+                Opt.OutPath = argv[++i];
+            else if (!std::strcmp(Arg, "--format") && Next(1))
+            {
+                const char* Name = argv[++i];
+                if (!std::strcmp(Name, "y4m"))
+                    Opt.Format = FrameFormat::Y4M;
+                else if (!std::strcmp(Name, "png"))
+                    Opt.Format = FrameFormat::PNG;
+                else if (!std::strcmp(Name, "raw"))
+                    Opt.Format = FrameFormat::RawRGBA;
+                else
+                    return false;
+            }
+            else if (!std::strcmp(Arg, "--frames") && Next(1))
+                Opt.Frames = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--fps") && Next(1))
+                Opt.FPS = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--size") && Next(2))
+            {
+                Opt.Width  = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+                Opt.Height = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (!std::strcmp(Arg, "--type") && Next(1))
+                Opt.Type = std::atoi(argv[++i]);
+            else if (!std::strcmp(Arg, "--maxiter") && Next(1))
+                Opt.MaxIter = std::atoi(argv[++i]);
+            else if (!std::strcmp(Arg, "--zoom") && Next(1))
+                Opt.Zoom = std::atof(argv[++i]);
+            else if (!std::strcmp(Arg, "--zoom-speed") && Next(1))
+                Opt.ZoomSpeed = std::atof(argv[++i]);
+            else if (!std::strcmp(Arg, "--offset") && Next(2))
+            {
+                Opt.OffsetX = std::atof(argv[++i]);
+                Opt.OffsetY = std::atof(argv[++i]);
+            }
+            else if (!std::strcmp(Arg, "--center") && Next(2))
+            {
+                Opt.CenterX  = argv[++i];
+                Opt.CenterY  = argv[++i];
+                Opt.DeepZoom = true;
+            }
+            else if (!std::strcmp(Arg, "--double"))
+                Opt.Precision = CPU_PRECISION_DOUBLE;
+            else if (!std::strcmp(Arg, "--double-float"))
+                Opt.Precision = CPU_PRECISION_DOUBLE_FLOAT;
+            else
+                return false;
+        }
+        return Opt.Frames > 0 && Opt.FPS > 0 && Opt.Width > 0 && Opt.Height > 0 && Opt.Type >= 0 && Opt.Type < CPU_FRACTAL_2D_COUNT;
+    }
+
+    // Mismos valores por defecto que FractalViewer::Initialize
+    CPUShaderConstants MakeConstants(const ExportOptions& Opt, float Time, double Zoom)
+    {
+        const DoubleFloat<float> ZoomDF  = DFFromDouble(Zoom);
+        const DoubleFloat<float> OffsetX = DFFromDouble(Opt.OffsetX);
+        const DoubleFloat<float> OffsetY = DFFromDouble(Opt.OffsetY);
+
+        CPUShaderConstants C = {};
+        C.TimeAndResolution  = {Time, static_cast<float>(Opt.Width), static_cast<float>(Opt.Height), static_cast<float>(Opt.Type)};
+        C.ZoomOffset         = {ZoomDF.Hi, OffsetX.Hi, OffsetY.Hi, 0.0f};
+        C.ZoomOffsetLo       = {ZoomDF.Lo, OffsetX.Lo, OffsetY.Lo, 0.0f};
+        C.FractalColor       = {1, 1, 1, 1};
+        C.BackgroundColor    = {0, 0, 0, 1};
+        C.maxiter            = Opt.MaxIter;
+        C.FractalParams1     = {100.0f, 2.0f, static_cast<float>(Opt.Precision)};
+        C.FractalParams2     = {1, 0, 0, 0};
+        C.Options3D          = {100, 10.0f, 0.001f, 0};
+        C.AnimationParams    = {1.0f, 0, 0, 0};
+        return C;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ExportOptions Opt;
+    if (!ParseOptions(argc, argv, Opt))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    CPUFractalRenderer                       Renderer;
+    std::unique_ptr<CPUPerturbationRenderer> pPerturbation;
+    CPUDeepZoomView                          View;
+    if (Opt.DeepZoom)
+    {
+        if (!CPUPerturbationRenderer::SupportsFractalType(Opt.Type))
+        {
+            std::fprintf(stderr, "Deep zoom is only available for the Mandelbrot and Burning Ship types\n");
+            return 1;
+        }
+        pPerturbation.reset(new CPUPerturbationRenderer{Renderer.GetThreadPool()});
+    }
+
+    const std::string Path = FrameWriter::GetOutputPath(Opt.OutPath, Opt.Format);
+    FrameWriter       Writer{Path, Opt.Format, Opt.Width, Opt.Height, Opt.FPS};
+
+    const float dt   = 1.0f / static_cast<float>(Opt.FPS);
+    float       Time = 0.0f;
+    double      Zoom = Opt.Zoom;
+    CPUImage    Image;
+    for (std::uint32_t Frame = 0; Frame < Opt.Frames && !Writer.HasError(); ++Frame)
+    {
+        const CPUShaderConstants Constants = MakeConstants(Opt, Time, Zoom);
+        if (pPerturbation)
+        {
+            // Bits suficientes para el tamaño de píxel de este frame
+            const unsigned NumLimbs = BigFloat::LimbsForZoom(Zoom * Opt.Height);
+            if (!BigFloat::FromString(Opt.CenterX.c_str(), NumLimbs, View.CenterX) || !BigFloat::FromString(Opt.CenterY.c_str(), NumLimbs, View.CenterY))
+            {
+                std::fprintf(stderr, "Invalid --center value\n");
+                return 1;
+            }
+            View.Zoom = Zoom;
+            pPerturbation->Render(View, Constants, Image);
+        }
+        else
+        {
+            Renderer.Render2D(Constants, Image);
+        }
+
+        const std::uint8_t* pPixels = reinterpret_cast<const std::uint8_t*>(Image.Pixels.data());
+        Writer.Push(std::vector<std::uint8_t>(pPixels, pPixels + Image.Pixels.size() * 4));
+
+        Time += dt;
+        Zoom *= 1.0 + Opt.ZoomSpeed * dt;
+
+        std::printf("\rframe %u / %u", Frame + 1, Opt.Frames);
+        std::fflush(stdout);
+    }
+    Writer.Finish();
+    std::printf("\n%u frames written to %s\n", Writer.GetNumWritten(), Path.c_str());
+
+    return Writer.HasError() ? 1 : 0;
+}
@@ -0,0 +1,281 @@
+// Granja de render por tiles con el backend CPU (FarmCoordinator / RunFarmWorker): un
+// coordinador reparte las tiles de un póster o de una animación 2D entre workers en otros
+// procesos o máquinas y junta los resultados según llegan.
+//
+//   FractalFarmCPU worker --connect 192.168.1.10:7400 [--threads N]
+//   FractalFarmCPU coordinator --listen :7400 --out poster --size 16384 16384 --tile 256
+//                  --type 0 --maxiter 2000 [--zoom Z] [--offset X Y] [--double | --double-float]
+//   FractalFarmCPU coordinator --listen unix:/tmp/farm.sock --out zoom --frames 300 --fps 30
+//                  --size 1920 1080 [--format y4m|png|raw] [--zoom-speed S] [--local-workers N]
+//
+// Con un solo frame (--frames 1, por defecto) el resultado va a un BigTIFF con PosterWriter,
+// tile a tile y con continuación si se interrumpe; con varios, a FrameWriter en orden,
+// guardando en memoria solo los frames a medias. --local-workers N lanza además N workers en
+// hilos de este proceso (con los núcleos repartidos entre ellos). A --out se le añade .tif o
+// la extensión del formato solo si no la lleva (FrameWriter::GetOutputPath).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../Export/FrameWriter.hpp"
+#include "../Export/PosterWriter.hpp"
+#include "../Export/RenderFarm.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct FarmOptions
+    {
+        bool          Worker       = false;
+        std::string   Address      = ":7400";
+        std::uint32_t NumThreads   = 0;
+        std::string   OutPath      = "farm";
+        FrameFormat   Format       = FrameFormat::Y4M;
+        std::uint32_t Frames       = 1;
+        std::uint32_t FPS          = 30;
+        std::uint32_t Width        = 4096;
+        std::uint32_t Height       = 4096;
+        std::uint32_t TileSize     = 256;
+        int           Type         = CPU_FRACTAL_2D_MANDELBROT;
+        int           MaxIter      = 100;
+        double        Zoom         = 1.0;
+        double        ZoomSpeed    = 1.0;
+        double        OffsetX      = 0.0;
+        double        OffsetY      = 0.0;
+        int           Precision    = CPU_PRECISION_FLOAT;
+        std::uint32_t LocalWorkers = 0;
+    };
+
+    void PrintUsage()
+    {
+        std::printf("Usage: FractalFarmCPU worker --connect HOST:PORT|unix:PATH [--threads N]\n"
+                    "       FractalFarmCPU coordinator --listen HOST:PORT|unix:PATH [--out path] [--size W H] [--tile N]\n"
+                    "                      [--type N] [--maxiter N] [--zoom Z] [--offset X Y] [--double | --double-float]\n"
+                    "                      [--frames N] [--fps N] [--zoom-speed S] [--format y4m|png|raw] [--local-workers N]\n"
+                    "The .tif or format extension is added to --out if missing; PNG frames go to path_00000.png...\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, FarmOptions& Opt)
+    {
+        if (argc < 2 || (std::strcmp(argv[1], "worker") != 0 && std::strcmp(argv[1], "coordinator") != 0))
+            return false;
+        Opt.Worker = !std::strcmp(argv[1], "worker");
+
+        for (int i = 2; i < argc; ++i)
+        {
+            const char* Arg  = argv[i];
+            auto        Next = [&](int Count) { return i + Count < argc; };
+
+            if ((!std::strcmp(Arg, "--connect") || !std::strcmp(Arg, "--listen")) && Next(1))
+                Opt.Address = argv[++i];
+            else if (!std::strcmp(Arg, "--threads") && Next(1))
+                Opt.NumThreads = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--out") && Next(1))
+                Opt.OutPath = argv[++i];
+            else if (!std::strcmp(Arg, "--format") && Next(1))
+            {
+                const char* Name = argv[++i];
+                if (!std::strcmp(Name, "y4m"))
+                    Opt.Format = FrameFormat::Y4M;
+                else if (!std::strcmp(Name, "png"))
+                    Opt.Format = FrameFormat::PNG;
+                else if (!std::strcmp(Name, "raw"))
+                    Opt.Format = FrameFormat::RawRGBA;
+                else
+                    return false;
+            }
+            else if (!std::strcmp(Arg, "--frames") && Next(1))
+                Opt.Frames = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--fps") && Next(1))
+                Opt.FPS = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--size") && Next(2))
+            {
+                Opt.Width  = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+                Opt.Height = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (!std::strcmp(Arg, "--tile") && Next(1))
+                Opt.TileSize = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--type") && Next(1))
+                Opt.Type = std::atoi(argv[++i]);
+            else if (!std::strcmp(Arg, "--maxiter") && Next(1))
+                Opt.MaxIter = std::atoi(argv[++i]);
+            else if (!std::strcmp(Arg, "--zoom") && Next(1))
+                Opt.Zoom = std::atof(argv[++i]);
+            else if (!std::strcmp(Arg, "--zoom-speed") && Next(1))
+                Opt.ZoomSpeed = std::atof(argv[++i]);
+            else if (!std::strcmp(Arg, "--offset") && Next(2))
+            {
+                Opt.OffsetX = std::atof(argv[++i]);
+                Opt.OffsetY = std::atof(argv[++i]);
+            }
+            else if (!std::strcmp(Arg, "--double"))
+                Opt.Precision = CPU_PRECISION_DOUBLE;
+            else if (!std::strcmp(Arg, "--double-float"))
+                Opt.Precision = CPU_PRECISION_DOUBLE_FLOAT;
+            else if (!std::strcmp(Arg, "--local-workers") && Next(1))
+                Opt.LocalWorkers = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else
+                return false;
+        }
+        return Opt.Frames > 0 && Opt.FPS > 0 && Opt.Width > 0 && Opt.Height > 0 && Opt.TileSize > 0 && Opt.Type >= 0 &&
+            Opt.Type < CPU_FRACTAL_2D_COUNT;
+    }
+
+    // Mismos valores por defecto que FractalViewer::Initialize; Time y Zoom avanzan como en
+    // FractalExportCPU
+    CPUShaderConstants MakeConstants(const FarmOptions& Opt, float Time, double Zoom)
+    {
+        const DoubleFloat<float> ZoomDF  = DFFromDouble(Zoom);
+        const DoubleFloat<float> OffsetX = DFFromDouble(Opt.OffsetX);
+        const DoubleFloat<float> OffsetY = DFFromDouble(Opt.OffsetY);
+
+        CPUShaderConstants C = {};
+        C.TimeAndResolution  = {Time, static_cast<float>(Opt.Width), static_cast<float>(Opt.Height), static_cast<float>(Opt.Type)};
+        C.ZoomOffset         = {ZoomDF.Hi, OffsetX.Hi, OffsetY.Hi, 0.0f};
+        C.ZoomOffsetLo       = {ZoomDF.Lo, OffsetX.Lo, OffsetY.Lo, 0.0f};
+        C.FractalColor       = {1, 1, 1, 1};
+        C.BackgroundColor    = {0, 0, 0, 1};
+        C.maxiter            = Opt.MaxIter;
+        C.FractalParams1     = {100.0f, 2.0f, static_cast<float>(Opt.Precision)};
+        C.FractalParams2     = {1, 0, 0, 0};
+        C.Options3D          = {100, 10.0f, 0.001f, 0};
+        C.AnimationParams    = {1.0f, 0, 0, 0};
+        return C;
+    }
+
+    int RunWorker(const FarmOptions& Opt)
+    {
+        FarmWorkerOptions WorkerOptions;
+        WorkerOptions.NumThreads = Opt.NumThreads;
+        std::uint32_t NumTiles   = 0;
+        const bool    Ok         = RunFarmWorker(Opt.Address, WorkerOptions, &NumTiles);
+        std::printf("%u tiles rendered, %s\n", NumTiles, Ok ? "coordinator finished" : "connection lost");
+        return Ok ? 0 : 1;
+    }
+
+    int RunCoordinator(const FarmOptions& Opt)
+    {
+        FarmCoordinator Coordinator{Opt.Address};
+        if (Coordinator.HasError())
+        {
+            std::fprintf(stderr, "Could not listen on %s\n", Opt.Address.c_str());
+            return 1;
+        }
+        std::printf("Listening on %s\n", Coordinator.GetAddress().c_str());
+
+        std::vector<std::thread> LocalWorkers;
+        for (std::uint32_t i = 0; i < Opt.LocalWorkers; ++i)
+        {
+            FarmWorkerOptions WorkerOptions;
+            WorkerOptions.NumThreads = std::max(1u, std::thread::hardware_concurrency() / Opt.LocalWorkers);
+            LocalWorkers.emplace_back([&Coordinator, WorkerOptions] { RunFarmWorker(Coordinator.GetAddress(), WorkerOptions); });
+        }
+
+        std::vector<FarmTile> Tiles;
+        const float           dt   = 1.0f / static_cast<float>(Opt.FPS);
+        double                Zoom = Opt.Zoom;
+        for (std::uint32_t Frame = 0; Frame < Opt.Frames; ++Frame)
+        {
+            AppendFrameTiles(MakeConstants(Opt, Frame * dt, Zoom), Frame, Opt.TileSize, Tiles);
+            Zoom *= 1.0 + Opt.ZoomSpeed * dt;
+        }
+
+        const auto StartTime = std::chrono::steady_clock::now();
+        bool       Ok        = true;
+        if (Opt.Frames == 1)
+        {
+            // Póster: las tiles de la granja son las del BigTIFF, y las ya escritas no se piden
+            const std::string        Path      = WithExtension(Opt.OutPath, ".tif");
+            const CPUShaderConstants Constants = Tiles[0].Constants;
+            PosterWriter             Writer{Path, Opt.Width, Opt.Height, Opt.TileSize, PosterWriter::HashBytes(&Constants, sizeof(Constants))};
+            if (Writer.HasError() || Writer.GetTileSize() != Opt.TileSize)
+            {
+                std::fprintf(stderr, "Could not create %s (the tile size must be a multiple of 16)\n", Path.c_str());
+                return 1;
+            }
+
+            std::vector<FarmTile>      Missing;
+            std::vector<std::uint32_t> PosterIndex;
+            for (std::uint32_t i = 0; i < Tiles.size(); ++i)
+            {
+                if (!Writer.IsTileDone(i))
+                {
+                    Missing.push_back(Tiles[i]);
+                    PosterIndex.push_back(i);
+                }
+            }
+            Ok = Coordinator.Run(Missing, [&](std::uint32_t Index, const FarmTile& Tile, const std::uint32_t* pPixels) {
+                Writer.WriteTile(PosterIndex[Index], pPixels, Tile.Width, Tile.Height);
+                std::printf("\rtile %u / %u, %u workers", Writer.GetNumDone(), Writer.GetNumTiles(), Coordinator.GetNumWorkers());
+                std::fflush(stdout);
+            });
+            Ok = Writer.Finish() && Ok;
+            std::printf("\n%s: %u / %u tiles\n", Path.c_str(), Writer.GetNumDone(), Writer.GetNumTiles());
+        }
+        else
+        {
+            // Animación: cada frame se junta en memoria y se escribe en orden al completarse
+            const std::string Path = FrameWriter::GetOutputPath(Opt.OutPath, Opt.Format);
+            FrameWriter       Writer{Path, Opt.Format, Opt.Width, Opt.Height, Opt.FPS};
+            const std::uint32_t TilesPerFrame = static_cast<std::uint32_t>(Tiles.size()) / Opt.Frames;
+
+            struct PartialFrame
+            {
+                std::vector<std::uint8_t> RGBA;
+                std::uint32_t             NumTiles = 0;
+            };
+            std::map<std::uint32_t, PartialFrame> Frames;
+            std::uint32_t                         NextFrame = 0;
+
+            Ok = Coordinator.Run(Tiles, [&](std::uint32_t, const FarmTile& Tile, const std::uint32_t* pPixels) {
+                PartialFrame& Frame = Frames[Tile.Frame];
+                Frame.RGBA.resize(static_cast<size_t>(Opt.Width) * Opt.Height * 4);
+                for (std::uint32_t y = 0; y < Tile.Height; ++y)
+                    std::memcpy(&Frame.RGBA[(static_cast<size_t>(Tile.Y0 + y) * Opt.Width + Tile.X0) * 4], pPixels + static_cast<size_t>(y) * Tile.Width,
+                                Tile.Width * 4);
+                ++Frame.NumTiles;
+
+                for (auto It = Frames.find(NextFrame); It != Frames.end() && It->second.NumTiles == TilesPerFrame; It = Frames.find(NextFrame))
+                {
+                    Writer.Push(std::move(It->second.RGBA));
+                    Frames.erase(It);
+                    std::printf("\rframe %u / %u, %u workers", ++NextFrame, Opt.Frames, Coordinator.GetNumWorkers());
+                    std::fflush(stdout);
+                }
+            });
+            Writer.Finish();
+            Ok = Ok && !Writer.HasError();
+            std::printf("\n%u frames written to %s\n", Writer.GetNumWritten(), Path.c_str());
+        }
+
+        const FarmStats& Stats   = Coordinator.GetStats();
+        const double     Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+        std::printf("%.1f s, %u workers (%u lost), %u tiles reissued, %u duplicated at the end\n", Seconds, Stats.Workers, Stats.LostWorkers,
+                    Stats.Reissued, Stats.Duplicated);
+
+        Coordinator.Shutdown();
+        for (std::thread& Thread : LocalWorkers)
+            Thread.join();
+        return Ok ? 0 : 1;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    FarmOptions Opt;
+    if (!ParseOptions(argc, argv, Opt))
+    {
+        PrintUsage();
+        return 1;
+    }
+    return Opt.Worker ? RunWorker(Opt) : RunCoordinator(Opt);
+}
@@ -0,0 +1,123 @@
+// Prueba de la granja de render (FarmCoordinator + RunFarmWorker) en esta máquina:
+//  - tres workers por TCP en 127.0.0.1, uno de los cuales se desconecta sin responder a su
+//    segunda tile; las tiles de dos frames 2D y uno 3D, juntadas según llegan, coinciden píxel
+//    a píxel con Render2D / Render3D y las del worker perdido se vuelven a repartir;
+//  - en POSIX, lo mismo con dos workers por un socket Unix;
+//  - al destruir el coordinador los workers que quedan terminan con la orden de despedida.
+// Los workers son hilos de este proceso con su propio CPUFractalRenderer, pero solo hablan
+// con el coordinador por el socket, igual que procesos separados. Devuelve 1 si algo falla.
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../Export/RenderFarm.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    CPUShaderConstants MakeConstants(bool Is3D, std::uint32_t Width, std::uint32_t Height, float Time)
+    {
+        const int Type = Is3D ? static_cast<int>(CPU_FRACTAL_3D_MANDELBULB) : static_cast<int>(CPU_FRACTAL_2D_MANDELBROT_COLORS);
+
+        CPUShaderConstants C  = MakeTestConstants(Type, static_cast<float>(Width), static_cast<float>(Height), 1.0f, -0.5f, 0.0f);
+        C.TimeAndResolution.x = Time;
+        C.maxiter             = 200;
+        C.Options3D.w         = 8.0f;
+        C.CameraPos           = {0.0f, 0.0f, -2.5f, Is3D ? 1.0f : 0.0f};
+        return C;
+    }
+
+    // NumWorkers workers contra un coordinador en Address; el primero abandona su tile DropAfter
+    bool TestFarm(const char* Name, const std::string& Address, std::uint32_t NumWorkers, std::uint32_t DropAfter)
+    {
+        std::vector<CPUShaderConstants> Frames = {MakeConstants(false, 200, 150, 0.0f), MakeConstants(false, 200, 150, 1.5f),
+                                                  MakeConstants(true, 120, 90, 0.0f)};
+        std::vector<FarmTile>           Tiles;
+        for (std::uint32_t f = 0; f < Frames.size(); ++f)
+            AppendFrameTiles(Frames[f], f, 32, Tiles);
+
+        std::vector<CPUImage> Images(Frames.size());
+        for (size_t f = 0; f < Frames.size(); ++f)
+            Images[f].Resize(static_cast<std::uint32_t>(Frames[f].TimeAndResolution.y), static_cast<std::uint32_t>(Frames[f].TimeAndResolution.z));
+
+        std::vector<std::thread>   Workers;
+        std::vector<std::uint32_t> WorkerTiles(NumWorkers, 0);
+        std::vector<char>          WorkerBye(NumWorkers, 0);
+        std::uint32_t              Delivered = 0;
+        bool                       Ran       = false;
+        FarmStats                  Stats;
+        {
+            FarmCoordinator Coordinator{Address};
+            if (Coordinator.HasError())
+            {
+                std::printf("%-4s could not listen on %s  FAIL\n", Name, Address.c_str());
+                return false;
+            }
+            Coordinator.SetIdleTimeout(30.0);
+
+            for (std::uint32_t w = 0; w < NumWorkers; ++w)
+            {
+                FarmWorkerOptions Options;
+                Options.NumThreads = 1;
+                Options.DropAfter  = w == 0 ? DropAfter : 0;
+                Workers.emplace_back([&, w, Options] { WorkerBye[w] = RunFarmWorker(Coordinator.GetAddress(), Options, &WorkerTiles[w]); });
+            }
+
+            Ran = Coordinator.Run(Tiles, [&](std::uint32_t, const FarmTile& Tile, const std::uint32_t* pPixels) {
+                CPUImage& Image = Images[Tile.Frame];
+                for (std::uint32_t y = 0; y < Tile.Height; ++y)
+                    for (std::uint32_t x = 0; x < Tile.Width; ++x)
+                        Image.Pixels[(Tile.Y0 + y) * Image.Width + Tile.X0 + x] = pPixels[y * Tile.Width + x];
+                ++Delivered;
+            });
+            Stats = Coordinator.GetStats();
+        }
+        for (std::thread& Thread : Workers)
+            Thread.join();
+
+        // Referencia: cada frame entero con un solo renderizador
+        CPUFractalRenderer Renderer;
+        size_t             Mismatches = 0;
+        for (size_t f = 0; f < Frames.size(); ++f)
+        {
+            CPUImage Reference;
+            if (Frames[f].CameraPos.w > 0.5f)
+                Renderer.Render3D(Frames[f], Reference);
+            else
+                Renderer.Render2D(Frames[f], Reference);
+            for (size_t i = 0; i < Reference.Pixels.size(); ++i)
+                Mismatches += Images[f].Pixels[i] != Reference.Pixels[i] ? 1 : 0;
+        }
+
+        // El worker que abandona no recibe la despedida; los demás sí
+        bool ByeOk = true;
+        for (std::uint32_t w = 0; w < NumWorkers; ++w)
+            ByeOk = ByeOk && (WorkerBye[w] != 0) == (w != 0 || DropAfter == 0);
+
+        std::uint32_t Rendered = 0;
+        for (std::uint32_t n : WorkerTiles)
+            Rendered += n;
+
+        const bool Reissued = DropAfter == 0 || (Stats.LostWorkers == 1 && Stats.Reissued >= 1);
+        const bool Ok       = Ran && Delivered == Tiles.size() && Mismatches == 0 && Reissued && ByeOk && Stats.Workers == NumWorkers;
+        std::printf("%-4s %u workers: %u / %zu tiles (%u rendered, %u lost workers, %u reissued, %u duplicated), %zu mismatched px, bye %s  %s\n",
+                    Name, NumWorkers, Delivered, Tiles.size(), Rendered, Stats.LostWorkers, Stats.Reissued, Stats.Duplicated, Mismatches,
+                    ByeOk ? "ok" : "FAIL", Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    bool Ok = true;
+    Ok      = TestFarm("tcp", "127.0.0.1:0", 3, 2) && Ok;
+#ifndef _WIN32
+    Ok = TestFarm("unix", "unix:fractal_farm_test.sock", 2, 0) && Ok;
+#endif
+    return Ok ? 0 : 1;
+}
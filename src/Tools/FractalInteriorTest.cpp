@@ -0,0 +1,89 @@
+// Prueba de la salida anticipada del interior 2D (FractalParams2.y): cada vista se renderiza
+// con RenderEscape2D sin y con ella y se compara el resultado de escape píxel a píxel:
+//  - los píxeles que escapan lo hacen en la misma iteración (la detección de periodo no puede
+//    cortar una órbita que todavía iba a escapar salvo en una fracción mínima);
+//  - los que llegan al tope lo siguen haciendo;
+//  - en las vistas con mucho interior, las iteraciones ejecutadas bajan al menos a la mitad;
+//  - con c animado (Deformation / Phase, t != 0) la órbita empieza en z = uv y no en c: la
+//    prueba de cardioide / bulbo no puede marcar como interior píxeles que escapan.
+// Devuelve 1 si algo falla.
+
+#include <cstdio>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct InteriorView
+    {
+        const char* Name;
+        int         Type;
+        int         Precision;
+        float       Zoom, OffsetX, OffsetY;
+        bool        ExpectSpeedup;   // mucho interior: las iteraciones deben bajar a la mitad
+        float       Time        = 0; // con Deformation / Phase distintos de 0, c animado
+        float       Deformation = 0; // AnimationParams.z
+        float       Phase       = 0; // AnimationParams.w
+    };
+
+    bool TestView(CPUFractalRenderer& Renderer, const InteriorView& View)
+    {
+        CPUShaderConstants C  = MakeTestConstants(View.Type, 320.0f, 240.0f, View.Zoom, View.OffsetX, View.OffsetY);
+        C.TimeAndResolution.x = View.Time;
+        C.maxiter             = 2000;
+        C.FractalParams1.z    = static_cast<float>(View.Precision);
+        C.AnimationParams.z   = View.Deformation;
+        C.AnimationParams.w   = View.Phase;
+
+        std::vector<CPUEscapeSample> Full, EarlyOut;
+        C.FractalParams2 = {1, 0, 0, 0};
+        Renderer.RenderEscape2D(C, Full);
+        const std::uint64_t FullIterations = Renderer.GetLastStats().Iterations;
+        C.FractalParams2                   = {1, 1, 0, 0};
+        Renderer.RenderEscape2D(C, EarlyOut);
+        const std::uint64_t EarlyIterations = Renderer.GetLastStats().Iterations;
+
+        const float Cap       = static_cast<float>(C.maxiter);
+        size_t      Capped    = 0;
+        size_t      Different = 0;
+        for (size_t i = 0; i < Full.size(); ++i)
+        {
+            Capped += Full[i].Iter >= Cap;
+            Different += Full[i].Iter != EarlyOut[i].Iter;
+        }
+
+        const double Mismatch = static_cast<double>(Different) / static_cast<double>(Full.size());
+        const double Ratio    = static_cast<double>(EarlyIterations) / static_cast<double>(FullIterations);
+        const bool   Ok       = Mismatch <= 1e-3 && (!View.ExpectSpeedup || Ratio <= 0.5) && EarlyIterations <= FullIterations;
+        std::printf("%-28s %5.1f%% interior, %.4f%% mismatch, %6.2f%% of the iterations  %s\n", View.Name,
+                    100.0 * Capped / static_cast<double>(Full.size()), 100.0 * Mismatch, 100.0 * Ratio, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    static const InteriorView Views[] = {
+        {"mandelbrot_float", CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_FLOAT, 1.0f, -0.5f, 0.0f, true},
+        {"mandelbrot_double", CPU_FRACTAL_2D_MANDELBROT, CPU_PRECISION_DOUBLE, 1.0f, -0.5f, 0.0f, true},
+        {"mandelbrot_df", CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_DOUBLE_FLOAT, 1.0f, -0.5f, 0.0f, true},
+        {"mandelbrot_float_deep", CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_FLOAT, 2e4f, -0.7436439f, 0.1318259f, false},
+        {"burning_ship_double", CPU_FRACTAL_2D_BURNING_SHIP, CPU_PRECISION_DOUBLE, 1.0f, -0.5f, 0.0f, true},
+        {"burning_ship_colors_deep", CPU_FRACTAL_2D_BURNING_SHIP_COLORS, CPU_PRECISION_FLOAT, 2e4f, -1.7619f, -0.0283f, false},
+        {"julia_dragons_float", CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS, CPU_PRECISION_FLOAT, 1.0f, 0.0f, 0.0f, true},
+        {"mandelbrot_float_animated", CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_FLOAT, 1.0f, -0.5f, 0.0f, false, 1.5707964f, 0.5f, 0.0f},
+        {"mandelbrot_double_animated", CPU_FRACTAL_2D_MANDELBROT, CPU_PRECISION_DOUBLE, 1.0f, -0.5f, 0.0f, false, 1.5707964f, 1.5f, 0.0f},
+        {"mandelbrot_df_animated", CPU_FRACTAL_2D_MANDELBROT_COLORS, CPU_PRECISION_DOUBLE_FLOAT, 1.0f, -0.5f, 0.0f, false, 0.7f, 0.3f, 0.2f},
+        {"mandelbrot_float_phase", CPU_FRACTAL_2D_MANDELBROT, CPU_PRECISION_FLOAT, 1.0f, -0.5f, 0.0f, false, 0.4f, 0.0f, 0.15f},
+    };
+
+    CPUFractalRenderer Renderer;
+    bool               Ok = true;
+    for (const InteriorView& View : Views)
+        Ok = TestView(Renderer, View) && Ok;
+    return Ok ? 0 : 1;
+}
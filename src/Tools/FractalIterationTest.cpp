@@ -0,0 +1,86 @@
+// Prueba del presupuesto automático de iteraciones (CPUIterationBudget):
+//  - las cubetas del histograma y los contadores de AccumulateEscapeStats en un buffer hecho
+//    a mano (escaparon, en el tope y en el tope junto a un escape tardío);
+//  - el controlador en bucle cerrado con RenderEscape2D, como en el viewer: una vista general
+//    que empieza en 10000 baja, un zoom 2e4 que empieza en 32 sube, y los dos se quedan
+//    quietos en un valor con los píxeles sin resolver por debajo del umbral.
+// Devuelve 1 si algo falla.
+
+#include <cstdio>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../CPU/CPUIterationBudget.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    bool TestHistogram(CPUThreadPool& Pool)
+    {
+        bool BinsOk = GetEscapeHistogramBin(0.0f) == 0 && GetEscapeHistogramBin(1e9f) == CPUEscapeHistogramBins - 1;
+        for (std::uint32_t Bin = 0; Bin + 1 < CPUEscapeHistogramBins; ++Bin)
+            BinsOk = BinsOk && GetEscapeHistogramBin(GetEscapeHistogramBinEnd(Bin) * 0.999f) <= Bin &&
+                GetEscapeHistogramBin(GetEscapeHistogramBinEnd(Bin) * 1.001f + 0.001f) > Bin;
+
+        // 4x3 con tope 100: dos píxeles en el tope, uno junto a un escape en 60 (tardío) y
+        // otro rodeado de escapes en 5 (interior resuelto)
+        const float Iters[12] = {
+            5, 5, 5, 60,
+            5, 100, 5, 100,
+            5, 5, 5, 5};
+        std::vector<CPUEscapeSample> Samples;
+        for (float Iter : Iters)
+            Samples.push_back(CPUEscapeSample{Iter, 0.0f});
+        CPUEscapeStats Stats;
+        AccumulateEscapeStats(Pool, Samples.data(), 4, 3, 100, Stats);
+
+        const bool Ok = BinsOk && Stats.Pixels == 12 && Stats.Escaped == 10 && Stats.Capped == 2 && Stats.Unresolved == 1 &&
+            Stats.Bins[GetEscapeHistogramBin(5.0f)] == 9 && Stats.Bins[GetEscapeHistogramBin(60.0f)] == 1 && Stats.MaxIter == 100;
+        std::printf("%-10s bins %s, %llu escaped, %llu capped, %llu unresolved  %s\n", "histogram", BinsOk ? "ok" : "FAIL",
+                    static_cast<unsigned long long>(Stats.Escaped), static_cast<unsigned long long>(Stats.Capped),
+                    static_cast<unsigned long long>(Stats.Unresolved), Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+
+    // Frames hasta que el controlador deja de cambiar maxiter (o MaxFrames)
+    bool TestController(CPUFractalRenderer& Renderer, const char* Name, float Zoom, float OffsetX, float OffsetY, int StartIter, bool ExpectRaise)
+    {
+        CPUShaderConstants C = MakeTestConstants(CPU_FRACTAL_2D_MANDELBROT_COLORS, 320.0f, 240.0f, Zoom, OffsetX, OffsetY);
+
+        const CPUIterationBudgetSettings Settings;
+        const std::uint32_t              MaxFrames = 24;
+        std::vector<CPUEscapeSample>     Samples;
+        CPUEscapeStats                   Stats;
+        int                              MaxIter = StartIter;
+        std::uint32_t                    Frames  = 0;
+        bool                             Stable  = false;
+        for (; Frames < MaxFrames && !Stable; ++Frames)
+        {
+            C.maxiter = MaxIter;
+            Renderer.RenderEscape2D(C, Samples);
+            AccumulateEscapeStats(Renderer.GetThreadPool(), Samples.data(), 320, 240, MaxIter, Stats);
+            const int Next = ChooseIterationBudget(Stats, Settings);
+            Stable         = Next == MaxIter;
+            MaxIter        = Next;
+        }
+
+        const double Unresolved = static_cast<double>(Stats.Unresolved) / static_cast<double>(Stats.Pixels);
+        const bool   Moved      = ExpectRaise ? MaxIter > StartIter : MaxIter < StartIter;
+        const bool   Ok         = Stable && Moved && Unresolved <= Settings.UnresolvedFraction;
+        std::printf("%-10s %d -> %d in %u frames, %.2f%% capped, %.4f%% unresolved  %s\n", Name, StartIter, MaxIter, Frames,
+                    100.0 * Stats.Capped / static_cast<double>(Stats.Pixels), 100.0 * Unresolved, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    CPUFractalRenderer Renderer;
+    bool               Ok = true;
+    Ok                    = TestHistogram(Renderer.GetThreadPool()) && Ok;
+    Ok                    = TestController(Renderer, "shallow", 1.0f, -0.5f, 0.0f, 10000, false) && Ok;
+    Ok                    = TestController(Renderer, "deep", 2e4f, -0.7436439f, 0.1318259f, 32, true) && Ok;
+    return Ok ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+// Prueba de la marcha por paquetes (RenderPacket3D): cada vista se renderiza con Render3D rayo
+// a rayo y por paquetes y se comparan los píxeles y las evaluaciones del DE:
+//  - los cuatro tipos 3D, el Mandelbulb también con la potencia animada (DE lane a lane);
+//  - con la prepasada de cono, con la historia temporal (distancia de inicio reproyectada) y
+//    con el cache de distancias (lanes resueltas con el cache y lanes con el DE);
+//  - como mucho un 0.5% de píxeles distintos (el Menger, por el fmod vectorial) y las mismas
+//    evaluaciones del DE salvo ese margen;
+//  - los DE del Mandelbox y del Quaternion Julia son positivos lejos del fractal y no pasan
+//    de |p|, y el fractal se ve en cada vista.
+// Devuelve 1 si algo falla.
+
+#include <cmath>
+#include <cstdio>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct PacketView
+    {
+        const char* Name;
+        int         Type;
+        CPUFloat3   CameraPos;
+        float       Yaw, Pitch; // grados
+        float       BulbPower;  // 0 = animada
+        bool        Cone;
+        bool        Temporal;
+        bool        Bricks;
+    };
+
+    CPUShaderConstants MakeView(const PacketView& View, float Shift)
+    {
+        CPUShaderConstants C  = MakeTestConstants(View.Type, 96.0f, 72.0f);
+        C.TimeAndResolution.x = 1.5f;
+        C.maxiter             = 4;
+        C.Options3D.w         = View.BulbPower;
+
+        const float Yaw   = (View.Yaw + Shift * 25.0f) * 3.14159265f / 180.0f;
+        const float Pitch = View.Pitch * 3.14159265f / 180.0f;
+        C.CameraPos       = {View.CameraPos.x - Shift, View.CameraPos.y, View.CameraPos.z - Shift, 1.0f};
+        C.CameraDirX      = {std::cos(Yaw), 0.0f, -std::sin(Yaw), 0.0f};
+        C.CameraDirY      = {-std::sin(Yaw) * std::sin(Pitch), std::cos(Pitch), -std::cos(Yaw) * std::sin(Pitch), 0.0f};
+        C.CameraDirZ      = {std::sin(Yaw) * std::cos(Pitch), std::sin(Pitch), std::cos(Yaw) * std::cos(Pitch), 0.0f};
+        return C;
+    }
+
+    // Render3D de la vista; con Temporal, antes un frame con la cámara desplazada
+    CPURenderStats Render(CPUFractalRenderer& Renderer, const PacketView& View, bool Packets, CPUImage& Image)
+    {
+        const CPUShaderConstants C = MakeView(View, 0.0f);
+
+        Renderer.ResetTemporalHistory();
+        Renderer.SetPacketMarching(Packets);
+        Renderer.SetConePrepass(View.Cone);
+        Renderer.SetTemporalReprojection(View.Temporal);
+        if (View.Temporal)
+            Renderer.Render3D(MakeView(View, 0.02f), Image);
+        Renderer.Render3D(C, Image);
+        return Renderer.GetLastStats();
+    }
+
+    bool TestView(const PacketView& View)
+    {
+        // El cache se hornea una vez y lo usan las dos marchas
+        CPUFractalRenderer    Renderer;
+        CPUDistanceBrickCache Bricks;
+        if (View.Bricks)
+        {
+            Bricks.Prepare(Renderer.GetThreadPool(), MakeView(View, 0.0f), CPUDistanceBrickSettings{});
+            Bricks.BakeNearCamera(Renderer.GetThreadPool(), View.CameraPos, Bricks.GetStats().BandBricks);
+            Renderer.SetDistanceBricks(&Bricks);
+        }
+
+        CPUImage             Scalar, Packet;
+        const CPURenderStats ScalarStats = Render(Renderer, View, false, Scalar);
+        const CPURenderStats PacketStats = Render(Renderer, View, true, Packet);
+
+        size_t Different = 0;
+        for (size_t i = 0; i < Scalar.Pixels.size(); ++i)
+            Different += Scalar.Pixels[i] != Packet.Pixels[i];
+
+        // Píxeles con impacto, rayo a rayo desde la cámara
+        const CPUShaderConstants C       = MakeView(View, 0.0f);
+        const CPUFractal3DSetup  Setup   = MakeFractal3DSetup(C);
+        size_t                   Fractal = 0;
+        for (int y = 0; y < Setup.Height; ++y)
+        {
+            for (int x = 0; x < Setup.Width; ++x)
+            {
+                CPURay3DStats Ray;
+                RenderPixel3D(Setup, C, static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, Ray);
+                Fractal += Ray.Hit;
+            }
+        }
+
+        const double Pixels        = static_cast<double>(Scalar.Pixels.size());
+        const double Mismatch      = Different / Pixels;
+        const double Coverage      = Fractal / Pixels;
+        const double EvaluationGap = std::abs(static_cast<double>(PacketStats.DEEvaluations) - static_cast<double>(ScalarStats.DEEvaluations)) /
+            static_cast<double>(ScalarStats.DEEvaluations);
+        const bool Ok = Mismatch <= 0.005 && EvaluationGap <= 0.005 && Coverage > 0.02;
+        std::printf("%-24s %5.1f%% fractal, %.3f%% px differ, %.1f / %.1f DE per ray, %.3f%% DE gap  %s\n", View.Name, 100.0 * Coverage,
+                    100.0 * Mismatch, ScalarStats.GetDEEvaluationsPerRay(), PacketStats.GetDEEvaluationsPerRay(), 100.0 * EvaluationGap,
+                    Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+
+    // Lejos del fractal el DE es positivo y no se pasa: queda por debajo de |p|
+    bool TestDistances()
+    {
+        bool Ok = true;
+        for (float z : {3.5f, 5.0f, 8.0f})
+        {
+            const CPUFloat3 Pos   = {0.3f, -0.2f, -z};
+            const float     Box   = DistanceMandelbox(Pos, 2.0f);
+            const float     Julia = DistanceQuaternionJulia(Pos, DefaultQuaternionJuliaC);
+            const float     Bound = std::sqrt(Pos.x * Pos.x + Pos.y * Pos.y + Pos.z * Pos.z);
+            const bool      Good  = Box > 0.0f && Box <= Bound && Julia > 0.0f && Julia <= Bound;
+            std::printf("DE at z = -%.1f: mandelbox %.4f, quaternion julia %.4f  %s\n", z, Box, Julia, Good ? "ok" : "FAIL");
+            Ok = Good && Ok;
+        }
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    static const PacketView Views[] = {
+        {"mandelbulb_power8", CPU_FRACTAL_3D_MANDELBULB, {0.0f, 0.0f, -4.0f}, 0.0f, 0.0f, 8.0f, false, false, false},
+        {"mandelbulb_animated", CPU_FRACTAL_3D_MANDELBULB, {-1.6f, 1.2f, -2.8f}, 30.0f, 20.0f, 0.0f, false, false, false},
+        {"mandelbulb_cone", CPU_FRACTAL_3D_MANDELBULB, {0.0f, 0.0f, -4.0f}, 0.0f, 0.0f, 8.0f, true, false, false},
+        {"mandelbulb_temporal", CPU_FRACTAL_3D_MANDELBULB, {0.2f, 0.1f, -2.3f}, 5.0f, 2.0f, 8.0f, false, true, false},
+        {"mandelbulb_bricks", CPU_FRACTAL_3D_MANDELBULB, {0.2f, 0.1f, -2.3f}, 5.0f, 2.0f, 8.0f, false, false, true},
+        {"menger", CPU_FRACTAL_3D_MENGER_SPONGE, {0.3f, 0.2f, -2.5f}, 25.0f, -15.0f, 0.0f, false, false, false},
+        {"menger_bricks", CPU_FRACTAL_3D_MENGER_SPONGE, {0.1f, 0.2f, -2.5f}, 0.0f, 0.0f, 0.0f, false, false, true},
+        {"mandelbox", CPU_FRACTAL_3D_MANDELBOX, {-2.82f, -2.05f, -4.88f}, 30.0f, 20.0f, 0.0f, false, false, false},
+        {"mandelbox_temporal", CPU_FRACTAL_3D_MANDELBOX, {-2.82f, -2.05f, -4.88f}, 30.0f, 20.0f, 0.0f, true, true, false},
+        {"quaternion_julia", CPU_FRACTAL_3D_QUATERNION_JULIA, {-0.99f, -0.78f, -2.72f}, 20.0f, 15.0f, 0.0f, false, false, false},
+    };
+
+    bool Ok = TestDistances();
+    for (const PacketView& View : Views)
+        Ok = TestView(View) && Ok;
+    return Ok ? 0 : 1;
+}
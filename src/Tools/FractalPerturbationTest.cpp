@@ -0,0 +1,110 @@
+// Prueba del deep zoom con δ en float del pixel shader (CPUPerturbationRenderer::SetFloatDeltas,
+// el mismo algoritmo que EscapePerturbation2D de fractal2D.fxh) frente a δ en double:
+//  - al menos el 95% de los píxeles tiene las iteraciones a menos de un 10% de las de double,
+//    desde zoom 1e10 (sin escala) hasta 1e250, muy por debajo de los ~1e-38 de float;
+//  - la imagen de referencia tiene estructura (muchos valores de iteración distintos), para
+//    que la coincidencia no salga de una vista uniforme.
+// Las vistas se centran en puntos de Misiurewicz, con estructura a cualquier zoom: c = i en el
+// Mandelbrot (la serie ya deja δ por encima de 2^-64) y M_{3,1} del eje real en el Burning
+// Ship, sin serie, que recorre entero el tramo con δ escalado. Devuelve 1 si algo falla.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "../CPU/CPUPerturbation.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    constexpr int Width  = 160;
+    constexpr int Height = 120;
+
+    struct DeepScene
+    {
+        const char* Name;
+        int         Type;
+        double      Zoom;
+        const char* CenterX;
+        const char* CenterY;
+        int         MaxIter;
+    };
+
+    std::vector<float> EscapeImage(CPUPerturbationRenderer& Renderer, const DeepScene& S, bool FloatDeltas, double& Ms)
+    {
+        CPUShaderConstants C = MakeTestConstants(S.Type, Width, Height);
+        C.maxiter            = S.MaxIter;
+
+        CPUDeepZoomView View;
+        const unsigned  NumLimbs = BigFloat::LimbsForZoom(S.Zoom * Height);
+        BigFloat::FromString(S.CenterX, NumLimbs, View.CenterX);
+        BigFloat::FromString(S.CenterY, NumLimbs, View.CenterY);
+        View.Zoom = S.Zoom;
+
+        std::vector<CPUEscapeSample> Samples;
+        Renderer.SetFloatDeltas(FloatDeltas);
+        const auto Start = std::chrono::steady_clock::now();
+        Renderer.RenderEscape(View, C, Samples);
+        Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+        std::vector<float> Iter;
+        Iter.reserve(Samples.size());
+        for (const CPUEscapeSample& Sample : Samples)
+            Iter.push_back(Sample.Iter);
+        return Iter;
+    }
+
+    // Porcentaje de píxeles con las iteraciones a menos de un 10% de la referencia
+    double MatchRate(const std::vector<float>& A, const std::vector<float>& Reference)
+    {
+        size_t Matches = 0;
+        for (size_t i = 0; i < A.size(); ++i)
+            Matches += std::abs(A[i] - Reference[i]) <= 0.1f * std::max(Reference[i], 1.0f) ? 1 : 0;
+        return 100.0 * static_cast<double>(Matches) / static_cast<double>(A.size());
+    }
+
+    bool TestScene(CPUPerturbationRenderer& Renderer, const DeepScene& S)
+    {
+        double     MsDouble = 0, MsFloat = 0;
+        const auto Double = EscapeImage(Renderer, S, false, MsDouble);
+        const auto Float  = EscapeImage(Renderer, S, true, MsFloat);
+
+        const double Match    = MatchRate(Float, Double);
+        const size_t Distinct = std::set<float>(Double.begin(), Double.end()).size();
+
+        const bool Ok = Match >= 95.0 && Distinct >= 20;
+        std::printf("%-14s zoom %.0e: float %6.2f%% px match, %4zu iteration values, series skip %5d, double / float %6.1f / %6.1f ms  %s\n",
+                    S.Name, S.Zoom, Match, Distinct, Renderer.GetSeries().SkipIter, MsDouble, MsFloat, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    // M_{3,1} del eje real (z_3 = -z_2, c^3 + 2c^2 + 2c + 2 = 0), con 283 cifras
+    const char* M31 = "-1.54368901269207636157085597180174798652520329765098393524080403783116867392797386648515791457605912546212082922636706018927"
+                      "875646332214101152290921890529272299278169715758295042217008951856341070038520012800028236647726177998690899688410461497697"
+                      "69270868479696119789201814461289913";
+
+    const DeepScene Scenes[] = {
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT, 1e10, "0", "1", 2000},
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT, 1e40, "0", "1", 4000},
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT, 1e100, "0", "1", 8000},
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT_COLORS, 1e250, "0", "1", 16000},
+        {"burning_ship", CPU_FRACTAL_2D_BURNING_SHIP, 1e10, M31, "0", 2000},
+        {"burning_ship", CPU_FRACTAL_2D_BURNING_SHIP, 1e100, M31, "0", 8000},
+        {"burning_ship", CPU_FRACTAL_2D_BURNING_SHIP_COLORS, 1e250, M31, "0", 16000}};
+
+    CPUFractalRenderer      Renderer;
+    CPUPerturbationRenderer Perturbation{Renderer.GetThreadPool()};
+
+    bool Ok = true;
+    for (const DeepScene& S : Scenes)
+        Ok = TestScene(Perturbation, S) && Ok;
+    return Ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+// Póster de tamaño arbitrario (p.ej. 32768 x 32768) con el backend CPU, sin GPU ni swap chain.
+// El lienzo virtual se recorre en tiles de --tile píxeles (CPUFractalRenderer::RenderRegion) y
+// cada tile va directa a un BigTIFF con tiles (PosterWriter), así que la memoria no crece con el
+// tamaño del póster. Si se interrumpe, volver a lanzarlo con los mismos parámetros continúa
+// desde la última tile escrita; --restart empieza de cero.
+//
+//   FractalPosterCPU --out poster.tif --size 32768 32768 --tile 512 --type 0 --maxiter 2000
+//                    --zoom 1 [--offset x y] [--double | --double-float]
+//   FractalPosterCPU --out bulb.tif --size 16384 16384 --type3d 0 --camera 0 0 -2.5
+//                    [--yaw 0] [--pitch 0] [--power 8] [--time 0]
+//
+// --max-tiles N para después de N tiles (repartir el render en varias sesiones).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../Export/PosterWriter.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    struct PosterOptions
+    {
+        std::string   OutPath   = "poster.tif";
+        std::uint32_t Width     = 8192;
+        std::uint32_t Height    = 8192;
+        std::uint32_t TileSize  = 512;
+        bool          Is3D      = false;
+        int           Type      = CPU_FRACTAL_2D_MANDELBROT;
+        int           MaxIter   = 100;
+        double        Zoom      = 1.0;
+        double        OffsetX   = 0.0;
+        double        OffsetY   = 0.0;
+        int           Precision = CPU_PRECISION_FLOAT;
+        CPUFloat3     CameraPos = {0.0f, 0.0f, -4.0f};
+        float         Yaw       = 0.0f;
+        float         Pitch     = 0.0f;
+        float         BulbPower = 0.0f;
+        float         Time      = 0.0f;
+        std::uint32_t MaxTiles  = 0; // 0 = todas
+        bool          Restart   = false;
+    };
+
+    void PrintUsage()
+    {
+        std::printf("Usage: FractalPosterCPU [--out path.tif] [--size W H] [--tile N] [--type N | --type3d N] [--maxiter N]\n"
+                    "                        [--zoom Z] [--offset X Y] [--double | --double-float] [--camera X Y Z]\n"
+                    "                        [--yaw DEG] [--pitch DEG] [--power P] [--time T] [--max-tiles N] [--restart]\n");
+    }
+
+    bool ParseOptions(int argc, char** argv, PosterOptions& Opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* Arg  = argv[i];
+            auto        Next = [&](int Count) { return i + Count < argc; };
+
+            if (!std::strcmp(Arg, "--out") && Next(1))
+                Opt.OutPath = argv[++i];
+            else if (!std::strcmp(Arg, "--size") && Next(2))
+            {
+                Opt.Width  = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+                Opt.Height = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            }
+            else if (!std::strcmp(Arg, "--tile") && Next(1))
+                Opt.TileSize = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--type") && Next(1))
+            {
+                Opt.Type = std::atoi(argv[++i]);
+                Opt.Is3D = false;
+            }
+            else if (!std::strcmp(Arg, "--type3d") && Next(1))
+            {
+                Opt.Type = std::atoi(argv[++i]);
+                Opt.Is3D = true;
+            }
+            else if (!std::strcmp(Arg, "--maxiter") && Next(1))
+                Opt.MaxIter = std::atoi(argv[++i]);
+            else if (!std::strcmp(Arg, "--zoom") && Next(1))
+                Opt.Zoom = std::atof(argv[++i]);
+            else if (!std::strcmp(Arg, "--offset") && Next(2))
+            {
+                Opt.OffsetX = std::atof(argv[++i]);
+                Opt.OffsetY = std::atof(argv[++i]);
+            }
+            else if (!std::strcmp(Arg, "--double"))
+                Opt.Precision = CPU_PRECISION_DOUBLE;
+            else if (!std::strcmp(Arg, "--double-float"))
+                Opt.Precision = CPU_PRECISION_DOUBLE_FLOAT;
+            else if (!std::strcmp(Arg, "--camera") && Next(3))
+            {
+                Opt.CameraPos.x = static_cast<float>(std::atof(argv[++i]));
+                Opt.CameraPos.y = static_cast<float>(std::atof(argv[++i]));
+                Opt.CameraPos.z = static_cast<float>(std::atof(argv[++i]));
+            }
+            else if (!std::strcmp(Arg, "--yaw") && Next(1))
+                Opt.Yaw = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(Arg, "--pitch") && Next(1))
+                Opt.Pitch = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(Arg, "--power") && Next(1))
+                Opt.BulbPower = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(Arg, "--time") && Next(1))
+                Opt.Time = static_cast<float>(std::atof(argv[++i]));
+            else if (!std::strcmp(Arg, "--max-tiles") && Next(1))
+                Opt.MaxTiles = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+            else if (!std::strcmp(Arg, "--restart"))
+                Opt.Restart = true;
+            else
+                return false;
+        }
+        const int NumTypes = Opt.Is3D ? static_cast<int>(CPU_FRACTAL_3D_COUNT) : static_cast<int>(CPU_FRACTAL_2D_COUNT);
+        return Opt.Width > 0 && Opt.Height > 0 && Opt.TileSize > 0 && Opt.Type >= 0 && Opt.Type < NumTypes;
+    }
+
+    // Mismos valores por defecto que FractalViewer::Initialize; la resolución es la del póster
+    CPUShaderConstants MakeConstants(const PosterOptions& Opt)
+    {
+        const DoubleFloat<float> Zoom    = DFFromDouble(Opt.Zoom);
+        const DoubleFloat<float> OffsetX = DFFromDouble(Opt.OffsetX);
+        const DoubleFloat<float> OffsetY = DFFromDouble(Opt.OffsetY);
+
+        CPUShaderConstants C = {};
+        C.TimeAndResolution  = {Opt.Time, static_cast<float>(Opt.Width), static_cast<float>(Opt.Height), static_cast<float>(Opt.Type)};
+        C.ZoomOffset         = {Zoom.Hi, OffsetX.Hi, OffsetY.Hi, 0.0f};
+        C.ZoomOffsetLo       = {Zoom.Lo, OffsetX.Lo, OffsetY.Lo, 0.0f};
+        C.FractalColor       = {1, 1, 1, 1};
+        C.BackgroundColor    = {0, 0, 0, 1};
+        C.maxiter            = Opt.MaxIter;
+        C.FractalParams1     = {100.0f, 2.0f, static_cast<float>(Opt.Precision)};
+        C.FractalParams2     = {1, 0, 0, 0};
+        C.Options3D          = {100, 10.0f, 0.001f, Opt.BulbPower};
+        C.AnimationParams    = {1.0f, 0, 0, 0};
+
+        // Base de la cámara como FirstPersonCamera: guiñada sobre Y y luego cabeceo
+        const float Yaw   = Opt.Yaw * 3.14159265f / 180.0f;
+        const float Pitch = Opt.Pitch * 3.14159265f / 180.0f;
+        C.CameraPos       = {Opt.CameraPos.x, Opt.CameraPos.y, Opt.CameraPos.z, Opt.Is3D ? 1.0f : 0.0f};
+        C.CameraDirX      = {std::cos(Yaw), 0.0f, -std::sin(Yaw), 0.0f};
+        C.CameraDirY      = {-std::sin(Yaw) * std::sin(Pitch), std::cos(Pitch), -std::cos(Yaw) * std::sin(Pitch), 0.0f};
+        C.CameraDirZ      = {std::sin(Yaw) * std::cos(Pitch), std::sin(Pitch), std::cos(Yaw) * std::cos(Pitch), 0.0f};
+        return C;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    PosterOptions Opt;
+    if (!ParseOptions(argc, argv, Opt))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const CPUShaderConstants Constants = MakeConstants(Opt);
+    if (Opt.Restart)
+        std::remove((Opt.OutPath + ".progress").c_str());
+
+    PosterWriter Writer{Opt.OutPath, Opt.Width, Opt.Height, Opt.TileSize, PosterWriter::HashBytes(&Constants, sizeof(Constants))};
+    if (Writer.HasError())
+    {
+        std::fprintf(stderr, "Could not create %s\n", Opt.OutPath.c_str());
+        return 1;
+    }
+    if (Writer.IsResumed())
+        std::printf("Resuming %s: %u / %u tiles already written\n", Opt.OutPath.c_str(), Writer.GetNumDone(), Writer.GetNumTiles());
+
+    const std::uint32_t TileSize  = Writer.GetTileSize();
+    const auto          StartTime = std::chrono::steady_clock::now();
+    CPUFractalRenderer  Renderer;
+    CPUImage            Tile;
+    std::uint32_t       Rendered = 0;
+    for (std::uint32_t Index = 0; Index < Writer.GetNumTiles() && !Writer.HasError(); ++Index)
+    {
+        if (Writer.IsTileDone(Index))
+            continue;
+        if (Opt.MaxTiles > 0 && Rendered == Opt.MaxTiles)
+            break;
+
+        const std::uint32_t X0 = (Index % Writer.GetTilesX()) * TileSize;
+        const std::uint32_t Y0 = (Index / Writer.GetTilesX()) * TileSize;
+        Renderer.RenderRegion(Constants, X0, Y0, std::min(TileSize, Opt.Width - X0), std::min(TileSize, Opt.Height - Y0), Tile);
+        Writer.WriteTile(Index, Tile.Pixels.data(), Tile.Width, Tile.Height);
+        ++Rendered;
+
+        const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+        std::printf("\rtile %u / %u (%.1f s)", Writer.GetNumDone(), Writer.GetNumTiles(), Seconds);
+        std::fflush(stdout);
+    }
+    const std::uint32_t NumDone  = Writer.GetNumDone();
+    const bool          Ok       = Writer.Finish();
+    const bool          Complete = NumDone == Writer.GetNumTiles();
+    std::printf("\n%s: %u / %u tiles%s\n", Opt.OutPath.c_str(), NumDone, Writer.GetNumTiles(),
+                !Ok ? ", write error" : Complete ? "" : " (run again to resume)");
+
+    return Ok ? 0 : 1;
+}
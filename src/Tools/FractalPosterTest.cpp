@@ -0,0 +1,197 @@
+// Prueba del póster por tiles (CPUFractalRenderer::RenderRegion + PosterWriter):
+//  - un póster 2D y uno 3D renderizados por tiles, con una interrupción a medias y la
+//    continuación en otro PosterWriter, coinciden píxel a píxel con Render2D / Render3D de la
+//    imagen completa, leyendo las tiles por las tablas del propio BigTIFF;
+//  - al terminar se borra el fichero de progreso y con otra escena no se continúa.
+// Devuelve 1 si algo falla.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../Export/PosterWriter.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    std::uint64_t GetLE(const std::uint8_t* pData, int Bytes)
+    {
+        std::uint64_t v = 0;
+        for (int i = 0; i < Bytes; ++i)
+            v |= std::uint64_t{pData[i]} << (8 * i);
+        return v;
+    }
+
+    // Lector mínimo del BigTIFF de PosterWriter: reconstruye la imagen RGBA8 a partir de
+    // ImageWidth, ImageLength, TileWidth, TileOffsets y TileByteCounts
+    bool ReadPoster(const std::string& Path, CPUImage& Image)
+    {
+        std::FILE* pFile = std::fopen(Path.c_str(), "rb");
+        if (pFile == nullptr)
+            return false;
+        std::vector<std::uint8_t> Data;
+        std::uint8_t              Buffer[1 << 16];
+        for (size_t Read; (Read = std::fread(Buffer, 1, sizeof(Buffer), pFile)) > 0;)
+            Data.insert(Data.end(), Buffer, Buffer + Read);
+        std::fclose(pFile);
+
+        if (Data.size() < 16 || Data[0] != 'I' || Data[1] != 'I' || GetLE(&Data[2], 2) != 43 || GetLE(&Data[4], 2) != 8)
+            return false;
+        const std::uint64_t IFDOffset = GetLE(&Data[8], 8);
+        if (IFDOffset + 8 > Data.size())
+            return false;
+
+        std::uint64_t Width = 0, Height = 0, TileSize = 0, NumOffsets = 0, Offsets = 0, Counts = 0;
+        const std::uint64_t NumTags = GetLE(&Data[IFDOffset], 8);
+        for (std::uint64_t t = 0; t < NumTags; ++t)
+        {
+            const std::uint8_t* pEntry = &Data[IFDOffset + 8 + t * 20];
+            const std::uint64_t Value  = GetLE(pEntry + 12, 8);
+            switch (GetLE(pEntry, 2))
+            {
+                case 256: Width = Value; break;
+                case 257: Height = Value; break;
+                case 322: TileSize = Value; break;
+                case 324: NumOffsets = GetLE(pEntry + 4, 8); Offsets = Value; break;
+                case 325: Counts = Value; break;
+            }
+        }
+        if (Width == 0 || Height == 0 || TileSize == 0)
+            return false;
+
+        const std::uint64_t TilesX = (Width + TileSize - 1) / TileSize;
+        const std::uint64_t TilesY = (Height + TileSize - 1) / TileSize;
+        if (NumOffsets != TilesX * TilesY)
+            return false;
+
+        Image.Resize(static_cast<std::uint32_t>(Width), static_cast<std::uint32_t>(Height));
+        for (std::uint64_t i = 0; i < NumOffsets; ++i)
+        {
+            const std::uint64_t Offset = NumOffsets == 1 ? Offsets : GetLE(&Data[Offsets + i * 8], 8);
+            const std::uint64_t Bytes  = NumOffsets == 1 ? Counts : GetLE(&Data[Counts + i * 8], 8);
+            if (Bytes != TileSize * TileSize * 4 || Offset + Bytes > Data.size())
+                return false;
+
+            const std::uint64_t X0 = (i % TilesX) * TileSize;
+            const std::uint64_t Y0 = (i / TilesX) * TileSize;
+            for (std::uint64_t y = Y0; y < std::min(Y0 + TileSize, Height); ++y)
+            {
+                const std::uint8_t* pSrc = &Data[Offset + (y - Y0) * TileSize * 4];
+                std::memcpy(&Image.Pixels[y * Width + X0], pSrc, (std::min(X0 + TileSize, Width) - X0) * 4);
+            }
+        }
+        return true;
+    }
+
+    bool FileExists(const std::string& Path)
+    {
+        std::FILE* pFile = std::fopen(Path.c_str(), "rb");
+        if (pFile != nullptr)
+            std::fclose(pFile);
+        return pFile != nullptr;
+    }
+
+    // Escribe hasta MaxTiles tiles pendientes (0 = todas); devuelve cuántas escribió
+    std::uint32_t RenderPosterTiles(CPUFractalRenderer& Renderer, const CPUShaderConstants& Constants, PosterWriter& Writer, std::uint32_t MaxTiles)
+    {
+        const std::uint32_t Width    = static_cast<std::uint32_t>(Constants.TimeAndResolution.y);
+        const std::uint32_t Height   = static_cast<std::uint32_t>(Constants.TimeAndResolution.z);
+        const std::uint32_t TileSize = Writer.GetTileSize();
+        std::uint32_t       Rendered = 0;
+        CPUImage            Tile;
+        for (std::uint32_t Index = 0; Index < Writer.GetNumTiles() && (MaxTiles == 0 || Rendered < MaxTiles); ++Index)
+        {
+            if (Writer.IsTileDone(Index))
+                continue;
+            const std::uint32_t X0 = (Index % Writer.GetTilesX()) * TileSize;
+            const std::uint32_t Y0 = (Index / Writer.GetTilesX()) * TileSize;
+            Renderer.RenderRegion(Constants, X0, Y0, std::min(TileSize, Width - X0), std::min(TileSize, Height - Y0), Tile);
+            if (Writer.WriteTile(Index, Tile.Pixels.data(), Tile.Width, Tile.Height))
+                ++Rendered;
+        }
+        return Rendered;
+    }
+
+    CPUShaderConstants MakeConstants(bool Is3D, std::uint32_t Width, std::uint32_t Height)
+    {
+        const int Type = Is3D ? static_cast<int>(CPU_FRACTAL_3D_MANDELBULB) : static_cast<int>(CPU_FRACTAL_2D_MANDELBROT_COLORS);
+
+        CPUShaderConstants C  = MakeTestConstants(Type, static_cast<float>(Width), static_cast<float>(Height), 1.0f, -0.5f, 0.0f);
+        C.TimeAndResolution.x = 0.0f;
+        C.maxiter             = 200;
+        C.Options3D.w         = 8.0f;
+        C.CameraPos           = {0.0f, 0.0f, -2.5f, Is3D ? 1.0f : 0.0f};
+        return C;
+    }
+
+    // Póster interrumpido tras la mitad de las tiles y continuado, frente a la imagen completa
+    bool TestPoster(CPUFractalRenderer& Renderer, const char* Name, bool Is3D, std::uint32_t Width, std::uint32_t Height, std::uint32_t TileSize)
+    {
+        const std::string        Path      = std::string{"fractal_poster_test_"} + Name + ".tif";
+        const CPUShaderConstants Constants = MakeConstants(Is3D, Width, Height);
+        const std::uint64_t      Hash      = PosterWriter::HashBytes(&Constants, sizeof(Constants));
+        std::remove((Path + ".progress").c_str());
+
+        std::uint32_t FirstRun = 0, SecondRun = 0, NumTiles = 0;
+        bool          Resumed = false;
+        {
+            PosterWriter Writer{Path, Width, Height, TileSize, Hash};
+            NumTiles = Writer.GetNumTiles();
+            FirstRun = RenderPosterTiles(Renderer, Constants, Writer, NumTiles / 2);
+            Writer.Finish();
+        }
+        const bool HalfProgress = FileExists(Path + ".progress");
+        {
+            PosterWriter Writer{Path, Width, Height, TileSize, Hash};
+            Resumed   = Writer.IsResumed() && Writer.GetNumDone() == FirstRun;
+            SecondRun = RenderPosterTiles(Renderer, Constants, Writer, 0);
+            Writer.Finish();
+        }
+        const bool NoProgress = !FileExists(Path + ".progress");
+
+        CPUImage Reference, Poster;
+        if (Is3D)
+            Renderer.Render3D(Constants, Reference);
+        else
+            Renderer.Render2D(Constants, Reference);
+        const bool Read       = ReadPoster(Path, Poster) && Poster.Pixels.size() == Reference.Pixels.size();
+        size_t     Mismatches = Read ? 0 : Reference.Pixels.size();
+        for (size_t i = 0; Read && i < Reference.Pixels.size(); ++i)
+            Mismatches += Poster.Pixels[i] != Reference.Pixels[i] ? 1 : 0;
+
+        // Otra escena con el mismo fichero empieza de cero
+        CPUShaderConstants Other = Constants;
+        Other.maxiter += 1;
+        bool Restarted = false;
+        {
+            PosterWriter Writer{Path, Width, Height, TileSize, PosterWriter::HashBytes(&Other, sizeof(Other))};
+            Restarted = !Writer.IsResumed() && Writer.GetNumDone() == 0;
+        }
+        std::remove((Path + ".progress").c_str());
+        std::remove(Path.c_str());
+
+        const bool Ok = FirstRun == NumTiles / 2 && FirstRun + SecondRun == NumTiles && HalfProgress && Resumed && NoProgress && Read &&
+            Mismatches == 0 && Restarted;
+        std::printf("%-4s %ux%u tile %u: %u + %u / %u tiles, %zu mismatched px, resume %s, restart %s  %s\n", Name, Width, Height, TileSize,
+                    FirstRun, SecondRun, NumTiles, Mismatches, Resumed && HalfProgress ? "ok" : "FAIL", Restarted ? "ok" : "FAIL",
+                    Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    CPUFractalRenderer Renderer;
+
+    bool Ok = true;
+    // Tamaños que no son múltiplo de la tile, para las tiles recortadas de los bordes
+    Ok = TestPoster(Renderer, "2d", false, 300, 200, 64) && Ok;
+    Ok = TestPoster(Renderer, "3d", true, 150, 100, 32) && Ok;
+    return Ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// Prueba del modo double-float de los kernels 2D (CPU_PRECISION_DOUBLE_FLOAT) frente a una
+// referencia escalar con la coordenada, c y la órbita en double:
+//  - la coordenada de cada píxel (GetPixelCoordDF) está a menos de 0.05 píxeles de la de
+//    GetPixelCoordD hasta zoom 1e12 (el límite práctico de ~48 bits de mantisa);
+//  - al menos el 95% de los píxeles tiene las iteraciones a menos de un 10% de la referencia.
+//    No se pide igualdad exacta: cerca del borde la órbita es caótica y un error de 2^-48 en c
+//    cambia la cifra exacta en muchos píxeles (también double frente a long double).
+// También imprime la coincidencia del camino float, que a estos zooms ya no resuelve los
+// píxeles, y el tiempo de cada modo. Devuelve 1 si algo falla.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../CPU/CPUFractalKernels2D.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    constexpr int Width  = 160;
+    constexpr int Height = 120;
+
+    struct PrecisionScene
+    {
+        const char* Name;
+        int         Type;
+        double      Zoom;
+        const char* CenterX;
+        const char* CenterY;
+        int         MaxIter;
+    };
+
+    CPUShaderConstants MakeConstants(const PrecisionScene& S, int Precision)
+    {
+        const DoubleFloat<float> Zoom    = DFFromDouble(S.Zoom);
+        const DoubleFloat<float> CenterX = DFFromDouble(std::atof(S.CenterX));
+        const DoubleFloat<float> CenterY = DFFromDouble(std::atof(S.CenterY));
+
+        CPUShaderConstants C = MakeTestConstants(S.Type, Width, Height, Zoom.Hi, CenterX.Hi, CenterY.Hi);
+        C.ZoomOffsetLo       = {Zoom.Lo, CenterX.Lo, CenterY.Lo, 0.0f};
+        C.maxiter            = S.MaxIter;
+        C.FractalParams1.z   = static_cast<float>(Precision);
+        return C;
+    }
+
+    // Iteraciones de todos los píxeles con una precisión y el tiempo que ha costado
+    std::vector<float> EscapeImage(const PrecisionScene& S, int Precision, double& Ms)
+    {
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(MakeConstants(S, Precision));
+        std::vector<CPUEscapeSample> Row(Width);
+        std::vector<float>           Iter;
+        Iter.reserve(Width * Height);
+
+        const auto Start = std::chrono::steady_clock::now();
+        for (int y = 0; y < Height; ++y)
+        {
+            EscapeRow2D(Setup, y, 0, Width, Row.data());
+            for (const CPUEscapeSample& Sample : Row)
+                Iter.push_back(Sample.Iter);
+        }
+        Ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+        return Iter;
+    }
+
+    // Referencia escalar con todo en double (coordenada, c y órbita), también para Burning
+    // Ship, cuyo camino double de los kernels toma el UV en float como el HLSL
+    std::vector<float> EscapeImageReference(const PrecisionScene& S)
+    {
+        const CPUFractal2DSetup Setup = MakeFractal2DSetup(MakeConstants(S, CPU_PRECISION_DOUBLE));
+        std::vector<float>      Iter;
+        Iter.reserve(Width * Height);
+        for (int y = 0; y < Height; ++y)
+        {
+            for (int x = 0; x < Width; ++x)
+            {
+                double X, Y;
+                GetPixelCoordD(Setup, x + 0.5, y + 0.5, X, Y);
+                const bool   Julia = Setup.Formula == CPU_ESCAPE_FORMULA_JULIA;
+                const double cx    = Julia ? Setup.CxD : X + Setup.CxD;
+                const double cy    = Julia ? Setup.CyD : Y + Setup.CyD;
+
+                double zx = X, zy = Y;
+                int    it = 0;
+                for (int i = 0; i < Setup.MaxIter; ++i)
+                {
+                    const double ax = Setup.Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP ? std::abs(zx) : zx;
+                    const double ay = Setup.Formula == CPU_ESCAPE_FORMULA_BURNING_SHIP ? std::abs(zy) : zy;
+                    zx              = ax * ax - ay * ay + cx;
+                    zy              = 2.0 * ax * ay + cy;
+                    if (zx * zx + zy * zy > Setup.Bailout2)
+                        break;
+                    ++it;
+                }
+                Iter.push_back(static_cast<float>(it));
+            }
+        }
+        return Iter;
+    }
+
+    // Porcentaje de píxeles con las iteraciones a menos de un 10% de la referencia: cerca del
+    // borde la órbita es caótica y hasta double frente a long double difiere en la cifra exacta
+    double MatchRate(const std::vector<float>& A, const std::vector<float>& Reference)
+    {
+        size_t Matches = 0;
+        for (size_t i = 0; i < A.size(); ++i)
+            Matches += std::abs(A[i] - Reference[i]) <= 0.1f * std::max(Reference[i], 1.0f) ? 1 : 0;
+        return 100.0 * static_cast<double>(Matches) / static_cast<double>(A.size());
+    }
+
+    // Mayor distancia, en píxeles, entre la coordenada double-float y la double
+    double MaxCoordErrorPx(const PrecisionScene& S)
+    {
+        const CPUFractal2DSetup SetupDF = MakeFractal2DSetup(MakeConstants(S, CPU_PRECISION_DOUBLE_FLOAT));
+        const CPUFractal2DSetup SetupD  = MakeFractal2DSetup(MakeConstants(S, CPU_PRECISION_DOUBLE));
+        const double            PixelSize = 2.0 / (Height * SetupD.ZoomD);
+
+        double MaxError = 0.0;
+        for (int y = 0; y < Height; y += 7)
+        {
+            for (int x = 0; x < Width; x += 5)
+            {
+                DoubleFloat<float> XDF, YDF;
+                double             XD, YD;
+                GetPixelCoordDF(SetupDF, x + 0.5f, y + 0.5f, XDF, YDF);
+                GetPixelCoordD(SetupD, x + 0.5, y + 0.5, XD, YD);
+                MaxError = std::max(MaxError, std::max(std::abs(DFToDouble(XDF) - XD), std::abs(DFToDouble(YDF) - YD)) / PixelSize);
+            }
+        }
+        return MaxError;
+    }
+
+    bool TestScene(const PrecisionScene& S)
+    {
+        double     MsFloat = 0, MsDouble = 0, MsDF = 0;
+        const auto Float     = EscapeImage(S, CPU_PRECISION_FLOAT, MsFloat);
+        const auto Double    = EscapeImage(S, CPU_PRECISION_DOUBLE, MsDouble);
+        const auto DF        = EscapeImage(S, CPU_PRECISION_DOUBLE_FLOAT, MsDF);
+        const auto Reference = EscapeImageReference(S);
+
+        const double MatchDF    = MatchRate(DF, Reference);
+        const double MatchFloat = MatchRate(Float, Reference);
+        const double CoordError = MaxCoordErrorPx(S);
+
+        const bool Ok = MatchDF >= 95.0 && CoordError < 0.05;
+        std::printf("%-18s zoom %.0e: df %6.2f%% (float %6.2f%%) px match, coord error %.1e px, float / double / df %6.1f / %6.1f / %6.1f ms  %s\n",
+                    S.Name, S.Zoom, MatchDF, MatchFloat, CoordError, MsFloat, MsDouble, MsDF, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    const char* SeahorseX = "-0.743643887037158704752191506114774";
+    const char* SeahorseY = "0.131825904205311970493132056385139";
+
+    const PrecisionScene Scenes[] = {
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT, 1e6, SeahorseX, SeahorseY, 2000},
+        {"mandelbrot", CPU_FRACTAL_2D_MANDELBROT, 1e10, SeahorseX, SeahorseY, 3000},
+        {"mandelbrot_colors", CPU_FRACTAL_2D_MANDELBROT_COLORS, 1e12, SeahorseX, SeahorseY, 4000},
+        {"burning_ship", CPU_FRACTAL_2D_BURNING_SHIP, 1e8, "-1.62", "0.0", 2000},
+        {"julia_dragons", CPU_FRACTAL_2D_JULIA_TWIN_DRAGONS_COLORS, 1e8, "0.3402865", "0.1052630", 2000}};
+
+    bool Ok = true;
+    for (const PrecisionScene& S : Scenes)
+        Ok = TestScene(S) && Ok;
+    return Ok ? 0 : 1;
+}
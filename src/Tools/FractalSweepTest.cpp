@@ -0,0 +1,77 @@
+// Prueba del barrido de parámetros (CPUFractalRenderer::RenderSweep): para un barrido del
+// Julia, uno del Burning Ship y uno de potencias del Mandelbulb, cada celda del atlas coincide
+// píxel a píxel con RenderRegion de su miniatura, y las miniaturas de valores distintos no
+// salen iguales. Devuelve 1 si algo falla.
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../CPU/CPUParameterSweep.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    bool TestSweep(CPUFractalRenderer& Renderer, const char* Name, int MaxIter, const CPUSweepSettings& Settings)
+    {
+        CPUShaderConstants Base = MakeTestConstants(CPU_FRACTAL_2D_MANDELBROT_COLORS, 320.0f, 240.0f);
+        Base.maxiter            = MaxIter;
+
+        std::vector<CPUShaderConstants> Slices;
+        MakeParameterSweep(Base, Settings, Slices);
+
+        CPUImage Atlas;
+        Renderer.RenderSweep(Slices, Settings.Columns, Atlas);
+        const double Seconds = Renderer.GetLastStats().Seconds;
+
+        size_t Mismatches = 0, Duplicates = 0;
+        CPUImage Thumb, PrevThumb;
+        for (std::uint32_t i = 0; i < Slices.size(); ++i)
+        {
+            Renderer.RenderRegion(Slices[i], 0, 0, Settings.ThumbWidth, Settings.ThumbHeight, Thumb);
+            const std::uint32_t X0 = i % Settings.Columns * Settings.ThumbWidth;
+            const std::uint32_t Y0 = i / Settings.Columns * Settings.ThumbHeight;
+            for (std::uint32_t y = 0; y < Thumb.Height; ++y)
+                for (std::uint32_t x = 0; x < Thumb.Width; ++x)
+                    Mismatches += Atlas.Pixels[(Y0 + y) * Atlas.Width + X0 + x] != Thumb.Pixels[y * Thumb.Width + x] ? 1 : 0;
+            Duplicates += i > 0 && Thumb.Pixels == PrevThumb.Pixels ? 1 : 0;
+            std::swap(Thumb, PrevThumb);
+        }
+
+        const bool Ok = Atlas.Width == Settings.Columns * Settings.ThumbWidth && Atlas.Height == Settings.Rows * Settings.ThumbHeight && Mismatches == 0 &&
+            Duplicates == 0;
+        std::printf("%-22s %zu thumbnails of %ux%u in %.1f ms, %zu mismatched px, %zu repeated thumbnails  %s\n", Name, Slices.size(),
+                    Settings.ThumbWidth, Settings.ThumbHeight, Seconds * 1e3, Mismatches, Duplicates, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    CPUFractalRenderer Renderer;
+    bool               Ok = true;
+
+    CPUSweepSettings Settings;
+    Settings.Columns     = 6;
+    Settings.Rows        = 4;
+    Settings.ThumbWidth  = 40;
+    Settings.ThumbHeight = 30;
+    Ok                   = TestSweep(Renderer, "julia_c", 256, Settings) && Ok;
+
+    Settings.Parameter = CPU_SWEEP_BURNING_SHIP_DEFORM;
+    Ok                 = TestSweep(Renderer, "burning_ship_deform", 256, Settings) && Ok;
+
+    Settings.Parameter   = CPU_SWEEP_BULB_POWER;
+    Settings.Columns     = 3;
+    Settings.Rows        = 2;
+    Settings.ThumbWidth  = 36;
+    Settings.ThumbHeight = 28;
+    Settings.MinX        = 2.0f;
+    Settings.MaxX        = 12.0f;
+    Ok                   = TestSweep(Renderer, "mandelbulb_power", 4, Settings) && Ok;
+
+    return Ok ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// Constantes de partida de las pruebas de src/Tools: colores, bailout 100 y potencia 2 en
+// float, c sin animar y la cámara 3D en z = -4 mirando hacia +z (CameraPos.w = 0: 2D). Cada
+// prueba cambia después solo lo que varía (maxiter, tiempo, precisión, cámara...).
+
+#include "../CPU/CPUShaderConstants.hpp"
+
+namespace Diligent
+{
+
+    inline CPUShaderConstants MakeTestConstants(int Type, float Width, float Height, float Zoom = 1.0f, float X = 0.0f, float Y = 0.0f)
+    {
+        CPUShaderConstants C = {};
+        C.TimeAndResolution  = {1.0f, Width, Height, static_cast<float>(Type)};
+        C.ZoomOffset         = {Zoom, X, Y, 0.0f};
+        C.FractalColor       = {1, 1, 1, 1};
+        C.BackgroundColor    = {0, 0, 0, 1};
+        C.maxiter            = 256;
+        C.FractalParams1     = {100.0f, 2.0f, static_cast<float>(CPU_PRECISION_FLOAT)};
+        C.FractalParams2     = {1, 0, 0, 0};
+        C.Options3D          = {100, 10.0f, 0.001f, 0.0f};
+        C.AnimationParams    = {1.0f, 0, 0, 0};
+        C.CameraPos          = {0.0f, 0.0f, -4.0f, 0.0f};
+        C.CameraDirX         = {1, 0, 0, 0};
+        C.CameraDirY         = {0, 1, 0, 0};
+        C.CameraDirZ         = {0, 0, 1, 0};
+        return C;
+    }
+
+} // namespace Diligent
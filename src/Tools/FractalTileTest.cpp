@@ -0,0 +1,208 @@
+// Prueba del cache de tiles 2D (CPUTileCache):
+//  - una vista alineada con las tiles de su nivel (píxel de vista = píxel de tile) montada con
+//    tiles es igual que RenderEscape2D;
+//  - la segunda vez sale entera del LRU en memoria, y otro cache con el mismo fichero la saca
+//    entera del disco; con un LRU de 4 tiles sigue saliendo entera, sin calcular nada;
+//  - al acercarse sin presupuesto se muestran los antecesores y al alejarse las hijas, y con
+//    presupuesto la vista se completa en varios frames igual que de una vez;
+//  - una tile corrupta en el fichero se descarta y se vuelve a calcular;
+//  - un segundo almacén no puede abrir un fichero que ya está abierto, y sí cuando se cierra.
+// Devuelve 1 si algo falla.
+
+#include <cstdio>
+#include <vector>
+
+#include "../CPU/CPUFractalRenderer.hpp"
+#include "../CPU/CPUTileCache.hpp"
+#include "FractalTestConstants.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+    const char* const CachePath = "fractal_tile_test.cache";
+
+    CPUShaderConstants MakeView(float Zoom, float OffsetX = -0.5f, float OffsetY = 0.0f)
+    {
+        CPUShaderConstants C = MakeTestConstants(CPU_FRACTAL_2D_MANDELBROT_COLORS, 256.0f, 256.0f, Zoom, OffsetX, OffsetY);
+        C.maxiter            = 500;
+        C.FractalParams1.z   = static_cast<float>(CPU_PRECISION_DOUBLE);
+        C.FractalParams2.y   = 1.0f;
+        return C;
+    }
+
+    size_t CountDifferent(const std::vector<CPUEscapeSample>& A, const std::vector<CPUEscapeSample>& B)
+    {
+        if (A.size() != B.size())
+            return A.size() + B.size();
+        size_t Different = 0;
+        for (size_t i = 0; i < A.size(); ++i)
+            Different += A[i].Iter != B[i].Iter || A[i].Mag != B[i].Mag;
+        return Different;
+    }
+
+    bool Report(const char* Name, const CPUTileCacheStats& Stats, size_t Different, bool Ok)
+    {
+        std::printf("%-12s level %d, %u tiles: %u memory, %u disk, %u rendered, %u placeholders, %zu px differ  %s\n", Name, Stats.Level,
+                    Stats.Tiles, Stats.MemoryHits, Stats.DiskHits, Stats.Rendered, Stats.Placeholders, Different, Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+
+    // Zoom 1 con 256 px de alto y tiles de 128: nivel 3, mismo tamaño de píxel que la tile y
+    // bordes de la vista en bordes de píxel de tile
+    bool TestStore(CPUFractalRenderer& Renderer)
+    {
+        CPUTileCacheSettings Settings;
+        Settings.DiskPath  = CachePath;
+        Settings.DiskSlots = 256;
+
+        const CPUShaderConstants     View = MakeView(1.0f);
+        std::vector<CPUEscapeSample> Direct, Cold, Warm, Disk, Mixed;
+        Renderer.RenderEscape2D(View, Direct);
+
+        bool Ok = true;
+        {
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            const bool   Complete = Cache.CanCache(View) && Cache.RenderEscape(View, Cold);
+            CPUTileCacheStats Stats    = Cache.GetLastStats();
+            size_t            Different = CountDifferent(Direct, Cold);
+            Ok = Report("cold", Stats, Different, Complete && Stats.Level == 3 && Stats.Rendered == Stats.Tiles && Different == 0) && Ok;
+
+            Cache.RenderEscape(View, Warm);
+            Stats     = Cache.GetLastStats();
+            Different = CountDifferent(Cold, Warm);
+            Ok        = Report("memory", Stats, Different, Stats.MemoryHits == Stats.Tiles && Stats.Rendered == 0 && Different == 0) && Ok;
+        }
+        {
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(View, Disk);
+            const CPUTileCacheStats& Stats     = Cache.GetLastStats();
+            const size_t             Different = CountDifferent(Cold, Disk);
+            Ok = Report("disk", Stats, Different, Stats.DiskHits == Stats.Tiles && Stats.Rendered == 0 && Different == 0) && Ok;
+        }
+        {
+            // 6 tiles en un LRU de 4: se van expulsando y vuelven del disco
+            Settings.MemoryTiles = 4;
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(View, Mixed);
+            Cache.RenderEscape(View, Mixed);
+            const CPUTileCacheStats& Stats     = Cache.GetLastStats();
+            const size_t             Different = CountDifferent(Cold, Mixed);
+            Ok = Report("lru4", Stats, Different,
+                        Stats.Resident <= 4 && Stats.MemoryHits + Stats.DiskHits == Stats.Tiles && Stats.Rendered == 0 && Different == 0) &&
+                Ok;
+        }
+        return Ok;
+    }
+
+    bool TestPlaceholders(CPUFractalRenderer& Renderer)
+    {
+        CPUTileCacheSettings Settings;
+        const CPUShaderConstants Far  = MakeView(1.0f);
+        const CPUShaderConstants Near = MakeView(2.0f);
+
+        std::vector<CPUEscapeSample> Reference, Samples;
+        {
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(Near, Reference);
+        }
+
+        bool Ok = true;
+        {
+            // Acercarse: el nivel 3 ya está, el 4 sale de sus padres y luego de 4 en 4
+            Settings.MaxTilesPerFrame = 0;
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(Far, Samples);
+            const bool              Complete = Cache.RenderEscape(Near, Samples);
+            const CPUTileCacheStats Stats    = Cache.GetLastStats();
+            Ok = Report("zoom in", Stats, CountDifferent(Reference, Samples),
+                        !Complete && Stats.Rendered == 0 && Stats.Placeholders == Stats.Tiles) &&
+                Ok;
+        }
+        {
+            Settings.MaxTilesPerFrame = 1;
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(Far, Samples);
+            std::uint32_t Frames = 1;
+            while (!Cache.RenderEscape(Near, Samples) && Frames < 64)
+                ++Frames;
+            const size_t Different = CountDifferent(Reference, Samples);
+            std::printf("%-12s complete in %u frames, %zu px differ  %s\n", "progressive", Frames, Different, Frames > 1 && Different == 0 ? "ok" : "FAIL");
+            Ok = Frames > 1 && Different == 0 && Ok;
+        }
+        {
+            // Alejarse: la vista de nivel 4 cubre las cuatro hijas de la tile [-1, 0]^2 del nivel 3,
+            // que sale de ellas; las otras cinco no tienen sustituto y se calculan
+            Settings.MaxTilesPerFrame = 0;
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            Cache.RenderEscape(MakeView(2.0f, -0.5f, -0.5f), Samples);
+            const bool              Complete = Cache.RenderEscape(Far, Samples);
+            const CPUTileCacheStats Stats    = Cache.GetLastStats();
+            Ok = Report("zoom out", Stats, 0, !Complete && Stats.Placeholders == 1 && Stats.Rendered == Stats.Tiles - 1) && Ok;
+        }
+        return Ok;
+    }
+
+    // Un byte cambiado en los datos de cada hueco ocupado: todas se descartan y se recalculan
+    bool TestCorruption(CPUFractalRenderer& Renderer)
+    {
+        CPUTileCacheSettings Settings;
+        Settings.DiskPath  = CachePath;
+        Settings.DiskSlots = 256;
+
+        std::uint64_t FileBytes = 0;
+        {
+            CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+            FileBytes = Cache.GetStore().GetFileBytes();
+        }
+        const std::uint64_t TileBytes  = std::uint64_t{Settings.TileSize} * Settings.TileSize * sizeof(CPUEscapeSample);
+        const std::uint64_t DataOffset = FileBytes - Settings.DiskSlots * TileBytes;
+        if (std::FILE* pFile = std::fopen(CachePath, "r+b"))
+        {
+            for (std::uint32_t Slot = 0; Slot < Settings.DiskSlots; ++Slot)
+            {
+                std::fseek(pFile, static_cast<long>(DataOffset + Slot * TileBytes + 100), SEEK_SET);
+                std::fputc(0x5A, pFile);
+            }
+            std::fclose(pFile);
+        }
+
+        const CPUShaderConstants     View = MakeView(1.0f);
+        std::vector<CPUEscapeSample> Direct, Samples;
+        Renderer.RenderEscape2D(View, Direct);
+
+        CPUTileCache Cache{Renderer.GetThreadPool(), Settings};
+        Cache.RenderEscape(View, Samples);
+        const CPUTileCacheStats& Stats     = Cache.GetLastStats();
+        const size_t             Different = CountDifferent(Direct, Samples);
+        return Report("corrupt", Stats, Different, Stats.DiskHits == 0 && Stats.Rendered == Stats.Tiles && Different == 0);
+    }
+
+    bool TestLock()
+    {
+        CPUTileStore First, Second;
+        const bool   FirstOpen  = First.Open(CachePath, 128, 16);
+        const bool   SecondOpen = Second.Open(CachePath, 128, 16);
+        First.Close();
+        const bool AfterClose = Second.Open(CachePath, 128, 16);
+        const bool Ok         = FirstOpen && !SecondOpen && AfterClose;
+        std::printf("%-12s first %s, second %s, after close %s  %s\n", "lock", FirstOpen ? "open" : "failed", SecondOpen ? "open" : "refused",
+                    AfterClose ? "open" : "failed", Ok ? "ok" : "FAIL");
+        return Ok;
+    }
+} // namespace
+
+int main()
+{
+    std::remove(CachePath);
+
+    CPUFractalRenderer Renderer;
+    bool               Ok = true;
+    Ok                    = TestStore(Renderer) && Ok;
+    Ok                    = TestPlaceholders(Renderer) && Ok;
+    Ok                    = TestCorruption(Renderer) && Ok;
+    Ok                    = TestLock() && Ok;
+
+    std::remove(CachePath);
+    return Ok ? 0 : 1;
+}